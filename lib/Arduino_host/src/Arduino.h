@@ -0,0 +1,98 @@
+/** @file       Arduino.h
+ *  @brief      This file is the main header of the host stand-in for the Arduino STM32 core, so the laser firmware
+ *              builds and runs on a PC.
+ *  @details    It has the parts of the core the firmware uses: time, pins, @c String, @c Print and the serial port.
+ *              Time is counted on the monotonic clock from when the program starts. Pins keep what was last
+ *              written to them, so a @c digitalRead() of an output gives back what was written, and an input with a
+ *              pull-up reads @c HIGH. The timers are in HardwareTimer.h and the serial port in HardwareSerial.h.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef ARDUINO_HOST_ARDUINO_H
+#define ARDUINO_HOST_ARDUINO_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmath>
+#include <cstdlib>
+
+#include "WString.h"
+#include "Print.h"
+#include "HardwareSerial.h"
+#include "pins_arduino.h"
+
+using std::abs;
+
+// ========================================== Constants ==========================================
+
+// Pin levels and modes
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+#define INPUT_PULLDOWN 0x3
+
+// Math constants
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+// PWM and ADC resolution, the same as the STM32 core's defaults
+#define PWM_RESOLUTION 8
+#define ADC_RESOLUTION 10
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+
+// =========================================== Functions ===========================================
+
+// The sketch
+void setup(void);
+void loop(void);
+
+// Time since the program started
+unsigned long millis(void);
+unsigned long micros(void);
+
+// Waiting; delay() blocks the calling task once the scheduler runs (see freertos_posix.cpp)
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+// Pins
+void pinMode(uint32_t pin, uint32_t mode);
+void digitalWrite(uint32_t pin, uint32_t value);
+int digitalRead(uint32_t pin);
+void analogWrite(uint32_t pin, uint32_t value);
+int analogRead(uint32_t pin);
+void analogWriteResolution(int bits);
+void analogReadResolution(int bits);
+
+// Interrupts; there are none to turn off on a PC
+inline void noInterrupts(void) {}
+inline void interrupts(void) {}
+
+// Math, as templates so the two sides can be different types like with Arduino's macros
+template <class T, class L> auto min(const T &a, const L &b) -> decltype((b < a) ? b : a) { return (b < a) ? b : a; }
+template <class T, class L> auto max(const T &a, const L &b) -> decltype((b < a) ? b : a) { return (a < b) ? b : a; }
+template <class T, class L, class H> T constrain(const T &x, const L &low, const H &high)
+{
+    return x < low ? low : (x > high ? high : x);
+}
+template <class T> T sq(const T &x) { return x*x; }
+inline long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+    return (x - in_min)*(out_max - out_min)/(in_max - in_min) + out_min;
+}
+inline double radians(double degrees) { return degrees*DEG_TO_RAD; }
+inline double degrees(double radians) { return radians*RAD_TO_DEG; }
+
+#endif //ARDUINO_HOST_ARDUINO_H
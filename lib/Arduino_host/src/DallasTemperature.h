@@ -0,0 +1,46 @@
+/** @file       DallasTemperature.h
+ *  @brief      This file contains the host stand-in for the DallasTemperature library.
+ *  @details    With nothing on the bus there are no sensors, and temperatures read @c DEVICE_DISCONNECTED_C, like the
+ *              real library does when a sensor doesn't answer.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef ARDUINO_HOST_DALLASTEMPERATURE_H
+#define ARDUINO_HOST_DALLASTEMPERATURE_H
+
+#include <stdint.h>
+#include "OneWire.h"
+
+// What a sensor that doesn't answer reads
+#define DEVICE_DISCONNECTED_C -127
+
+/** @brief      Class which stands in for DallasTemperature.
+ */
+class DallasTemperature
+{
+    protected:
+    OneWire *_bus;                      // The bus the sensors are on
+    uint8_t _resolution;                // Bits of resolution, 9 to 12
+
+    public:
+    // Constructor, for a bus
+    DallasTemperature(OneWire *bus) : _bus(bus), _resolution(12) {}
+
+    // Look for sensors on the bus
+    void begin(void) {}
+
+    // Get the number of sensors found
+    uint8_t getDeviceCount(void) { return 0; }
+
+    // Resolution of every sensor
+    void setResolution(uint8_t resolution) { _resolution = resolution; }
+    uint8_t getResolution(void) { return _resolution; }
+
+    // Start a reading, and get the result
+    void requestTemperatures(void) {}
+    float getTempCByIndex(uint8_t index) { (void)index; return DEVICE_DISCONNECTED_C; }
+};
+
+#endif //ARDUINO_HOST_DALLASTEMPERATURE_H
@@ -0,0 +1,225 @@
+/** @file       HardwareSerial.cpp
+ *  @brief      This file contains the host stand-in for the serial port, on standard input and output.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include "Arduino.h"
+#include "host_hal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#include <algorithm>
+
+/// The serial port to the PC
+HardwareSerial Serial(STDIN_FILENO, STDOUT_FILENO);
+
+
+// ========================================  Class: HardwareSerial ========================================
+
+/** @brief      Constructor for the HardwareSerial class
+ *  @param      in_fd File to read from
+ *  @param      out_fd File to write to
+ */
+HardwareSerial::HardwareSerial(int in_fd, int out_fd)
+{
+    _in_fd = in_fd;
+    _out_fd = out_fd;
+    _rx_head = 0;
+    _rx_count = 0;
+    _pty_name[0] = '\0';
+    _memory_input = false;
+    _memory_output = false;
+    _memory_lock = new std::mutex;
+}
+
+
+/** @brief      Start the port
+ *  @details    Makes reading never wait, like the UART.
+ *  @param      baud Baud rate; not used
+ */
+void HardwareSerial::begin(unsigned long baud)
+{
+    (void)baud;
+    if (_memory_input)
+    {
+        return;
+    }
+    fcntl(_in_fd, F_SETFL, fcntl(_in_fd, F_GETFL) | O_NONBLOCK);
+}
+
+
+/** @brief      Move the port to a new pseudo-terminal
+ *  @details    The terminal is raw, so bytes go through as they are, like on the board's USB serial port. The port
+ *              reads and writes the master side; the name returned is the side to open from another program.
+ *  @returns    The name of the terminal, or NULL if one couldn't be opened
+ */
+const char *HardwareSerial::open_pty(void)
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0 || ptsname(master) == NULL)
+    {
+        return NULL;
+    }
+    strncpy(_pty_name, ptsname(master), sizeof(_pty_name) - 1);
+
+    // Make the other side raw too, so it doesn't echo or change line endings before a program opens it
+    int slave = open(_pty_name, O_RDWR | O_NOCTTY);
+    if (slave >= 0)
+    {
+        struct termios settings;
+        tcgetattr(slave, &settings);
+        cfmakeraw(&settings);
+        tcsetattr(slave, TCSANOW, &settings);
+        close(slave);
+    }
+    _in_fd = master;
+    _out_fd = master;
+    return _pty_name;
+}
+
+
+/** @brief      Move reading, writing or both to memory
+ *  @details    After this, bytes given to @c feed() are read, and what is written is kept for @c take_output().
+ *              Reading from memory alone is how a whole job is given to the port at once.
+ *  @param      input @c true to read what is fed in instead of the file
+ *  @param      output @c true to keep what is written instead of writing the file
+ */
+void HardwareSerial::use_memory(bool input, bool output)
+{
+    std::lock_guard<std::mutex> lock(*_memory_lock);
+    _memory_input = input;
+    _memory_output = output;
+}
+
+
+/** @brief      Give the port bytes to read, as if the PC sent them
+ *  @param      bytes The bytes
+ *  @param      size How many
+ */
+void HardwareSerial::feed(const char *bytes, size_t size)
+{
+    std::lock_guard<std::mutex> lock(*_memory_lock);
+    _memory_in.append(bytes, size);
+}
+
+
+/** @brief      Take everything written to the port since this was last called
+ *  @returns    The bytes written
+ */
+std::string HardwareSerial::take_output(void)
+{
+    std::lock_guard<std::mutex> lock(*_memory_lock);
+    std::string output;
+    output.swap(_memory_out);
+    return output;
+}
+
+
+/** @brief      Take in bytes that have arrived, up to the room in the buffer
+ */
+void HardwareSerial::fill(void)
+{
+    host_hal_count(HAL_SERIAL);
+    if (_memory_input)
+    {
+        std::lock_guard<std::mutex> lock(*_memory_lock);
+        size_t count = std::min(_memory_in.size(), (size_t)(SERIAL_RX_BUFFER_SIZE - _rx_count));
+        for (size_t index = 0; index < count; index++)
+        {
+            _rx_buffer[(_rx_head + _rx_count) % SERIAL_RX_BUFFER_SIZE] = _memory_in[index];
+            _rx_count++;
+        }
+        _memory_in.erase(0, count);
+        return;
+    }
+    while (_rx_count < SERIAL_RX_BUFFER_SIZE)
+    {
+        uint8_t byte;
+        if (::read(_in_fd, &byte, 1) != 1)
+        {
+            return;
+        }
+        _rx_buffer[(_rx_head + _rx_count) % SERIAL_RX_BUFFER_SIZE] = byte;
+        _rx_count++;
+    }
+}
+
+
+/** @brief      Get the number of bytes waiting to be read
+ *  @returns    Bytes waiting
+ */
+int HardwareSerial::available(void)
+{
+    fill();
+    return _rx_count;
+}
+
+
+/** @brief      Read the next byte
+ *  @returns    The byte, or -1 if there isn't one
+ */
+int HardwareSerial::read(void)
+{
+    fill();
+    if (_rx_count == 0)
+    {
+        return -1;
+    }
+    uint8_t byte = _rx_buffer[_rx_head];
+    _rx_head = (_rx_head + 1) % SERIAL_RX_BUFFER_SIZE;
+    _rx_count--;
+    return byte;
+}
+
+
+/** @brief      Look at the next byte without taking it
+ *  @returns    The byte, or -1 if there isn't one
+ */
+int HardwareSerial::peek(void)
+{
+    fill();
+    return _rx_count == 0 ? -1 : _rx_buffer[_rx_head];
+}
+
+
+/** @brief      Write a byte
+ *  @param      byte The byte
+ *  @returns    1 if it was written
+ */
+size_t HardwareSerial::write(uint8_t byte)
+{
+    return write(&byte, 1);
+}
+
+
+/** @brief      Write a run of bytes, waiting until they're all written
+ *  @param      buffer The bytes
+ *  @param      size How many
+ *  @returns    How many were written
+ */
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    host_hal_count(HAL_SERIAL);
+    if (_memory_output)
+    {
+        std::lock_guard<std::mutex> lock(*_memory_lock);
+        _memory_out.append((const char*)buffer, size);
+        return size;
+    }
+    size_t count = 0;
+    while (count < size)
+    {
+        ssize_t written = ::write(_out_fd, buffer + count, size - count);
+        if (written < 0 && errno != EINTR && errno != EAGAIN)
+        {
+            break;
+        }
+        count += written > 0 ? written : 0;
+    }
+    return count;
+}
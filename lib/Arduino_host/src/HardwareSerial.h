@@ -0,0 +1,78 @@
+/** @file       HardwareSerial.h
+ *  @brief      This file contains the host stand-in for the serial port, @c Serial.
+ *  @details    On a PC the serial port is the program's standard input and output, so a G-code file can be piped in
+ *              and the answers read from standard output. Reading never waits: bytes that have arrived on standard
+ *              input are taken in when @c available(), @c peek() or @c read() is called, like the UART's buffer.
+ *
+ *              The port can also be moved to a pseudo-terminal, which the Python tools can open like the board's
+ *              port, or to memory, where a host program feeds it bytes and takes what was written; see host_hal.h.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef ARDUINO_HOST_HARDWARESERIAL_H
+#define ARDUINO_HOST_HARDWARESERIAL_H
+
+#include <mutex>
+#include <string>
+#include "Print.h"
+
+// Bytes taken in from standard input at a time; the same as the STM32 core's serial receive buffer
+#define SERIAL_RX_BUFFER_SIZE 64
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which stands in for a serial port, on standard input and output.
+ */
+class HardwareSerial : public Stream
+{
+    protected:
+    int _in_fd;                                 // File to read from
+    int _out_fd;                                // File to write to
+    uint8_t _rx_buffer[SERIAL_RX_BUFFER_SIZE];  // Bytes read but not yet taken
+    uint16_t _rx_head;                          // Next byte to take
+    uint16_t _rx_count;                         // Bytes waiting
+    char _pty_name[64];                         // Name of the pseudo-terminal, if on one
+    bool _memory_input;                         // True when reading memory instead of a file
+    bool _memory_output;                        // True when writing memory instead of a file
+    std::string _memory_in;                     // Bytes fed in but not yet taken into the buffer
+    std::string _memory_out;                    // Bytes written but not yet taken
+    std::mutex *_memory_lock;                   // Guards the memory, which the host program uses from its thread
+
+    // Take in bytes that have arrived, if there's room
+    void fill(void);
+
+    public:
+    // Constructor, for the files to read and write
+    HardwareSerial(int in_fd, int out_fd);
+
+    // Start the port; the baud rate doesn't matter here
+    void begin(unsigned long baud);
+
+    // Reading
+    int available(void) override;
+    int read(void) override;
+    int peek(void) override;
+
+    // Writing
+    size_t write(uint8_t byte) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+    // True once the port can be used
+    operator bool(void) { return true; }
+
+    // Not in the Arduino core: move the port to a pseudo-terminal, and get its name, or NULL if it couldn't be opened
+    const char *open_pty(void);
+
+    // Not in the Arduino core: move reading, writing or both to memory, then feed it bytes and take what was written
+    void use_memory(bool input, bool output);
+    void feed(const char *bytes, size_t size);
+    std::string take_output(void);
+};
+
+/// The serial port to the PC
+extern HardwareSerial Serial;
+
+#endif //ARDUINO_HOST_HARDWARESERIAL_H
@@ -0,0 +1,202 @@
+/** @file       HardwareTimer.cpp
+ *  @brief      This file contains the host stand-in for the STM32 timers.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include "HardwareTimer.h"
+#include "host_hal.h"
+#include "FreeRTOS.h"
+
+/// Registers of every timer
+TIM_TypeDef host_timers[HOST_TIMER_COUNT];
+
+
+// ========================================  Class: HardwareTimer ========================================
+
+/** @brief      Constructor for the HardwareTimer class
+ *  @details    Like the STM32 core, the timer starts paused with a prescaler of 1 and an overflow of 0x10000.
+ *  @param      instance The timer's registers, such as @c TIM3
+ */
+HardwareTimer::HardwareTimer(TIM_TypeDef *instance)
+{
+    _instance = instance;
+    _instance->CR1 &= ~TIM_CR1_CEN;
+    _instance->PSC = 0;
+    _instance->ARR = 0xFFFF;
+    _counted_to = ullTaskHostTime();
+}
+
+
+/** @brief      Check whether the timer counts encoder edges instead of time
+ *  @returns    @c true if the slave mode is one of the encoder modes (1 to 3)
+ */
+bool HardwareTimer::in_encoder_mode(void)
+{
+    uint32_t slave_mode = _instance->SMCR & TIM_SMCR_SMS;
+    return slave_mode >= 1 && slave_mode <= 3;
+}
+
+
+/** @brief      Bring @c CNT up to now, if the timer is running and counting time
+ *  @details    Whole ticks are added and the time they took is moved past, so no part of a tick is lost between
+ *              reads. In encoder mode the counts come from the motor tied to the timer, if there is one. It also
+ *              counts the call, for the methods that call it; the rest count their own.
+ */
+void HardwareTimer::update_count(void)
+{
+    host_hal_count(HAL_TIMER);
+    uint64_t now = ullTaskHostTime();
+    if (in_encoder_mode())
+    {
+        host_encoder_update(_instance);
+        _counted_to = now;
+        return;
+    }
+    if (!(_instance->CR1 & TIM_CR1_CEN))
+    {
+        _counted_to = now;
+        return;
+    }
+    double tick_hz = (double)HOST_TIMER_CLOCK_HZ/(_instance->PSC + 1);
+    uint64_t ticks = (uint64_t)((now - _counted_to)*1e-9*tick_hz);
+    if (ticks > 0)
+    {
+        _instance->CNT = (uint32_t)((_instance->CNT + ticks) % ((uint64_t)_instance->ARR + 1));
+        _counted_to += (uint64_t)(ticks*1e9/tick_hz);
+    }
+}
+
+
+/** @brief      Stop counting
+ */
+void HardwareTimer::pause(void)
+{
+    update_count();
+    _instance->CR1 &= ~TIM_CR1_CEN;
+}
+
+
+/** @brief      Start counting, if not counting already
+ */
+void HardwareTimer::resume(void)
+{
+    update_count();
+    _instance->CR1 |= TIM_CR1_CEN;
+}
+
+
+/** @brief      Set a channel's mode
+ *  @param      channel Channel 1 to 4
+ *  @param      mode The mode
+ *  @param      pin The pin number of the channel
+ */
+void HardwareTimer::setMode(uint32_t channel, TimerModes_t mode, uint32_t pin)
+{
+    setMode(channel, mode, digitalPinToPinName(pin));
+}
+
+
+/** @brief      Set a channel's mode; on a PC nothing is wired to the pin
+ *  @param      channel Channel 1 to 4
+ *  @param      mode The mode
+ *  @param      pin The pin name of the channel, or @c NC
+ */
+void HardwareTimer::setMode(uint32_t channel, TimerModes_t mode, PinName pin)
+{
+    host_hal_count(HAL_TIMER);
+    (void)channel;
+    (void)mode;
+    (void)pin;
+}
+
+
+/** @brief      Set the prescaler
+ *  @param      prescaler Timer clock ticks per count, 1 to 0x10000
+ */
+void HardwareTimer::setPrescaleFactor(uint32_t prescaler)
+{
+    update_count();
+    _instance->PSC = prescaler > 0 ? prescaler - 1 : 0;
+}
+
+
+/** @brief      Get the prescaler
+ *  @returns    Timer clock ticks per count
+ */
+uint32_t HardwareTimer::getPrescaleFactor(void)
+{
+    host_hal_count(HAL_TIMER);
+    return _instance->PSC + 1;
+}
+
+
+/** @brief      Set the overflow, where the count wraps to 0
+ *  @param      overflow The overflow
+ *  @param      format Units of the overflow: counts, microseconds, or hertz
+ */
+void HardwareTimer::setOverflow(uint32_t overflow, TimerFormat_t format)
+{
+    update_count();
+    uint64_t counts = overflow;
+    if (format == MICROSEC_FORMAT)
+    {
+        counts = (uint64_t)overflow*(HOST_TIMER_CLOCK_HZ/1000000)/(_instance->PSC + 1);
+    }
+    else if (format == HERTZ_FORMAT)
+    {
+        counts = overflow > 0 ? HOST_TIMER_CLOCK_HZ/(_instance->PSC + 1)/overflow : 0;
+    }
+    _instance->ARR = counts > 0 ? (uint32_t)(counts - 1) : 0;
+}
+
+
+/** @brief      Get the overflow
+ *  @param      format Units: counts, microseconds, or hertz
+ *  @returns    The overflow
+ */
+uint32_t HardwareTimer::getOverflow(TimerFormat_t format)
+{
+    host_hal_count(HAL_TIMER);
+    uint64_t counts = (uint64_t)_instance->ARR + 1;
+    if (format == MICROSEC_FORMAT)
+    {
+        return (uint32_t)(counts*(_instance->PSC + 1)/(HOST_TIMER_CLOCK_HZ/1000000));
+    }
+    if (format == HERTZ_FORMAT)
+    {
+        return (uint32_t)(HOST_TIMER_CLOCK_HZ/(_instance->PSC + 1)/counts);
+    }
+    return (uint32_t)counts;
+}
+
+
+/** @brief      Set the count
+ *  @param      count The count
+ *  @param      format Units: counts or microseconds
+ */
+void HardwareTimer::setCount(uint32_t count, TimerFormat_t format)
+{
+    update_count();
+    if (format == MICROSEC_FORMAT)
+    {
+        count = (uint32_t)((uint64_t)count*(HOST_TIMER_CLOCK_HZ/1000000)/(_instance->PSC + 1));
+    }
+    _instance->CNT = count;
+}
+
+
+/** @brief      Get the count
+ *  @param      format Units: counts or microseconds
+ *  @returns    The count
+ */
+uint32_t HardwareTimer::getCount(TimerFormat_t format)
+{
+    update_count();
+    if (format == MICROSEC_FORMAT)
+    {
+        return (uint32_t)((uint64_t)_instance->CNT*(_instance->PSC + 1)/(HOST_TIMER_CLOCK_HZ/1000000));
+    }
+    return _instance->CNT;
+}
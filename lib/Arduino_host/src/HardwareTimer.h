@@ -0,0 +1,141 @@
+/** @file       HardwareTimer.h
+ *  @brief      This file contains the host stand-in for the STM32 timers: their registers and the @c HardwareTimer
+ *              class.
+ *  @details    Each timer has a @c TIM_TypeDef with the registers the firmware touches, so code that sets bits in
+ *              @c SMCR or @c CR1 builds and does the same thing. A running timer counts up at the timer clock over
+ *              its prescaler, worked out from the monotonic clock whenever it is read, and wraps at its overflow.
+ *              A timer in encoder mode (@c SMCR slave mode 3) doesn't count with time; its @c CNT only moves when
+ *              something writes it, as the encoder would.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef ARDUINO_HOST_HARDWARETIMER_H
+#define ARDUINO_HOST_HARDWARETIMER_H
+
+#include <stdint.h>
+#include "pins_arduino.h"
+
+// ========================================== Constants ==========================================
+
+// Timer clock: the L476's 80 MHz system clock
+#define HOST_TIMER_CLOCK_HZ 80000000UL
+
+// Register bits the firmware uses
+#define TIM_CR1_CEN 0x0001UL
+#define TIM_SMCR_SMS_0 0x0001UL
+#define TIM_SMCR_SMS_1 0x0002UL
+#define TIM_SMCR_SMS_2 0x0004UL
+#define TIM_SMCR_SMS (TIM_SMCR_SMS_0 | TIM_SMCR_SMS_1 | TIM_SMCR_SMS_2)
+
+// Slave mode 3: count both edges of both encoder channels
+#define TIM_ENCODERMODE_TI12 (TIM_SMCR_SMS_0 | TIM_SMCR_SMS_1)
+
+/// Registers of a timer
+typedef struct
+{
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t SMCR;
+    volatile uint32_t DIER;
+    volatile uint32_t SR;
+    volatile uint32_t EGR;
+    volatile uint32_t CCMR1;
+    volatile uint32_t CCMR2;
+    volatile uint32_t CCER;
+    volatile uint32_t CNT;
+    volatile uint32_t PSC;
+    volatile uint32_t ARR;
+    volatile uint32_t RCR;
+    volatile uint32_t CCR1;
+    volatile uint32_t CCR2;
+    volatile uint32_t CCR3;
+    volatile uint32_t CCR4;
+} TIM_TypeDef;
+
+// The timers, numbered like the L476's
+#define HOST_TIMER_COUNT 18
+extern TIM_TypeDef host_timers[HOST_TIMER_COUNT];
+#define TIM1 (&host_timers[1])
+#define TIM2 (&host_timers[2])
+#define TIM3 (&host_timers[3])
+#define TIM4 (&host_timers[4])
+#define TIM5 (&host_timers[5])
+#define TIM6 (&host_timers[6])
+#define TIM7 (&host_timers[7])
+#define TIM8 (&host_timers[8])
+#define TIM15 (&host_timers[15])
+#define TIM16 (&host_timers[16])
+#define TIM17 (&host_timers[17])
+
+/// Timer channel modes
+typedef enum
+{
+    TIMER_DISABLED,
+    TIMER_OUTPUT_COMPARE,
+    TIMER_OUTPUT_COMPARE_ACTIVE,
+    TIMER_OUTPUT_COMPARE_INACTIVE,
+    TIMER_OUTPUT_COMPARE_TOGGLE,
+    TIMER_OUTPUT_COMPARE_PWM1,
+    TIMER_OUTPUT_COMPARE_PWM2,
+    TIMER_OUTPUT_COMPARE_FORCED_ACTIVE,
+    TIMER_OUTPUT_COMPARE_FORCED_INACTIVE,
+    TIMER_INPUT_CAPTURE_RISING,
+    TIMER_INPUT_CAPTURE_FALLING,
+    TIMER_INPUT_CAPTURE_BOTHEDGE,
+    TIMER_NOT_USED = 0xFFFF
+} TimerModes_t;
+
+/// Units for counts and overflows
+typedef enum
+{
+    TICK_FORMAT,
+    MICROSEC_FORMAT,
+    HERTZ_FORMAT
+} TimerFormat_t;
+
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which stands in for the STM32 core's @c HardwareTimer.
+ */
+class HardwareTimer
+{
+    protected:
+    TIM_TypeDef *_instance;                                 // The timer's registers
+    uint64_t _counted_to;               // Time the count was last brought up to, in nanoseconds
+
+    // Bring CNT up to now, if the timer is running and counting time
+    void update_count(void);
+
+    // Check whether the timer counts encoder edges instead of time
+    bool in_encoder_mode(void);
+
+    public:
+    // Constructor, for a timer's registers
+    HardwareTimer(TIM_TypeDef *instance);
+
+    // Stop and start counting
+    void pause(void);
+    void resume(void);
+
+    // Set a channel's mode; on a PC nothing is wired to the pin
+    void setMode(uint32_t channel, TimerModes_t mode, uint32_t pin);
+    void setMode(uint32_t channel, TimerModes_t mode, PinName pin = NC);
+
+    // Prescaler and overflow
+    void setPrescaleFactor(uint32_t prescaler);
+    uint32_t getPrescaleFactor(void);
+    void setOverflow(uint32_t overflow, TimerFormat_t format = TICK_FORMAT);
+    uint32_t getOverflow(TimerFormat_t format = TICK_FORMAT);
+
+    // Count
+    void setCount(uint32_t count, TimerFormat_t format = TICK_FORMAT);
+    uint32_t getCount(TimerFormat_t format = TICK_FORMAT);
+
+    // Timer clock frequency
+    uint32_t getTimerClkFreq(void) { return HOST_TIMER_CLOCK_HZ; }
+};
+
+#endif //ARDUINO_HOST_HARDWARETIMER_H
@@ -0,0 +1,33 @@
+/** @file       OneWire.h
+ *  @brief      This file contains the host stand-in for the OneWire library; there is no bus on a PC, so nothing
+ *              answers on it.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef ARDUINO_HOST_ONEWIRE_H
+#define ARDUINO_HOST_ONEWIRE_H
+
+#include <stdint.h>
+
+/** @brief      Class which stands in for a OneWire bus with nothing on it.
+ */
+class OneWire
+{
+    protected:
+    uint8_t _pin;                       // Bus pin
+
+    public:
+    // Constructor, for the bus pin
+    OneWire(uint8_t pin) : _pin(pin) {}
+
+    // Reset the bus; returns 1 if something answered
+    uint8_t reset(void) { return 0; }
+
+    // Write and read bytes
+    void write(uint8_t byte, uint8_t power = 0) { (void)byte; (void)power; }
+    uint8_t read(void) { return 0xFF; }
+};
+
+#endif //ARDUINO_HOST_ONEWIRE_H
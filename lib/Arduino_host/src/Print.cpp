@@ -0,0 +1,84 @@
+/** @file       Print.cpp
+ *  @brief      This file contains the host stand-in for Arduino's @c Print and @c Stream classes.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include "Arduino.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+
+// ========================================  Class: Print ========================================
+
+/** @brief      Write a run of bytes, one at a time
+ *  @param      buffer The bytes
+ *  @param      size How many
+ *  @returns    How many were written
+ */
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t count = 0;
+    while (size-- > 0 && write(*buffer++) == 1)
+    {
+        count++;
+    }
+    return count;
+}
+
+
+/** @brief      Write text
+ *  @param      text Ended with a null; NULL writes nothing
+ *  @returns    How many bytes were written
+ */
+size_t Print::write(const char *text)
+{
+    return text == NULL ? 0 : write((const uint8_t*)text, strlen(text));
+}
+
+
+/** @brief      Print like @c printf()
+ *  @details    Like the STM32 core, the text is cut off at 256 bytes.
+ *  @param      format The format
+ *  @returns    How many bytes were written
+ */
+size_t Print::printf(const char *format, ...)
+{
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    return write(text);
+}
+
+
+
+// ========================================  Class: Stream ========================================
+
+/** @brief      Read bytes until there are enough, or one doesn't come within the timeout
+ *  @param      buffer Filled with the bytes
+ *  @param      length How many to read
+ *  @returns    How many were read
+ */
+size_t Stream::readBytes(char *buffer, size_t length)
+{
+    size_t count = 0;
+    while (count < length)
+    {
+        unsigned long start = millis();
+        while (available() <= 0)
+        {
+            if (millis() - start >= _timeout)
+            {
+                return count;
+            }
+            delay(1);
+        }
+        buffer[count++] = (char)read();
+    }
+    return count;
+}
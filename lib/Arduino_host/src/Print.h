@@ -0,0 +1,88 @@
+/** @file       Print.h
+ *  @brief      This file contains the host stand-in for Arduino's @c Print and @c Stream classes.
+ *  @details    Anything that can write bytes can print text and numbers, the way Arduino does it; see WString.h.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef ARDUINO_HOST_PRINT_H
+#define ARDUINO_HOST_PRINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "WString.h"
+
+// ========================================== Constants ==========================================
+
+// Bases for printing whole numbers
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which prints text and numbers to anything that can write bytes.
+ */
+class Print
+{
+    public:
+    virtual ~Print(void) {}
+
+    // Write one byte, or a run of them; returns how many were written
+    virtual size_t write(uint8_t byte) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *text);
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+
+    // Print text and numbers
+    size_t print(const String &text) { return write(text.c_str()); }
+    size_t print(const char *text) { return write(text); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char value, int base = DEC) { return print(String(value, base)); }
+    size_t print(int value, int base = DEC) { return print(String(value, base)); }
+    size_t print(unsigned int value, int base = DEC) { return print(String(value, base)); }
+    size_t print(long value, int base = DEC) { return print(String(value, base)); }
+    size_t print(unsigned long value, int base = DEC) { return print(String(value, base)); }
+    size_t print(double value, int decimal_places = 2) { return print(String(value, decimal_places)); }
+
+    // Print them and end the line
+    size_t println(void) { return write("\r\n"); }
+    template <class T> size_t println(T item) { size_t count = print(item); return count + println(); }
+    template <class T> size_t println(T item, int format) { size_t count = print(item, format); return count + println(); }
+
+    // Print like printf()
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+    // Wait until everything written has gone out
+    virtual void flush(void) {}
+};
+
+
+/** @brief      Class for things which can be read from as well as printed to.
+ */
+class Stream : public Print
+{
+    protected:
+    unsigned long _timeout = 1000;      // Milliseconds to wait in readBytes()
+
+    public:
+    // Get the number of bytes waiting to be read
+    virtual int available(void) = 0;
+
+    // Read the next byte, or -1 if there isn't one
+    virtual int read(void) = 0;
+
+    // Look at the next byte without taking it, or -1 if there isn't one
+    virtual int peek(void) = 0;
+
+    // Set how long readBytes() waits for each byte
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+
+    // Read bytes until there are enough or one doesn't come in time
+    size_t readBytes(char *buffer, size_t length);
+};
+
+#endif //ARDUINO_HOST_PRINT_H
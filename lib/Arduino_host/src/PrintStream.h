@@ -0,0 +1,40 @@
+/** @file       PrintStream.h
+ *  @brief      This file contains the host stand-in for the PrintStream library, which lets anything printable be
+ *              written with @c <<, like @c Serial @c << @c "Hi" @c << @c endl.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef ARDUINO_HOST_PRINTSTREAM_H
+#define ARDUINO_HOST_PRINTSTREAM_H
+
+#include "Print.h"
+
+/// Ends a line when written with @c <<
+enum _EndLineCode { endl };
+
+/** @brief      Print anything @c Print can print
+ *  @param      printer Where to print
+ *  @param      item What to print
+ *  @returns    The printer, for the next @c <<
+ */
+template <class T> inline Print &operator<<(Print &printer, const T &item)
+{
+    printer.print(item);
+    return printer;
+}
+
+/** @brief      End a line
+ *  @param      printer Where to print
+ *  @param      code @c endl
+ *  @returns    The printer, for the next @c <<
+ */
+inline Print &operator<<(Print &printer, _EndLineCode code)
+{
+    (void)code;
+    printer.println();
+    return printer;
+}
+
+#endif //ARDUINO_HOST_PRINTSTREAM_H
@@ -0,0 +1,200 @@
+/** @file       WString.cpp
+ *  @brief      This file contains the host stand-in for Arduino's @c String class.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include "WString.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// ======================================== Subfunctions ========================================
+
+/** @brief      Write a whole number in a base, like Arduino's @c ultoa()
+ *  @param      value The number
+ *  @param      base 2 to 36
+ *  @returns    The digits
+ */
+static std::string unsigned_text(unsigned long value, unsigned char base)
+{
+    if (base < 2 || base > 36)
+    {
+        base = 10;
+    }
+    std::string digits;
+    do
+    {
+        uint8_t digit = value % base;
+        digits.insert(digits.begin(), (char)(digit < 10 ? '0' + digit : 'a' + digit - 10));
+        value /= base;
+    } while (value != 0);
+    return digits;
+}
+
+
+/** @brief      Write a signed whole number; only base 10 gets a minus sign, like Arduino
+ *  @param      value The number
+ *  @param      base 2 to 36
+ *  @param      bits Bits in the number's type, for the two's complement of negatives in other bases
+ *  @returns    The digits
+ */
+static std::string signed_text(long value, unsigned char base, uint8_t bits)
+{
+    if (base == 10 && value < 0)
+    {
+        return "-" + unsigned_text(0UL - (unsigned long)value, 10);
+    }
+    unsigned long mask = bits >= 8*sizeof(unsigned long) ? ~0UL : (1UL << bits) - 1;
+    return unsigned_text((unsigned long)value & mask, base);
+}
+
+
+/** @brief      Write a float with a number of decimal places, like Arduino's @c dtostrf()
+ *  @param      value The number
+ *  @param      decimal_places Digits after the point
+ *  @returns    The digits
+ */
+static std::string float_text(double value, unsigned char decimal_places)
+{
+    char text[64];
+    snprintf(text, sizeof(text), "%.*f", decimal_places, value);
+    return text;
+}
+
+
+
+// ========================================  Class: String ========================================
+
+String::String(unsigned char value, unsigned char base) : _text(unsigned_text(value, base)) {}
+String::String(int value, unsigned char base) : _text(signed_text(value, base, 8*sizeof(int))) {}
+String::String(unsigned int value, unsigned char base) : _text(unsigned_text(value, base)) {}
+String::String(long value, unsigned char base) : _text(signed_text(value, base, 8*sizeof(long))) {}
+String::String(unsigned long value, unsigned char base) : _text(unsigned_text(value, base)) {}
+String::String(float value, unsigned char decimal_places) : _text(float_text(value, decimal_places)) {}
+String::String(double value, unsigned char decimal_places) : _text(float_text(value, decimal_places)) {}
+
+
+/** @brief      Find a character
+ *  @param      c The character
+ *  @param      from Where to start looking
+ *  @returns    Its place, or -1 if it isn't there
+ */
+int String::indexOf(char c, unsigned int from) const
+{
+    size_t place = _text.find(c, from);
+    return place == std::string::npos ? -1 : (int)place;
+}
+
+
+/** @brief      Get the end of the string
+ *  @param      from Place of the first character
+ *  @returns    The characters from there on
+ */
+String String::substring(unsigned int from) const
+{
+    return substring(from, _text.length());
+}
+
+
+/** @brief      Get part of the string
+ *  @param      from Place of the first character
+ *  @param      to Place after the last character; swapped with @c from if it's smaller, like Arduino
+ *  @returns    The characters between
+ */
+String String::substring(unsigned int from, unsigned int to) const
+{
+    if (from > to)
+    {
+        unsigned int temp = from;
+        from = to;
+        to = temp;
+    }
+    String part;
+    if (from < _text.length())
+    {
+        part._text = _text.substr(from, (to < _text.length() ? to : _text.length()) - from);
+    }
+    return part;
+}
+
+
+/** @brief      Take spaces off both ends
+ */
+void String::trim(void)
+{
+    size_t first = _text.find_first_not_of(" \t\r\n\f\v");
+    size_t last = _text.find_last_not_of(" \t\r\n\f\v");
+    _text = first == std::string::npos ? "" : _text.substr(first, last - first + 1);
+}
+
+
+/** @brief      Copy the characters into a buffer, cut short to fit and ended with a null
+ *  @param      buffer Where they go
+ *  @param      size Bytes in the buffer
+ *  @param      index Place of the first character to copy
+ */
+void String::toCharArray(char *buffer, unsigned int size, unsigned int index) const
+{
+    getBytes((unsigned char*)buffer, size, index);
+}
+
+
+/** @brief      Copy the characters into a buffer, cut short to fit and ended with a null
+ *  @param      buffer Where they go
+ *  @param      size Bytes in the buffer
+ *  @param      index Place of the first character to copy
+ */
+void String::getBytes(unsigned char *buffer, unsigned int size, unsigned int index) const
+{
+    if (size == 0 || buffer == nullptr)
+    {
+        return;
+    }
+    if (index >= _text.length())
+    {
+        buffer[0] = '\0';
+        return;
+    }
+    unsigned int count = _text.length() - index;
+    count = count < size - 1 ? count : size - 1;
+    memcpy(buffer, _text.c_str() + index, count);
+    buffer[count] = '\0';
+}
+
+
+/** @brief      Read a whole number from the start of the string
+ *  @returns    The number, or 0 if there isn't one
+ */
+long String::toInt(void) const
+{
+    return atol(_text.c_str());
+}
+
+
+/** @brief      Read a number from the start of the string
+ *  @returns    The number, or 0 if there isn't one
+ */
+float String::toFloat(void) const
+{
+    return (float)atof(_text.c_str());
+}
+
+
+
+// ======================================== Functions ========================================
+
+String operator+(const String &left, const String &right)   { String sum(left); sum += right; return sum; }
+String operator+(const String &left, const char *right)     { String sum(left); sum += right; return sum; }
+String operator+(const char *left, const String &right)     { String sum(left); sum += right; return sum; }
+String operator+(const String &left, char right)            { String sum(left); sum += right; return sum; }
+String operator+(const String &left, unsigned char right)   { return left + String(right); }
+String operator+(const String &left, int right)             { return left + String(right); }
+String operator+(const String &left, unsigned int right)    { return left + String(right); }
+String operator+(const String &left, long right)            { return left + String(right); }
+String operator+(const String &left, unsigned long right)   { return left + String(right); }
+String operator+(const String &left, float right)           { return left + String(right); }
+String operator+(const String &left, double right)          { return left + String(right); }
@@ -0,0 +1,86 @@
+/** @file       WString.h
+ *  @brief      This file contains the host stand-in for Arduino's @c String class.
+ *  @details    It has the constructors, adding and the methods the firmware uses, and prints numbers the way Arduino
+ *              does: whole numbers in the base given, and floats with 2 decimal places unless told otherwise.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef ARDUINO_HOST_WSTRING_H
+#define ARDUINO_HOST_WSTRING_H
+
+#include <stdint.h>
+#include <string>
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which stands in for Arduino's @c String.
+ */
+class String
+{
+    protected:
+    std::string _text;                  // The characters
+
+    public:
+    // Constructors
+    String(void) {}
+    String(const char *text) : _text(text != nullptr ? text : "") {}
+    String(const String &other) = default;
+    explicit String(char c) : _text(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(float value, unsigned char decimal_places = 2);
+    explicit String(double value, unsigned char decimal_places = 2);
+    String &operator=(const String &other) = default;
+
+    // Characters and length
+    const char *c_str(void) const { return _text.c_str(); }
+    unsigned int length(void) const { return _text.length(); }
+    char charAt(unsigned int index) const { return index < _text.length() ? _text[index] : '\0'; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    bool reserve(unsigned int size) { _text.reserve(size); return true; }
+
+    // Adding to the end
+    String &operator+=(const String &other) { _text += other._text; return *this; }
+    String &operator+=(const char *text) { _text += text; return *this; }
+    String &operator+=(char c) { _text += c; return *this; }
+    bool concat(const String &other) { _text += other._text; return true; }
+
+    // Comparing
+    bool operator==(const String &other) const { return _text == other._text; }
+    bool operator!=(const String &other) const { return _text != other._text; }
+    bool equals(const String &other) const { return _text == other._text; }
+    bool startsWith(const String &prefix) const { return _text.compare(0, prefix._text.length(), prefix._text) == 0; }
+
+    // Finding and cutting
+    int indexOf(char c, unsigned int from = 0) const;
+    String substring(unsigned int from) const;
+    String substring(unsigned int from, unsigned int to) const;
+    void trim(void);
+
+    // Copying out and converting
+    void toCharArray(char *buffer, unsigned int size, unsigned int index = 0) const;
+    void getBytes(unsigned char *buffer, unsigned int size, unsigned int index = 0) const;
+    long toInt(void) const;
+    float toFloat(void) const;
+};
+
+
+// Adding strings and things that become strings
+String operator+(const String &left, const String &right);
+String operator+(const String &left, const char *right);
+String operator+(const char *left, const String &right);
+String operator+(const String &left, char right);
+String operator+(const String &left, unsigned char right);
+String operator+(const String &left, int right);
+String operator+(const String &left, unsigned int right);
+String operator+(const String &left, long right);
+String operator+(const String &left, unsigned long right);
+String operator+(const String &left, float right);
+String operator+(const String &left, double right);
+
+#endif //ARDUINO_HOST_WSTRING_H
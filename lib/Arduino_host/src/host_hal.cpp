@@ -0,0 +1,334 @@
+/** @file       host_hal.cpp
+ *  @brief      This file contains the counts of hardware calls, the pin write log and the motors of the host stand-in
+ *              of the Arduino core.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include "Arduino.h"
+#include "host_hal.h"
+#include "FreeRTOS.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mutex>
+
+///@cond
+/// Hardware calls made by one task
+struct host_hal_stats
+{
+    TaskHandle_t task;                  // The task, or NULL for calls from outside any task
+    char name[16];                      // Its name, for the report
+    uint32_t calls[HAL_CALL_KINDS];     // Calls of each kind
+};
+
+/// A motor and how fast it is turning
+struct host_motor
+{
+    host_motor_config config;           // How it is wired and how it moves
+    float speed;                        // Counts a second
+    double counts;                      // Counts turned but not yet added to the timer, less than one
+    uint64_t moved_to;                  // When it was last moved, in nanoseconds
+};
+
+// Names of the kinds of calls, for the report and the log
+static const char *const call_names[HAL_CALL_KINDS] =
+    {"pinMode", "digitalWrite", "digitalRead", "analogWrite", "analogRead", "timer", "serial"};
+
+// Nanoseconds each kind of call takes on the board's 80 MHz core, for virtual time: register writes through the
+// Arduino core, an ADC conversion, and a call into the USB serial driver
+static const uint32_t call_costs[HAL_CALL_KINDS] = {1000, 250, 250, 1500, 10000, 300, 2000};
+
+// Everything here is guarded by this; made once and never deleted, so exit() can run while tasks still call in
+static std::mutex &hal_lock = *new std::mutex;
+
+static host_hal_stats stats[HOST_HAL_MAX_TASKS];
+static uint8_t stats_count = 0;
+static host_motor motors[HOST_MAX_MOTORS];
+static uint8_t motor_count = 0;
+static FILE *pin_log = NULL;
+///@endcond
+
+
+// ==================================== Subfunctions ====================================
+
+/** @brief      Find the calls of the calling task, making room for them the first time it calls
+ *  @details    The hardware lock must be held.
+ *  @returns    The task's calls
+ */
+static host_hal_stats *task_stats(void)
+{
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    for (uint8_t index = 0; index < stats_count; index++)
+    {
+        if (stats[index].task == task)
+        {
+            return &stats[index];
+        }
+    }
+    if (stats_count == HOST_HAL_MAX_TASKS)
+    {
+        return &stats[HOST_HAL_MAX_TASKS - 1];
+    }
+    host_hal_stats *new_stats = &stats[stats_count++];
+    new_stats->task = task;
+    strncpy(new_stats->name, task != NULL ? pcTaskGetName(task) : "setup", sizeof(new_stats->name) - 1);
+    return new_stats;
+}
+
+
+/** @brief      Print the reports of hardware calls, deadlines and queues on stderr when the program stops
+ */
+static void report_at_exit(void)
+{
+    vTaskHostReport(stderr);
+    host_hal_report(stderr);
+    if (pin_log != NULL)
+    {
+        fflush(pin_log);
+    }
+}
+
+
+/** @brief      Get the direction a motor's H-bridge is driving it, from its pins
+ *  @param      config How the motor is wired
+ *  @returns    1 to count up, -1 to count down, or 0 if it is braked or in standby
+ */
+static int motor_direction(const host_motor_config &config)
+{
+    if (!host_pin_value(config.standby_pin))
+    {
+        return 0;
+    }
+    bool forward = host_pin_value(config.forward_pin);
+    bool reverse = host_pin_value(config.reverse_pin);
+    return (forward == reverse) ? 0 : (forward ? 1 : -1);
+}
+
+
+
+// ==================================== Functions ====================================
+
+/** @brief      Read the environment variables which set up the host stand-in
+ *  @details    Called by @c main() before @c setup(). See host_hal.h for the variables.
+ */
+void host_hal_start(void)
+{
+    // First, so nothing reads the PC's clock before the virtual one takes over
+    if (getenv("LASER_VIRTUAL") != NULL)
+    {
+        vTaskHostUseVirtualTime();
+    }
+
+    const char *serial_mode = getenv("LASER_SERIAL");
+    if (serial_mode != NULL && strcmp(serial_mode, "pty") == 0)
+    {
+        const char *pty_name = Serial.open_pty();
+        fprintf(stderr, "Serial port: %s\n", pty_name != NULL ? pty_name : "couldn't open a pty");
+    }
+    else if (serial_mode != NULL && strcmp(serial_mode, "memory") == 0)
+    {
+        Serial.use_memory(true, true);
+    }
+
+    const char *job_name = getenv("LASER_JOB");
+    if (job_name != NULL)
+    {
+        FILE *job = fopen(job_name, "rb");
+        if (job == NULL)
+        {
+            fprintf(stderr, "Couldn't open job %s\n", job_name);
+        }
+        else
+        {
+            Serial.use_memory(true, serial_mode != NULL && strcmp(serial_mode, "memory") == 0);
+            char buffer[4096];
+            size_t size;
+            while ((size = fread(buffer, 1, sizeof(buffer), job)) > 0)
+            {
+                Serial.feed(buffer, size);
+            }
+            fclose(job);
+        }
+    }
+
+    const char *log_name = getenv("LASER_HAL_LOG");
+    if (log_name != NULL)
+    {
+        pin_log = fopen(log_name, "w");
+        if (pin_log != NULL)
+        {
+            fprintf(pin_log, "time_us,task,call,pin,value\n");
+        }
+    }
+
+    const char *queue_log_name = getenv("LASER_QUEUE_LOG");
+    if (queue_log_name != NULL)
+    {
+        vQueueHostSetLog(fopen(queue_log_name, "w"));
+    }
+
+    atexit(report_at_exit);
+
+    const char *run_ms = getenv("LASER_RUN_MS");
+    if (run_ms != NULL)
+    {
+        vTaskHostStopAfter(strtoul(run_ms, NULL, 10));
+    }
+}
+
+
+/** @brief      Count a hardware call against the calling task
+ *  @details    Also moves the virtual clock on by what the call takes on the board, if on virtual time.
+ *  @param      kind The kind of call
+ */
+void host_hal_count(host_hal_call kind)
+{
+    std::lock_guard<std::mutex> lock(hal_lock);
+    task_stats()->calls[kind]++;
+    vTaskHostCharge(call_costs[kind]);
+}
+
+
+/** @brief      Count a pin call against the calling task, and write it to the log if there is one
+ *  @param      kind The kind of call
+ *  @param      pin The pin number
+ *  @param      value The value written, or the mode set
+ */
+void host_hal_pin_event(host_hal_call kind, uint32_t pin, uint32_t value)
+{
+    std::lock_guard<std::mutex> lock(hal_lock);
+    host_hal_stats *caller = task_stats();
+    caller->calls[kind]++;
+    vTaskHostCharge(call_costs[kind]);
+    if (pin_log != NULL)
+    {
+        fprintf(pin_log, "%lu,%s,%s,%lu,%lu\n", micros(), caller->name, call_names[kind], (unsigned long)pin,
+                (unsigned long)value);
+    }
+}
+
+
+/** @brief      Get the calls of a kind made by every task so far
+ *  @param      kind The kind of call
+ *  @returns    Calls
+ */
+uint32_t host_hal_total(host_hal_call kind)
+{
+    std::lock_guard<std::mutex> lock(hal_lock);
+    uint32_t total = 0;
+    for (uint8_t index = 0; index < stats_count; index++)
+    {
+        total += stats[index].calls[kind];
+    }
+    return total;
+}
+
+
+/** @brief      Print the hardware calls of every task, and how many it makes each time around its loop
+ *  @details    A task's loops are the times it has delayed (see @c uxTaskHostLoopCount()), so for the control task
+ *              the last column is the calls per control tick.
+ *  @param      file Where to print
+ */
+void host_hal_report(FILE *file)
+{
+    std::lock_guard<std::mutex> lock(hal_lock);
+    fprintf(file, "%-16s %8s", "HAL calls", "loops");
+    for (uint8_t kind = 0; kind < HAL_CALL_KINDS; kind++)
+    {
+        fprintf(file, " %12s", call_names[kind]);
+    }
+    fprintf(file, " %10s\n", "per loop");
+
+    for (uint8_t index = 0; index < stats_count; index++)
+    {
+        uint32_t loops = stats[index].task != NULL ? uxTaskHostLoopCount(stats[index].task) : 0;
+        uint32_t total = 0;
+        fprintf(file, "%-16s %8lu", stats[index].name, (unsigned long)loops);
+        for (uint8_t kind = 0; kind < HAL_CALL_KINDS; kind++)
+        {
+            fprintf(file, " %12lu", (unsigned long)stats[index].calls[kind]);
+            total += stats[index].calls[kind];
+        }
+        if (loops > 0)
+        {
+            fprintf(file, " %10.2f\n", (double)total/loops);
+        }
+        else
+        {
+            fprintf(file, " %10s\n", "-");
+        }
+    }
+}
+
+
+/** @brief      Tie a motor to an encoder timer
+ *  @param      config How the motor is wired and how it moves
+ *  @returns    @c true if there was room for it
+ */
+bool host_motor_attach(const host_motor_config &config)
+{
+    std::lock_guard<std::mutex> lock(hal_lock);
+    if (motor_count == HOST_MAX_MOTORS || config.encoder_timer == NULL)
+    {
+        return false;
+    }
+    host_motor &motor = motors[motor_count++];
+    motor.config = config;
+    motor.speed = 0;
+    motor.counts = 0;
+    motor.moved_to = ullTaskHostTime();
+    return true;
+}
+
+
+/** @brief      Add the counts a timer's motor has turned since it was last read to the timer's count
+ *  @details    The speed heads for the duty cycle times full speed with a first order lag, and the position is moved
+ *              by the average speed over the time gone by; counts less than one are kept for next time. Like the
+ *              encoder interface, the count wraps at the overflow both ways, and nothing is counted while the timer
+ *              is stopped.
+ *  @param      timer The encoder timer
+ */
+void host_encoder_update(TIM_TypeDef *timer)
+{
+    std::lock_guard<std::mutex> lock(hal_lock);
+    for (uint8_t index = 0; index < motor_count; index++)
+    {
+        host_motor &motor = motors[index];
+        if (motor.config.encoder_timer != timer)
+        {
+            continue;
+        }
+        uint64_t now = ullTaskHostTime();
+        float seconds = (now - motor.moved_to)*1e-9f;
+        motor.moved_to = now;
+
+        float duty = host_pin_value(motor.config.pwm_pin)/255.0f;
+        float target = motor_direction(motor.config)*duty*motor.config.full_speed;
+        float last_speed = motor.speed;
+        motor.speed = target + (motor.speed - target)*expf(-seconds/motor.config.time_constant);
+        motor.counts += 0.5*(last_speed + motor.speed)*seconds;
+
+        int64_t whole = (int64_t)floor(motor.counts);
+        motor.counts -= whole;
+        if (timer->CR1 & TIM_CR1_CEN)
+        {
+            int64_t range = (int64_t)timer->ARR + 1;
+            timer->CNT = (uint32_t)((((int64_t)timer->CNT + whole) % range + range) % range);
+        }
+    }
+}
+
+
+/** @brief      Turn an encoder by a number of counts, as if by hand
+ *  @param      timer The encoder timer
+ *  @param      counts Counts to turn it; negative counts down
+ */
+void host_encoder_move(TIM_TypeDef *timer, int32_t counts)
+{
+    std::lock_guard<std::mutex> lock(hal_lock);
+    int64_t range = (int64_t)timer->ARR + 1;
+    timer->CNT = (uint32_t)((((int64_t)timer->CNT + counts) % range + range) % range);
+}
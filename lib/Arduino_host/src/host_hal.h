@@ -0,0 +1,115 @@
+/** @file       host_hal.h
+ *  @brief      This file contains what the host stand-in of the Arduino core adds for running the firmware on a PC:
+ *              a log of pin writes, counts of hardware calls, and motors that turn the encoders.
+ *  @details    None of this is in the Arduino core; it is for host programs and for the native build's
+ *              @c main.cpp section.
+ *
+ *              Every hardware call (pins, PWM, timers and the serial port) is counted against the task that made it,
+ *              and the FreeRTOS stand-in counts how many times each task has gone around its loop (blocked in a
+ *              delay), so the report gives the hardware calls per loop of every task: for the control task, the calls
+ *              per control tick.
+ *
+ *              A motor ties a TB6612FNG's PWM, direction and standby pins to an encoder timer. Its speed follows
+ *              the duty cycle with a first order lag, and the counts it turns are added to the timer's @c CNT when
+ *              the timer is read, so a control loop can be closed without the board.
+ *
+ *              When the program starts, these environment variables are read:
+ *
+ *              | Variable                  | Does                                                              |
+ *              |---------------------------|-------------------------------------------------------------------|
+ *              | @c LASER_SERIAL=pty       | Make @c Serial a pseudo-terminal, and print its name on stderr,   |
+ *              |                           | so the Python tools can open it like the board's port             |
+ *              | @c LASER_SERIAL=memory    | Read and write @c Serial in memory, for a host program            |
+ *              | @c LASER_JOB=file         | Give @c Serial the whole file to read at once                     |
+ *              | @c LASER_VIRTUAL=1        | Run on virtual time (see freertos_posix.cpp)                      |
+ *              | @c LASER_HAL_LOG=file     | Write every pin and PWM write to a CSV file, with a timestamp     |
+ *              | @c LASER_QUEUE_LOG=file   | Write every change to a queue's fill to a CSV file                |
+ *              | @c LASER_RUN_MS=ms        | Stop the program after this many milliseconds, on the tasks' clock|
+ *
+ *              With @c LASER_VIRTUAL and @c LASER_JOB a job runs the same way every time, as fast as the PC can
+ *              go: a timing benchmark. Each hardware call moves the virtual clock on by about what it takes on the
+ *              board, and each task's step by the cost set with @c vTaskHostSetStepCost().
+ *
+ *              The report of hardware calls, deadlines and queues is printed on stderr when the program stops.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef ARDUINO_HOST_HOST_HAL_H
+#define ARDUINO_HOST_HOST_HAL_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "HardwareTimer.h"
+
+// ========================================== Constants ==========================================
+
+// Tasks the report has room for; calls from any more are counted with the last one
+#define HOST_HAL_MAX_TASKS 24
+
+// Motors that can be tied to encoder timers
+#define HOST_MAX_MOTORS 4
+
+/// Kinds of hardware call that are counted
+enum host_hal_call
+{
+    HAL_PIN_MODE,
+    HAL_DIGITAL_WRITE,
+    HAL_DIGITAL_READ,
+    HAL_ANALOG_WRITE,
+    HAL_ANALOG_READ,
+    HAL_TIMER,
+    HAL_SERIAL,
+    HAL_CALL_KINDS
+};
+
+
+// =========================================== Structs ===========================================
+
+/// How a motor is wired and how it moves
+struct host_motor_config
+{
+    uint32_t pwm_pin;                   // PWM input of the H-bridge
+    uint32_t forward_pin;               // Direction pin that is HIGH when the encoder should count up
+    uint32_t reverse_pin;               // Direction pin that is HIGH when the encoder should count down
+    uint32_t standby_pin;               // H-bridge standby; the motor only runs while this is HIGH
+    TIM_TypeDef *encoder_timer;         // Timer its encoder is on
+    float full_speed;                   // Encoder counts a second at 100% duty cycle
+    float time_constant;                // Seconds for the speed to get 63% of the way to a new duty cycle
+};
+
+
+// =========================================== Functions ===========================================
+
+// Read the environment variables; called by main() before setup()
+void host_hal_start(void);
+
+// Count a hardware call against the calling task
+void host_hal_count(host_hal_call kind);
+
+// Count a pin write, and log it if asked
+void host_hal_pin_event(host_hal_call kind, uint32_t pin, uint32_t value);
+
+// Get the calls of a kind made by every task so far
+uint32_t host_hal_total(host_hal_call kind);
+
+// Print the hardware calls of every task, and per loop
+void host_hal_report(FILE *file);
+
+// Set an input pin's level from outside, like a switch would
+void host_pin_set(uint32_t pin, uint32_t value);
+
+// Get what was last written to a pin, or its level
+uint32_t host_pin_value(uint32_t pin);
+
+// Tie a motor to an encoder timer
+bool host_motor_attach(const host_motor_config &config);
+
+// Add the counts a timer's motor has turned since it was last read; called by HardwareTimer in encoder mode
+void host_encoder_update(TIM_TypeDef *timer);
+
+// Turn an encoder by a number of counts, as if by hand
+void host_encoder_move(TIM_TypeDef *timer, int32_t counts);
+
+#endif //ARDUINO_HOST_HOST_HAL_H
@@ -0,0 +1,53 @@
+/** @file       pins_arduino.h
+ *  @brief      This file contains the pin names of the Nucleo L476RG for the host stand-in of the Arduino core.
+ *  @details    Pins are numbered 16 to a port, @c PA0 to @c PA15 then @c PB0 and so on. They only need to be told
+ *              apart on a PC, so the numbers aren't the STM32 core's. @c PinName values are the port times 16 plus
+ *              the pin, with alternate timer outputs in the bits above, like the STM32 core.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef ARDUINO_HOST_PINS_ARDUINO_H
+#define ARDUINO_HOST_PINS_ARDUINO_H
+
+#include <stdint.h>
+
+// ========================================== Constants ==========================================
+
+// Digital pin numbers
+enum
+{
+    PA0, PA1, PA2, PA3, PA4, PA5, PA6, PA7, PA8, PA9, PA10, PA11, PA12, PA13, PA14, PA15,
+    PB0, PB1, PB2, PB3, PB4, PB5, PB6, PB7, PB8, PB9, PB10, PB11, PB12, PB13, PB14, PB15,
+    PC0, PC1, PC2, PC3, PC4, PC5, PC6, PC7, PC8, PC9, PC10, PC11, PC12, PC13, PC14, PC15,
+    PD0, PD1, PD2,
+    NUM_DIGITAL_PINS
+};
+
+// User LED on the Nucleo
+#define LED_BUILTIN PA5
+
+// Pin names, for the timer functions
+#define PIN_NAME_ALT1 0x100
+#define PIN_NAME_ALT2 0x200
+#define PIN_NAME_ALT_MASK 0x300
+typedef enum
+{
+    PA_0 = 0x00, PA_1, PA_2, PA_3, PA_4, PA_5, PA_6, PA_7, PA_8, PA_9, PA_10, PA_11, PA_12, PA_13, PA_14, PA_15,
+    PB_0 = 0x10, PB_1, PB_2, PB_3, PB_4, PB_5, PB_6, PB_7, PB_8, PB_9, PB_10, PB_11, PB_12, PB_13, PB_14, PB_15,
+    PC_0 = 0x20, PC_1, PC_2, PC_3, PC_4, PC_5, PC_6, PC_7, PC_8, PC_9, PC_10, PC_11, PC_12, PC_13, PC_14, PC_15,
+    PD_0 = 0x30, PD_1, PD_2,
+    PB_0_ALT1 = PB_0 | PIN_NAME_ALT1,
+    PB_0_ALT2 = PB_0 | PIN_NAME_ALT2,
+    NC = (int)0xFFFFFFFF
+} PinName;
+
+
+// =========================================== Functions ===========================================
+
+// Change between pin names and pin numbers
+uint32_t pinNametoDigitalPin(PinName pin_name);
+PinName digitalPinToPinName(uint32_t pin);
+
+#endif //ARDUINO_HOST_PINS_ARDUINO_H
@@ -0,0 +1,219 @@
+/** @file       wiring.cpp
+ *  @brief      This file contains time, pins and @c main() for the host stand-in of the Arduino core.
+ *  @details    Every pin call is counted against the task that made it, and writes can be logged; see host_hal.h.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include "Arduino.h"
+#include "host_hal.h"
+#include "FreeRTOS.h"
+
+#include <chrono>
+#include <thread>
+
+///@cond
+// Mode and last value written for every pin
+static uint8_t pin_modes[NUM_DIGITAL_PINS];
+static uint32_t pin_values[NUM_DIGITAL_PINS];
+///@endcond
+
+
+// ======================================== Time ========================================
+
+/** @brief      Get the milliseconds since the program started
+ *  @details    On the clock the tasks run on, which may be virtual; see freertos_posix.cpp.
+ *  @returns    Milliseconds
+ */
+unsigned long millis(void)
+{
+    return ullTaskHostTime()/1000000;
+}
+
+
+/** @brief      Get the microseconds since the program started
+ *  @returns    Microseconds
+ */
+unsigned long micros(void)
+{
+    return ullTaskHostTime()/1000;
+}
+
+
+/** @brief      Wait for a number of milliseconds
+ *  @details    Weak, so the FreeRTOS stand-in's @c delay() is used when it is linked in, like STM32FreeRTOS does.
+ *  @param      ms Milliseconds to wait
+ */
+__attribute__((weak)) void delay(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+
+/** @brief      Wait for a number of microseconds, without letting other tasks run
+ *  @details    On virtual time the wait is charged to the clock, so the loop ends right away.
+ *  @param      us Microseconds to wait
+ */
+void delayMicroseconds(uint32_t us)
+{
+    unsigned long start = micros();
+    vTaskHostCharge((uint64_t)us*1000);
+    while (micros() - start < us) {}
+}
+
+
+
+// ======================================== Pins ========================================
+
+/** @brief      Set a pin's mode
+ *  @details    An input with a pull-up reads @c HIGH until something else is written to it.
+ *  @param      pin The pin number
+ *  @param      mode @c INPUT, @c OUTPUT, @c INPUT_PULLUP or @c INPUT_PULLDOWN
+ */
+void pinMode(uint32_t pin, uint32_t mode)
+{
+    host_hal_pin_event(HAL_PIN_MODE, pin, mode);
+    if (pin < NUM_DIGITAL_PINS)
+    {
+        pin_modes[pin] = mode;
+        pin_values[pin] = (mode == INPUT_PULLUP) ? HIGH : LOW;
+    }
+}
+
+
+/** @brief      Write to a pin
+ *  @param      pin The pin number
+ *  @param      value @c HIGH or @c LOW
+ */
+void digitalWrite(uint32_t pin, uint32_t value)
+{
+    host_hal_pin_event(HAL_DIGITAL_WRITE, pin, value ? HIGH : LOW);
+    if (pin < NUM_DIGITAL_PINS)
+    {
+        pin_values[pin] = value ? HIGH : LOW;
+    }
+}
+
+
+/** @brief      Read a pin
+ *  @param      pin The pin number
+ *  @returns    The last value written to the pin, or its pull-up or pull-down
+ */
+int digitalRead(uint32_t pin)
+{
+    host_hal_count(HAL_DIGITAL_READ);
+    return (pin < NUM_DIGITAL_PINS && pin_values[pin]) ? HIGH : LOW;
+}
+
+
+/** @brief      Write a PWM duty cycle to a pin
+ *  @param      pin The pin number
+ *  @param      value Duty cycle, 0 to 255
+ */
+void analogWrite(uint32_t pin, uint32_t value)
+{
+    host_hal_pin_event(HAL_ANALOG_WRITE, pin, value);
+    if (pin < NUM_DIGITAL_PINS)
+    {
+        pin_values[pin] = value;
+    }
+}
+
+
+/** @brief      Read an analog pin
+ *  @param      pin The pin number
+ *  @returns    0; nothing is wired to the analog pins on a PC
+ */
+int analogRead(uint32_t pin)
+{
+    host_hal_count(HAL_ANALOG_READ);
+    (void)pin;
+    return 0;
+}
+
+
+/** @brief      Set the PWM resolution; not used on a PC
+ *  @param      bits Bits of resolution
+ */
+void analogWriteResolution(int bits)
+{
+    (void)bits;
+}
+
+
+/** @brief      Set the ADC resolution; not used on a PC
+ *  @param      bits Bits of resolution
+ */
+void analogReadResolution(int bits)
+{
+    (void)bits;
+}
+
+
+/** @brief      Set an input pin's level from outside, like a switch or sensor would
+ *  @details    Not in the Arduino core, and not counted as a call. The level stays until something else sets or
+ *              writes the pin.
+ *  @param      pin The pin number
+ *  @param      value @c HIGH or @c LOW
+ */
+void host_pin_set(uint32_t pin, uint32_t value)
+{
+    if (pin < NUM_DIGITAL_PINS)
+    {
+        pin_values[pin] = value ? HIGH : LOW;
+    }
+}
+
+
+/** @brief      Get what was last written to a pin, or the level it was set to
+ *  @details    Not in the Arduino core, and not counted as a call; for PWM pins this is the duty cycle, 0 to 255.
+ *  @param      pin The pin number
+ *  @returns    The value, or 0 if there's no such pin
+ */
+uint32_t host_pin_value(uint32_t pin)
+{
+    return pin < NUM_DIGITAL_PINS ? pin_values[pin] : 0;
+}
+
+
+/** @brief      Get the pin number of a pin name
+ *  @param      pin_name The pin name, which may have an alternate timer output
+ *  @returns    The pin number
+ */
+uint32_t pinNametoDigitalPin(PinName pin_name)
+{
+    return pin_name == NC ? (uint32_t)NUM_DIGITAL_PINS : ((uint32_t)pin_name & ~PIN_NAME_ALT_MASK);
+}
+
+
+/** @brief      Get the pin name of a pin number
+ *  @param      pin The pin number
+ *  @returns    The pin name, or @c NC if there's no such pin
+ */
+PinName digitalPinToPinName(uint32_t pin)
+{
+    return pin < NUM_DIGITAL_PINS ? (PinName)pin : NC;
+}
+
+
+
+// ======================================== Main ========================================
+
+/** @brief      Run the sketch, like the Arduino core's @c main()
+ *  @details    First reads the environment variables which set up the host stand-in; see host_hal.h. Left out of
+ *              unit tests (@c pio @c test), which have their own @c main() in test/.
+ *  @returns    Never returns
+ */
+#ifndef PIO_UNIT_TESTING
+int main(void)
+{
+    host_hal_start();
+    setup();
+    for (;;)
+    {
+        loop();
+    }
+    return 0;
+}
+#endif //PIO_UNIT_TESTING
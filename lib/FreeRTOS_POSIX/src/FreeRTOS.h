@@ -0,0 +1,85 @@
+/** @file       FreeRTOS.h
+ *  @brief      This file is a stand-in for the FreeRTOS headers, so the laser firmware builds and runs on a PC.
+ *  @details    Only the part of FreeRTOS the firmware uses is here: tasks made with @c xTaskCreate() or
+ *              @c xTaskCreateStatic(), delays, the tick count, task notifications, queues, event groups (in
+ *              @c event_groups.h) and critical sections. That is enough for @c taskqueue.h, @c taskshare.h and every
+ *              task to build unchanged. Each task runs on its own thread, but like on the one core of the STM32 only
+ *              one task runs at a time, and when a task blocks the highest priority task that is ready runs next.
+ *              How this differs from the real thing is described in freertos_posix.cpp.
+ *
+ *              The real FreeRTOS.h only has the types and settings, and @c task.h and @c queue.h are included on
+ *              their own; here they are included at the bottom, because the firmware gets them from
+ *              @c STM32FreeRTOS.h, which is only included on the board.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef FREERTOS_POSIX_H
+#define FREERTOS_POSIX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ========================================== Constants ==========================================
+
+// Types, the same size as on the Cortex-M4
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+#define portBASE_TYPE long
+#define configSTACK_DEPTH_TYPE uint16_t
+typedef uint32_t StackType_t;
+
+// Tasks and queues can be made in memory the caller gives, like on the board (see static_alloc.h)
+#define configSUPPORT_STATIC_ALLOCATION 1
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+
+// Tasks have a number for tracing (vTaskSetTaskNumber()), and a run time: the CPU time their thread has used, in
+// real microseconds (vTaskGetInfo()), against a clock of real microseconds
+#define configUSE_TRACE_FACILITY 1
+#define configGENERATE_RUN_TIME_STATS 1
+#define portGET_RUN_TIME_COUNTER_VALUE() ulTaskHostRunTimeClock()
+
+// Return values
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define errQUEUE_FULL pdFALSE
+#define errQUEUE_EMPTY pdFALSE
+
+// Wait forever
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+
+// One tick a millisecond, the same as FreeRTOSConfig_Default.h in the STM32FreeRTOS fork
+#define configTICK_RATE_HZ ((TickType_t)1000)
+#define configMAX_PRIORITIES 32
+#define portTICK_PERIOD_MS ((TickType_t)1000/configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((TickType_t)(ms)*configTICK_RATE_HZ)/(TickType_t)1000))
+
+// Critical sections keep out other threads that act like interrupts; tasks already run one at a time
+void vPortEnterCritical(void);
+void vPortExitCritical(void);
+#define portENTER_CRITICAL() vPortEnterCritical()
+#define portEXIT_CRITICAL() vPortExitCritical()
+#define taskENTER_CRITICAL() vPortEnterCritical()
+#define taskEXIT_CRITICAL() vPortExitCritical()
+
+// The FromISR functions never ask for a switch here (the CPU is handed on at the end of the critical section, or
+// when the running task blocks), so there's nothing to yield for
+#define portYIELD_FROM_ISR(higher_priority_task_woken) ((void)(higher_priority_task_woken))
+
+// Trace hooks, called with pxCurrentTCB pointing at the task when it gets and gives up the CPU, like in FreeRTOS.
+// They do nothing unless defined before this is included
+#ifndef traceTASK_SWITCHED_IN
+    #define traceTASK_SWITCHED_IN()
+#endif
+#ifndef traceTASK_SWITCHED_OUT
+    #define traceTASK_SWITCHED_OUT()
+#endif
+
+#include "task.h"
+#include "queue.h"
+
+#endif //FREERTOS_POSIX_H
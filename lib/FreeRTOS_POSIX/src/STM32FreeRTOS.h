@@ -0,0 +1,13 @@
+/** @file       STM32FreeRTOS.h
+ *  @brief      This file stands in for the STM32FreeRTOS library header when the firmware is built on a PC.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef FREERTOS_POSIX_STM32FREERTOS_H
+#define FREERTOS_POSIX_STM32FREERTOS_H
+
+#include "FreeRTOS.h"
+
+#endif //FREERTOS_POSIX_STM32FREERTOS_H
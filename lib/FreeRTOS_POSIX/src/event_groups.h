@@ -0,0 +1,44 @@
+/** @file       event_groups.h
+ *  @brief      This file contains the event group functions of the FreeRTOS stand-in which runs the firmware on a PC.
+ *  @details    These have the same names and arguments as in FreeRTOS, and are written in freertos_posix.cpp. Like
+ *              on the board with 32 bit ticks, a group has 24 bits; the top 8 are FreeRTOS's own.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef FREERTOS_POSIX_EVENT_GROUPS_H
+#define FREERTOS_POSIX_EVENT_GROUPS_H
+
+#include "FreeRTOS.h"
+
+typedef struct host_event_group* EventGroupHandle_t;
+typedef TickType_t EventBits_t;
+
+// Bits a group has for the firmware
+#define EVENT_GROUP_BITS ((EventBits_t)0x00FFFFFFUL)
+
+/// Memory for an event group made with xEventGroupCreateStatic(); big enough for the stand-in's group
+typedef struct
+{
+    uint64_t words[1];
+} StaticEventGroup_t;
+
+
+// =========================================== Functions ===========================================
+
+// Make an event group with no bits set, on the heap or in memory the caller gives
+EventGroupHandle_t xEventGroupCreate(void);
+EventGroupHandle_t xEventGroupCreateStatic(StaticEventGroup_t *event_group_buffer);
+
+// Set or clear bits; setting them wakes the tasks waiting for them
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, const EventBits_t bits_to_set);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, const EventBits_t bits_to_clear);
+#define xEventGroupGetBits(group) xEventGroupClearBits(group, 0)
+
+// Wait up to ticks_to_wait for any or all of some bits to be set
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, const EventBits_t bits_to_wait_for,
+                                const BaseType_t clear_on_exit, const BaseType_t wait_for_all_bits,
+                                TickType_t ticks_to_wait);
+
+#endif //FREERTOS_POSIX_EVENT_GROUPS_H
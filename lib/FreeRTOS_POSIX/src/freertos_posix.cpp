@@ -0,0 +1,1550 @@
+/** @file       freertos_posix.cpp
+ *  @brief      This file contains the FreeRTOS stand-in which runs the laser firmware's tasks on threads on a PC.
+ *  @details    Each task gets its own thread, but a task only runs while it holds the one "CPU", so like on the
+ *              one core of the STM32 only one task runs at a time. The CPU goes to the ready task with the highest
+ *              priority, and the one that has been ready longest if there is a tie, like the FreeRTOS scheduler.
+ *
+ *              A task gives up the CPU when it blocks: in @c vTaskDelay(), @c vTaskDelayUntil(), or waiting on a
+ *              queue, an event group or a notification. It is also preempted when a task with a higher priority is ready, but only at its next FreeRTOS
+ *              call: a queue function, or the end of a critical section, which every share @c put() and @c get()
+ *              has. On the board the tick interrupt would preempt it right away, so here a higher priority task can
+ *              be held off for as long as the running task goes without one of those calls. No task in the firmware
+ *              goes long without one.
+ *
+ *              Ticks come from @c std::chrono::steady_clock, the monotonic clock, with one tick per millisecond
+ *              counted from when the scheduler starts. Delays end on tick edges, like they do on the board.
+ *
+ *              With virtual time (@c vTaskHostUseVirtualTime()) the clock only moves when the firmware makes it:
+ *              every time a task gives up the CPU its step cost is added, hardware calls add their own costs through
+ *              @c vTaskHostCharge(), and when every task is blocked the clock jumps to the next wake-up. Which task
+ *              runs then depends only on priorities, wake times and the order tasks were made, so a run gives the
+ *              same results every time and a long job runs as fast as the PC can go. A task that wakes while another
+ *              is in the middle of a step waits for the end of that step, so a step's cost is also the longest it
+ *              can hold off a task with a higher priority.
+ *
+ *              The trace hooks @c traceTASK_SWITCHED_OUT() and @c traceTASK_SWITCHED_IN() are called when a task
+ *              gives up and gets the CPU; a task's step cost is added before it gives it up, so with virtual time a
+ *              traced step is as long as it counts for.
+ *
+ *              Each task's missed deadlines (a @c vTaskDelayUntil() time that had already gone by) are counted, and
+ *              with virtual time its longest loop, and each queue's fill is kept over time, for @c vTaskHostReport()
+ *              and the queue log.
+ *
+ *              Each task's thread runs on a stack of @c HOST_TASK_STACK_SIZE bytes which is filled with
+ *              @c HOST_STACK_FILL_BYTE before it starts, like FreeRTOS fills stacks on the board, so
+ *              @c uxTaskGetStackHighWaterMark() finds how much was used the same way. The stack is the PC's, with
+ *              its bigger pointers, the stand-ins' code and the thread library's own data at the top, so the size
+ *              used is a guide to the board's rather than the same.
+ *
+ *              Everything here is made once and never deleted, so a program can call @c exit() while tasks are
+ *              still blocked.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include "FreeRTOS.h"
+#include "event_groups.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <pthread.h>
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///@cond
+typedef std::chrono::steady_clock host_clock;
+
+/// A task and where it is in the line for the CPU
+struct host_task
+{
+    TaskFunction_t code;                // Task function
+    void *parameters;                   // Given to the task function
+    char name[16];                      // Name for printouts
+    UBaseType_t priority;               // Higher runs first
+    bool ready;                         // True while waiting for the CPU
+    bool blocked;                       // True while delayed or waiting on a queue
+    const void *waiting_on;             // Queue, event group or task whose notification it is blocked on, or NULL
+    uint32_t ready_order;               // Order it became ready in, for tasks with the same priority
+    uint32_t loops;                     // Times it has called vTaskDelay() or vTaskDelayUntil()
+    uint64_t wake_time;                 // Nanoseconds it blocks until, unless it waits forever
+    bool forever;                       // True while blocked with no time limit
+    uint32_t step_cost;                 // Virtual nanoseconds each step takes
+    uint32_t missed;                    // Times vTaskDelayUntil() was called after the wake time had gone by
+    uint32_t worst_late;                // Most ticks it was late by
+    bool loop_ended;                    // True from a delay until the end of the step it ends
+    uint64_t loop_busy;                 // Virtual nanoseconds it has run for in this loop so far
+    uint64_t worst_loop;                // Most virtual nanoseconds it has run for in one loop
+    uint32_t notify_value;              // Notifications given and not yet taken
+    EventBits_t waiting_for_bits;       // Event group bits it is blocked on
+    bool waiting_for_all;               // True if it needs all of them, not just one
+    uint8_t *stack;                     // HOST_TASK_STACK_SIZE bytes its thread runs on
+    UBaseType_t uxTaskNumber;           // Number for tracing, named like FreeRTOS's for the trace hooks
+    clockid_t cpu_clock;                // Clock of the CPU time its thread has used, once the thread has started
+    bool started;                       // True once its thread has started
+};
+
+/// An event group: bits tasks set, clear and wait for
+struct host_event_group
+{
+    EventBits_t bits;                   // Bits set
+};
+
+/// A queue: a ring of items copied in byte for byte
+struct host_queue
+{
+    uint8_t *buffer;                    // queue_length*item_size bytes
+    UBaseType_t length;                 // Items it can hold
+    UBaseType_t item_size;              // Bytes per item
+    UBaseType_t head;                   // Place of the item at the front
+    UBaseType_t count;                  // Items in the queue
+    const char *name;                   // Name from vQueueAddToRegistry(), or NULL
+    UBaseType_t most;                   // Most items it has held
+    uint64_t made_at;                   // Nanoseconds when it was made
+    uint64_t changed_at;                // Nanoseconds when the count last changed
+    double item_time;                   // Items times nanoseconds, to get the average fill
+    struct host_queue *next;            // The queue made before this one, or NULL
+};
+
+// Kernel lock, and a signal sent whenever a queue or the CPU changes hands. Never deleted, so exit() is safe. The
+// lock is set up at compile time, since global queues are made by constructors that may run before this file's.
+static std::mutex kernel;
+static std::condition_variable &changed = *new std::condition_variable;
+
+// Lock for critical sections
+static std::recursive_mutex &critical = *new std::recursive_mutex;
+
+// Every task, the newest queue (the start of a list of them all), the task running, and the task run by this thread
+// (NULL for threads that aren't tasks)
+static std::vector<host_task*> &tasks = *new std::vector<host_task*>;
+static host_queue *newest_queue = NULL;
+static host_task *running = NULL;
+static thread_local host_task *this_task = NULL;
+static thread_local uint16_t critical_nesting = 0;
+static uint32_t ready_count = 0;
+
+// Whether the scheduler has started, and when (tick 0), in nanoseconds since the program started
+static BaseType_t scheduler_state = taskSCHEDULER_NOT_STARTED;
+static uint64_t start_time = 0;
+
+// Virtual time, if used, and when to stop the program
+static bool virtual_time = false;
+static std::atomic<uint64_t> virtual_now(0);
+static uint64_t stop_time = UINT64_MAX;
+
+// Where queue fills are logged, if anywhere
+static FILE *queue_log = NULL;
+///@endcond
+
+
+// ======================================== Subfunctions ========================================
+
+/** @brief      Get when the program started on the monotonic clock
+ *  @details    Kept here so it is set the first time anything asks, even from the constructor of a global.
+ *  @returns    The time
+ */
+static host_clock::time_point program_start(void)
+{
+    static const host_clock::time_point start = host_clock::now();
+    return start;
+}
+
+
+/** @brief      Get the time, on the monotonic clock or the virtual one
+ *  @returns    Nanoseconds since the program started
+ */
+static uint64_t time_now(void)
+{
+    if (virtual_time)
+    {
+        return virtual_now;
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(host_clock::now() - program_start()).count();
+}
+
+
+/** @brief      Get the milliseconds since the scheduler started, without wrapping
+ *  @returns    The tick count, 64 bits wide
+ */
+static uint64_t ticks_now(void)
+{
+    return (time_now() - start_time)/1000000;
+}
+
+
+/** @brief      Get the time a tick starts at
+ *  @param      tick A tick count, 64 bits wide
+ *  @returns    Nanoseconds since the program started
+ */
+static uint64_t tick_time(uint64_t tick)
+{
+    return start_time + tick*1000000;
+}
+
+
+/** @brief      Check whether a task is the next one to get the CPU
+ *  @param      task A ready task
+ *  @returns    @c true if the CPU is free and no ready task comes before this one
+ */
+static bool is_next(host_task *task)
+{
+    if (running != NULL)
+    {
+        return false;
+    }
+    for (host_task *other : tasks)
+    {
+        if (other != task && other->ready && (other->priority > task->priority
+            || (other->priority == task->priority && other->ready_order < task->ready_order)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/** @brief      Mark a task ready to run, behind other ready tasks of its priority
+ *  @param      task The task
+ */
+static void make_ready(host_task *task)
+{
+    if (!task->ready)
+    {
+        task->ready = true;
+        task->ready_order = ready_count++;
+    }
+}
+
+
+/** @brief      Call the trace hook for a task getting or giving up the CPU
+ *  @details    The hooks look at @c pxCurrentTCB, like in FreeRTOS's tasks.c, so it is made here for them.
+ *  @param      task The task
+ *  @param      switched_in @c true if it got the CPU, @c false if it gave it up
+ */
+static void trace_switch(host_task *task, bool switched_in)
+{
+    host_task *pxCurrentTCB = task;
+    if (switched_in)
+    {
+        traceTASK_SWITCHED_IN();
+    }
+    else
+    {
+        traceTASK_SWITCHED_OUT();
+    }
+    (void)pxCurrentTCB;
+}
+
+
+/** @brief      Wait for the CPU, then take it
+ *  @details    Does nothing for threads that aren't tasks.
+ *  @param      lock The kernel lock, held
+ */
+static void take_cpu(std::unique_lock<std::mutex> &lock)
+{
+    host_task *task = this_task;
+    if (task == NULL)
+    {
+        return;
+    }
+    make_ready(task);
+    changed.wait(lock, [task]{ return is_next(task); });
+    task->ready = false;
+    running = task;
+    trace_switch(task, true);
+}
+
+
+/** @brief      Give up the CPU, so the next ready task can run
+ *  @details    Does nothing for threads that aren't tasks.
+ */
+static void give_cpu(void)
+{
+    if (this_task != NULL && running == this_task)
+    {
+        running = NULL;
+        changed.notify_all();
+    }
+}
+
+
+/** @brief      Wait for a change to a queue, the CPU or the virtual clock, or until a time
+ *  @details    With virtual time there's nothing to wait for on the PC's clock; whatever moves the virtual clock
+ *              sends the signal.
+ *  @param      lock The kernel lock, held
+ *  @param      wake_time When to stop waiting, in nanoseconds since the program started
+ *  @param      forever @c true to ignore @c wake_time
+ */
+static void wait_for_change(std::unique_lock<std::mutex> &lock, uint64_t wake_time, bool forever)
+{
+    if (forever || virtual_time)
+    {
+        changed.wait(lock);
+    }
+    else
+    {
+        changed.wait_until(lock, program_start() + std::chrono::nanoseconds(wake_time));
+    }
+}
+
+
+/** @brief      Make ready every task whose wake time has come on the virtual clock
+ *  @details    They are made ready in the order of their wake times, then the order they were made, so tasks of the
+ *              same priority always run in the same order.
+ */
+static void wake_due_tasks(void)
+{
+    std::vector<host_task*> due;
+    for (host_task *task : tasks)
+    {
+        if (task->blocked && !task->forever && task->wake_time <= virtual_now)
+        {
+            due.push_back(task);
+        }
+    }
+    std::stable_sort(due.begin(), due.end(), [](host_task *a, host_task *b){ return a->wake_time < b->wake_time; });
+    for (host_task *task : due)
+    {
+        task->blocked = false;
+        task->waiting_on = NULL;
+        make_ready(task);
+    }
+    changed.notify_all();
+}
+
+
+/** @brief      Move the virtual clock on at the end of the calling task's step
+ *  @details    Adds the task's step cost and wakes the tasks that are due. If then no task is ready, nothing can
+ *              happen until the next wake-up, so the clock jumps there. If the clock has reached the stop time, the
+ *              program stops, keeping the CPU so no other task runs while it does.
+ *  @param      lock The kernel lock, held
+ */
+static void end_step(std::unique_lock<std::mutex> &lock)
+{
+    if (!virtual_time)
+    {
+        return;
+    }
+    if (this_task != NULL)
+    {
+        virtual_now += this_task->step_cost;
+        this_task->loop_busy += this_task->step_cost;
+        if (this_task->loop_ended)
+        {
+            this_task->worst_loop = std::max(this_task->worst_loop, this_task->loop_busy);
+            this_task->loop_busy = 0;
+            this_task->loop_ended = false;
+        }
+    }
+    wake_due_tasks();
+
+    bool any_ready = false;
+    uint64_t next_wake = UINT64_MAX;
+    for (host_task *task : tasks)
+    {
+        any_ready = any_ready || task->ready;
+        if (task->blocked && !task->forever)
+        {
+            next_wake = std::min(next_wake, task->wake_time);
+        }
+    }
+    if (!any_ready && running == NULL && next_wake != UINT64_MAX)
+    {
+        virtual_now = std::max((uint64_t)virtual_now, next_wake);
+        wake_due_tasks();
+    }
+
+    if (virtual_now >= stop_time)
+    {
+        running = this_task;
+        lock.unlock();
+        exit(0);
+    }
+}
+
+
+/** @brief      Block the calling task until a time, or until something it waits on changes
+ *  @details    Another thread that changes the queue, event group or notification makes the task ready with
+ *              @c unblock_waiters(). Called from a thread that isn't a task, this just waits; the caller checks
+ *              again what it is waiting for.
+ *  @param      lock The kernel lock, held
+ *  @param      wake_time When to wake up if nothing else wakes the task first, in nanoseconds since the program
+ *              started
+ *  @param      forever @c true to ignore @c wake_time and wait for the change
+ *  @param      object The queue, event group or task (for its notification) waited on, or NULL
+ */
+static void block(std::unique_lock<std::mutex> &lock, uint64_t wake_time, bool forever, const void *object)
+{
+    host_task *task = this_task;
+    if (task == NULL)
+    {
+        // Before the scheduler starts nothing else moves the virtual clock, so this thread does
+        if (virtual_time && scheduler_state != taskSCHEDULER_RUNNING && !forever)
+        {
+            virtual_now = std::max((uint64_t)virtual_now, wake_time);
+            return;
+        }
+        wait_for_change(lock, wake_time, forever);
+        return;
+    }
+
+    task->blocked = true;
+    task->waiting_on = object;
+    task->wake_time = wake_time;
+    task->forever = forever;
+    give_cpu();
+    end_step(lock);
+    trace_switch(task, false);
+    while (task->blocked && (forever || time_now() < wake_time))
+    {
+        wait_for_change(lock, wake_time, forever);
+    }
+    task->blocked = false;
+    task->waiting_on = NULL;
+    take_cpu(lock);
+}
+
+
+/** @brief      Count another time around the calling task's loop, which ends in a delay or a wait for a
+ *              notification or event
+ *  @details    With virtual time, the loop's run time is added up when the step ends (see @c end_step()).
+ */
+static void count_loop(void)
+{
+    if (this_task != NULL)
+    {
+        this_task->loops++;
+        this_task->loop_ended = true;
+    }
+}
+
+
+/** @brief      Make ready every task blocked on a queue, event group or notification, after it changes
+ *  @details    They all check it again, so the one with the highest priority gets to it first. The threads are only
+ *              woken if a task was waiting, since waking every thread costs far more than the queue call.
+ *  @param      object The queue, event group or task (for its notification)
+ */
+static void unblock_waiters(const void *object)
+{
+    bool any_waiting = false;
+    for (host_task *task : tasks)
+    {
+        if (task->blocked && task->waiting_on == object)
+        {
+            task->blocked = false;
+            task->waiting_on = NULL;
+            make_ready(task);
+            any_waiting = true;
+        }
+    }
+    if (any_waiting)
+    {
+        changed.notify_all();
+    }
+}
+
+
+/** @brief      Let a ready task with a higher priority than the calling task run
+ *  @details    This is where a task is preempted; see the top of this file. Inside a critical section it waits for
+ *              the end of it, like the board's switch does, so queue calls made there (such as the @c Queue bulk
+ *              methods' FromISR calls) don't hand on the CPU while other threads are kept out.
+ *  @param      lock The kernel lock, held
+ */
+static void preempt(std::unique_lock<std::mutex> &lock)
+{
+    host_task *task = this_task;
+    if (task == NULL || running != task || critical_nesting > 0)
+    {
+        return;
+    }
+    for (host_task *other : tasks)
+    {
+        if (other->ready && other->priority > task->priority)
+        {
+            give_cpu();
+            trace_switch(task, false);
+            take_cpu(lock);
+            return;
+        }
+    }
+}
+
+
+/** @brief      Block the calling task until something is true or a number of ticks pass
+ *  @param      lock The kernel lock, held
+ *  @param      object The queue, event group or task (for its notification) the condition is about
+ *  @param      ticks_to_wait Ticks to wait, 0 to not wait, or @c portMAX_DELAY to wait forever
+ *  @param      condition What to wait for; checked with the kernel lock held
+ *  @returns    @c true if the condition is true
+ */
+template <class Condition>
+static bool block_for(std::unique_lock<std::mutex> &lock, const void *object, TickType_t ticks_to_wait,
+                      Condition condition)
+{
+    uint64_t timeout = tick_time(ticks_now() + ticks_to_wait);
+    while (!condition())
+    {
+        if (ticks_to_wait == 0 || (ticks_to_wait != portMAX_DELAY && time_now() >= timeout))
+        {
+            return false;
+        }
+        // Another task may get to it first, so the condition is checked again after every wake-up
+        block(lock, timeout, ticks_to_wait == portMAX_DELAY, object);
+    }
+    return true;
+}
+
+
+/** @brief      Run a task on its thread
+ *  @param      task The task
+ */
+static void *run_task(void *p_task)
+{
+    host_task *task = (host_task*)p_task;
+    this_task = task;
+    {
+        std::unique_lock<std::mutex> lock(kernel);
+        take_cpu(lock);
+    }
+    task->code(task->parameters);
+
+    // FreeRTOS tasks must never return; if one does, it just stops
+    std::unique_lock<std::mutex> lock(kernel);
+    give_cpu();
+    trace_switch(task, false);
+    return NULL;
+}
+
+
+/** @brief      Start a task's thread, on the task's own stack
+ *  @param      task The task
+ */
+static void start_thread(host_task *task)
+{
+    pthread_attr_t attributes;
+    pthread_t thread;
+    pthread_attr_init(&attributes);
+    pthread_attr_setstack(&attributes, task->stack, HOST_TASK_STACK_SIZE);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+    if (pthread_create(&thread, &attributes, run_task, task) != 0)
+    {
+        fprintf(stderr, "Couldn't start a thread for task %s\n", task->name);
+        exit(1);
+    }
+    pthread_attr_destroy(&attributes);
+    task->started = (pthread_getcpuclockid(thread, &task->cpu_clock) == 0);
+}
+
+
+/** @brief      Keep track of a queue's fill after it changes, and log it if asked
+ *  @param      queue The queue, after its count changed by one
+ *  @param      was The count before it changed
+ */
+static void count_changed(host_queue *queue, UBaseType_t was)
+{
+    uint64_t now = time_now();
+    queue->item_time += (double)was*(now - queue->changed_at);
+    queue->changed_at = now;
+    queue->most = std::max(queue->most, queue->count);
+    if (queue_log != NULL)
+    {
+        fprintf(queue_log, "%llu,%s,%lu\n", (unsigned long long)(now/1000), queue->name != NULL ? queue->name : "",
+                (unsigned long)queue->count);
+    }
+}
+
+
+/** @brief      Copy an item into a queue
+ *  @param      queue The queue, with room for the item
+ *  @param      item The item
+ *  @param      to_front @c true to put it in front of the other items
+ */
+static void queue_copy_in(host_queue *queue, const void *item, bool to_front)
+{
+    UBaseType_t place;
+    if (to_front)
+    {
+        queue->head = (queue->head + queue->length - 1) % queue->length;
+        place = queue->head;
+    }
+    else
+    {
+        place = (queue->head + queue->count) % queue->length;
+    }
+    memcpy(&queue->buffer[place*queue->item_size], item, queue->item_size);
+    queue->count++;
+    count_changed(queue, queue->count - 1);
+    unblock_waiters(queue);
+}
+
+
+/** @brief      Copy the item at the front of a queue out, and take it off the queue if asked
+ *  @param      queue The queue, with an item in it
+ *  @param      buffer Where the item goes
+ *  @param      remove @c true to take the item off the queue
+ */
+static void queue_copy_out(host_queue *queue, void *buffer, bool remove)
+{
+    memcpy(buffer, &queue->buffer[queue->head*queue->item_size], queue->item_size);
+    if (remove)
+    {
+        queue->head = (queue->head + 1) % queue->length;
+        queue->count--;
+        count_changed(queue, queue->count + 1);
+        unblock_waiters(queue);
+    }
+}
+
+
+/** @brief      Put an item in a queue, waiting for room
+ *  @param      queue The queue
+ *  @param      item The item
+ *  @param      ticks_to_wait Ticks to wait for room
+ *  @param      to_front @c true to put it in front of the other items
+ *  @returns    @c pdTRUE if the item went in
+ */
+static BaseType_t queue_send(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait, bool to_front)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    if (!block_for(lock, queue, ticks_to_wait, [queue]{ return queue->count < queue->length; }))
+    {
+        return errQUEUE_FULL;
+    }
+    queue_copy_in(queue, item, to_front);
+    preempt(lock);
+    return pdTRUE;
+}
+
+
+/** @brief      Get the item at the front of a queue, waiting for one
+ *  @param      queue The queue
+ *  @param      buffer Where the item goes
+ *  @param      ticks_to_wait Ticks to wait for an item
+ *  @param      remove @c true to take the item off the queue
+ *  @returns    @c pdTRUE if there was an item
+ */
+static BaseType_t queue_receive(QueueHandle_t queue, void *buffer, TickType_t ticks_to_wait, bool remove)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    if (!block_for(lock, queue, ticks_to_wait, [queue]{ return queue->count > 0; }))
+    {
+        return errQUEUE_EMPTY;
+    }
+    queue_copy_out(queue, buffer, remove);
+    preempt(lock);
+    return pdTRUE;
+}
+
+
+
+// ======================================== Tasks ========================================
+
+/** @brief      Set up a task, in memory from the heap or the caller, and start it if the scheduler is running
+ *  @param      task_memory Memory for the task
+ *  @param      task_code The task function
+ *  @param      name Name for printouts
+ *  @param      parameters Given to the task function
+ *  @param      priority Higher runs first
+ *  @returns    The task
+ */
+static host_task *add_task(void *task_memory, TaskFunction_t task_code, const char *const name, void *const parameters,
+                           UBaseType_t priority)
+{
+    host_task *task = new (task_memory) host_task;
+    task->code = task_code;
+    task->parameters = parameters;
+    strncpy(task->name, name != NULL ? name : "", sizeof(task->name) - 1);
+    task->name[sizeof(task->name) - 1] = '\0';
+    task->priority = priority < configMAX_PRIORITIES ? priority : configMAX_PRIORITIES - 1;
+    task->ready = false;
+    task->blocked = false;
+    task->waiting_on = NULL;
+    task->ready_order = 0;
+    task->loops = 0;
+    task->wake_time = 0;
+    task->forever = false;
+    task->step_cost = HOST_DEFAULT_STEP_COST;
+    task->missed = 0;
+    task->worst_late = 0;
+    task->loop_ended = false;
+    task->loop_busy = 0;
+    task->worst_loop = 0;
+    task->notify_value = 0;
+    task->waiting_for_bits = 0;
+    task->waiting_for_all = false;
+    task->uxTaskNumber = 0;
+    task->started = false;
+    void *stack = NULL;
+    if (posix_memalign(&stack, 4096, HOST_TASK_STACK_SIZE) != 0)
+    {
+        fprintf(stderr, "No memory for the stack of task %s\n", task->name);
+        exit(1);
+    }
+    task->stack = (uint8_t*)stack;
+    memset(task->stack, HOST_STACK_FILL_BYTE, HOST_TASK_STACK_SIZE);
+
+    std::unique_lock<std::mutex> lock(kernel);
+    tasks.push_back(task);
+    if (scheduler_state == taskSCHEDULER_RUNNING)
+    {
+        make_ready(task);
+        start_thread(task);
+        preempt(lock);
+    }
+    return task;
+}
+
+
+/** @brief      Make a task
+ *  @details    The stack depth isn't used; threads get @c HOST_TASK_STACK_SIZE bytes.
+ *  @param      task_code The task function
+ *  @param      name Name for printouts
+ *  @param      stack_depth Stack size on the board
+ *  @param      parameters Given to the task function
+ *  @param      priority Higher runs first
+ *  @param      created_task Filled with the task's handle, if not NULL
+ *  @returns    @c pdPASS
+ */
+BaseType_t xTaskCreate(TaskFunction_t task_code, const char *const name, const configSTACK_DEPTH_TYPE stack_depth,
+                       void *const parameters, UBaseType_t priority, TaskHandle_t *const created_task)
+{
+    (void)stack_depth;
+    host_task *task = add_task(::operator new(sizeof(host_task)), task_code, name, parameters, priority);
+    if (created_task != NULL)
+    {
+        *created_task = task;
+    }
+    return pdPASS;
+}
+
+
+/** @brief      Make a task in memory the caller gives
+ *  @details    The task is made in @c task_buffer. Like the stack depth, the stack isn't used; threads get
+ *              @c HOST_TASK_STACK_SIZE bytes of their own.
+ *  @param      task_code The task function
+ *  @param      name Name for printouts
+ *  @param      stack_depth Stack size on the board, in words
+ *  @param      parameters Given to the task function
+ *  @param      priority Higher runs first
+ *  @param      stack_buffer The task's stack on the board
+ *  @param      task_buffer Memory for the task
+ *  @returns    The task's handle, or NULL if either buffer is missing
+ */
+TaskHandle_t xTaskCreateStatic(TaskFunction_t task_code, const char *const name, const uint32_t stack_depth,
+                               void *const parameters, UBaseType_t priority, StackType_t *const stack_buffer,
+                               StaticTask_t *const task_buffer)
+{
+    static_assert(sizeof(StaticTask_t) >= sizeof(host_task), "StaticTask_t must hold a host_task");
+    (void)stack_depth;
+    if (stack_buffer == NULL || task_buffer == NULL)
+    {
+        return NULL;
+    }
+    return add_task(task_buffer, task_code, name, parameters, priority);
+}
+
+
+/** @brief      Start running the tasks
+ *  @details    Every task is made ready before any thread starts, so the highest priority task runs first. Like on
+ *              the board, this never returns.
+ */
+void vTaskStartScheduler(void)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    start_time = time_now();
+    scheduler_state = taskSCHEDULER_RUNNING;
+    for (host_task *task : tasks)
+    {
+        make_ready(task);
+    }
+    for (host_task *task : tasks)
+    {
+        start_thread(task);
+    }
+    changed.wait(lock, []{ return false; });
+}
+
+
+/** @brief      Block the calling task for a number of ticks
+ *  @details    Like FreeRTOS, this wakes on the tick @c ticks_to_delay after the current one, so a delay of 1 may
+ *              be less than a millisecond. A delay of 0 lets other ready tasks of the same priority run. Called from
+ *              a thread that isn't a task, it just sleeps.
+ *  @param      ticks_to_delay Ticks to block for
+ */
+void vTaskDelay(const TickType_t ticks_to_delay)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    count_loop();
+    block(lock, tick_time(ticks_now() + ticks_to_delay), false, NULL);
+}
+
+
+/** @brief      Block the calling task until a fixed time after it last woke up
+ *  @details    Like FreeRTOS, if that time has already gone by the task doesn't block, and the wake time still moves
+ *              on by @c time_increment, so a late loop doesn't push back the ones after it.
+ *  @param      previous_wake_time The tick the task last woke at; moved on by @c time_increment
+ *  @param      time_increment Ticks between wake-ups
+ */
+void vTaskDelayUntil(TickType_t *const previous_wake_time, const TickType_t time_increment)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    count_loop();
+    uint64_t now = ticks_now();
+    TickType_t now_ticks = (TickType_t)now;
+    TickType_t wake_ticks = *previous_wake_time + time_increment;
+
+    // Same test as FreeRTOS, which allows for the tick count wrapping
+    bool wait;
+    if (now_ticks < *previous_wake_time)
+    {
+        wait = wake_ticks < *previous_wake_time && wake_ticks > now_ticks;
+    }
+    else
+    {
+        wait = wake_ticks < *previous_wake_time || wake_ticks > now_ticks;
+    }
+    *previous_wake_time = wake_ticks;
+
+    // Late: count the deadline missed, and by how much
+    if (!wait && this_task != NULL)
+    {
+        this_task->missed++;
+        this_task->worst_late = std::max(this_task->worst_late, (uint32_t)(TickType_t)(now_ticks - wake_ticks));
+    }
+
+    if (wait)
+    {
+        block(lock, tick_time(now + (TickType_t)(wake_ticks - now_ticks)), false, NULL);
+    }
+    else if (virtual_time)
+    {
+        // The loop still ends a step, or a task that's always late would never let the clock wake anyone
+        block(lock, time_now(), false, NULL);
+    }
+}
+
+
+/** @brief      Get the number of ticks since the scheduler started
+ *  @returns    Ticks, which wrap like they do on the board
+ */
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)ticks_now();
+}
+
+
+/** @brief      Get the number of ticks since the scheduler started, from an interrupt
+ *  @returns    Ticks
+ */
+TickType_t xTaskGetTickCountFromISR(void)
+{
+    return (TickType_t)ticks_now();
+}
+
+
+/** @brief      Get whether the scheduler has started
+ *  @returns    @c taskSCHEDULER_NOT_STARTED or @c taskSCHEDULER_RUNNING
+ */
+BaseType_t xTaskGetSchedulerState(void)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    return scheduler_state;
+}
+
+
+/** @brief      Get the task that called this
+ *  @returns    The task, or NULL if called from a thread that isn't a task
+ */
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return this_task;
+}
+
+
+/** @brief      Get the name of a task
+ *  @param      task The task, or NULL for the calling task
+ *  @returns    The name, or "" if called with NULL from a thread that isn't a task
+ */
+char *pcTaskGetName(TaskHandle_t task)
+{
+    static char no_name[] = "";
+    task = task != NULL ? task : this_task;
+    return task != NULL ? task->name : no_name;
+}
+
+
+/** @brief      Get the priority of a task
+ *  @param      task The task, or NULL for the calling task
+ *  @returns    The priority, or 0 if called with NULL from a thread that isn't a task
+ */
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task)
+{
+    task = task != NULL ? task : this_task;
+    return task != NULL ? task->priority : 0;
+}
+
+
+/** @brief      Set a task's number, which is only for tracing
+ *  @param      task The task, or NULL for the calling task
+ *  @param      number The number
+ */
+void vTaskSetTaskNumber(TaskHandle_t task, const UBaseType_t number)
+{
+    task = task != NULL ? task : this_task;
+    if (task != NULL)
+    {
+        task->uxTaskNumber = number;
+    }
+}
+
+
+/** @brief      Get a task's name, number, state, priority, run time and free stack
+ *  @details    The run time is the CPU time the task's thread has used, in us, from the PC's clock for the thread.
+ *              It is real time even on virtual time, and counts what the thread did for the stand-in too.
+ *  @param      task The task, or NULL for the calling task
+ *  @param      status Filled in
+ *  @param      get_free_stack_space @c pdTRUE to find the least stack the task has had free, which takes a while
+ *  @param      state The state to give, or @c eInvalid to find it
+ */
+void vTaskGetInfo(TaskHandle_t task, TaskStatus_t *status, BaseType_t get_free_stack_space, eTaskState state)
+{
+    task = task != NULL ? task : this_task;
+    if (task == NULL)
+    {
+        memset(status, 0, sizeof(*status));
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(kernel);
+    status->xHandle = task;
+    status->pcTaskName = task->name;
+    status->xTaskNumber = task->uxTaskNumber;
+    if (state == eInvalid)
+    {
+        state = (running == task) ? eRunning : task->blocked ? eBlocked : eReady;
+    }
+    status->eCurrentState = state;
+    status->uxCurrentPriority = task->priority;
+    status->uxBasePriority = task->priority;
+    status->ulRunTimeCounter = 0;
+    struct timespec cpu_time;
+    if (task->started && clock_gettime(task->cpu_clock, &cpu_time) == 0)
+    {
+        status->ulRunTimeCounter = (uint32_t)((uint64_t)cpu_time.tv_sec*1000000 + cpu_time.tv_nsec/1000);
+    }
+    status->pxStackBase = (StackType_t*)task->stack;
+    lock.unlock();
+
+    status->usStackHighWaterMark = get_free_stack_space ? uxTaskGetStackHighWaterMark(task) : 0;
+}
+
+
+/** @brief      Get a task's number, which is only for tracing
+ *  @param      task The task
+ *  @returns    The number, or 0 if it hasn't been set or the task is NULL
+ */
+UBaseType_t uxTaskGetTaskNumber(TaskHandle_t task)
+{
+    return task != NULL ? task->uxTaskNumber : 0;
+}
+
+
+/** @brief      Get the least stack a task has had free since it started
+ *  @details    Counts the fill bytes at the far end of the task's stack, which nothing has written over yet, like
+ *              FreeRTOS does. The stack is the PC's (see the top of this file).
+ *  @param      task The task, or NULL for the calling task
+ *  @returns    Free stack in words, or 0 if called with NULL from a thread that isn't a task
+ */
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+    task = task != NULL ? task : this_task;
+    if (task == NULL)
+    {
+        return 0;
+    }
+    size_t untouched = 0;
+    while (untouched < HOST_TASK_STACK_SIZE && task->stack[untouched] == HOST_STACK_FILL_BYTE)
+    {
+        untouched++;
+    }
+    return untouched/sizeof(StackType_t);
+}
+
+
+/** @brief      Get how many times a task has been around its loop
+ *  @details    Not in FreeRTOS. Each call to @c vTaskDelay(), @c vTaskDelayUntil(), @c ulTaskNotifyTake() or
+ *              @c xEventGroupWaitBits() counts as one loop, since every task in the firmware ends its loop with one;
+ *              for the control task it is the number of control ticks.
+ *  @param      task The task, or NULL for the calling task
+ *  @returns    Loops, or 0 if called with NULL from a thread that isn't a task
+ */
+uint32_t uxTaskHostLoopCount(TaskHandle_t task)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    task = task != NULL ? task : this_task;
+    return task != NULL ? task->loops : 0;
+}
+
+
+/** @brief      Run on virtual time instead of the PC's clock
+ *  @details    Not in FreeRTOS; see the top of this file. Call before anything reads the time, as the clock starts
+ *              again from 0.
+ */
+void vTaskHostUseVirtualTime(void)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    virtual_time = true;
+    virtual_now = 0;
+}
+
+
+/** @brief      Stop the program a number of milliseconds after it started
+ *  @details    Not in FreeRTOS. With virtual time the program stops when the virtual clock gets there; otherwise a
+ *              thread waits that long on the PC's clock.
+ *  @param      ms Milliseconds to run for
+ */
+void vTaskHostStopAfter(uint32_t ms)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    if (virtual_time)
+    {
+        stop_time = (uint64_t)ms*1000000;
+    }
+    else
+    {
+        std::thread([ms]{ std::this_thread::sleep_for(std::chrono::milliseconds(ms)); exit(0); }).detach();
+    }
+}
+
+
+/** @brief      Move the virtual clock on by the time something the calling task did would take on the board
+ *  @details    Not in FreeRTOS; the Arduino stand-in calls this for every hardware call. Does nothing without virtual
+ *              time, where things take as long as they take.
+ *  @param      ns Nanoseconds
+ */
+void vTaskHostCharge(uint64_t ns)
+{
+    if (virtual_time)
+    {
+        virtual_now += ns;
+        if (this_task != NULL)
+        {
+            this_task->loop_busy += ns;
+        }
+    }
+}
+
+
+/** @brief      Set how long a task's step takes on the virtual clock, besides the hardware calls it makes
+ *  @details    Not in FreeRTOS. A step is the run between getting the CPU and giving it up, which for most tasks is
+ *              one time around its loop.
+ *  @param      task The task, or NULL for the calling task
+ *  @param      ns Nanoseconds a step
+ */
+void vTaskHostSetStepCost(TaskHandle_t task, uint32_t ns)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    task = task != NULL ? task : this_task;
+    if (task != NULL)
+    {
+        task->step_cost = ns;
+    }
+}
+
+
+/** @brief      Get the time since the program started, on the clock the tasks run on
+ *  @details    Not in FreeRTOS; the Arduino stand-in's @c micros() and timers use this, so they keep virtual time too.
+ *  @returns    Nanoseconds
+ */
+uint64_t ullTaskHostTime(void)
+{
+    return time_now();
+}
+
+
+/** @brief      Get the real microseconds since the program started
+ *  @details    Not in FreeRTOS; it is the clock @c portGET_RUN_TIME_COUNTER_VALUE() reads, which task run times
+ *              (see @c vTaskGetInfo()) are measured against. It is real time even on virtual time, like the run
+ *              times are. It wraps after about 71 minutes.
+ *  @returns    The microseconds
+ */
+uint32_t ulTaskHostRunTimeClock(void)
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(host_clock::now()
+                                                                            - program_start()).count();
+}
+
+
+/** @brief      Print each task's loops, missed deadlines, longest loop and stack used, and how full each queue got
+ *  @details    Not in FreeRTOS. A task's longest loop is the most virtual time it ran for between two delays: its
+ *              step costs and hardware calls, not the time it waited for the CPU. It is only kept with virtual time,
+ *              and is what the execution times in the firmware's task table come from. A queue's average is over the
+ *              time since it was made. Stack used is on the PC (see the top of this file).
+ *  @param      file Where to print
+ */
+void vTaskHostReport(FILE *file)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    uint64_t now = time_now();
+    fprintf(file, "%s time: %.3f s\n", virtual_time ? "Virtual" : "Run", now/1e9);
+    fprintf(file, "%-16s %8s %8s %8s %10s %10s %10s\n", "Task", "priority", "loops", "missed", "worst late",
+            "worst loop", "stack");
+    for (host_task *task : tasks)
+    {
+        fprintf(file, "%-16s %8lu %8lu %8lu %8lu ms %7lu us %8lu B\n", task->name, (unsigned long)task->priority,
+                (unsigned long)task->loops, (unsigned long)task->missed, (unsigned long)task->worst_late,
+                (unsigned long)((task->worst_loop + 999)/1000),
+                (unsigned long)(HOST_TASK_STACK_SIZE - uxTaskGetStackHighWaterMark(task)*sizeof(StackType_t)));
+    }
+    fprintf(file, "%-20s %8s %8s %8s\n", "Queue", "length", "most", "average");
+    for (host_queue *queue = newest_queue; queue != NULL; queue = queue->next)
+    {
+        double item_time = queue->item_time + (double)queue->count*(now - queue->changed_at);
+        double average = now > queue->made_at ? item_time/(double)(now - queue->made_at) : queue->count;
+        fprintf(file, "%-20s %8lu %8lu %8.2f\n", queue->name != NULL ? queue->name : "(no name)",
+                (unsigned long)queue->length, (unsigned long)queue->most, average);
+    }
+}
+
+
+/** @brief      Log every change to a queue's fill, as CSV lines of microseconds, queue name and items
+ *  @details    Not in FreeRTOS.
+ *  @param      file Where to log, or NULL to stop
+ */
+void vQueueHostSetLog(FILE *file)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    queue_log = file;
+    if (queue_log != NULL)
+    {
+        fprintf(queue_log, "time_us,queue,items\n");
+    }
+}
+
+
+/** @brief      Enter a critical section
+ *  @details    Keeps out other threads that act like interrupts. Critical sections can be nested.
+ */
+void vPortEnterCritical(void)
+{
+    critical.lock();
+    critical_nesting++;
+}
+
+
+/** @brief      Leave a critical section
+ *  @details    Leaving the outermost one lets a ready task with a higher priority run, like a tick that came
+ *              during the critical section would on the board.
+ */
+void vPortExitCritical(void)
+{
+    critical_nesting--;
+    critical.unlock();
+    if (critical_nesting == 0 && this_task != NULL)
+    {
+        std::unique_lock<std::mutex> lock(kernel);
+        preempt(lock);
+    }
+}
+
+
+/** @brief      Wait for a number of milliseconds
+ *  @details    STM32FreeRTOS makes Arduino's @c delay() block the calling task instead of spinning, and this does the
+ *              same; the Arduino stand-in's own @c delay() is weak so this one is used.
+ *  @param      ms Milliseconds to wait
+ */
+void delay(uint32_t ms)
+{
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+
+
+// ==================================== Task Notifications ====================================
+
+/** @brief      Give a task a notification, waking it if it waits for one
+ *  @param      task The task
+ *  @returns    @c pdPASS
+ */
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    task->notify_value++;
+    unblock_waiters(task);
+    preempt(lock);
+    return pdPASS;
+}
+
+
+/** @brief      Wait for a notification to the calling task, then take it
+ *  @param      clear_on_exit @c pdTRUE to take every notification given, @c pdFALSE to take one
+ *  @param      ticks_to_wait Ticks to wait, 0 to not wait, or @c portMAX_DELAY to wait forever
+ *  @returns    The notifications given before any were taken, or 0 if none came in time
+ */
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    host_task *task = this_task;
+    if (task == NULL)
+    {
+        return 0;
+    }
+    count_loop();
+    if (!block_for(lock, task, ticks_to_wait, [task]{ return task->notify_value > 0; }))
+    {
+        return 0;
+    }
+    uint32_t value = task->notify_value;
+    task->notify_value = clear_on_exit ? 0 : value - 1;
+    return value;
+}
+
+
+
+
+// ======================================== Queues ========================================
+
+/** @brief      Set up a queue, in memory from the heap or the caller
+ *  @param      queue_memory Memory for the queue
+ *  @param      buffer Memory for the items
+ *  @param      queue_length Items it can hold
+ *  @param      item_size Bytes per item
+ *  @returns    The queue
+ */
+static host_queue *add_queue(void *queue_memory, uint8_t *buffer, UBaseType_t queue_length, UBaseType_t item_size)
+{
+    host_queue *queue = new (queue_memory) host_queue;
+    queue->buffer = buffer;
+    queue->length = queue_length;
+    queue->item_size = item_size;
+    queue->head = 0;
+    queue->count = 0;
+    queue->name = NULL;
+    queue->most = 0;
+    queue->made_at = time_now();
+    queue->changed_at = queue->made_at;
+    queue->item_time = 0;
+
+    std::unique_lock<std::mutex> lock(kernel);
+    queue->next = newest_queue;
+    newest_queue = queue;
+    return queue;
+}
+
+
+/** @brief      Make a queue
+ *  @param      queue_length Items it can hold
+ *  @param      item_size Bytes per item
+ *  @returns    The queue's handle, or NULL if the length or size is 0
+ */
+QueueHandle_t xQueueCreate(UBaseType_t queue_length, UBaseType_t item_size)
+{
+    if (queue_length == 0 || item_size == 0)
+    {
+        return NULL;
+    }
+    return add_queue(::operator new(sizeof(host_queue)), new uint8_t[queue_length*item_size], queue_length,
+                     item_size);
+}
+
+
+/** @brief      Make a queue in memory the caller gives
+ *  @param      queue_length Items it can hold
+ *  @param      item_size Bytes per item
+ *  @param      storage_buffer Memory for the items, @c queue_length*item_size bytes
+ *  @param      queue_buffer Memory for the queue
+ *  @returns    The queue's handle, or NULL if the length or size is 0 or a buffer is missing
+ */
+QueueHandle_t xQueueCreateStatic(UBaseType_t queue_length, UBaseType_t item_size, uint8_t *storage_buffer,
+                                 StaticQueue_t *queue_buffer)
+{
+    static_assert(sizeof(StaticQueue_t) >= sizeof(host_queue), "StaticQueue_t must hold a host_queue");
+    if (queue_length == 0 || item_size == 0 || storage_buffer == NULL || queue_buffer == NULL)
+    {
+        return NULL;
+    }
+    return add_queue(queue_buffer, storage_buffer, queue_length, item_size);
+}
+
+
+/** @brief      Give a queue a name, for the report and the queue log
+ *  @details    Like FreeRTOS, only the pointer is kept, so the name must last as long as the queue.
+ *  @param      queue The queue
+ *  @param      name Its name
+ */
+void vQueueAddToRegistry(QueueHandle_t queue, const char *name)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    if (queue != NULL)
+    {
+        queue->name = name;
+    }
+}
+
+
+/** @brief      Put an item in the back of a queue, waiting for room
+ *  @param      queue The queue
+ *  @param      item The item, copied in
+ *  @param      ticks_to_wait Ticks to wait for room
+ *  @returns    @c pdTRUE if the item went in, @c errQUEUE_FULL if not
+ */
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait)
+{
+    return queue_send(queue, item, ticks_to_wait, false);
+}
+
+
+/** @brief      Put an item in the front of a queue, waiting for room
+ *  @param      queue The queue
+ *  @param      item The item, copied in
+ *  @param      ticks_to_wait Ticks to wait for room
+ *  @returns    @c pdTRUE if the item went in, @c errQUEUE_FULL if not
+ */
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait)
+{
+    return queue_send(queue, item, ticks_to_wait, true);
+}
+
+
+/** @brief      Take the item at the front of a queue, waiting for one
+ *  @param      queue The queue
+ *  @param      buffer Filled with the item
+ *  @param      ticks_to_wait Ticks to wait for an item
+ *  @returns    @c pdTRUE if there was an item, @c errQUEUE_EMPTY if not
+ */
+BaseType_t xQueueReceive(QueueHandle_t queue, void *buffer, TickType_t ticks_to_wait)
+{
+    return queue_receive(queue, buffer, ticks_to_wait, true);
+}
+
+
+/** @brief      Copy the item at the front of a queue without taking it, waiting for one
+ *  @param      queue The queue
+ *  @param      buffer Filled with the item
+ *  @param      ticks_to_wait Ticks to wait for an item
+ *  @returns    @c pdTRUE if there was an item, @c errQUEUE_EMPTY if not
+ */
+BaseType_t xQueuePeek(QueueHandle_t queue, void *buffer, TickType_t ticks_to_wait)
+{
+    return queue_receive(queue, buffer, ticks_to_wait, false);
+}
+
+
+/** @brief      Get the number of items in a queue
+ *  @param      queue The queue
+ *  @returns    Items waiting
+ */
+UBaseType_t uxQueueMessagesWaiting(const QueueHandle_t queue)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    return queue->count;
+}
+
+
+/** @brief      Get the room left in a queue
+ *  @param      queue The queue
+ *  @returns    Items that can still be put in
+ */
+UBaseType_t uxQueueSpacesAvailable(const QueueHandle_t queue)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    return queue->length - queue->count;
+}
+
+
+/** @brief      Put an item in the back of a queue from an interrupt, if there's room
+ *  @param      queue The queue
+ *  @param      item The item, copied in
+ *  @param      higher_priority_task_woken Set to @c pdFALSE if not NULL; the CPU is handed on when the running
+ *              task blocks anyway
+ *  @returns    @c pdTRUE if the item went in, @c errQUEUE_FULL if not
+ */
+BaseType_t xQueueSendToBackFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_task_woken)
+{
+    if (higher_priority_task_woken != NULL)
+    {
+        *higher_priority_task_woken = pdFALSE;
+    }
+    return queue_send(queue, item, 0, false);
+}
+
+
+/** @brief      Put an item in the front of a queue from an interrupt, if there's room
+ *  @param      queue The queue
+ *  @param      item The item, copied in
+ *  @param      higher_priority_task_woken Set to @c pdFALSE if not NULL
+ *  @returns    @c pdTRUE if the item went in, @c errQUEUE_FULL if not
+ */
+BaseType_t xQueueSendToFrontFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_task_woken)
+{
+    if (higher_priority_task_woken != NULL)
+    {
+        *higher_priority_task_woken = pdFALSE;
+    }
+    return queue_send(queue, item, 0, true);
+}
+
+
+/** @brief      Take the item at the front of a queue from an interrupt, if there is one
+ *  @param      queue The queue
+ *  @param      buffer Filled with the item
+ *  @param      higher_priority_task_woken Set to @c pdFALSE if not NULL
+ *  @returns    @c pdTRUE if there was an item, @c errQUEUE_EMPTY if not
+ */
+BaseType_t xQueueReceiveFromISR(QueueHandle_t queue, void *buffer, BaseType_t *higher_priority_task_woken)
+{
+    if (higher_priority_task_woken != NULL)
+    {
+        *higher_priority_task_woken = pdFALSE;
+    }
+    return queue_receive(queue, buffer, 0, true);
+}
+
+
+/** @brief      Copy the item at the front of a queue from an interrupt, if there is one
+ *  @param      queue The queue
+ *  @param      buffer Filled with the item
+ *  @returns    @c pdTRUE if there was an item, @c errQUEUE_EMPTY if not
+ */
+BaseType_t xQueuePeekFromISR(QueueHandle_t queue, void *buffer)
+{
+    return queue_receive(queue, buffer, 0, false);
+}
+
+
+/** @brief      Get the number of items in a queue from an interrupt
+ *  @param      queue The queue
+ *  @returns    Items waiting
+ */
+UBaseType_t uxQueueMessagesWaitingFromISR(const QueueHandle_t queue)
+{
+    return uxQueueMessagesWaiting(queue);
+}
+
+
+
+
+// ===================================== Event Groups =====================================
+
+/** @brief      Make an event group in memory the caller gives, with no bits set
+ *  @param      event_group_buffer Memory for the event group
+ *  @returns    The event group's handle, or NULL if the memory is missing
+ */
+EventGroupHandle_t xEventGroupCreateStatic(StaticEventGroup_t *event_group_buffer)
+{
+    static_assert(sizeof(StaticEventGroup_t) >= sizeof(host_event_group), "StaticEventGroup_t must hold a group");
+    if (event_group_buffer == NULL)
+    {
+        return NULL;
+    }
+    host_event_group *group = new (event_group_buffer) host_event_group;
+    group->bits = 0;
+    return group;
+}
+
+
+/** @brief      Make an event group, with no bits set
+ *  @returns    The event group's handle
+ */
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    return xEventGroupCreateStatic((StaticEventGroup_t*)::operator new(sizeof(StaticEventGroup_t)));
+}
+
+
+/** @brief      Make ready the tasks blocked on an event group whose bits are now set
+ *  @details    Unlike a queue's waiters, tasks waiting for other bits stay blocked, as they do on the board, so
+ *              setting bits costs a task that isn't waiting for them no extra step.
+ *  @param      group The event group
+ */
+static void unblock_bit_waiters(host_event_group *group)
+{
+    bool any_waiting = false;
+    for (host_task *task : tasks)
+    {
+        EventBits_t set = group->bits & task->waiting_for_bits;
+        if (task->blocked && task->waiting_on == group
+            && (task->waiting_for_all ? set == task->waiting_for_bits : set != 0))
+        {
+            task->blocked = false;
+            task->waiting_on = NULL;
+            make_ready(task);
+            any_waiting = true;
+        }
+    }
+    if (any_waiting)
+    {
+        changed.notify_all();
+    }
+}
+
+
+/** @brief      Set bits in an event group, waking the tasks waiting for them
+ *  @param      group The event group
+ *  @param      bits_to_set The bits
+ *  @returns    The bits after setting them; a task woken by them may already have cleared some
+ */
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, const EventBits_t bits_to_set)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    group->bits |= bits_to_set & EVENT_GROUP_BITS;
+    unblock_bit_waiters(group);
+    preempt(lock);
+    return group->bits;
+}
+
+
+/** @brief      Clear bits in an event group
+ *  @param      group The event group
+ *  @param      bits_to_clear The bits, or 0 just to read them (which is what @c xEventGroupGetBits() does)
+ *  @returns    The bits before clearing them
+ */
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, const EventBits_t bits_to_clear)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    EventBits_t bits = group->bits;
+    group->bits &= ~bits_to_clear;
+    return bits;
+}
+
+
+/** @brief      Wait for bits in an event group to be set
+ *  @param      group The event group
+ *  @param      bits_to_wait_for The bits
+ *  @param      clear_on_exit @c pdTRUE to clear the bits waited for if they were set in time
+ *  @param      wait_for_all_bits @c pdTRUE to wait for all of the bits, @c pdFALSE for any of them
+ *  @param      ticks_to_wait Ticks to wait, 0 to not wait, or @c portMAX_DELAY to wait forever
+ *  @returns    The bits when they were set, or when the time ran out, before any were cleared
+ */
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, const EventBits_t bits_to_wait_for,
+                                const BaseType_t clear_on_exit, const BaseType_t wait_for_all_bits,
+                                TickType_t ticks_to_wait)
+{
+    std::unique_lock<std::mutex> lock(kernel);
+    count_loop();
+    auto all_set = [group, bits_to_wait_for, wait_for_all_bits]
+    {
+        EventBits_t set = group->bits & bits_to_wait_for;
+        return wait_for_all_bits ? set == bits_to_wait_for : set != 0;
+    };
+    if (this_task != NULL)
+    {
+        this_task->waiting_for_bits = bits_to_wait_for;
+        this_task->waiting_for_all = wait_for_all_bits;
+    }
+    bool in_time = block_for(lock, group, ticks_to_wait, all_set);
+    EventBits_t bits = group->bits;
+    if (in_time && clear_on_exit)
+    {
+        group->bits &= ~bits_to_wait_for;
+    }
+    return bits;
+}
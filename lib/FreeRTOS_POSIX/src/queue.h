@@ -0,0 +1,61 @@
+/** @file       queue.h
+ *  @brief      This file contains the queue functions of the FreeRTOS stand-in which runs the firmware on a PC.
+ *  @details    These have the same names and arguments as in FreeRTOS, and are written in freertos_posix.cpp. Items
+ *              are copied in and out byte for byte, like FreeRTOS does. The @c FromISR functions never block, and
+ *              may be called from threads that aren't tasks, which is how the stand-in acts out interrupts.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef FREERTOS_POSIX_QUEUE_H
+#define FREERTOS_POSIX_QUEUE_H
+
+#include <stdio.h>
+#include "FreeRTOS.h"
+
+typedef struct host_queue* QueueHandle_t;
+
+/// Memory for a queue made with xQueueCreateStatic(); big enough for the stand-in's queue, which is made in it
+typedef struct
+{
+    uint64_t words[12];
+} StaticQueue_t;
+
+
+// =========================================== Functions ===========================================
+
+// Make a queue which holds queue_length items of item_size bytes
+QueueHandle_t xQueueCreate(UBaseType_t queue_length, UBaseType_t item_size);
+
+// Make a queue in memory the caller gives: queue_length*item_size bytes for the items, and the queue itself
+QueueHandle_t xQueueCreateStatic(UBaseType_t queue_length, UBaseType_t item_size, uint8_t *storage_buffer,
+                                 StaticQueue_t *queue_buffer);
+
+// Put an item in the back or front of a queue, waiting up to ticks_to_wait for room
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait);
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait);
+#define xQueueSend xQueueSendToBack
+
+// Take the item at the front of a queue, or copy it without taking it, waiting up to ticks_to_wait for one
+BaseType_t xQueueReceive(QueueHandle_t queue, void *buffer, TickType_t ticks_to_wait);
+BaseType_t xQueuePeek(QueueHandle_t queue, void *buffer, TickType_t ticks_to_wait);
+
+// Get the number of items in a queue, or the room left
+UBaseType_t uxQueueMessagesWaiting(const QueueHandle_t queue);
+UBaseType_t uxQueueSpacesAvailable(const QueueHandle_t queue);
+
+// The same, from an interrupt: these never wait
+BaseType_t xQueueSendToBackFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_task_woken);
+BaseType_t xQueueSendToFrontFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_task_woken);
+BaseType_t xQueueReceiveFromISR(QueueHandle_t queue, void *buffer, BaseType_t *higher_priority_task_woken);
+BaseType_t xQueuePeekFromISR(QueueHandle_t queue, void *buffer);
+UBaseType_t uxQueueMessagesWaitingFromISR(const QueueHandle_t queue);
+
+// Give a queue a name for debugging; the name is kept by pointer, like FreeRTOS does
+void vQueueAddToRegistry(QueueHandle_t queue, const char *name);
+
+// Not in FreeRTOS: log every change to a queue's fill as CSV
+void vQueueHostSetLog(FILE *file);
+
+#endif //FREERTOS_POSIX_QUEUE_H
@@ -0,0 +1,145 @@
+/** @file       task.h
+ *  @brief      This file contains the task functions of the FreeRTOS stand-in which runs the firmware on a PC.
+ *  @details    These have the same names and arguments as in FreeRTOS, and are written in freertos_posix.cpp.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef FREERTOS_POSIX_TASK_H
+#define FREERTOS_POSIX_TASK_H
+
+#include <stdio.h>
+#include "FreeRTOS.h"
+
+// ========================================== Constants ==========================================
+
+// What xTaskGetSchedulerState() returns
+#define taskSCHEDULER_SUSPENDED ((BaseType_t)0)
+#define taskSCHEDULER_NOT_STARTED ((BaseType_t)1)
+#define taskSCHEDULER_RUNNING ((BaseType_t)2)
+
+// Virtual nanoseconds a task's step takes until vTaskHostSetStepCost() says otherwise
+#define HOST_DEFAULT_STEP_COST 10000
+
+// Bytes of stack each task's thread gets, and the byte it is filled with first, to find how much of it was used
+#define HOST_TASK_STACK_SIZE (256*1024)
+#define HOST_STACK_FILL_BYTE 0xa5
+
+// Let tasks of the same priority run
+#define taskYIELD() vTaskDelay(0)
+
+// Types
+typedef void (*TaskFunction_t)(void*);
+typedef struct host_task* TaskHandle_t;
+
+/// What a task is doing, for vTaskGetInfo()
+typedef enum
+{
+    eRunning = 0,
+    eReady,
+    eBlocked,
+    eSuspended,
+    eDeleted,
+    eInvalid
+} eTaskState;
+
+/// What vTaskGetInfo() tells about a task; the run time counter is the CPU time its thread has used, in us
+typedef struct
+{
+    TaskHandle_t xHandle;
+    const char *pcTaskName;
+    UBaseType_t xTaskNumber;
+    eTaskState eCurrentState;
+    UBaseType_t uxCurrentPriority;
+    UBaseType_t uxBasePriority;
+    uint32_t ulRunTimeCounter;
+    StackType_t *pxStackBase;
+    configSTACK_DEPTH_TYPE usStackHighWaterMark;
+} TaskStatus_t;
+
+/// Memory for a task made with xTaskCreateStatic(); big enough for the stand-in's task, which is made in it
+typedef struct
+{
+    uint64_t words[20];
+} StaticTask_t;
+
+
+// =========================================== Functions ===========================================
+
+// Make a task; it starts running when the scheduler does, or right away if it already has
+BaseType_t xTaskCreate(TaskFunction_t task_code, const char *const name, const configSTACK_DEPTH_TYPE stack_depth,
+                       void *const parameters, UBaseType_t priority, TaskHandle_t *const created_task);
+
+// Make a task in memory the caller gives
+TaskHandle_t xTaskCreateStatic(TaskFunction_t task_code, const char *const name, const uint32_t stack_depth,
+                               void *const parameters, UBaseType_t priority, StackType_t *const stack_buffer,
+                               StaticTask_t *const task_buffer);
+
+// Start running the tasks; doesn't return
+void vTaskStartScheduler(void);
+
+// Block the calling task for a number of ticks
+void vTaskDelay(const TickType_t ticks_to_delay);
+
+// Block the calling task until a tick a fixed time after the last time it woke up
+void vTaskDelayUntil(TickType_t *const previous_wake_time, const TickType_t time_increment);
+
+// Get the number of ticks since the scheduler started
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+
+// Get whether the scheduler has started
+BaseType_t xTaskGetSchedulerState(void);
+
+// Get the task that called this, or NULL if it isn't a task
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+// Get the name of a task, or of the calling task if the handle is NULL
+char *pcTaskGetName(TaskHandle_t task);
+
+// Get the priority of a task, or of the calling task if the handle is NULL
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task);
+
+// Get the least stack a task has had free, in words, or of the calling task if the handle is NULL
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+// Give a task a notification, or wait for one to the calling task and take it; returns the notifications given
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait);
+
+// Set or get a task's number, which is only for tracing; it is 0 until it is set
+void vTaskSetTaskNumber(TaskHandle_t task, const UBaseType_t number);
+UBaseType_t uxTaskGetTaskNumber(TaskHandle_t task);
+
+// Get a task's name, number, state, priority, run time and, if asked, free stack; eInvalid finds the state
+void vTaskGetInfo(TaskHandle_t task, TaskStatus_t *status, BaseType_t get_free_stack_space, eTaskState state);
+
+
+// ===================================== Not in FreeRTOS =====================================
+
+// Get how many times a task has delayed or waited, which is once a loop for every task in the firmware
+uint32_t uxTaskHostLoopCount(TaskHandle_t task);
+
+// Run on a virtual clock, which moves by the modelled cost of what the tasks do
+void vTaskHostUseVirtualTime(void);
+
+// Stop the program a number of milliseconds after it started, on whichever clock the tasks run on
+void vTaskHostStopAfter(uint32_t ms);
+
+// Move the virtual clock on by the time the calling task spent on something
+void vTaskHostCharge(uint64_t ns);
+
+// Set how long a task's step takes on the virtual clock, besides its hardware calls
+void vTaskHostSetStepCost(TaskHandle_t task, uint32_t ns);
+
+// Get the nanoseconds since the program started, on whichever clock the tasks run on
+uint64_t ullTaskHostTime(void);
+
+// Get the real microseconds since the program started, which portGET_RUN_TIME_COUNTER_VALUE() reads
+uint32_t ulTaskHostRunTimeClock(void);
+
+// Print each task's loops, missed deadlines, longest loop and stack used, and how full each queue got
+void vTaskHostReport(FILE *file);
+
+#endif //FREERTOS_POSIX_TASK_H
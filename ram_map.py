@@ -0,0 +1,142 @@
+"""@file       ram_map.py
+   @brief      This file prints the RAM each part of the laser firmware takes, after every PlatformIO build.
+   @details    The tasks, queues and shares are rows of the tables in src/static_alloc.h, each with the part of the
+               firmware it belongs to. This script reads those rows, finds the memory each row made in the built
+               program with @c nm, and adds it up by part. Everything else in RAM is listed too, biggest first, and
+               on the board the RAM left over is what the heap and the main stack get.
+
+               PlatformIO runs it after linking (see @c extra_scripts in platformio.ini). It can also be run on a
+               program that was built some other way:
+
+                   python3 ram_map.py <program> [nm] [RAM bytes]
+
+   @date    10-19-2026 File Created
+"""
+
+import os
+import re
+import subprocess
+import sys
+
+# Where the tables are
+TABLE_FILE = os.path.join("src", "static_alloc.h")
+
+# A row of a table: what it is, its name and the part of the firmware it belongs to
+ROW = re.compile(r"^\s*(TASK|QUEUE|SHARE)\(\s*(\w+)\s*,\s*(\w+)")
+
+# Symbols each kind of row makes, from its name
+ROW_SYMBOLS = {
+    "TASK": ["{}_stack", "{}_tcb"],
+    "QUEUE": ["{}", "{}_items", "{}_control"],
+    "SHARE": ["{}"],
+}
+
+# Things in RAM that aren't in the tables, listed one by one
+OTHERS_LISTED = 8
+
+
+def read_table(table_file):
+    """Read the rows of the tables.
+       @param   table_file Path of static_alloc.h
+       @returns A list of (kind, name, part) for every row
+    """
+    rows = []
+    with open(table_file) as table:
+        for line in table:
+            match = ROW.match(line)
+            if match:
+                rows.append(match.groups())
+    return rows
+
+
+def read_symbols(program, nm, tool_env=None):
+    """Read the sizes of the things a program keeps in RAM.
+       @param   program The built program
+       @param   nm The nm of the toolchain that built it
+       @param   tool_env Environment variables to run nm with, so it can be found; None for this script's own
+       @returns A dictionary of sizes in bytes, by name without the C++ decoration
+    """
+    listing = subprocess.run([nm, "-S", "-C", program], capture_output=True, text=True, check=True,
+                             env=tool_env).stdout
+    sizes = {}
+    for line in listing.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) == 4 and fields[2] in "bBdD":
+            sizes[fields[3]] = sizes.get(fields[3], 0) + int(fields[1], 16)
+    return sizes
+
+
+def print_ram_map(program, nm, ram_size=None, table_file=TABLE_FILE, tool_env=None):
+    """Print the RAM each part of the firmware takes.
+       @param   program The built program
+       @param   nm The nm of the toolchain that built it
+       @param   ram_size Bytes of RAM on the board, or None off the board
+       @param   table_file Path of static_alloc.h
+       @param   tool_env Environment variables to run nm with
+    """
+    sizes = read_symbols(program, nm, tool_env)
+    rows = read_table(table_file)
+
+    parts = {}
+    in_tables = set()
+    left_out = []
+    for kind, name, part in rows:
+        found = [symbol.format(name) for symbol in ROW_SYMBOLS[kind] if symbol.format(name) in sizes]
+        if not found:
+            left_out.append(name)
+            continue
+        totals = parts.setdefault(part, {"TASK": 0, "QUEUE": 0, "SHARE": 0})
+        for symbol in found:
+            totals[kind] += sizes[symbol]
+            in_tables.add(symbol)
+
+    print("RAM map of {} (tables in {})".format(os.path.basename(program), table_file))
+    print("{:<12} {:>8} {:>8} {:>8} {:>8}".format("part", "tasks", "queues", "shares", "total"))
+    table_total = 0
+    for part in sorted(parts):
+        totals = parts[part]
+        total = sum(totals.values())
+        table_total += total
+        print("{:<12} {:>8} {:>8} {:>8} {:>8}".format(part, totals["TASK"], totals["QUEUE"], totals["SHARE"], total))
+    print("{:<12} {:>35}".format("tables", table_total))
+
+    others = sorted(((size, symbol) for symbol, size in sizes.items() if symbol not in in_tables), reverse=True)
+    other_total = sum(size for size, symbol in others)
+    print("{:<12} {:>35}".format("other", other_total))
+    for size, symbol in others[:OTHERS_LISTED]:
+        print("  {:<45} {:>8}".format(symbol[:45], size))
+
+    used = table_total + other_total
+    if ram_size:
+        print("{:<12} {:>35}  of {} ({:.0f}%), {} left for the heap and main stack".format(
+            "static", used, ram_size, 100.0*used/ram_size, ram_size - used))
+    else:
+        print("{:<12} {:>35}".format("static", used))
+    if left_out:
+        print("Not in this build: " + ", ".join(left_out))
+
+
+# PlatformIO's build gives the script an Import() to get its environment; run by hand there isn't one
+try:
+    Import("env")
+except NameError:
+    env = None
+
+# Run after PlatformIO links the program
+if env is not None:
+    def ram_map_action(target, source, env):
+        nm = re.sub(r"g?cc$", "nm", env.subst("$CC"))
+        ram_size = None
+        if "BOARD" in env:
+            ram_size = int(env.BoardConfig().get("upload.maximum_ram_size", 0)) or None
+        print_ram_map(str(target[0]), nm, ram_size, os.path.join(env.subst("$PROJECT_DIR"), TABLE_FILE),
+                      dict((key, str(value)) for key, value in env["ENV"].items()))
+
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}${PROGSUFFIX}", ram_map_action)
+
+# Run by hand
+elif __name__ == "__main__":
+    if len(sys.argv) < 2:
+        sys.exit("Usage: python3 ram_map.py <program> [nm] [RAM bytes]")
+    print_ram_map(sys.argv[1], sys.argv[2] if len(sys.argv) > 2 else "nm",
+                  int(sys.argv[3]) if len(sys.argv) > 3 else None)
@@ -0,0 +1,214 @@
+#-----------------------------------------------------------------------------------------------
+# This file defines the encoder for the binary motion protocol (see binary_protocol.h in the
+# firmware), and a benchmark which compares it to sending text gcode over 115200 baud. It is the
+# Python twin of the C++ reference encoder and benchmark in tools/binary_encoder.h and
+# tools/binary_benchmark.cpp, and makes the same frames.
+#
+# Run it by itself to see the benchmark:
+#   python3 Binary_coms.py [file.gcode]
+#-----------------------------------------------------------------------------------------------
+
+import struct
+import sys
+
+# Frame constants: these must match binary_protocol.h
+BIN_SYNC = 0xA5
+
+BIN_OP_MOVE = 0x01
+BIN_OP_END = 0x0F
+
+BIN_FLAG_TRAVEL = 0x10
+BIN_FLAG_ABS = 0x20
+BIN_FLAG_S = 0x40
+BIN_FLAG_F = 0x80
+
+BIN_POS_SCALE = 100
+
+# Bytes the host may have sent without an acknowledgement: the receive buffer in serial.h
+BIN_WINDOW = 128
+
+TRAVEL_SPEED = 600      # mm/min, same as gcode.h
+
+# Serial link: 115200 baud, 8N1 is 10 bits per byte
+BAUD_RATE = 115200
+BYTES_PER_SECOND = BAUD_RATE / 10
+
+
+# This function calculates the CRC-8 (polynomial 0x07) of a bytes object, the same as crc8() in
+# binary_protocol.cpp.
+def crc8(data, crc = 0):
+    for byte in data:
+        crc ^= byte
+        for bit in range(8):
+            if crc & 0x80:
+                crc = ((crc << 1) ^ 0x07) & 0xFF
+            else:
+                crc = (crc << 1) & 0xFF
+    return crc
+
+#-----------------------------------------------------------------------------------------------
+
+# This class turns moves into binary frames. It keeps the last position, S, F and sequence number
+# so each frame only carries what changed, the same way binary_decoder does on the other end.
+class binary_encoder:
+    def __init__(self):
+        self.reset()
+
+    def reset(self):
+        self.seq = 0
+        self.X_fixed = None         # Unknown until the first (absolute) move
+        self.Y_fixed = None
+        self.S = 0
+        self.F = TRAVEL_SPEED
+
+    def frame(self, opcode, payload = b''):
+        body = bytes([opcode, self.seq]) + payload
+        self.seq = (self.seq + 1) & 0xFF
+        return bytes([BIN_SYNC]) + body + bytes([crc8(body)])
+
+    # Make a move frame. S is in percent (0 to 100), like the S the firmware gets from gcode,
+    # and F is in mm/min. Travel moves ignore S and F.
+    def move(self, X, Y, S = None, F = None, travel = False):
+        X_fixed = int(round(X*BIN_POS_SCALE))
+        Y_fixed = int(round(Y*BIN_POS_SCALE))
+        opcode = BIN_OP_MOVE
+
+        if travel:
+            opcode |= BIN_FLAG_TRAVEL
+
+        if self.X_fixed is None or not (-32768 <= X_fixed - self.X_fixed <= 32767 and -32768 <= Y_fixed - self.Y_fixed <= 32767):
+            opcode |= BIN_FLAG_ABS
+            payload = struct.pack('<ii', X_fixed, Y_fixed)
+        else:
+            payload = struct.pack('<hh', X_fixed - self.X_fixed, Y_fixed - self.Y_fixed)
+        self.X_fixed = X_fixed
+        self.Y_fixed = Y_fixed
+
+        if not travel and S is not None and int(round(S)) != self.S:
+            self.S = int(round(S))
+            opcode |= BIN_FLAG_S
+            payload += struct.pack('<B', self.S)
+        if not travel and F is not None and int(round(F)) != self.F:
+            self.F = int(round(F))
+            opcode |= BIN_FLAG_F
+            payload += struct.pack('<H', self.F)
+
+        return self.frame(opcode, payload)
+
+    # Make the frame which ends binary mode
+    def end(self):
+        return self.frame(BIN_OP_END)
+
+#-----------------------------------------------------------------------------------------------
+
+# This function reads the words from a G0 or G1 line. Returns None for any other line.
+# S is scaled the same way as the firmware: S1.00 is 100%.
+def read_move(line):
+    line = line.split(';')[0].strip().upper()
+    words = {}
+    for word in line.split():
+        try:
+            words[word[0]] = float(word[1:])
+        except ValueError:
+            return None
+    if words.get('G') not in (0, 1):
+        return None
+    if 'S' in words:
+        words['S'] = words['S']*100
+    return words
+
+
+# This function turns a list of gcode lines into binary frames, ending with an end frame.
+# Lines that aren't moves (comments, units, etc.) are skipped.
+def gcode_to_frames(data):
+    encoder = binary_encoder()
+    frames = []
+    X = 0
+    Y = 0
+    for line in data:
+        words = read_move(line)
+        if words is None:
+            continue
+        X = words.get('X', X)
+        Y = words.get('Y', Y)
+        frames.append(encoder.move(X, Y, words.get('S'), words.get('F'), travel = (words['G'] == 0)))
+    frames.append(encoder.end())
+    return frames
+
+
+# This function sends gcode to the laser as binary frames. Frames are sent as long as the bytes
+# that haven't been acknowledged fit in BIN_WINDOW, and sending starts over from the frame the
+# laser asks for if one is rejected.
+def send_binary(ComPort, data):
+    frames = gcode_to_frames(data)
+
+    #Switch the laser to binary mode. Answers to text lines sent before this may still come in first.
+    ComPort.write("$B\n")
+    while ComPort.read() != 'Binary\n':
+        pass
+
+    acked = 0               #Index of the first frame which hasn't been acknowledged
+    sent = 0                #Index of the next frame to send
+    while acked < len(frames):
+        #Fill the window
+        while sent < len(frames) and sum(len(f) for f in frames[acked:sent+1]) <= BIN_WINDOW:
+            ComPort.write_bytes(frames[sent])
+            sent += 1
+
+        #Wait for an answer. Sequence numbers wrap at 256, so count forward from the oldest frame.
+        reply = ComPort.read().strip()
+        if reply.startswith('rb'):
+            resend = (int(reply[2:]) - acked) & 0xFF
+            if acked + resend < sent:
+                sent = acked + resend
+                acked = sent
+        elif reply.startswith('b'):
+            acked += ((int(reply[1:]) - acked) & 0xFF) + 1
+
+#-----------------------------------------------------------------------------------------------
+
+# This function works out how many moves per second a 115200 baud link can carry for the text
+# protocol (with and without the Ready?/Ready handshake) and for binary frames.
+#   turnaround is the time the host waits between hearing "Ready" and sending the line, plus
+#   the time the laser takes to see "Ready?" (the reader task runs every 2 ms).
+def benchmark(data, turnaround = 0.012):
+    moves = [line for line in data if read_move(line) is not None]
+    frames = gcode_to_frames(data)
+
+    text_bytes = sum(len(line) + 1 for line in moves)      # +1 for the null at the end of each line
+    handshake_bytes = len(moves)*len("Ready?\0")
+    reply_bytes = len(moves)*len("Ready\n")
+    binary_bytes = sum(len(f) for f in frames)
+
+    #Handshake: every line waits for the question and the answer to cross the link, one after the other
+    text_time = (text_bytes + handshake_bytes + reply_bytes)/BYTES_PER_SECOND + len(moves)*turnaround
+    stream_time = text_bytes/BYTES_PER_SECOND
+    binary_time = binary_bytes/BYTES_PER_SECOND
+
+    print('Moves:                  ', len(moves))
+    print('Text bytes per move:     %.1f' % (text_bytes/len(moves)))
+    print('Binary bytes per move:   %.1f' % (binary_bytes/len(moves)))
+    print('Text with handshake:     %.0f moves/s' % (len(moves)/text_time))
+    print('Text without handshake:  %.0f moves/s' % (len(moves)/stream_time))
+    print('Binary frames:           %.0f moves/s' % (len(moves)/binary_time))
+
+
+# This function makes a test path of short cutting moves and the travel between them, like an
+# engraved raster or a finely divided curve.
+def test_path():
+    data = ['G21', 'G90', 'G0 X0.00 Y0.00']
+    for row in range(50):
+        y = row*0.2
+        data.append('G0 X0.00 Y%.2f' % y)
+        for col in range(1, 40):
+            data.append('G1 X%.2f Y%.2f S%.2f F1200' % (col*0.25, y + 0.01*(col % 3), 0.5 + 0.01*(col % 5)))
+    return data
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], 'r') as f_gcode:
+            data = f_gcode.read().splitlines()
+    else:
+        data = test_path()
+    benchmark(data)
@@ -0,0 +1,232 @@
+#-----------------------------------------------------------------------------------------------
+# This file defines the compressor for the compressed text mode (see lz_decompress.h in the
+# firmware), the function which streams compressed gcode to the [Laser], and a report of the
+# compression ratio and lines/s for a set of jobs.
+#
+# The compression is LZSS like heatshrink: a literal is a 1 bit then 8 bits, and a back reference
+# is a 0 bit, 8 bits of (distance - 1) and 4 bits of (count - 1), most significant bit first. The
+# laser only keeps a 256 byte window of past text.
+#
+# Text is sent in blocks of whole lines: a length byte, then that many compressed bytes. A length
+# of 0 goes back to plain text. The window carries on across blocks.
+#
+# Run it by itself to see the report:
+#   python3 Compress_coms.py [file.gcode ...]
+#-----------------------------------------------------------------------------------------------
+
+from collections import deque
+import math
+import sys
+
+import Binary_coms as bc
+import Stream_coms as stc
+
+# These must match lz_decompress.h
+LZ_WINDOW_BITS = 8
+LZ_LOOKAHEAD_BITS = 4
+LZ_WINDOW_SIZE = 1 << LZ_WINDOW_BITS
+LZ_MAX_COUNT = 1 << LZ_LOOKAHEAD_BITS
+LZ_MAX_BLOCK_SIZE = stc.RX_BUFFER_SIZE - 1
+
+# A back reference costs 13 bits and a literal 9, so only matches this long are worth it
+LZ_MIN_COUNT = 2
+
+
+# This function compresses text, with history being the text the laser already has in its window.
+# Returns the compressed bytes, padded with zero bits to a whole byte.
+def lz_compress(text, history = b''):
+    history = history[-LZ_WINDOW_SIZE:]
+    buffer = history + text
+    bits = []
+    starts = {}                 #Where each pair of bytes has been seen, to find matches quickly
+    for i in range(len(history) - 1):
+        starts.setdefault(buffer[i:i+2], []).append(i)
+    position = len(history)
+    while position < len(buffer):
+        #Find the longest match in the window; it may run into the text being matched
+        best_count = 0
+        best_distance = 0
+        for start in reversed(starts.get(buffer[position:position+2], [])):
+            distance = position - start
+            if distance > LZ_WINDOW_SIZE:
+                break
+            count = 0
+            while (count < LZ_MAX_COUNT and position + count < len(buffer)
+                   and buffer[start + count] == buffer[position + count]):
+                count += 1
+            if count > best_count:
+                best_count = count
+                best_distance = distance
+                if count == LZ_MAX_COUNT:
+                    break
+
+        #Remember where the pairs of bytes used up here start
+        step = best_count if best_count >= LZ_MIN_COUNT else 1
+        for i in range(position, min(position + step, len(buffer) - 1)):
+            starts.setdefault(buffer[i:i+2], []).append(i)
+
+        if best_count >= LZ_MIN_COUNT:
+            bits.append('0' + format(best_distance - 1, '0%db' % LZ_WINDOW_BITS)
+                        + format(best_count - 1, '0%db' % LZ_LOOKAHEAD_BITS))
+            position += best_count
+        else:
+            bits.append('1' + format(buffer[position], '08b'))
+            position += 1
+
+    bits = ''.join(bits)
+    bits += '0'*(-len(bits) % 8)
+    return bytes(int(bits[i:i+8], 2) for i in range(0, len(bits), 8))
+
+
+# This function expands compressed bytes the same way lz_decoder does, to check the compressor.
+def lz_decompress(data, history = b''):
+    bits = ''.join(format(byte, '08b') for byte in data)
+    output = bytearray(history)
+    start = len(output)
+    position = 0
+    while position + 9 <= len(bits):
+        if bits[position] == '1':
+            output.append(int(bits[position+1:position+9], 2))
+            position += 9
+        else:
+            if position + 1 + LZ_WINDOW_BITS + LZ_LOOKAHEAD_BITS > len(bits):
+                break               #Padding
+            distance = int(bits[position+1:position+1+LZ_WINDOW_BITS], 2) + 1
+            count = int(bits[position+1+LZ_WINDOW_BITS:position+1+LZ_WINDOW_BITS+LZ_LOOKAHEAD_BITS], 2) + 1
+            for i in range(count):
+                output.append(output[-distance])
+            position += 1 + LZ_WINDOW_BITS + LZ_LOOKAHEAD_BITS
+    return bytes(output[start:])
+
+
+# This function splits lines into compressed blocks which each fit in the laser's receive buffer.
+# Returns a list of (block bytes with its length byte, number of lines in the block).
+def make_blocks(lines):
+    blocks = []
+    history = b''
+    block_lines = []
+    block_data = b''
+    for line in lines:
+        text = ''.join(l + '\n' for l in block_lines + [line]).encode()
+        data = lz_compress(text, history)
+        if len(data) > LZ_MAX_BLOCK_SIZE and block_lines:
+            #This line doesn't fit; finish the block without it
+            blocks.append((bytes([len(block_data)]) + block_data, len(block_lines)))
+            history = (history + ''.join(l + '\n' for l in block_lines).encode())[-LZ_WINDOW_SIZE:]
+            block_lines = [line]
+            block_data = lz_compress((line + '\n').encode(), history)
+        else:
+            block_lines.append(line)
+            block_data = data
+    if block_lines:
+        blocks.append((bytes([len(block_data)]) + block_data, len(block_lines)))
+    return blocks
+
+#-----------------------------------------------------------------------------------------------
+
+# This function streams gcode to the laser as compressed blocks, using character counting: a block's
+# bytes count against the receive buffer until the last line in it has been answered.
+# Returns a list of (line, error code) for lines answered with an error.
+def send_compressed(ComPort, data, rx_size = stc.RX_BUFFER_SIZE, echo = False):
+    lines = [stc.clean_line(line) for line in data if stc.clean_line(line) != '']
+    blocks = make_blocks(lines)
+
+    ComPort.write("$Z\n")
+    while ComPort.read() != 'Compressed\n':
+        pass
+
+    in_flight = deque()         #[bytes, lines not answered yet] for each block sent
+    in_flight_bytes = 0
+    line_index = 0              #Next line to be answered, for error messages
+    errors = []
+
+    def wait_for_answer():
+        nonlocal in_flight_bytes, line_index
+        answered, value = stc.read_answer(ComPort)
+        if not answered:
+            if echo:
+                print(value)
+            return
+        if value != 0:
+            errors.append((lines[line_index], value))
+            print('error:%d on line "%s"' % (value, lines[line_index]))
+        line_index += 1
+        in_flight[0][1] -= 1
+        if in_flight[0][1] == 0:
+            in_flight_bytes -= in_flight.popleft()[0]
+
+    for block, n_lines in blocks:
+        while in_flight_bytes + len(block) > rx_size:
+            wait_for_answer()
+        ComPort.write_bytes(block)
+        in_flight.append([len(block), n_lines])
+        in_flight_bytes += len(block)
+
+    #Back to plain text
+    ComPort.write_bytes(bytes([0]))
+    while in_flight:
+        wait_for_answer()
+    return errors
+
+#-----------------------------------------------------------------------------------------------
+
+# These functions make test jobs like the ones the laser runs, for when no files are given.
+def vector_job():
+    #Outlines of circles, as a CAM program would write them
+    data = ['; Vector outlines', 'G21', 'G90', 'M3']
+    for ring in range(8):
+        cx = 20 + 25*(ring % 4)
+        cy = 20 + 25*(ring // 4)
+        r = 4 + ring
+        data.append('G0 X%.3f Y%.3f' % (cx + r, cy))
+        for step in range(1, 121):
+            angle = 2*math.pi*step/120
+            data.append('G1 X%.3f Y%.3f S0.80 F900' % (cx + r*math.cos(angle), cy + r*math.sin(angle)))
+    data.append('M5')
+    return data
+
+
+def fill_job():
+    #Hatched fill written out as G0/G1 pairs
+    data = ['; Hatch fill', 'G21', 'G90', 'M3']
+    for line in range(300):
+        y = 10 + 0.1*line
+        x0, x1 = (10.0, 60.0) if line % 2 == 0 else (60.0, 10.0)
+        data.append('G0 X%.2f Y%.2f' % (x0, y))
+        data.append('G1 X%.2f Y%.2f S1.00 F1500' % (x1, y))
+    data.append('M5')
+    return data
+
+
+# This function prints the compression ratio and lines/s at 115200 baud for one job.
+def report(name, data):
+    lines = [stc.clean_line(line) for line in data if stc.clean_line(line) != '']
+    text_bytes = sum(len(line) + 1 for line in lines)
+    blocks = make_blocks(lines)
+    compressed_bytes = sum(len(block) for block, _ in blocks) + 1
+
+    #Check that the laser would get back exactly the same text
+    history = b''
+    expanded = b''
+    for block, _ in blocks:
+        text = lz_decompress(block[1:], history)
+        expanded += text
+        history = (history + text)[-LZ_WINDOW_SIZE:]
+    if expanded != ''.join(line + '\n' for line in lines).encode():
+        print('%s: COMPRESSED TEXT DOES NOT MATCH' % name)
+        return
+
+    print('%-14s %6d lines  %7d -> %6d bytes  ratio %.2f  %5.0f -> %5.0f lines/s'
+          % (name, len(lines), text_bytes, compressed_bytes, text_bytes/compressed_bytes,
+             len(lines)/(text_bytes/bc.BYTES_PER_SECOND), len(lines)/(compressed_bytes/bc.BYTES_PER_SECOND)))
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        for filepath in sys.argv[1:]:
+            with open(filepath, 'r') as f_gcode:
+                report(filepath, f_gcode.read().splitlines())
+    else:
+        report('raster', bc.test_path())
+        report('vector', vector_job())
+        report('fill', fill_job())
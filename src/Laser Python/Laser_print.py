@@ -6,6 +6,9 @@ import numpy as np
 
 import Preview_Gcode as gc
 import Serial_coms as sc
+import Binary_coms as bc
+import Stream_coms as stc
+import Compress_coms as cc
 import time
 
 class Laser_printer:
@@ -32,67 +35,23 @@ class Laser_printer:
     def send_file(self):
         input_command = input('Ok to send to Laser? Y/N')
         if input_command == 'Y' or input_command == 'y' or input_command == '':
+            passes = input('Number of passes (1): ')
+            data = stc.multi_pass(self.data, int(passes) if passes.isdigit() else 1)
 
-            # Currently only writes line 10 of data; update this later to send all data, but we'll use 
-            # this for testing
-            # Data_to_write = self.data[17]
-            # Data_to_write += '\0'           #termination char for microcontroller
+            #Stream the whole file; the laser answers each line so we know when there is room for more,
+            #and lines are numbered and checksummed so any that get corrupted are sent again
+            errors = stc.send_numbered(self.ComPort, data, echo = True)
+            print('File sent with %d errors' % len(errors))
 
-            # print('Sending Gcode:',Data_to_write)
-            # self.ComPort.write(Data_to_write)
 
-            # print('Reading Data...')
-            # read_val = self.ComPort.read()
-
-            # print('Read Val:',read_val)
-            # print(len(self.data))
-
-
-            i = 0
-            
-            while  i <= 10:     #np.arange(0,len(self.data) 
-
-                #Add comment displayer later
-
-                #Ask the microcontroller if it's ready for data
-                # print("Asking mc if it's ready")
-                self.ComPort.write("Ready?\0")
-
-                #Read the status of the mc:
-                awaiting_response = True
-                while awaiting_response:
-                    # print("Waiting for response")
-                    # time.sleep(0.100)
-                    read_val = self.ComPort.read()
-                    # print(read_val.encode())
-
-                    # The microcontroller will send "Ready" when it can take a gcode line: 
-                    # This line won't be reached until we get a ready response from the mc.
-                    if read_val == 'Ready\n':
-                        # print('Response Recived')
-                        awaiting_response = False
-
-                        line = self.data[i] #get line from data
-                        line += '\0'        #Add null char to signal end of line for mc
-
-                        #write the line to the mc and move i to the next line
-                        time.sleep(0.010)
-                        self.ComPort.write(line)
-                        i += 1
-
-                        #print the line so we can see what was just sent
-                        # if line[0] == ';':
-                            # print(line[1:len(line)])      
-                        print(line[0:len(line)])                 
-
-                # #If we're told to wait, just wait here until we get a new reading from read_val.
-                # elif read_val == "Wait":
-                #     #Stay in the while loop reading values until we get a "Ready" signal from the mc. 
-                #     awaiting_response = True
-                #     while awaiting_response:
-                #         read_val = self.ComPort.read()
-                #         if read_val == "Ready":
-                #             awaiting_response = False
+    def send_file_binary(self):
+        input_command = input('Ok to send to Laser as binary frames? Y/N')
+        if input_command == 'Y' or input_command == 'y' or input_command == '':
+            bc.send_binary(self.ComPort, self.data)
 
 
-            
+    def send_file_compressed(self):
+        input_command = input('Ok to send to Laser as compressed text? Y/N')
+        if input_command == 'Y' or input_command == 'y' or input_command == '':
+            errors = cc.send_compressed(self.ComPort, self.data, echo = True)
+            print('File sent with %d errors' % len(errors))
@@ -35,6 +35,8 @@ SERIAL_DEVICE = '/dev/cu.usbmodem14203'
 
 help_menu   = "Use these commands to run the laser cutter UI:\n"
 help_menu  += "p, prnt     Print a .gcode file\n"
+help_menu  += "b, bprnt    Print a .gcode file using binary frames\n"
+help_menu  += "z, zprnt    Print a .gcode file using compressed text\n"
 help_menu  += "h, help     Display help menu\n"
 help_menu  += "e, exit     Exit program"
 
@@ -75,6 +77,18 @@ def main():
             printer.preview_file()
             printer.send_file()
 
+        #Print file with binary frames command
+        elif input_command == "b" or input_command == "bprnt":
+            printer = lp.Laser_printer(ComPort)
+            printer.preview_file()
+            printer.send_file_binary()
+
+        #Print file with compressed text command
+        elif input_command == "z" or input_command == "zprnt":
+            printer = lp.Laser_printer(ComPort)
+            printer.preview_file()
+            printer.send_file_compressed()
+
         #Invalid command
         else:
             print('"' + input_command + '" is an invalid Command. Choose one of the commands below:\n')
@@ -0,0 +1,128 @@
+#-----------------------------------------------------------------------------------------------
+# This file works out how long the laser takes to react to a feed hold, from the moment the hold
+# gets to the laser to the moment motion stops, with every buffer in front of the motors full.
+#
+# It compares two ways of asking for the hold:
+#   As a line:       the hold waits behind every line in the receive ring and the read queue and
+#                    every ramp segment in the ramp queue, so motion only stops once all of those
+#                    moves have run.
+#   Real-time byte:  task_read_serial picks the '!' out as soon as it runs (every 2 ms) and pauses
+#                    the timing share, and the motion stops on the next encoder tick (every 10 ms).
+#
+# The laser isn't run; this is a simulation with the task periods and queue sizes from the
+# firmware, the test path from Binary_coms.py for the move lengths (F taken as mm/min), and a
+# random phase for every task on every trial. It also works out how long a status report takes.
+#
+# Run it with:
+#   python3 Realtime_benchmark.py [file.gcode]
+#-----------------------------------------------------------------------------------------------
+
+import math
+import random
+import sys
+
+import Binary_coms as bc
+import Stream_coms as stc
+
+READ_TASK_PERIOD = 0.002        # task_read_serial runs every 2 ms
+PRINT_TASK_PERIOD = 0.010       # task_print_serial runs every 10 ms
+ENCODER_PERIOD = 0.010          # encoder_A_period, from the task table in static_alloc.h
+READ_Q_SIZE = 32                # Same as serial.h
+RAMP_QUEUE_RUNNING = 32 - 4     # RAMP_COEFF_Q_SIZE - RAMP_COEFF_Q_PAUSE_LIMIT: segments the translator keeps queued
+TRAVEL_SPEED = 600              # Same as gcode.h, in mm/min
+STATUS_REPORT_BYTES = len('<Run|Buf:28|Ov:100>\n')
+TRIALS = 100000
+
+
+# This function works out how long each line of a job takes to run, in seconds, the way the
+# translator does it: the length of the move divided by the feedrate. Lines that don't move take 0.
+def move_times(data):
+    X, Y, F = 0.0, 0.0, TRAVEL_SPEED
+    times = []
+    for line in data:
+        words = {}
+        for word in line.split()[1:]:
+            try:
+                words[word[0]] = float(word[1:])
+            except ValueError:
+                pass
+        new_X, new_Y = words.get('X', X), words.get('Y', Y)
+        F = words.get('F', F)
+        length = math.hypot(new_X - X, new_Y - Y)
+        times.append(length/(F/60) if line.startswith(('G0', 'G1')) else 0.0)
+        X, Y = new_X, new_Y
+    return times
+
+
+# This function works out how many lines are waiting in front of the motors when everything is
+# full, starting from a given line: a full ramp queue, a full read queue, and as many lines as fit
+# in the receive ring.
+def lines_ahead(data, start):
+    n_lines = RAMP_QUEUE_RUNNING + READ_Q_SIZE
+    ring_bytes = 0
+    while start + n_lines < len(data):
+        size = len(data[start + n_lines]) + 1
+        if ring_bytes + size > stc.RX_BUFFER_SIZE:
+            break
+        ring_bytes += size
+        n_lines += 1
+    return n_lines
+
+
+# This function returns how long after time 0 a task with a given period and phase runs next.
+def next_run(time, period, phase):
+    return phase + math.ceil((time - phase)/period)*period
+
+
+# This function runs the trials and returns the hold latencies (line, real-time byte) and the
+# status report latencies, in seconds.
+def simulate(data, trials = TRIALS):
+    times = move_times(data)
+    byte_time = 1/bc.BYTES_PER_SECOND
+    line_latency = []
+    realtime_latency = []
+    status_latency = []
+
+    for _ in range(trials):
+        start = random.randrange(len(data) - 1)
+        read_phase = random.uniform(0, READ_TASK_PERIOD)
+        print_phase = random.uniform(0, PRINT_TASK_PERIOD)
+        encoder_phase = random.uniform(0, ENCODER_PERIOD)
+
+        #As a line: the move being run is part way done, and everything queued behind it has to run
+        ahead = lines_ahead(data, start)
+        left = random.uniform(0, times[start]) + sum(times[start + 1:start + ahead])
+        line_latency.append(next_run(left, ENCODER_PERIOD, encoder_phase))
+
+        #Real-time byte: the reader sees it after the byte is in, and the next encoder tick stops motion
+        seen = next_run(byte_time, READ_TASK_PERIOD, read_phase)
+        realtime_latency.append(next_run(seen, ENCODER_PERIOD, encoder_phase))
+
+        #Status report: the reader puts it in the print queue, and the print task sends it
+        printed = next_run(seen, PRINT_TASK_PERIOD, print_phase)
+        status_latency.append(printed + STATUS_REPORT_BYTES*byte_time)
+
+    return line_latency, realtime_latency, status_latency
+
+
+# This function prints the worst case and mean of a list of latencies.
+def report(name, latencies):
+    print('%-26s worst %8.1f ms   mean %8.1f ms' % (name, 1000*max(latencies), 1000*sum(latencies)/len(latencies)))
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], 'r') as f_gcode:
+            data = f_gcode.read().splitlines()
+    else:
+        data = bc.test_path()
+    data = [stc.clean_line(line) for line in data if stc.clean_line(line) != '']
+
+    random.seed(507)
+    line_latency, realtime_latency, status_latency = simulate(data)
+    print('Feed hold with the receive ring, read queue and ramp queue full (%d trials, simulated):' % TRIALS)
+    report('Hold sent as a line:', line_latency)
+    report('Real-time byte:', realtime_latency)
+    report('Status report (?):', status_latency)
+    bound = 1/bc.BYTES_PER_SECOND + READ_TASK_PERIOD + ENCODER_PERIOD
+    print('Real-time bound: 1 byte + 1 reader period + 1 encoder period = %.1f ms' % (1000*bound))
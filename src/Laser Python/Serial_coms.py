@@ -40,6 +40,10 @@ class serial_coms:
         #Write encoded data to the serial port
         self.ser.write(Data_to_write.encode())
 
+    def write_bytes(self,Data_to_write):
+        #Write raw bytes (binary frames) to the serial port without encoding them
+        self.ser.write(Data_to_write)
+
     def read(self):
         # print('Reading Data...')
 
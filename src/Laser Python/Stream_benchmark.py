@@ -0,0 +1,289 @@
+#-----------------------------------------------------------------------------------------------
+# This file measures how fast gcode lines can be sent with the Ready?/Ready handshake compared to
+# character counting. The host side runs the real functions in Stream_coms.py over a pty, and a
+# simulated laser on the other end of the pty behaves like task_read_serial and task_translate:
+# bytes come in at 115200 baud, lines go through a RX_BUFFER_SIZE ring and a READ_Q_SIZE queue,
+# and every line is answered once it is used. Moves are used as fast as they arrive, so the
+# numbers show the limit of the link and the protocol, not of the motors.
+#
+# It also runs the numbered, checksummed protocol with random bit errors put into the bytes going
+# to the laser, and checks that the laser ran every line exactly once, in order, and sends the
+# same lines as compressed text (see Compress_coms.py). Stream_test.py uses the simulated laser
+# for tests of the same things that pass or fail.
+#
+# Run it with:
+#   python3 Stream_benchmark.py [file.gcode]
+#-----------------------------------------------------------------------------------------------
+
+import os
+import pty
+import random
+import select
+import sys
+import threading
+import time
+import tty
+
+import Binary_coms as bc
+import Compress_coms as cc
+import Stream_coms as stc
+
+READ_Q_SIZE = 32            # Same as serial.h
+READ_TASK_PERIOD = 0.002    # task_read_serial runs every 2 ms
+
+
+# This class has the same write()/read() functions as serial_coms, but talks to a pty.
+class pty_coms:
+    def __init__(self, fd, timeout = 5):
+        self.fd = fd
+        self.buffer = b''
+        self.timeout = timeout
+
+    def write(self, Data_to_write):
+        os.write(self.fd, Data_to_write.encode())
+
+    def write_bytes(self, Data_to_write):
+        os.write(self.fd, Data_to_write)
+
+    def read(self):
+        #Read until a newline, like serial.read_until(), with a 5 s timeout
+        end_time = time.time() + self.timeout
+        while b'\n' not in self.buffer:
+            ready, _, _ = select.select([self.fd], [], [], max(0, end_time - time.time()))
+            if not ready:
+                return ''
+            self.buffer += os.read(self.fd, 1024)
+        line, self.buffer = self.buffer.split(b'\n', 1)
+        return (line + b'\n').decode()
+
+
+# This class works the same way as the line number and checksum part of decode::check_line().
+class simulated_decoder:
+    def __init__(self):
+        self.line_number = 0
+        self.numbered = False
+
+    # Returns (error code, line without the number and checksum)
+    def check_line(self, line):
+        has_number = line.startswith('N')
+        if has_number:
+            if '*' not in line:
+                return stc.CHECKSUM_ERROR, line
+            body, _, sent_checksum = line.rpartition('*')
+            checksum = 0
+            for char in body:
+                checksum ^= ord(char)
+            if sent_checksum == '' or sent_checksum.strip('0123456789') != '' or int(sent_checksum) != checksum:
+                return stc.CHECKSUM_ERROR, line
+            number_text = ''
+            for char in body[1:]:
+                if char not in '0123456789':
+                    break
+                number_text += char
+            if number_text == '':
+                return stc.LINE_NUMBER_ERROR, line
+            number = int(number_text)
+            line = body[1 + len(number_text):].lstrip(' ')
+        elif self.numbered and not line.startswith('M110'):
+            return stc.LINE_NUMBER_ERROR, line
+
+        if line.startswith('M110'):
+            words = line[4:].split()
+            try:
+                self.line_number = int(float(words[0][1:])) if words and words[0].startswith('N') else 0
+            except ValueError:
+                self.line_number = 0
+            self.numbered = has_number
+            return 0, ''
+
+        if has_number:
+            if number <= self.line_number and self.numbered:
+                return 0, ''
+            if number != self.line_number + 1:
+                return stc.LINE_NUMBER_ERROR, line
+            self.line_number = number
+            self.numbered = True
+        return 0, line
+
+
+# This class is the simulated laser on the other end of the pty. Bytes going to it can be given
+# random bit errors, with a chance of error_rate for each byte, and the lines it reads can be given
+# one bit error each by their place in the order they arrive, counting from 0, with corrupt_lines.
+# With reset_after it acts like it got a soft reset once it has used that many lines.
+class simulated_laser(threading.Thread):
+    def __init__(self, fd, error_rate = 0, corrupt_lines = (), reset_after = None):
+        super().__init__(daemon = True)
+        self.fd = fd
+        self.running = True
+        self.lines_used = 0
+        self.overflows = 0
+        self.error_rate = error_rate
+        self.corrupted = 0
+        self.corrupt_lines = set(corrupt_lines)
+        self.lines_read = 0
+        self.corrupted_lines = []       # Lines given a bit error by corrupt_lines, before the error
+        self.resends = []               # Line numbers asked for with "Resend:"
+        self.reset_after = reset_after
+        self.decoder = simulated_decoder()
+        self.ran = []                   # Lines that made it to the gcode interpreter
+
+    def corrupt(self, incoming):
+        incoming = bytearray(incoming)
+        for i in range(len(incoming)):
+            if random.random() < self.error_rate:
+                incoming[i] ^= 1 << random.randrange(8)
+                self.corrupted += 1
+        return bytes(incoming)
+
+    # Flip a bit in a line if it is one of corrupt_lines. The second character is never part of a
+    # line ending, so the line still arrives as one line.
+    def corrupt_line(self, line):
+        if self.lines_read in self.corrupt_lines and len(line) > 1:
+            self.corrupted_lines.append(line.decode('latin-1'))
+            line = line[:1] + bytes([line[1] ^ 0x01]) + line[2:]
+        self.lines_read += 1
+        return line
+
+    def run(self):
+        ring = b''
+        line = b''
+        queue = []
+        compressed = False
+        text = b''                      # Text that has come out of the decompressor
+        history = b''
+        last_received = b'\n'
+        skip_to_line_end = False        # Set when a reset threw away the start of the line coming in
+        os.write(self.fd, b'[RX:%d]\n' % stc.RX_BUFFER_SIZE)
+        last_time = time.time()
+        while self.running:
+            time.sleep(READ_TASK_PERIOD)
+            now = time.time()
+
+            #Bytes can't come in faster than the baud rate allows
+            allowed = int((now - last_time)*bc.BYTES_PER_SECOND)
+            last_time = now
+            ready, _, _ = select.select([self.fd], [], [], 0)
+            if ready and allowed > 0:
+                incoming = self.corrupt(os.read(self.fd, allowed))
+                if len(ring) + len(incoming) > stc.RX_BUFFER_SIZE:
+                    self.overflows += 1
+                ring += incoming
+                last_received = incoming[-1:] if incoming else last_received
+
+            #Compressed text: expand whole blocks as they come in
+            while compressed and ring and len(ring) > ring[0]:
+                if ring[0] == 0:
+                    compressed = False
+                    ring = ring[1:]
+                    break
+                block, ring = ring[1:1 + ring[0]], ring[1 + ring[0]:]
+                expanded = cc.lz_decompress(block, history)
+                history = (history + expanded)[-cc.LZ_WINDOW_SIZE:]
+                text += expanded
+
+            #Reader: split the text into lines while the read queue has room
+            replies = b''
+            while len(queue) < READ_Q_SIZE:
+                if text:
+                    char, text = text[:1], text[1:]
+                elif ring and not compressed:
+                    char, ring = ring[:1], ring[1:]
+                else:
+                    break
+                if skip_to_line_end:
+                    skip_to_line_end = char not in (b'\n', b'\0')
+                elif char in (b'\n', b'\0'):
+                    if line == b'Ready?':
+                        replies += b'Ready\n'
+                    elif line == b'$Z':
+                        replies += b'Compressed\n'
+                        compressed = True
+                        history = b''
+                    else:
+                        queue.append(self.corrupt_line(line))
+                    line = b''
+                elif char != b'\r':
+                    line += char
+
+            #Translator: check and use every queued line and answer it
+            for used in queue:
+                if self.lines_used == self.reset_after:
+                    #Soft reset: everything not used yet is thrown away without an answer, along with the
+                    #rest of the line coming in
+                    skip_to_line_end = last_received not in (b'\n', b'\0')
+                    ring, text, line = b'', b'', b''
+                    self.decoder = simulated_decoder()
+                    self.reset_after = None
+                    replies += b'[RX:%d]\n' % stc.RX_BUFFER_SIZE
+                    break
+                error, command = self.decoder.check_line(used.decode('latin-1'))
+                if error:
+                    self.resends.append(self.decoder.line_number + 1)
+                    replies += b'Resend:%d\n' % (self.decoder.line_number + 1)
+                    replies += b'error:%d\n' % error
+                else:
+                    if command != '':
+                        self.ran.append(command)
+                    replies += b'ok\n'
+                self.lines_used += 1
+            queue = []
+
+            if replies:
+                os.write(self.fd, replies)
+
+
+# This function sends the lines with one of the functions in Stream_coms.py and returns lines/s
+# and the simulated laser.
+def measure(send_function, data, error_rate = 0):
+    master, slave = pty.openpty()
+    tty.setraw(master)
+    tty.setraw(slave)
+    laser = simulated_laser(slave, error_rate)
+    laser.start()
+
+    ComPort = pty_coms(master, timeout = 0.5)
+    ComPort.read()                  # [RX:128] banner
+    start = time.time()
+    send_function(ComPort, data)
+    elapsed = time.time() - start
+
+    laser.running = False
+    laser.join()
+    os.close(master)
+    os.close(slave)
+    if laser.overflows:
+        print('  Receive buffer overflowed %d times!' % laser.overflows)
+    return len(data)/elapsed, laser
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], 'r') as f_gcode:
+            data = f_gcode.read().splitlines()
+    else:
+        data = bc.test_path()
+    data = [stc.clean_line(line) for line in data if stc.clean_line(line) != '']
+
+    handshake_rate, _ = measure(stc.send_handshake, data[:200])
+    streaming_rate, _ = measure(stc.send_streaming, data)
+    numbered_rate, _ = measure(stc.send_numbered, data)
+    print('Ready?/Ready handshake:   %.0f lines/s' % handshake_rate)
+    print('Character counting:       %.0f lines/s' % streaming_rate)
+    print('Speedup:                  %.1fx' % (streaming_rate/handshake_rate))
+    print('Numbered and checksummed: %.0f lines/s' % numbered_rate)
+    compressed_rate, laser = measure(cc.send_compressed, data)
+    print('Compressed text:          %.0f lines/s%s' 
+          % (compressed_rate, '' if laser.ran == data else ', LINES DO NOT MATCH'))
+
+    #Error injection: every line has to run exactly once, in order, whatever gets corrupted
+    random.seed(507)
+    for error_rate in (1e-4, 1e-3, 1e-2):
+        rate, laser = measure(stc.send_numbered, data, error_rate)
+        if len(laser.ran) != len(data):
+            result = 'LINES LOST OR REPEATED'
+        else:
+            #The XOR checksum can't see two flips of the same bit in one line; count those separately
+            wrong = sum(ran != sent for ran, sent in zip(laser.ran, data))
+            result = 'all lines ran once, in order, %d with errors the checksum missed' % wrong
+        print('Bit errors in %.2f%% of bytes: %d bytes corrupted, %.0f lines/s, %s' 
+              % (100*error_rate, laser.corrupted, rate, result))
@@ -0,0 +1,350 @@
+#-----------------------------------------------------------------------------------------------
+# This file defines functions that send gcode lines to the [Laser], either with the original
+# Ready?/Ready handshake or by streaming with character counting.
+#
+# Character counting: the laser has a receive buffer of RX_BUFFER_SIZE bytes (it says so with
+# "[RX:<size>]" when it starts) and answers every line with "ok" or "error:N" once it has used
+# it. The host keeps track of the bytes it has sent which haven't been answered yet and sends
+# the next line as soon as it fits, so the buffer never runs dry and never overflows.
+#
+# Line numbers and checksums: with send_numbered() every line is sent as N<line> ... *<checksum>.
+# The laser rejects a line with a bad checksum or the wrong number with "Resend:<n>" and an
+# error, and rejects everything after it until line n comes again, so the host just goes back
+# to line n. Lines it already ran are answered "ok" without running them twice.
+#
+# Soft reset: after RT_SOFT_RESET the laser throws away every line it hasn't run, without an "ok"
+# or "error" for any of them, and says "[RX:<size>]" again. When the streaming functions see that,
+# they forget the lines they were waiting on, so the byte count starts again from an empty buffer,
+# and they stop sending the job, as the laser is held and the lines it dropped won't be run.
+#-----------------------------------------------------------------------------------------------
+
+from collections import deque
+import time
+
+# These must match serial.h
+RX_BUFFER_SIZE = 128
+LINE_BUFFER_SIZE = 80
+
+# Real-time commands, which must match serial.h. These are single bytes the laser acts on as soon as
+# they arrive, even with its receive buffer full, so they aren't counted against RX_BUFFER_SIZE and
+# aren't answered with "ok". Only send them while text is being sent, not binary or compressed data.
+RT_STATUS = 0x3F                # '?': the laser prints a status report (see parse_status())
+RT_FEED_HOLD = 0x21             # '!'
+RT_RESUME = 0x7E                # '~'
+RT_SOFT_RESET = 0x18            # Ctrl-X: throw away everything queued, unanswered, and hold where the head is
+RT_FEED_100 = 0x90
+RT_FEED_PLUS_10 = 0x91
+RT_FEED_MINUS_10 = 0x92
+RT_FEED_PLUS_1 = 0x93
+RT_FEED_MINUS_1 = 0x94
+FEED_OVERRIDE_MIN = 10
+FEED_OVERRIDE_MAX = 200
+
+# These must match gcode.h
+LINE_LENGTH_ERROR = 8
+CHECKSUM_ERROR = 9
+LINE_NUMBER_ERROR = 10
+SUBPROGRAM_ERROR = 11
+SETTING_ERROR = 12
+
+
+# This function takes the comment and extra spaces off a gcode line, since the laser doesn't need
+# them and every byte counts against the receive buffer. Returns '' if nothing is left.
+def clean_line(line):
+    return line.split(';')[0].strip()
+
+
+# This function adds a line number and checksum to a line. The checksum is the XOR of every
+# character before the '*', the same as decode::check_line() works it out.
+def add_checksum(number, line):
+    line = ('N%d %s' % (number, line)).strip()
+    checksum = 0
+    for char in line:
+        checksum ^= ord(char)
+    return '%s*%d' % (line, checksum)
+
+
+# This function reads one answer from the laser.
+# Returns (True, error code or 0) for an answer to a line, or (False, text) for anything else.
+def read_answer(ComPort):
+    reply = ComPort.read()
+    if reply == '':
+        raise RuntimeError('Laser stopped answering')
+    return parse_answer(reply)
+
+
+# This function sorts out what a line from the laser is. Returns the same as read_answer().
+def parse_answer(reply):
+    reply = reply.strip()
+    if reply == 'ok':
+        return True, 0
+    if reply.startswith('error:'):
+        return True, int(reply[6:])
+    return False, reply
+
+
+# This function checks whether a line from the laser is the "[RX:<size>]" it prints when it starts
+# and after a soft reset, which means every line it hadn't answered was thrown away.
+def is_reset(reply):
+    return reply.strip().startswith('[RX:')
+
+
+# This function reads a status report like <Run|MPos:12.345,-3.000|Buf:12|FS:20,50|Ov:100>.
+# Returns a dict with 'state' and a list of numbers for every other field, or None if the line
+# isn't a status report.
+def parse_status(reply):
+    reply = reply.strip()
+    if not (reply.startswith('<') and reply.endswith('>')):
+        return None
+    fields = reply[1:-1].split('|')
+    status = {'state': fields[0]}
+    for field in fields[1:]:
+        name, _, values = field.partition(':')
+        status[name] = [float(value) for value in values.split(',')]
+    return status
+
+
+# This function sends one machine command and waits for its answer. Returns (error code, other
+# lines the laser printed before answering).
+def send_command(ComPort, line):
+    ComPort.write(line + '\n')
+    printed = []
+    while True:
+        answered, value = read_answer(ComPort)
+        if answered:
+            return value, printed
+        printed.append(value)
+
+
+# This function reads the laser's settings with $$. Returns a dict of setting number: (value, name).
+def get_settings(ComPort):
+    error, printed = send_command(ComPort, '$$')
+    settings = {}
+    for line in printed:
+        if line.startswith('$') and '=' in line:
+            number, _, rest = line[1:].partition('=')
+            value, _, name = rest.partition(' ')
+            settings[int(number)] = (float(value), name.strip('()'))
+    return settings
+
+
+# This function changes one of the laser's settings, which it saves in flash and uses right away.
+# Returns 0, or SETTING_ERROR if the laser wouldn't take the value.
+def set_setting(ComPort, number, value):
+    error, _ = send_command(ComPort, '$%d=%g' % (number, value))
+    return error
+
+
+# This function wraps a job so the laser records it and runs it again for more passes, instead of
+# the host sending it every time. S and F set the power (1.00 is 100%) and feedrate of the extra
+# passes, and S_step and F_step change them by that much more on each pass.
+def multi_pass(data, passes, S = None, F = None, S_step = None, F_step = None):
+    if passes <= 1:
+        return list(data)
+    replay = '$JP P%d' % (passes - 1)
+    for letter, value in (('S', S), ('F', F), ('I', S_step), ('J', F_step)):
+        if value is not None:
+            replay += ' %s%g' % (letter, value)
+    return ['$JR'] + list(data) + ['$JE', replay]
+
+# This function sends a real-time command. Bytes over 0x7F would be changed by str.encode(), so
+# they are written as raw bytes.
+def send_realtime(ComPort, command):
+    ComPort.write_bytes(bytes([command]))
+
+
+# This function works out the feed override bytes that take the laser from one override to another,
+# in percent. Returns the list of bytes to send with send_realtime().
+def feed_override_commands(current, target):
+    target = max(FEED_OVERRIDE_MIN, min(FEED_OVERRIDE_MAX, int(round(target))))
+    if target == 100:
+        return [RT_FEED_100]
+    commands = []
+    if abs(target - 100) < abs(target - current):
+        commands.append(RT_FEED_100)
+        current = 100
+    while target - current >= 10:
+        commands.append(RT_FEED_PLUS_10)
+        current += 10
+    while current - target >= 10:
+        commands.append(RT_FEED_MINUS_10)
+        current -= 10
+    commands += [RT_FEED_PLUS_1 if target > current else RT_FEED_MINUS_1]*abs(target - current)
+    return commands
+
+#-----------------------------------------------------------------------------------------------
+
+# This function sends lines the original way: ask "Ready?", wait for "Ready", then send one line.
+def send_handshake(ComPort, data, echo = False):
+    for line in data:
+        line = clean_line(line)
+        if line == '':
+            continue
+
+        #Ask the microcontroller if it's ready for data, and wait for it to say so
+        ComPort.write("Ready?\0")
+        while ComPort.read() != 'Ready\n':
+            pass
+
+        #The original host waits a little before sending the line
+        time.sleep(0.010)
+        ComPort.write(line + '\0')
+        if echo:
+            print(line)
+
+
+# This function streams lines using character counting. Returns a list of (line, error code) for
+# every line that the laser answered with an error.
+def send_streaming(ComPort, data, rx_size = RX_BUFFER_SIZE, echo = False):
+    in_flight = deque()         #Lines sent but not answered yet, oldest first
+    in_flight_bytes = 0
+    errors = []
+    reset = False
+
+    def wait_for_answer():
+        nonlocal in_flight_bytes, reset
+        answered, value = read_answer(ComPort)
+        if not answered:
+            #The laser was reset and threw away every line it hadn't answered; they never will be
+            if is_reset(value):
+                print('Laser was reset: %d lines sent were not run, and the rest were not sent' % len(in_flight))
+                in_flight.clear()
+                in_flight_bytes = 0
+                reset = True
+            #Other messages, like error text, don't answer a line
+            elif echo:
+                print(value)
+            return
+        line = in_flight.popleft()
+        in_flight_bytes -= len(line) + 1
+        if value != 0:
+            errors.append((line, value))
+            print('error:%d on line "%s"' % (value, line))
+
+    for line in data:
+        line = clean_line(line)
+        if line == '':
+            continue
+        if len(line) >= LINE_BUFFER_SIZE:
+            print('Line too long for the laser, skipped: "%s"' % line)
+            continue
+
+        #Wait until there is room for the line in the laser's receive buffer
+        while in_flight_bytes + len(line) + 1 > rx_size:
+            wait_for_answer()
+        if reset:
+            break
+
+        ComPort.write(line + '\n')
+        in_flight.append(line)
+        in_flight_bytes += len(line) + 1
+        if echo:
+            print(line)
+
+    #Wait for the last lines to be used
+    while in_flight:
+        wait_for_answer()
+
+    return errors
+
+
+# This function streams lines using character counting, with line numbers and checksums so that
+# any line hurt on the way is sent again. Returns a list of (line, error code) for every line the
+# laser ran but answered with an error (like an unsupported gcode).
+#   The first line sent is "N0 M110 N0", which starts the count, and the last is an empty line with
+#   the next number. That one is only sent once everything else is answered, and only gets an
+#   "ok" if the laser really has every line before it, so the host can't finish early if a
+#   corrupted line ending made the laser answer more or fewer times than the host sent lines.
+def send_numbered(ComPort, data, rx_size = RX_BUFFER_SIZE, echo = False):
+    #A line which doesn't fit in the laser's line buffer with its number and checksum would be
+    #rejected every time it was sent, so it is skipped, and the lines after it take its number
+    lines = ['M110 N0']
+    messages = [add_checksum(0, lines[0])]
+    for line in data:
+        line = clean_line(line)
+        if line == '':
+            continue
+        message = add_checksum(len(lines), line)
+        if len(message) >= LINE_BUFFER_SIZE:
+            print('Line too long for the laser, skipped: "%s"' % line)
+            continue
+        lines.append(line)
+        messages.append(message)
+    lines.append('')
+    messages.append(add_checksum(len(lines) - 1, ''))
+
+    in_flight = deque()             #(line number, bytes, rewind count) for lines not answered yet
+    in_flight_bytes = 0
+    next_line = 0
+    rewinds = 0                     #Times we've gone back to resend; answers from before a rewind are ignored
+    resend = None                   #Line the laser asked for, waiting for the error answer that goes with it
+    errors = []
+    resent_lines = 0
+
+    def rewind_to(number):
+        nonlocal next_line, rewinds, resent_lines
+        resent_lines += next_line - number
+        next_line = number
+        rewinds += 1
+
+    while next_line < len(messages) or in_flight:
+        #Send the next line if it fits. The last line waits until everything else is answered.
+        if next_line < len(messages) and not (next_line == len(messages) - 1 and in_flight):
+            message = messages[next_line]
+            if in_flight_bytes + len(message) + 1 <= rx_size:
+                ComPort.write(message + '\n')
+                in_flight.append((next_line, len(message) + 1, rewinds))
+                in_flight_bytes += len(message) + 1
+                next_line += 1
+                continue
+
+        reply = ComPort.read()
+        if reply == '':
+            #Answers went missing (a line ending was corrupted so two lines arrived as one): start
+            #again from the oldest line that hasn't been answered. Lines already run just get "ok".
+            if in_flight:
+                rewind_to(min(number for number, _, _ in in_flight))
+            in_flight.clear()
+            in_flight_bytes = 0
+            continue
+
+        if reply.startswith('Resend:'):
+            resend = int(reply[7:])
+            continue
+
+        #The laser was reset and threw away every line it hadn't answered; stop the job
+        if is_reset(reply):
+            print('Laser was reset: %d lines sent were not run, and the rest were not sent' % len(in_flight))
+            in_flight.clear()
+            in_flight_bytes = 0
+            next_line = len(messages)
+            resend = None
+            continue
+
+        answered, value = parse_answer(reply)
+        if not answered:
+            if echo:
+                print(value)
+            continue
+        if not in_flight:
+            continue                #Extra answer for a line that was split in two
+        number, length, sent_rewinds = in_flight.popleft()
+        in_flight_bytes -= length
+
+        #A line too long (two lines joined by a hurt line ending) comes with a Resend too
+        if value in (CHECKSUM_ERROR, LINE_NUMBER_ERROR) or (value == LINE_LENGTH_ERROR and resend is not None):
+            if number == 0:
+                #The laser still has the count from the last job; start it again
+                rewind_to(0)
+            elif resend is not None and sent_rewinds == rewinds:
+                rewind_to(resend)
+            resend = None
+        elif value != 0:
+            errors.append((lines[number], value))
+            print('error:%d on line %d "%s"' % (value, number, lines[number]))
+        elif echo and sent_rewinds == rewinds:
+            print(lines[number])
+
+    if resent_lines:
+        print('%d lines were sent again' % resent_lines)
+    return errors
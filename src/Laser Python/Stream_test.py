@@ -0,0 +1,155 @@
+#-----------------------------------------------------------------------------------------------
+# This file tests the streaming functions in Stream_coms.py against the simulated laser in
+# Stream_benchmark.py, over a pty. Unlike the benchmark, which prints how fast each way goes, every
+# test here passes or fails:
+#
+#   Loopback: with nothing going wrong on the link, every line sent is answered exactly once, the
+#   laser runs every line once and in order, and no answer is left over when the host is done.
+#
+#   Error injection: numbered lines given bit errors on the way to the laser are rejected, asked
+#   for again with "Resend:", and run once they come through right, so the laser still runs every
+#   line once and in order.
+#
+#   Soft reset: when the laser throws away the lines it hasn't used and says "[RX:128]" again, the
+#   host stops waiting on them and stops sending the job.
+#
+# Run it with:
+#   python3 -m unittest Stream_test
+#-----------------------------------------------------------------------------------------------
+
+import os
+import pty
+import random
+import tty
+import unittest
+
+import Binary_coms as bc
+import Stream_benchmark as sb
+import Stream_coms as stc
+
+TEST_LINES = 400            # Lines of the test path to send; enough to fill the buffers many times
+
+
+# This class is a pty_coms that counts the lines the host writes and the answers it reads.
+class counting_coms(sb.pty_coms):
+    def __init__(self, fd, timeout = 0.5):
+        super().__init__(fd, timeout)
+        self.lines_written = 0
+        self.answers_read = 0
+
+    def write(self, Data_to_write):
+        self.lines_written += Data_to_write.count('\n')
+        super().write(Data_to_write)
+
+    def read(self):
+        reply = super().read()
+        if stc.parse_answer(reply)[0]:
+            self.answers_read += 1
+        return reply
+
+
+# This function sends lines to the simulated laser with one of the functions in Stream_coms.py.
+# Returns the host's port, the simulated laser, what the send function returned, and anything
+# the laser sent after the host was done.
+def loopback(send_function, data, **laser_args):
+    master, slave = pty.openpty()
+    tty.setraw(master)
+    tty.setraw(slave)
+    laser = sb.simulated_laser(slave, **laser_args)
+    laser.start()
+
+    ComPort = counting_coms(master)
+    ComPort.read()                  # [RX:128] banner
+    result = send_function(ComPort, data)
+    left_over = ComPort.read()
+
+    laser.running = False
+    laser.join()
+    os.close(master)
+    os.close(slave)
+    return ComPort, laser, result, left_over
+
+
+# This class checks that every line is answered exactly once when nothing goes wrong.
+class test_loopback(unittest.TestCase):
+    def setUp(self):
+        self.data = [stc.clean_line(line) for line in bc.test_path()[:TEST_LINES]]
+
+    # Character counting: one "ok" per line, and the receive buffer never overflows
+    def test_streaming(self):
+        ComPort, laser, errors, left_over = loopback(stc.send_streaming, self.data)
+        self.assertEqual(errors, [])
+        self.assertEqual(ComPort.lines_written, len(self.data))
+        self.assertEqual(laser.lines_used, len(self.data))
+        self.assertEqual(ComPort.answers_read, len(self.data))
+        self.assertEqual(left_over, '')
+        self.assertEqual(laser.ran, self.data)
+        self.assertEqual(laser.overflows, 0)
+
+    # Numbered lines: the "M110 N0" before the job and the empty line after it are answered too
+    def test_numbered(self):
+        ComPort, laser, errors, left_over = loopback(stc.send_numbered, self.data)
+        self.assertEqual(errors, [])
+        self.assertEqual(ComPort.lines_written, len(self.data) + 2)
+        self.assertEqual(laser.lines_used, len(self.data) + 2)
+        self.assertEqual(ComPort.answers_read, len(self.data) + 2)
+        self.assertEqual(left_over, '')
+        self.assertEqual(laser.ran, self.data)
+        self.assertEqual(laser.overflows, 0)
+
+
+# This class checks that lines hurt on the way are sent again until the laser takes them.
+class test_error_injection(unittest.TestCase):
+    def setUp(self):
+        self.data = [stc.clean_line(line) for line in bc.test_path()[:TEST_LINES]]
+
+    # A bit error in chosen lines, two of them one after the other: each is asked for again and
+    # then run, and nothing is run twice or left out. The second of the two is rejected anyway,
+    # as the line before it is missing, so only the first of them is asked for by its own number.
+    def test_corrupted_lines(self):
+        corrupt_lines = (3, 40, 41, 250)
+        ComPort, laser, errors, left_over = loopback(stc.send_numbered, self.data,
+                                                     corrupt_lines = corrupt_lines)
+        self.assertEqual(len(laser.corrupted_lines), len(corrupt_lines))
+        for index, line in zip(corrupt_lines, laser.corrupted_lines):
+            if index - 1 not in corrupt_lines:
+                self.assertIn(int(line[1:].split(' ')[0]), laser.resends)
+        self.assertEqual(errors, [])
+        self.assertEqual(left_over, '')
+        self.assertEqual(laser.ran, self.data)
+
+    # Random bit errors in the bytes, which can hit line endings too. Two flips of the same bit in
+    # one line get past the XOR checksum, so only the number of lines run is checked.
+    def test_random_errors(self):
+        random.seed(507)
+        ComPort, laser, errors, left_over = loopback(stc.send_numbered, self.data, error_rate = 1e-3)
+        self.assertGreater(laser.corrupted, 0)
+        self.assertGreater(len(laser.resends), 0)
+        self.assertEqual(left_over, '')
+        self.assertEqual(len(laser.ran), len(self.data))
+
+
+# This class checks what the host does when the laser is reset in the middle of a job.
+class test_soft_reset(unittest.TestCase):
+    def setUp(self):
+        self.data = [stc.clean_line(line) for line in bc.test_path()[:TEST_LINES]]
+
+    # Character counting: the lines thrown away are never answered, so the host has to stop
+    # waiting on them by itself. Lines already on the way when the laser was reset may still run.
+    def test_streaming(self):
+        ComPort, laser, errors, left_over = loopback(stc.send_streaming, self.data, reset_after = 100)
+        self.assertEqual(errors, [])
+        self.assertEqual(laser.ran[:100], self.data[:100])
+        self.assertLess(ComPort.lines_written, len(self.data))
+        self.assertLess(len(laser.ran), len(self.data))
+
+    # Numbered lines: the laser forgets the line count too, so no line sent after the reset runs
+    def test_numbered(self):
+        ComPort, laser, errors, left_over = loopback(stc.send_numbered, self.data, reset_after = 100)
+        self.assertEqual(errors, [])
+        self.assertEqual(laser.ran, self.data[:99])
+        self.assertLess(ComPort.lines_written, len(self.data))
+
+
+if __name__ == '__main__':
+    unittest.main()
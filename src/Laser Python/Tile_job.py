@@ -0,0 +1,86 @@
+#-----------------------------------------------------------------------------------------------
+# This file lays out many copies of one shape, either by sending every copy in full or by
+# defining the shape once as a subprogram and calling it for each copy (see subprogram.h in the
+# firmware), and compares the bytes each way puts on the serial link.
+#
+# A subprogram is defined with O<n> ... M99, with positions relative to its own origin, and
+# called with M98 P<n> X<x> Y<y> R<degrees> Q<scale>.
+#
+# Run it by itself to see the comparison for a 50 copy layout:
+#   python3 Tile_job.py
+#-----------------------------------------------------------------------------------------------
+
+import math
+
+import Binary_coms as bc
+import Stream_coms as stc
+
+
+# This function makes a test shape like a small logo: a star inside a ring, about 20 mm across.
+# Returns a list of (X, Y, cutting) points relative to the shape's origin.
+def logo_shape():
+    points = [(10.0, 0.0, False)]
+    for step in range(1, 73):
+        angle = 2*math.pi*step/72
+        points.append((10*math.cos(angle), 10*math.sin(angle), True))
+    points.append((0.0, 8.0, False))
+    for step in range(1, 11):
+        angle = math.pi/2 + math.pi*step/5
+        r = 8 if step % 2 == 0 else 3.5
+        points.append((r*math.cos(angle), r*math.sin(angle), True))
+    return points
+
+
+# This function writes the gcode for a shape placed at an offset, turned and scaled.
+def shape_lines(points, X = 0, Y = 0, angle = 0, scale = 1, S = 1.0, F = 900):
+    c = scale*math.cos(math.radians(angle))
+    s = scale*math.sin(math.radians(angle))
+    lines = []
+    for x, y, cutting in points:
+        px = X + c*x - s*y
+        py = Y + s*x + c*y
+        if cutting:
+            lines.append('G1 X%.3f Y%.3f S%.2f F%d' % (px, py, S, F))
+        else:
+            lines.append('G0 X%.3f Y%.3f' % (px, py))
+    return lines
+
+
+# This function lays out copies by sending every one of them in full.
+def tile_full(points, places):
+    data = ['G21', 'G90', 'M3']
+    for X, Y, angle, scale in places:
+        data += shape_lines(points, X, Y, angle, scale)
+    return data + ['M5', 'M2']
+
+
+# This function lays out copies by defining the shape once and calling it for each copy.
+def tile_subprogram(points, places, number = 1):
+    data = ['G21', 'G90', 'M3', 'O%d' % number] + shape_lines(points) + ['M99']
+    for X, Y, angle, scale in places:
+        call = 'M98 P%d X%g Y%g' % (number, X, Y)
+        if angle != 0:
+            call += ' R%g' % angle
+        if scale != 1:
+            call += ' Q%g' % scale
+        data.append(call)
+    return data + ['M5', 'M2']
+
+
+# This function counts the bytes the lines take on the link, after clean_line() and with the
+# newline each one is sent with.
+def link_bytes(data):
+    return sum(len(stc.clean_line(line)) + 1 for line in data if stc.clean_line(line) != '')
+
+
+if __name__ == '__main__':
+    points = logo_shape()
+    #50 copies on a 5 x 10 grid, every other one turned upside down
+    places = [(15 + 25*(i % 10), 15 + 25*(i // 10), 180*(i % 2), 1) for i in range(50)]
+
+    full = link_bytes(tile_full(points, places))
+    subprogram = link_bytes(tile_subprogram(points, places))
+    print('%d copies of a %d move shape' % (len(places), len(points)))
+    print('Every copy sent in full:  %7d bytes  %5.1f s at 115200 baud' % (full, full/bc.BYTES_PER_SECOND))
+    print('Subprogram and calls:     %7d bytes  %5.1f s at 115200 baud' % (subprogram, subprogram/bc.BYTES_PER_SECOND))
+    print('Bytes sent:               %.1f%% of full, %.0fx fewer' % (100*subprogram/full, full/subprogram))
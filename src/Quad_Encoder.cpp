@@ -13,6 +13,7 @@
  */
 
 #include "Quad_Encoder.h"
+#include <new>
 
 
 
@@ -59,8 +60,8 @@ Quad_Encoder::Quad_Encoder(uint8_t enc_sigpin_A, uint8_t enc_sigpin_B, uint8_t e
     //           Available from - https://github.com/spluttflob/ME507-Support/tree/master/examples/encoder_counter.cpp
     //           Read the Documentation here -  https://spluttflob.github.io/ME507-Support/classSTM32Encoder.html
 
-    // new hardware timer class instance using user-inputted TIMx.
-    EncTmr = new HardwareTimer(_p_eTIM);
+    // new hardware timer class instance using user-inputted TIMx, made in this object's memory instead of the heap
+    EncTmr = new (_timer_memory) HardwareTimer(_p_eTIM);
     
     // Pause the timer to keep it from counting while we are trying to set it up.
     EncTmr -> pause();
@@ -130,15 +131,15 @@ int32_t Quad_Encoder::enc_read(void)
     // Get the current count
     count = EncTmr -> getCount();
     
-    // positive overflow condition for counting up from 0 to 65535 
+    // positive overflow condition for counting up from 65535 to 0; the step from 65535 to 0 is a count too
     if ((_lastcount > TMR_COUNT_MAX - _bound) && (count < _bound))
     {
-        delta = (TMR_COUNT_MAX - _lastcount + count);
+        delta = (TMR_COUNT_MAX + 1 - _lastcount + count);
     }
-    // negative overflow condition for counting down from 65535 to 0
+    // negative overflow condition for counting down from 0 to 65535
     else if ((count > TMR_COUNT_MAX - _bound) && (_lastcount < _bound))
     {
-        delta = -1*(TMR_COUNT_MAX - count + _lastcount);
+        delta = -1*(TMR_COUNT_MAX + 1 - count + _lastcount);
     }
     // no overflow, delta is simply the difference between the current and last counts
     else 
@@ -49,6 +49,7 @@ class Quad_Encoder
     // NOTE: Please ensure that the hardware timer you have selected has at least 2 timer channels!
     TIM_TypeDef *_p_eTIM;      ///< pointer that contains user passed-in timer object (TIM1, TIM2, etc)
     HardwareTimer *EncTmr;     ///< Instance of Hardware Timer class used for an instance of the encoder class
+    alignas(HardwareTimer) uint8_t _timer_memory[sizeof(HardwareTimer)]; ///< Where @c EncTmr is made, so it isn't on the heap
     
     // Count Variables:
     uint16_t _lastcount;       ///< the previous count from the timer counter register
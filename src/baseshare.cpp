@@ -37,6 +37,9 @@
 // Set pointer to most recently created shared data item to initially be NULL
 BaseShare* BaseShare::p_newest = NULL;
 
+// No shared data items have been numbered for the trace yet
+uint8_t BaseShare::trace_count = 0;
+
 
 /** @brief   Construct a base shared data item.
  *  @details This default constructor saves the name of the shared data item. 
@@ -59,6 +62,13 @@ BaseShare::BaseShare (const char* p_name)
         strcpy (name, "(No Name)");
     }
 
+    // Nothing has been done with it yet
+    memset (&stats, 0, sizeof (stats));
+    stats.kind = "share";
+
+    // Number it for the trace
+    trace_id = ++trace_count;
+
     // Install this share in the linked list of shares
     p_next = p_newest;
     p_newest = this;
@@ -38,6 +38,28 @@
 #include <Arduino.h>
 
 
+/** @brief   Counts of what has been done with a share or queue.
+ *  @details Each kind of share counts what it can: a queue or ring counts 
+ *           the items put in and taken out, the ones which couldn't be (the
+ *           wait ran out), and the time tasks spent blocked waiting for room
+ *           or for an item. A share counts its writes and reads. Counts from
+ *           tasks on the same side of a queue aren't protected from each 
+ *           other, so one can now and then be lost, like @c max_full. 
+ */
+struct share_stats
+{
+    const char* kind;                       ///< "queue", "ring", "share"...
+    uint32_t puts;                          ///< Items put in, or writes
+    uint32_t gets;                          ///< Items taken out, or reads
+    uint32_t failed_puts;                   ///< Puts which timed out
+    uint32_t failed_gets;                   ///< Gets which timed out
+    uint32_t put_wait_us;                   ///< Time blocked waiting for room
+    uint32_t get_wait_us;                   ///< Time blocked waiting for items
+    uint16_t most;                          ///< Most items it has held
+    uint16_t size;                          ///< Items it can hold; 0 if one
+};
+
+
 /** @brief   Base class for classes that share data in a thread-safe manner 
  *           between tasks.
  *  @details This is a base class for classes which share data between tasks
@@ -71,10 +93,69 @@ class BaseShare
          */
         static BaseShare* p_newest;
 
+        /** @brief   What has been done with this shared item.
+         *  @details Descendent classes count into this; see @c share_stats.
+         */
+        share_stats stats;
+
+        /** @brief   Number of this shared item in the trace.
+         *  @details Items are numbered from 1 in the order they are made, 
+         *           and queues and rings record their puts and gets in the 
+         *           trace with it (see trace.h).
+         */
+        uint8_t trace_id;
+
+        /** @brief   Number of shared items made so far, for @c trace_id.
+         */
+        static uint8_t trace_count;
+
     public:
         // Construct a base shared data item
         BaseShare (const char* p_name = NULL);
 
+        /** @brief   Get the counts of what has been done with this item.
+         *  @details Descendent classes which keep some counts elsewhere, such
+         *           as a queue's @c max_full, override this to fill them in.
+         *  @param   copy Filled with the counts
+         */
+        virtual void get_stats (share_stats& copy)
+        {
+            copy = stats;
+        }
+
+        /** @brief   Get the name of this shared item.
+         *  @return  The name, up to 15 characters
+         */
+        const char* get_name (void)
+        {
+            return name;
+        }
+
+        /** @brief   Get the number of this shared item in the trace.
+         *  @return  The number, from 1
+         */
+        uint8_t get_trace_id (void)
+        {
+            return trace_id;
+        }
+
+        /** @brief   Get the item made before this one, to go through them all.
+         *  @return  The next item in the list, or @c NULL at the end
+         */
+        BaseShare* get_next (void)
+        {
+            return p_next;
+        }
+
+        /** @brief   Get the most recently made shared item, which starts the
+         *           list of them all.
+         *  @return  The newest item, or @c NULL if none has been made
+         */
+        static BaseShare* get_newest (void)
+        {
+            return p_newest;
+        }
+
         /** @brief   Print one shared data item within a list.
          *  @details Make a printout showing the condition of this shared data
          *           item, such as the value of a shared variable or how full a
@@ -0,0 +1,445 @@
+/** @file       benchmark_tasks.cpp
+ *  @brief      This file contains the tasks which time the ways of passing data between tasks.
+ *  @details    Each operation is timed on its own, so the results give both the operations a second and the
+ *              slowest single operation, which is what holds up the control loop. Timing an operation adds the
+ *              time to read the clock to it, the same for every container.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include "libraries&constants.h"
+#include "benchmark_tasks.h"
+
+#if !(defined STM32L4xx || defined STM32F4xx)
+    #include <thread>
+#endif
+
+
+///@cond
+/// Timing of one kind of operation
+struct benchmark_result
+{
+    uint32_t ops = 0;                   // Operations timed
+    uint64_t total = 0;                 // Clock counts they took together
+    uint32_t worst = 0;                 // Clock counts the slowest one took
+};
+
+/// How long reads took: reads in bucket n took under 2^(n + 5) ns, and the last bucket holds the rest
+struct benchmark_histogram
+{
+    uint32_t reads = 0;                                 // Reads timed
+    uint32_t contended = 0;                             // Reads which had to try again
+    uint32_t buckets[BENCHMARK_LATENCY_BUCKETS] = {};   // Reads in each range of times
+};
+
+/// The ring timed against the ramp segment queue
+typedef spsc_ring<ramp_segment_coefficients, RAMP_COEFF_Q_SIZE> benchmark_ring_type;
+///@endcond
+
+
+// ==================================== Subfunctions ====================================
+
+#if (defined STM32L4xx || defined STM32F4xx)
+
+/** @brief      Start the core's cycle counter
+ */
+static void start_benchmark_clock(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/** @brief      Read the benchmark clock, which is the core's cycle counter on the board
+ *  @returns    Clock counts
+ */
+static inline uint32_t benchmark_clock(void)
+{
+    return DWT->CYCCNT;
+}
+
+/** @brief      Get how fast the benchmark clock counts
+ *  @returns    Counts a second
+ */
+static uint32_t benchmark_clock_rate(void)
+{
+    return SystemCoreClock;
+}
+
+#else
+
+/** @brief      Start the benchmark clock; the PC's clock is always running
+ */
+static void start_benchmark_clock(void)
+{
+}
+
+/** @brief      Read the benchmark clock, which is the PC's clock in nanoseconds on the host
+ *  @returns    Clock counts; only differences are used, so it may wrap
+ */
+static inline uint32_t benchmark_clock(void)
+{
+    return (uint32_t)ullTaskHostTime();
+}
+
+/** @brief      Get how fast the benchmark clock counts
+ *  @returns    Counts a second
+ */
+static uint32_t benchmark_clock_rate(void)
+{
+    return 1000000000;
+}
+
+#endif
+
+
+/** @brief      Add the time one operation took to a result
+ *  @param      result The result
+ *  @param      start The clock when the operation started
+ */
+static inline void add_time(benchmark_result &result, uint32_t start)
+{
+    uint32_t taken = benchmark_clock() - start;
+    result.ops++;
+    result.total += taken;
+    if (taken > result.worst)
+    {
+        result.worst = taken;
+    }
+}
+
+
+/** @brief      Print one result as operations a second, and the average and slowest operation in nanoseconds
+ *  @param      container What was timed
+ *  @param      operation The operation timed
+ *  @param      result The timing
+ */
+static void print_result(const char *container, const char *operation, const benchmark_result &result)
+{
+    uint64_t rate = benchmark_clock_rate();
+    uint32_t ops_per_sec = result.total > 0 ? (uint32_t)(result.ops*rate/result.total) : 0;
+    uint32_t average_ns = result.ops > 0 ? (uint32_t)(result.total*1000000000ULL/rate/result.ops) : 0;
+    uint32_t worst_ns = (uint32_t)(result.worst*1000000000ULL/rate);
+
+    char line[LINE_BUFFER_SIZE];
+    snprintf(line, sizeof(line), "%-6s %-12s %10lu ops/s %8lu ns avg %8lu ns worst\n", container, operation,
+             (unsigned long)ops_per_sec, (unsigned long)average_ns, (unsigned long)worst_ns);
+    print_serial(line);
+}
+
+
+/** @brief      Fill a container with segments and empty it again, timing each put and get
+ *  @details    Works with anything that has the @c Queue methods @c put(), @c is_empty() and @c get(). A get is
+ *              checked first with @c is_empty(), the way the control path takes segments.
+ *  @param      container The queue or ring
+ *  @param      put_time Timing of the puts
+ *  @param      get_time Timing of the checks and gets
+ */
+template <class container_type>
+static void time_fill_and_empty(container_type &container, benchmark_result &put_time, benchmark_result &get_time)
+{
+    ramp_segment_coefficients segment;
+    for (uint16_t round = 0; round < BENCHMARK_ROUNDS; round++)
+    {
+        for (uint16_t count = 0; count < RAMP_COEFF_Q_SIZE; count++)
+        {
+            segment.t0 = count;
+            uint32_t start = benchmark_clock();
+            container.put(segment);
+            add_time(put_time, start);
+        }
+        for (uint16_t count = 0; count < RAMP_COEFF_Q_SIZE; count++)
+        {
+            uint32_t start = benchmark_clock();
+            if (!container.is_empty())
+            {
+                container.get(segment);
+            }
+            add_time(get_time, start);
+        }
+    }
+}
+
+
+/** @brief      Fill the ring with segments and empty it again, timing each in-place take
+ *  @details    A take is @c front(), copying the segment out, then @c pop(), the way the control path does it.
+ *  @param      ring The ring
+ *  @param      take_time Timing of the takes
+ */
+static void time_ring_in_place(benchmark_ring_type &ring, benchmark_result &take_time)
+{
+    ramp_segment_coefficients segment;
+    for (uint16_t round = 0; round < BENCHMARK_ROUNDS; round++)
+    {
+        for (uint16_t count = 0; count < RAMP_COEFF_Q_SIZE; count++)
+        {
+            segment.t0 = count;
+            ring.put(segment);
+        }
+        for (uint16_t count = 0; count < RAMP_COEFF_Q_SIZE; count++)
+        {
+            uint32_t start = benchmark_clock();
+            ramp_segment_coefficients *p_front = ring.front();
+            if (p_front != NULL)
+            {
+                segment = *p_front;
+                ring.pop();
+            }
+            add_time(take_time, start);
+        }
+    }
+}
+
+
+/** @brief      Add the time one read took to a histogram
+ *  @param      histogram The histogram
+ *  @param      start The clock when the read started
+ */
+static inline void add_to_histogram(benchmark_histogram &histogram, uint32_t start)
+{
+    uint64_t taken_ns = (uint64_t)(benchmark_clock() - start)*1000000000ULL/benchmark_clock_rate();
+    uint8_t bucket = 0;
+    while (bucket < BENCHMARK_LATENCY_BUCKETS - 1 && taken_ns >= (32ULL << bucket))
+    {
+        bucket++;
+    }
+    histogram.buckets[bucket]++;
+    histogram.reads++;
+}
+
+
+/** @brief      Print a histogram of read times, one line for each range that has reads in it
+ *  @param      share What was timed
+ *  @param      histogram The histogram
+ */
+static void print_histogram(const char *share, const benchmark_histogram &histogram)
+{
+    char line[LINE_BUFFER_SIZE];
+    snprintf(line, sizeof(line), "%s: %lu reads, %lu contended\n", share, (unsigned long)histogram.reads,
+             (unsigned long)histogram.contended);
+    print_serial(line);
+    for (uint8_t bucket = 0; bucket < BENCHMARK_LATENCY_BUCKETS; bucket++)
+    {
+        if (histogram.buckets[bucket] == 0)
+        {
+            continue;
+        }
+        if (bucket < BENCHMARK_LATENCY_BUCKETS - 1)
+        {
+            snprintf(line, sizeof(line), "  < %7lu ns %10lu\n", (unsigned long)(32UL << bucket),
+                     (unsigned long)histogram.buckets[bucket]);
+        }
+        else
+        {
+            snprintf(line, sizeof(line), "  >=%7lu ns %10lu\n", (unsigned long)(32UL << (bucket - 1)),
+                     (unsigned long)histogram.buckets[bucket]);
+        }
+        print_serial(line);
+    }
+}
+
+
+/** @brief      Read a share over and over, timing each read
+ *  @details    Works with a @c Share or a @c seqlock_share of encoder outputs.
+ *  @param      share The share
+ *  @param      reads Reads to make
+ *  @param      histogram Where the times go
+ */
+template <class share_type>
+static void time_share_reads(share_type &share, uint32_t reads, benchmark_histogram &histogram)
+{
+    encoder_output sample;
+    for (uint32_t count = 0; count < reads; count++)
+    {
+        uint32_t start = benchmark_clock();
+        share.get(sample);
+        add_to_histogram(histogram, start);
+    }
+}
+
+
+/** @brief      Time reads of a share while it is written, and print how long they took
+ *  @details    On a PC, @c BENCHMARK_READERS threads read the share at once while another thread writes it as fast
+ *              as it can, so reads run into writes far more often than in the firmware. These are plain threads and
+ *              not tasks, so they really do run at the same time, on different cores. On the board, with one core,
+ *              a read can only run into a write that interrupts it, so this task reads and writes in turns, and the
+ *              times are those of the calls themselves.
+ *  @param      share The share
+ *  @param      name Its name, for the printout
+ *  @param      contended_reads A function which gets the reads which have had to try again so far
+ */
+template <class share_type, class count_type>
+static void time_share(share_type &share, const char *name, count_type contended_reads)
+{
+    benchmark_histogram total;
+    uint32_t contended_before = contended_reads();
+    encoder_output sample;
+
+#if (defined STM32L4xx || defined STM32F4xx)
+    for (uint32_t count = 0; count < BENCHMARK_READS; count++)
+    {
+        sample.time = count;
+        share.put(sample);
+        time_share_reads(share, 1, total);
+    }
+#else
+    std::atomic<bool> reading(true);
+    std::thread writer([&]
+    {
+        encoder_output written;
+        while (reading.load(std::memory_order_relaxed))
+        {
+            written.time += 1;
+            share.put(written);
+        }
+    });
+
+    benchmark_histogram histograms[BENCHMARK_READERS];
+    std::thread readers[BENCHMARK_READERS];
+    for (uint8_t reader = 0; reader < BENCHMARK_READERS; reader++)
+    {
+        readers[reader] = std::thread(time_share_reads<share_type>, std::ref(share), (uint32_t)BENCHMARK_READS,
+                                      std::ref(histograms[reader]));
+    }
+    for (uint8_t reader = 0; reader < BENCHMARK_READERS; reader++)
+    {
+        readers[reader].join();
+        total.reads += histograms[reader].reads;
+        for (uint8_t bucket = 0; bucket < BENCHMARK_LATENCY_BUCKETS; bucket++)
+        {
+            total.buckets[bucket] += histograms[reader].buckets[bucket];
+        }
+    }
+    reading.store(false);
+    writer.join();
+    (void)sample;
+#endif
+
+    total.contended = contended_reads() - contended_before;
+    print_histogram(name, total);
+}
+
+
+
+// ==================================== Tasks ====================================
+
+/** @brief      Task which times the ramp segment queue against the lock-free ring, then prints the results
+ *  @details    Both hold ramp segments and are the size of @c ramp_segment_coefficient_queue. Each is filled and
+ *              emptied @c BENCHMARK_ROUNDS times from this one task, so what is timed is the cost of each call and not
+ *              the wait for another task. The results are printed once, then the task sleeps.
+ *  @param      p_params A pointer to function parameters which we don't use.
+ */
+void task_benchmark_queues(void* p_params)
+{
+    (void)p_params;                   // Does nothing but shut up a compiler warning
+
+    // Made the first time here, so they only take up memory in a build which runs the benchmarks
+    static Queue<ramp_segment_coefficients> benchmark_queue(RAMP_COEFF_Q_SIZE, "Bench queue");
+    static benchmark_ring_type benchmark_ring("Bench ring");
+
+    start_benchmark_clock();
+
+    benchmark_result queue_put, queue_get, ring_put, ring_get, ring_take;
+    time_fill_and_empty(benchmark_queue, queue_put, queue_get);
+    time_fill_and_empty(benchmark_ring, ring_put, ring_get);
+    time_ring_in_place(benchmark_ring, ring_take);
+
+    print_serial("Ramp segments, queue against ring:\n");
+    print_result("queue", "put", queue_put);
+    print_result("queue", "check+get", queue_get);
+    print_result("ring", "put", ring_put);
+    print_result("ring", "check+get", ring_get);
+    print_result("ring", "front+pop", ring_take);
+
+    for (;;)
+    {
+        vTaskDelay(1000);
+    }
+}
+
+
+/** @brief      Task which times reads of a @c Share against a @c seqlock_share of encoder outputs, then prints them
+ *  @details    Prints a histogram of read times for each, and how many reads of the @c seqlock_share had to try
+ *              again because of a write; a @c Share waits for the write instead, so it has none. See
+ *              @c time_share() for how the reads and writes are made. The results are printed once, then the task
+ *              sleeps.
+ *  @param      p_params A pointer to function parameters which we don't use.
+ */
+void task_benchmark_shares(void* p_params)
+{
+    (void)p_params;                   // Does nothing but shut up a compiler warning
+
+    // Made the first time here, so they only take up memory in a build which runs the benchmarks
+    static Share<encoder_output> benchmark_share("Bench share");
+    static seqlock_share<encoder_output> benchmark_seqlock("Bench seqlock");
+
+    start_benchmark_clock();
+
+    print_serial("Encoder samples, share against seqlock share:\n");
+    time_share(benchmark_share, "share", []{ return (uint32_t)0; });
+    time_share(benchmark_seqlock, "seqlock", []{ return benchmark_seqlock.contended_reads(); });
+
+    for (;;)
+    {
+        vTaskDelay(1000);
+    }
+}
+
+
+/** @brief      Task which times moving items through a @c Queue one at a time against many at a time
+ *  @details    For queue sizes from @c BENCHMARK_BULK_SMALLEST up to @c BENCHMARK_BULK_LARGEST, doubling, a queue of
+ *              that size is filled and emptied over and over, first with @c put() and @c get() on each item, then
+ *              with one @c put_n() and one @c get_n() for the whole queue. Prints the items a second each way. The
+ *              queues are made when the task runs, and kept. The results are printed once, then the task sleeps.
+ *  @param      p_params A pointer to function parameters which we don't use.
+ */
+void task_benchmark_bulk(void* p_params)
+{
+    (void)p_params;                   // Does nothing but shut up a compiler warning
+
+    static uint32_t items[BENCHMARK_BULK_LARGEST];
+    char line[LINE_BUFFER_SIZE];
+
+    start_benchmark_clock();
+
+    print_serial("Queue items a second, one at a time against put_n/get_n:\n");
+    for (uint16_t size = BENCHMARK_BULK_SMALLEST; size <= BENCHMARK_BULK_LARGEST; size *= 2)
+    {
+        Queue<uint32_t> *p_queue = new Queue<uint32_t>(size, "Bench bulk");
+        uint32_t rounds = BENCHMARK_BULK_ITEMS/size;
+
+        uint32_t start = benchmark_clock();
+        for (uint32_t round = 0; round < rounds; round++)
+        {
+            for (uint16_t index = 0; index < size; index++)
+            {
+                p_queue->put(items[index]);
+            }
+            for (uint16_t index = 0; index < size; index++)
+            {
+                p_queue->get(items[index]);
+            }
+        }
+        uint32_t single_time = benchmark_clock() - start;
+
+        start = benchmark_clock();
+        for (uint32_t round = 0; round < rounds; round++)
+        {
+            p_queue->put_n(items, size, 0);
+            p_queue->get_n(items, size, 0);
+        }
+        uint32_t bulk_time = benchmark_clock() - start;
+
+        uint64_t moved = (uint64_t)rounds*size*benchmark_clock_rate();
+        snprintf(line, sizeof(line), "size %3u: %10lu single %10lu bulk\n", size,
+                 (unsigned long)(single_time > 0 ? moved/single_time : 0),
+                 (unsigned long)(bulk_time > 0 ? moved/bulk_time : 0));
+        print_serial(line);
+    }
+
+    for (;;)
+    {
+        vTaskDelay(1000);
+    }
+}
@@ -0,0 +1,44 @@
+/** @file       benchmark_tasks.h
+ *  @brief      This file contains the header for the tasks which time the ways of passing data between tasks.
+ *  @details    The benchmarks are run with the @c TEST_BENCHMARK section of main.cpp, on the board or on a PC with
+ *              the native build (see platformio.ini). On the board they are timed with the core's cycle counter, and
+ *              on a PC with its clock, so they must not be run on virtual time (@c LASER_VIRTUAL), which would only
+ *              show the costs charged to it.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef BENCHMARK_TASKS_H
+#define BENCHMARK_TASKS_H
+
+#include "libraries&constants.h"
+
+
+// Times each container is filled and emptied in a benchmark
+#define BENCHMARK_ROUNDS 2000
+
+// Reads of each share timed by each reader, and reader threads on a PC
+#define BENCHMARK_READS 200000
+#define BENCHMARK_READERS 3
+
+// Ranges of read times in a histogram, doubling from under 32 ns
+#define BENCHMARK_LATENCY_BUCKETS 12
+
+// Sizes of the queues moved through one at a time and in bulk, doubling, and the items moved through each
+#define BENCHMARK_BULK_SMALLEST 8
+#define BENCHMARK_BULK_LARGEST 256
+#define BENCHMARK_BULK_ITEMS 65536
+
+
+// Time the ramp segment queue against the lock-free ring, then print the results
+void task_benchmark_queues(void* p_params);
+
+// Time reads of an encoder share against the seqlock share while they are written, then print the results
+void task_benchmark_shares(void* p_params);
+
+// Time moving items through queues of several sizes one at a time against in bulk, then print the results
+void task_benchmark_bulk(void* p_params);
+
+
+#endif //BENCHMARK_TASKS_H
@@ -0,0 +1,234 @@
+/** @file       binary_protocol.cpp
+ *  @brief      This file contains the decoder for binary motion frames sent by the host instead of text gcode.
+ *  @details    The frame layout is described in binary_protocol.h. The decoder turns each frame straight into an
+ *              @c XYSFvalues struct, so the translate task can send it to the ramp queue without parsing any text.
+ *
+ *  @date    10-19-2026 File Created
+ *
+*/
+
+#include "libraries&constants.h"
+
+
+// ========================================  Class: binary_decoder ========================================
+
+/** @brief      Constructor for the binary_decoder class
+ */
+binary_decoder::binary_decoder(void)
+{
+    reset();
+}
+
+
+/** @brief      Start over at the beginning of a binary stream
+ *  @details    Called when the host sends @c $B. The sequence number starts at 0 and the first move has to be
+ *              absolute, since the position here may not match what the host thinks it is.
+ */
+void binary_decoder::reset(void)
+{
+    _frame_length = 0;
+    _expected_length = 0;
+    _X_fixed = 0;
+    _Y_fixed = 0;
+    _XYSFval.X = 0;         _XYSFval.S = 0;
+    _XYSFval.Y = 0;         _XYSFval.F = get_setting(SETTING_TRAVEL_SPEED);
+    _travel = false;
+    _position_known = false;
+    _next_seq = 0;
+}
+
+
+/** @brief      Feed one byte from the serial port into the decoder
+ *  @details    Bytes before a @c BIN_SYNC byte are thrown away, so the decoder finds the start of the next frame by
+ *              itself after noise or a dropped byte. Once a whole frame is in, its CRC and sequence number are
+ *              checked and it is decoded.
+ *  @param      byte The byte read from the serial port
+ *  @returns    One of @c BIN_FRAME_NONE, @c BIN_FRAME_MOVE, @c BIN_FRAME_END or @c BIN_FRAME_ERROR
+ */
+uint8_t binary_decoder::feed(uint8_t byte)
+{
+    //Wait for the start of a frame
+    if (_frame_length == 0 && byte != BIN_SYNC)
+    {
+        return BIN_FRAME_NONE;
+    }
+
+    _frame[_frame_length++] = byte;
+
+    //The opcode tells us how long the frame is
+    if (_frame_length == 2)
+    {
+        _expected_length = frame_length(byte);
+        if (_expected_length == 0)
+        {
+            _frame_length = 0;
+            return BIN_FRAME_ERROR;
+        }
+    }
+
+    if (_frame_length < 3 || _frame_length < _expected_length)
+    {
+        return BIN_FRAME_NONE;
+    }
+
+    //Whole frame is in: start looking for the next one whatever happens to this one
+    _frame_length = 0;
+
+    //CRC covers everything between the sync byte and the CRC itself
+    if (crc8(&_frame[1], _expected_length - 2) != _frame[_expected_length - 1])
+    {
+        return BIN_FRAME_ERROR;
+    }
+    if (_frame[2] != _next_seq)
+    {
+        return BIN_FRAME_ERROR;
+    }
+
+    //The sequence number only moves on for a frame that is used
+    uint8_t result = decode_frame();
+    if (result != BIN_FRAME_ERROR)
+    {
+        _next_seq++;
+    }
+    return result;
+}
+
+
+/** @brief      Find the full length of a frame from its opcode byte
+ *  @param      opcode The opcode byte, with its flags
+ *  @returns    Number of bytes in the frame including the sync and CRC bytes, or 0 if the opcode isn't known
+ */
+uint8_t binary_decoder::frame_length(uint8_t opcode)
+{
+    switch (opcode & BIN_OP_MASK)
+    {
+        case BIN_OP_MOVE:
+            //sync + opcode + seq + crc, then the payload
+            return 4 + ((opcode & BIN_FLAG_ABS) ? 8 : 4) + ((opcode & BIN_FLAG_S) ? 1 : 0) + ((opcode & BIN_FLAG_F) ? 2 : 0);
+
+        case BIN_OP_END:
+            return 4;
+
+        default:
+            return 0;
+    }
+}
+
+
+/** @brief      Decode a frame that has passed its checks
+ *  @details    Travel moves go at the travel speed setting with the laser off, just like a G0 line, but they don't change the
+ *              S and F that following cutting moves use. A relative move before any absolute one would be taken
+ *              from 0,0, which isn't where the host thinks the head is, so it is rejected without changing anything.
+ *  @returns    @c BIN_FRAME_MOVE, @c BIN_FRAME_END or @c BIN_FRAME_ERROR
+ */
+uint8_t binary_decoder::decode_frame(void)
+{
+    uint8_t opcode = _frame[1];
+    if ((opcode & BIN_OP_MASK) == BIN_OP_END)
+    {
+        return BIN_FRAME_END;
+    }
+    if (!(opcode & BIN_FLAG_ABS) && !_position_known)
+    {
+        return BIN_FRAME_ERROR;
+    }
+
+    //Payload starts after sync, opcode and sequence number. Everything is little endian.
+    uint8_t *payload = &_frame[3];
+    if (opcode & BIN_FLAG_ABS)
+    {
+        _X_fixed = (int32_t)((uint32_t)payload[0] | (uint32_t)payload[1] << 8 | (uint32_t)payload[2] << 16 | (uint32_t)payload[3] << 24);
+        _Y_fixed = (int32_t)((uint32_t)payload[4] | (uint32_t)payload[5] << 8 | (uint32_t)payload[6] << 16 | (uint32_t)payload[7] << 24);
+        _position_known = true;
+        payload += 8;
+    }
+    else
+    {
+        _X_fixed += (int16_t)(payload[0] | payload[1] << 8);
+        _Y_fixed += (int16_t)(payload[2] | payload[3] << 8);
+        payload += 4;
+    }
+
+    if (opcode & BIN_FLAG_S)
+    {
+        _XYSFval.S = payload[0];
+        payload += 1;
+    }
+    if (opcode & BIN_FLAG_F)
+    {
+        _XYSFval.F = (uint16_t)(payload[0] | payload[1] << 8);
+    }
+
+    _XYSFval.X = (float)_X_fixed / BIN_POS_SCALE;
+    _XYSFval.Y = (float)_Y_fixed / BIN_POS_SCALE;
+    _travel = opcode & BIN_FLAG_TRAVEL;
+
+    return BIN_FRAME_MOVE;
+}
+
+
+/** @brief      Get the XYSF values from the last move frame
+ *  @returns    The position, power and feedrate of the last move, with S and F set for travel if it was a travel move
+ */
+XYSFvalues binary_decoder::get_XYSF(void)
+{
+    XYSFvalues XYSF = _XYSFval;
+    if (_travel)
+    {
+        XYSF.S = 0;
+        XYSF.F = get_setting(SETTING_TRAVEL_SPEED);
+    }
+    return XYSF;
+}
+
+
+/** @brief      Check if the last move frame was a travel move
+ *  @returns    @c true for a travel (G0) move, @c false for a cutting (G1) move
+ */
+bool binary_decoder::is_travel(void)
+{
+    return _travel;
+}
+
+
+/** @brief      Get the sequence number of the last frame that was accepted
+ *  @returns    The sequence number, which the reader sends back to the host as the acknowledgement
+ */
+uint8_t binary_decoder::get_seq(void)
+{
+    return _next_seq - 1;
+}
+
+
+/** @brief      Get the sequence number that the next frame must have
+ *  @returns    The sequence number, which the host should resend from after a frame is rejected
+ */
+uint8_t binary_decoder::get_next_seq(void)
+{
+    return _next_seq;
+}
+
+
+
+// ======================================== Subfunctions ========================================
+
+/** @brief      Calculate the CRC-8 of some bytes
+ *  @details    Uses polynomial 0x07 (x^8 + x^2 + x + 1) with no reflection, bit by bit. Frames are short enough that
+ *              a lookup table isn't worth the 256 bytes of flash.
+ *  @param      data The bytes to calculate the CRC of
+ *  @param      length Number of bytes
+ *  @param      crc Starting value, so a CRC can be continued over more than one call
+ *  @returns    The CRC
+ */
+uint8_t crc8(const uint8_t *data, uint8_t length, uint8_t crc)
+{
+    for (uint8_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
@@ -0,0 +1,117 @@
+/** @file       binary_protocol.h
+ *  @brief      This file contains the header for the binary_protocol.cpp file, which decodes binary motion frames.
+ *  @details    The binary protocol is an alternative to sending text gcode. The host switches to it by sending the
+ *              line @c $B, then streams frames laid out like this:
+ *
+ *              | Byte      | Contents                                                          |
+ *              |-----------|-------------------------------------------------------------------|
+ *              | 0         | @c BIN_SYNC                                                       |
+ *              | 1         | Opcode (@c BIN_OP_MOVE or @c BIN_OP_END) ORed with @c BIN_FLAG_ bits  |
+ *              | 2         | Sequence number, counting up by one per frame (wraps at 255)      |
+ *              | 3...      | Payload: X and Y, then S if @c BIN_FLAG_S, then F if @c BIN_FLAG_F |
+ *              | last      | CRC-8 (polynomial 0x07) of the opcode, sequence number and payload|
+ *
+ *              X and Y are fixed point in units of 1/@c BIN_POS_SCALE mm, little endian. Normally they are
+ *              @c int16_t changes from the previous point; with @c BIN_FLAG_ABS they are @c int32_t absolute
+ *              positions. The first move after @c $B must be absolute; relative ones before it are rejected. S is
+ *              a @c uint8_t power in percent and F is a @c uint16_t feedrate in mm/min. A typical cutting move takes
+ *              8 bytes instead of about 28 for text.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef BINARY_PROTOCOL_H
+#define BINARY_PROTOCOL_H
+
+#include "libraries&constants.h"
+
+// ========================================== Constants ==========================================
+
+// First byte of every frame
+#define BIN_SYNC 0xA5
+
+// Opcodes (low nibble of the opcode byte)
+#define BIN_OP_MOVE 0x01
+#define BIN_OP_END 0x0F
+#define BIN_OP_MASK 0x0F
+
+// Flags (high nibble of the opcode byte)
+#define BIN_FLAG_TRAVEL 0x10        // G0 travel move instead of G1
+#define BIN_FLAG_ABS 0x20           // X and Y are absolute int32 positions instead of int16 changes
+#define BIN_FLAG_S 0x40             // An S byte follows X and Y
+#define BIN_FLAG_F 0x80             // Two F bytes follow S (or X and Y if there is no S)
+
+// Fixed point scale of X and Y: counts per mm
+#define BIN_POS_SCALE 100
+
+// Largest frame: sync, opcode, sequence, 2 x int32, S, F, CRC
+#define BIN_MAX_FRAME_SIZE 15
+
+// Queue of decoded moves between the reader and the translate task
+#define BIN_MOVE_Q_SIZE 32
+#define BIN_MOVE_Q_PAUSE_LIMIT 4
+
+// Results from binary_decoder::feed()
+#define BIN_FRAME_NONE 0            // Frame isn't finished yet
+#define BIN_FRAME_MOVE 1            // A move was decoded; get it with get_XYSF()
+#define BIN_FRAME_END 2             // The host is done with binary mode
+#define BIN_FRAME_ERROR 3           // Bad CRC, opcode, or sequence number, or a relative move before any
+                                    // absolute one; the frame should be resent
+
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which decodes binary motion frames one byte at a time.
+ *  @details    Bytes are fed in as they come off the serial port. The decoder keeps the last position in fixed point
+ *              so that a long run of relative moves doesn't pile up rounding error, and it keeps the last S and F so
+ *              frames only need to carry them when they change. Frames with a bad CRC or the wrong sequence number,
+ *              and relative moves before the first absolute one, are dropped without changing any of that state, so
+ *              the host can resend from the frame that failed.
+ */
+class binary_decoder
+{
+    protected:
+    uint8_t _frame[BIN_MAX_FRAME_SIZE];     // Bytes of the frame being received
+    uint8_t _frame_length;                  // Number of bytes received so far
+    uint8_t _expected_length;               // Full length of the frame, known once the opcode is in
+
+    int32_t _X_fixed;                       // Last X position in fixed point
+    int32_t _Y_fixed;                       // Last Y position in fixed point
+    XYSFvalues _XYSFval;                    // Last decoded values
+    bool _travel;                           // True if the last move was a travel move
+    bool _position_known;                   // True once an absolute move has come since reset()
+
+    uint8_t _next_seq;                      // Sequence number the next frame must have
+
+    // Find the full length of a frame from its opcode byte
+    uint8_t frame_length(uint8_t opcode);
+
+    // Decode a frame that has passed its checks
+    uint8_t decode_frame(void);
+
+    public:
+    // Constructor
+    binary_decoder(void);
+
+    // Start over at the beginning of a binary stream
+    void reset(void);
+
+    // Feed one byte from the serial port into the decoder
+    uint8_t feed(uint8_t byte);
+
+    // Get-er functions
+    XYSFvalues get_XYSF(void);
+    bool is_travel(void);
+    uint8_t get_seq(void);
+    uint8_t get_next_seq(void);
+};
+
+
+// =========================================== Functions ===========================================
+
+// CRC-8 (polynomial 0x07) used to check binary frames
+uint8_t crc8(const uint8_t *data, uint8_t length, uint8_t crc = 0);
+
+
+#endif //BINARY_PROTOCOL_H
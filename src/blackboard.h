@@ -0,0 +1,219 @@
+/** @file       blackboard.h
+ *  @brief      This file contains a share of a whole record, which any task reads in one call and any task changes
+ *              a field of at a time.
+ *  @details    State that several tasks write, like the machine's mode, timing mode and feed override, used to be
+ *              kept in a @c Share each. A task that needed several of them read them one at a time, with a critical
+ *              section each, and could see a mix from before and after another task changed them. A blackboard
+ *              keeps them in one record instead, with a version that counts up with every change.
+ *
+ *              Reading works like a @c seqlock_share, which this is built on: @c get() copies the whole record
+ *              without a critical section, so what a reader sees was all true at one instant. Unlike a
+ *              @c seqlock_share, any task may write. A write copies the newest record, changes it and points
+ *              readers at the new copy inside a critical section, so writes from different tasks can't lose each
+ *              other's changes:
+ *
+ *              | Method                  | Writes                                                              |
+ *              |-------------------------|---------------------------------------------------------------------|
+ *              | @c put()                | The whole record                                                    |
+ *              | @c update()             | One field, only if its value is different                           |
+ *              | @c compare_and_update() | One field, only if it still has the value the caller expects        |
+ *              | @c update_with()        | Whatever a function changes in the record, all in one version       |
+ *
+ *              @c update() first looks at the field without a critical section, so a task that sets the same
+ *              value every period (the laser power, say) only takes the critical section when it changes. An
+ *              @c update() or @c compare_and_update() that changes nothing doesn't make a new version, so
+ *              @c get_if_newer() only finds changes.
+ *
+ *              The function given to @c update_with() runs inside the critical section, so it must be short and
+ *              must not call FreeRTOS.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef BLACKBOARD_H
+#define BLACKBOARD_H
+
+#include <Arduino.h>
+#include "FreeRTOS.h"
+#include "seqlock_share.h"
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which shares a record any task reads whole and any task changes.
+ *  @details    See the top of this file.
+ */
+template <class DataType> class blackboard : public seqlock_share<DataType>
+{
+    protected:
+    using seqlock_share<DataType>::_copies;
+    using seqlock_share<DataType>::_sequence;
+
+    /** @brief      Get the copy readers are using, for a writer in the critical section
+     *  @returns    The newest record
+     */
+    DataType &newest(void) { return _copies[_sequence.load(std::memory_order_relaxed) & 1]; }
+
+    /** @brief      Write a record to the copy readers aren't using and point them at it; in the critical section
+     *  @param      new_data The record
+     */
+    void publish(const DataType &new_data)
+    {
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        _copies[(sequence + 1) & 1] = new_data;
+        _sequence.store(sequence + 1, std::memory_order_release);
+    }
+
+    public:
+    // Constructor
+    blackboard(const char *p_name = NULL);
+
+    // Write the whole record
+    void put(const DataType &new_data);
+    void ISR_put(const DataType &new_data) { put(new_data); }
+
+    // Change one field if its value is different; returns true if it was changed
+    template <class Field, class Value> bool update(Field DataType::*field, Value value);
+
+    // Change one field only if it has the value expected; returns true if it did and was changed
+    template <class Field, class Value>
+    bool compare_and_update(Field DataType::*field, Value expected, Value value);
+
+    // Change the record with a function, in one version
+    template <class Change> void update_with(Change change);
+
+    /** @brief      Read one field of the newest record
+     *  @details    A field read alone is always whole, but two fields read this way may come from different
+     *              versions; use @c get() for those.
+     *  @param      field The field, like @c &machine_state::mode
+     *  @returns    The field's value
+     */
+    template <class Field> Field get_field(Field DataType::*field)
+    {
+        DataType snapshot;
+        this->get(snapshot);
+        return snapshot.*field;
+    }
+
+    // Print the share in the list of shares
+    void print_in_list(Print &print_dev);
+};
+
+
+// ========================================  Class: blackboard ========================================
+
+/** @brief      Constructor for the blackboard class
+ *  @details    Like a @c Share, the record isn't set until the first @c put(); @c setup() puts the first one.
+ *  @param      p_name A name for the list of shares
+ */
+template <class DataType>
+blackboard<DataType>::blackboard(const char *p_name)
+    : seqlock_share<DataType>(p_name)
+{
+    this->stats.kind = "board";
+}
+
+
+/** @brief      Write the whole record
+ *  @param      new_data The record
+ */
+template <class DataType>
+void blackboard<DataType>::put(const DataType &new_data)
+{
+    portENTER_CRITICAL();
+    publish(new_data);
+    portEXIT_CRITICAL();
+}
+
+
+/** @brief      Change one field, if its value is different
+ *  @details    The field is looked at first without a critical section; nothing is written if it already has the
+ *              value.
+ *  @param      field The field, like @c &machine_state::timing_mode
+ *  @param      value Its new value
+ *  @returns    @c true if the field was changed
+ */
+template <class DataType>
+template <class Field, class Value>
+bool blackboard<DataType>::update(Field DataType::*field, Value value)
+{
+    Field new_value = (Field)value;
+    if (get_field(field) == new_value)
+    {
+        return false;
+    }
+    bool changed = false;
+    portENTER_CRITICAL();
+    if (!(newest().*field == new_value))
+    {
+        DataType record = newest();
+        record.*field = new_value;
+        publish(record);
+        changed = true;
+    }
+    portEXIT_CRITICAL();
+    return changed;
+}
+
+
+/** @brief      Change one field only if it has the value the caller expects
+ *  @details    For a change that only makes sense from one value, like leaving a mode only if nothing else has
+ *              left it already.
+ *  @param      field The field
+ *  @param      expected The value it must have
+ *  @param      value Its new value
+ *  @returns    @c true if the field had the expected value and was changed
+ */
+template <class DataType>
+template <class Field, class Value>
+bool blackboard<DataType>::compare_and_update(Field DataType::*field, Value expected, Value value)
+{
+    Field old_value = (Field)expected;
+    Field new_value = (Field)value;
+    bool changed = false;
+    portENTER_CRITICAL();
+    if (newest().*field == old_value && !(old_value == new_value))
+    {
+        DataType record = newest();
+        record.*field = new_value;
+        publish(record);
+        changed = true;
+    }
+    portEXIT_CRITICAL();
+    return changed;
+}
+
+
+/** @brief      Change the record with a function, in one version
+ *  @details    For changes to several fields which readers must see together, or a change worked out from the
+ *              record, like a feed override step. The function runs in the critical section.
+ *  @param      change A function which takes the record as a @c DataType& and changes it
+ */
+template <class DataType>
+template <class Change>
+void blackboard<DataType>::update_with(Change change)
+{
+    portENTER_CRITICAL();
+    DataType record = newest();
+    change(record);
+    publish(record);
+    portEXIT_CRITICAL();
+}
+
+
+/** @brief      Print the share's name, version and contended reads out of all reads, then the next share in the list
+ *  @param      print_dev Where to print
+ */
+template <class DataType>
+void blackboard<DataType>::print_in_list(Print &print_dev)
+{
+    print_dev.printf("%-16sboard v%lu\t", this->name, (unsigned long)this->version());
+    print_dev << this->contended_reads() << '/' << this->reads() << endl;
+
+    if (this->p_next != NULL)
+    {
+        this->p_next->print_in_list(print_dev);
+    }
+}
+
+#endif //BLACKBOARD_H
@@ -20,11 +20,8 @@
 // HOMING CYCLE DATA
 
 ///@cond
-// check_home will hold the flag that will turn on the limit switches
-extern Share<bool> check_home;        // This holds the flag for starting the check home process
-
-Share<bool> X_home ("Check the home of X position"); // Is this defined as extern here?
-Share<bool> Y_home ("Check the home of Y position");
+// The machine's state, where the homed flags go
+extern blackboard<machine_state> machine_state_board;
 ///@endcond
 
 
@@ -33,16 +30,18 @@ Share<bool> Y_home ("Check the home of Y position");
 /** @brief   Task which, when called, activates home switches to establish home and zero the encoders.
  *  @details This task check to see when the X and Y limit switches are triggered (and 
  *           debounced). It will then send a flag to the encoders telling them to zero.
+ *           It sleeps until @c EVENT_HOME_REQUEST is signalled, so it uses no CPU until homing is asked for,
+ *           then reads the switches every @c check_home_period until both have been hit and clears the request.
  * 
  *  @param   p_params A pointer to function parameters which we don't use.
  */
 void check_home_task (void* p_params)
 {
+    (void)p_params;                             // Shuts up a compiler warning
 
     // Initialize debouncer code
 
-    // this flag tells the task to run
-    bool home_flag;
+    // these flags say which switches have been hit
     bool x_flag;
     bool y_flag;
 
@@ -51,67 +50,50 @@ void check_home_task (void* p_params)
     // Make "limit_switch_x" as the switch we want to debounce
     // Given input pin PC13 and threshhold of 5
     Debouncer limit_switch_x(PC13, 5);      // !!! NOTE!!! These pin are set up as INPUT_PULLUP, is that what we want? (I think yes, but maybe not)
-    
-    // Define some output variable that the "update" function can spit out to
-    bool output_limit_switch_x = 0;
-
 
     // Make "limit_switch_y" as the switch we want to debounce
     // Given input pin PC14 and threshhold of 5
     Debouncer limit_switch_y(PC14, 5);      // !!! NOTE!!! These pin are set up as INPUT_PULLUP, is that what we want? (I think yes, but maybe not)
-    
-    // Define some output variable that the "update" function can spit out to
-    bool output_limit_switch_y = 0;
- 
 
 
     for (;;)
     {
+        // Sleep until a "check home" command comes from serial
+        wait_for_events(EVENT_HOME_REQUEST, false, portMAX_DELAY);
 
-
-        check_home.get(home_flag);
-        
-
-        // Limit switch x value as a bool
-        output_limit_switch_x = limit_switch_x.update();
-        
-        // Limit switch x value as a bool
-        output_limit_switch_y = limit_switch_y.update();
-
-        if (home_flag == 0)             // Meaning there is not a "check home" command
+        // Say that both limit switches are not activated
+        x_flag = 0;
+        y_flag = 0;
+        machine_state_board.update_with([](machine_state &state)
         {
-            // Say that both limit switches are not activated
-            x_flag = 0;
-            y_flag = 0;
+            state.homed_X = false;
+            state.homed_Y = false;
+        });
 
-        }
-
-        else if (home_flag == 1)        // Meaning there is a "check home" command coming from serial
+        // Send flags as the limit switches are activated, until both have been
+        while (!(x_flag && y_flag))
         {
-            // Set up code to send flags when the limit switches are activated
-
-            if (output_limit_switch_x == 1)
+            if (limit_switch_x.update() == 1 && !x_flag)
             {
-
                 x_flag = 1;
             
                 //share x_flag
-                X_home.put(x_flag);
+                machine_state_board.update(&machine_state::homed_X, x_flag);
             }
 
-            else if (output_limit_switch_y == 1)
+            if (limit_switch_y.update() == 1 && !y_flag)
             {
-
                 y_flag = 1;
             
                 //share y_flag
-                Y_home.put(y_flag);
-            }            
-        }
-        
+                machine_state_board.update(&machine_state::homed_Y, y_flag);
+            }
 
+            vTaskDelay(check_home_period);
+        }
 
-        vTaskDelay(check_home_latency); // ???? we don't need to use vTaskDelayUntil right????
+        // Homing is done
+        end_homing();
     }
 
 }
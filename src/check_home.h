@@ -12,12 +12,7 @@
 
 #include "libraries&constants.h"
 
-///@cond
-
-//Task latency
-const TickType_t check_home_latency = 100;          // latency should be 10ms
-
-///@endcond
+// The task's period, check_home_period, is in the task table in static_alloc.h; it should be 10ms
 
 // check home task
 void check_home_task (void* p_params);
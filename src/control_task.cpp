@@ -15,10 +15,7 @@
 //setup externs for Incoming shares and queues here
 
 // TRANSLATED GCODE QUEUE
-extern Queue<ramp_segment_coefficients> ramp_segment_coefficient_queue;
-
-// CHECK HOME FLAG
-extern Share<bool> check_home;
+extern spsc_ring<ramp_segment_coefficients, RAMP_COEFF_Q_SIZE> ramp_segment_coefficient_queue;
 
 //Uncomment as used to ensure we don't make anything we don't use:
 // // MOTOR A ENCODER DATA
@@ -69,7 +66,6 @@ void control_task(void* p_params)
     TickType_t xLastWakeTime = xTaskGetTickCount(); //Start timing the task
 
     uint8_t control_state = NORMAL_OPERATION;       //Variable for controller state
-    bool home_flag = false;                         //Homing flag
 
     //Struct containing desired values from task_translate
     ramp_segment_coefficients desired;
@@ -86,11 +82,14 @@ void control_task(void* p_params)
     for(;;)
     {
         //State checker: Change the state if necessary
-        check_home.get(home_flag);
-        if (home_flag)
+        if (get_events() & EVENT_HOME_REQUEST)
         {
             control_state = HOMING;
         }
+        else
+        {
+            control_state = NORMAL_OPERATION;
+        }
 
 
         switch(control_state)
@@ -159,6 +158,6 @@ void control_task(void* p_params)
       //                                    and then when it gets home and is okayed by the user (?) future work
 
         
-        vTaskDelayUntil(&xLastWakeTime, control_task_period);
+        vTaskDelayUntil(&xLastWakeTime, control_period);
     }
 }
\ No newline at end of file
@@ -18,8 +18,7 @@
 #define SAFETY_STOP 1
 #define HOMING 2
 
-//Time period for control task
-const TickType_t control_task_period = 30;
+//Time period for control task: control_period, in the task table in static_alloc.h
 
 ///@endcond
 
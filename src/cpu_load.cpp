@@ -0,0 +1,215 @@
+/** @file       cpu_load.cpp
+ *  @brief      This file contains the CPU load monitor, which keeps how much of the CPU each task has used over the
+ *              last few seconds, and the idle meter.
+ *  @details    See cpu_load.h. Tasks are added before the scheduler starts. Only the monitor task writes the
+ *              readings, and it puts each one in inside a critical section, so the report, which runs in another
+ *              task, never copies one half written.
+ *
+ *              Run times and the clock are 32 bits and wrap, about once a minute on the board, but only the
+ *              difference between two readings a few seconds apart is used, which is right across a wrap.
+ *
+ *  @date    10-19-2026 File Created
+ *
+*/
+
+#include "libraries&constants.h"
+
+
+///@cond
+// Every task's run time, and the idle loops, at one moment
+struct cpu_load_reading
+{
+    uint32_t clock;                         // Run time clock
+    uint32_t idle_loops;                    // Times round the idle task so far
+    uint32_t run_time[CPU_LOAD_TASKS];      // Each task's run time so far, in run time clock counts
+};
+
+static TaskHandle_t cpu_load_tasks[CPU_LOAD_TASKS];
+static uint8_t cpu_load_task_count = 0;
+
+// The last CPU_LOAD_SAMPLES readings, in a ring
+static cpu_load_reading cpu_load_readings[CPU_LOAD_SAMPLES];
+static uint8_t cpu_load_newest = 0;
+static uint8_t cpu_load_reading_count = 0;
+
+// Counted by the idle hook, and the most idle loops per clock count seen in one period
+static volatile uint32_t idle_loops = 0;
+static float most_idle_rate = 0;
+///@endcond
+
+
+/** @brief      Add a task to the ones the monitor keeps track of
+ *  @details    Called by the @c start_ function of every task in static_alloc.h. Tasks past @c CPU_LOAD_TASKS
+ *              aren't kept track of, and count as other.
+ *  @param      task The task's handle; nothing is added if it is NULL
+ */
+void cpu_load_add(TaskHandle_t task)
+{
+    if (task == NULL || cpu_load_task_count >= CPU_LOAD_TASKS)
+    {
+        return;
+    }
+    cpu_load_tasks[cpu_load_task_count] = task;
+    cpu_load_task_count++;
+}
+
+
+#if (defined STM32L4xx || defined STM32F4xx)
+
+/** @brief      Count a time round the idle task, for the idle meter; called by FreeRTOS
+ *  @details    It runs on every loop of the idle task, so it must be short and must never block.
+ */
+extern "C" void vApplicationIdleHook(void)
+{
+    idle_loops++;
+}
+
+#endif
+
+
+/** @brief      Read the clock and every task's run time
+ *  @param      reading Filled with the reading
+ */
+static void take_reading(cpu_load_reading &reading)
+{
+    reading.clock = portGET_RUN_TIME_COUNTER_VALUE();
+    reading.idle_loops = idle_loops;
+    for (uint8_t index = 0; index < cpu_load_task_count; index++)
+    {
+        TaskStatus_t status;
+        vTaskGetInfo(cpu_load_tasks[index], &status, pdFALSE, eRunning);
+        reading.run_time[index] = status.ulRunTimeCounter;
+    }
+}
+
+
+/** @brief      Task which reads every task's run time each period and keeps the last few readings
+ *  @details    The monitor is at the lowest priority of the tasks, so reading doesn't hold the others up. It also
+ *              keeps the idle meter's most idle loops in a period.
+ *  @param      p_params A pointer to function parameters which we don't use.
+ */
+void task_cpu_load(void* p_params)
+{
+    (void)p_params;                   // Does nothing but shut up a compiler warning
+
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+
+    for(;;)
+    {
+        cpu_load_reading reading;
+        take_reading(reading);
+
+        if (cpu_load_reading_count > 0)
+        {
+            const cpu_load_reading &last = cpu_load_readings[cpu_load_newest];
+            uint32_t elapsed = reading.clock - last.clock;
+            if (elapsed > 0)
+            {
+                float idle_rate = (float)(reading.idle_loops - last.idle_loops) / elapsed;
+                most_idle_rate = (idle_rate > most_idle_rate) ? idle_rate : most_idle_rate;
+            }
+        }
+
+        portENTER_CRITICAL();
+        cpu_load_newest = (cpu_load_reading_count == 0) ? 0 : (cpu_load_newest + 1) % CPU_LOAD_SAMPLES;
+        cpu_load_readings[cpu_load_newest] = reading;
+        if (cpu_load_reading_count < CPU_LOAD_SAMPLES)
+        {
+            cpu_load_reading_count++;
+        }
+        portEXIT_CRITICAL();
+
+        vTaskDelayUntil(&xLastWakeTime, cpu_load_period);
+    }
+}
+
+
+/** @brief      Work out a share of a time in tenths of a percent
+ *  @param      part The part of the time
+ *  @param      whole The time
+ *  @returns    The share, in tenths of a percent
+ */
+static uint32_t permille(uint32_t part, uint32_t whole)
+{
+    return (whole == 0) ? 0 : (uint32_t)(((uint64_t)part * 1000 + whole / 2) / whole);
+}
+
+
+/** @brief      Print a row of the report
+ *  @param      name The row's name
+ *  @param      share Its share of the CPU in tenths of a percent
+ *  @param      peak Its most in one period, in tenths of a percent, or @c UINT32_MAX for none
+ */
+static void print_cpu_load_row(const char *name, uint32_t share, uint32_t peak)
+{
+    char row[LINE_BUFFER_SIZE];
+    if (peak == UINT32_MAX)
+    {
+        snprintf(row, sizeof(row), "%-16s %5lu.%lu\n", name, (unsigned long)(share / 10),
+                 (unsigned long)(share % 10));
+    }
+    else
+    {
+        snprintf(row, sizeof(row), "%-16s %5lu.%lu %6lu.%lu\n", name, (unsigned long)(share / 10),
+                 (unsigned long)(share % 10), (unsigned long)(peak / 10), (unsigned long)(peak % 10));
+    }
+    print_serial((const char*)row);
+}
+
+
+/** @brief      Print each task's share of the CPU over the window, the total and the idle meter
+ *  @details    This is what @c $T does; the rows are described in cpu_load.h. The window runs from the oldest
+ *              reading kept to now. A task's peak is its most in any one period of the window.
+ */
+void print_cpu_load(void)
+{
+    // Static so they aren't on the caller's stack; only the task that runs $T prints this
+    static cpu_load_reading window[CPU_LOAD_SAMPLES + 1];
+    char row[LINE_BUFFER_SIZE];
+
+    // Copy the readings oldest first, and end with one taken now
+    portENTER_CRITICAL();
+    uint8_t count = cpu_load_reading_count;
+    for (uint8_t index = 0; index < count; index++)
+    {
+        window[index] = cpu_load_readings[(cpu_load_newest + 1 + CPU_LOAD_SAMPLES - count + index)
+                                          % CPU_LOAD_SAMPLES];
+    }
+    portEXIT_CRITICAL();
+    take_reading(window[count]);
+
+    uint32_t elapsed = window[count].clock - window[0].clock;
+    if (elapsed == 0)
+    {
+        print_serial("No CPU load readings yet\n");
+        return;
+    }
+
+    uint32_t window_ms = (uint32_t)((uint64_t)elapsed * 1000 / CPU_LOAD_CLOCK_RATE);
+    snprintf(row, sizeof(row), "CPU use over the last %lu ms\n", (unsigned long)window_ms);
+    print_serial((const char*)row);
+    print_serial("task              cpu%   peak%\n");
+
+    uint32_t tasks_total = 0;
+    for (uint8_t task = 0; task < cpu_load_task_count; task++)
+    {
+        uint32_t used = window[count].run_time[task] - window[0].run_time[task];
+        uint32_t peak = 0;
+        for (uint8_t index = 0; index < count; index++)
+        {
+            uint32_t period_share = permille(window[index + 1].run_time[task] - window[index].run_time[task],
+                                             window[index + 1].clock - window[index].clock);
+            peak = (period_share > peak) ? period_share : peak;
+        }
+        tasks_total += permille(used, elapsed);
+        print_cpu_load_row(pcTaskGetName(cpu_load_tasks[task]), permille(used, elapsed), peak);
+    }
+    print_cpu_load_row("tasks", tasks_total, UINT32_MAX);
+    print_cpu_load_row("other", (tasks_total < 1000) ? 1000 - tasks_total : 0, UINT32_MAX);
+
+    #if (defined STM32L4xx || defined STM32F4xx)
+    float idle = (most_idle_rate > 0) ? (window[count].idle_loops - window[0].idle_loops) / (most_idle_rate * elapsed)
+                                      : 0.0f;
+    print_cpu_load_row("idle hook", (uint32_t)(1000.0f * (idle < 1.0f ? idle : 1.0f) + 0.5f), UINT32_MAX);
+    #endif
+}
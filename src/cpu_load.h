@@ -0,0 +1,73 @@
+/** @file       cpu_load.h
+ *  @brief      This file contains the header for the CPU load monitor, which keeps how much of the CPU each task
+ *              has used over the last few seconds, and the idle meter.
+ *  @details    FreeRTOS keeps each task's run time (@c configGENERATE_RUN_TIME_STATS): at every task switch it reads
+ *              a fast clock and adds the time since the last switch to the task going out. On the board the clock
+ *              is the core's cycle counter (see trace_hooks.h), so a task's time is right to the cycle, interrupts
+ *              included, which count for the task they came in on.
+ *
+ *              Every task made with a @c start_ function in static_alloc.h is added to the monitor as it is made.
+ *              The monitor task reads every task's run time each @c cpu_load_period ms and keeps the last
+ *              @c CPU_LOAD_SAMPLES readings, so @c $T gives each task's share of the CPU over the window they cover,
+ *              up to the moment it is asked:
+ *
+ *              | Row       | Meaning                                                                   |
+ *              |-----------|---------------------------------------------------------------------------|
+ *              | a task    | Its share of the CPU, and its most in any one period of the window         |
+ *              | tasks     | All of the tasks added, together                                          |
+ *              | other     | The rest: the idle task, the timer task and the scheduler                  |
+ *              | idle hook | The idle meter, where there is one                                        |
+ *
+ *              The idle meter is the old way of finding the load, and checks the other: the idle hook counts how
+ *              many times the idle task goes round, and the count in a period, against the most ever counted in a
+ *              period of that length, is the share of the CPU left idle. It learns the most from the quietest
+ *              period it has seen, so it reads too idle until the machine has been idle for a whole period, which
+ *              it is for the first seconds after starting.
+ *
+ *              The share left over is the headroom: before the control or encoder tasks' periods are cut, each
+ *              task's share grows by the ratio of the old period to the new one, and the total must stay well under
+ *              100% for the deadlines in static_alloc.h to be met (see schedule.h).
+ *
+ *              On a PC (see lib/FreeRTOS_POSIX) a task's run time is the real CPU time its thread has used,
+ *              against real time, so it measures the PC and the stand-in, not the board, and there is no idle hook.
+ *              On virtual time the host report's longest loops are the better guide to the board.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef CPU_LOAD_H
+#define CPU_LOAD_H
+
+#include "libraries&constants.h"
+
+#if (defined STM32L4xx || defined STM32F4xx) && !(configGENERATE_RUN_TIME_STATS && configUSE_IDLE_HOOK)
+    #error "The CPU load monitor needs configGENERATE_RUN_TIME_STATS and configUSE_IDLE_HOOK set to 1"
+#endif
+
+
+// Most tasks the monitor keeps track of
+#define CPU_LOAD_TASKS 12
+
+// Readings kept; the window $T reports on is this many monitor periods
+#define CPU_LOAD_SAMPLES 8
+
+// Counts a second of the run time clock: the core's clock on the board, microseconds on a PC
+#if (defined STM32L4xx || defined STM32F4xx)
+    #define CPU_LOAD_CLOCK_RATE SystemCoreClock
+#else
+    #define CPU_LOAD_CLOCK_RATE 1000000
+#endif
+
+
+// Add a task to the ones the monitor keeps track of
+void cpu_load_add(TaskHandle_t task);
+
+// Read every task's run time each cpu_load_period ms and keep the last CPU_LOAD_SAMPLES readings
+void task_cpu_load(void* p_params);
+
+// Print each task's share of the CPU over the window, the total and the idle meter
+void print_cpu_load(void);
+
+
+#endif //CPU_LOAD_H
@@ -17,11 +17,11 @@
 //Set up shares and queues
 
 // Shares for Encoder A and B
-extern Share<encoder_output> enc_A_output_share;
-extern Share<encoder_output> enc_B_output_share;
+extern seqlock_share<encoder_output> enc_A_output_share;
+extern seqlock_share<encoder_output> enc_B_output_share;
 
-// Shares for timing mode
-extern Share<uint8_t> timing_mode_share;
+// The machine's state, for the timing mode and the feed override from the real-time commands
+extern blackboard<machine_state> machine_state_board;
 
 ///@endcond
 
@@ -90,10 +90,11 @@ void task_encoder_A (void* p_params)
         raw_vel_A = (float)delta_position_A / (float)delta_time_A *   1000000;
                         // ticks            /       microsec      * microsec/sec 
 
-        //Filter the raw velocity to get meaningful output
+        //Filter the raw velocity to get meaningful output (the filter constant is a setting, see settings.h)
         //Why do we have to convert them to int32_t? No idea. But for whatever reason if I add these two
         //parts of the filter as floats, they lose all of their precision and add to 0 every time. Super frustrating.
-        velocity_A = (float)( (int32_t)(raw_vel_A*FILTER_A_ALPHA*10000) + (int32_t)(velocity_A*(1-FILTER_A_ALPHA)*10000) )/10000; 
+        float alpha_A = get_setting(SETTING_FILTER_ALPHA_A);
+        velocity_A = (float)( (int32_t)(raw_vel_A*alpha_A*10000) + (int32_t)(velocity_A*(1-alpha_A)*10000) )/10000; 
 
         //Convert values into desired units
         pos_A_out = convert_units(position_A,ENC_POSITION_MODE_TICKS);
@@ -112,7 +113,7 @@ void task_encoder_A (void* p_params)
 
 
         // Delay until reset        
-        vTaskDelayUntil(&xLastWakeTime, ENCODER_PERIOD_A);
+        vTaskDelayUntil(&xLastWakeTime, encoder_A_period);
     }
 
 }
@@ -189,10 +190,11 @@ void task_encoder_B (void* p_params)
         raw_vel_B = (float)delta_position_B / (float)delta_time_B *   1000000;
                         // ticks            /       microsec      * microsec/sec 
 
-        //Filter the raw velocity to get meaningful output
+        //Filter the raw velocity to get meaningful output (the filter constant is a setting, see settings.h)
         //Why do we have to convert them to int32_t? No idea. But for whatever reason if I add these two
         //parts of the filter as floats, they lose all of their precision and add to 0 every time. Super frustrating.
-        velocity_B = (float)( (int32_t)(raw_vel_B*FILTER_B_ALPHA*10000) + (int32_t)(velocity_B*(1-FILTER_B_ALPHA)*10000) )/10000; 
+        float alpha_B = get_setting(SETTING_FILTER_ALPHA_B);
+        velocity_B = (float)( (int32_t)(raw_vel_B*alpha_B*10000) + (int32_t)(velocity_B*(1-alpha_B)*10000) )/10000; 
 
         //Convert values into desired units
         pos_B_out = convert_units(position_B,ENC_POSITION_MODE_TICKS);
@@ -209,7 +211,7 @@ void task_encoder_B (void* p_params)
         enc_B_output_share.put(enc_B);
 
         // Delay until reset        
-        vTaskDelayUntil(&xLastWakeTime, ENCODER_PERIOD_B);
+        vTaskDelayUntil(&xLastWakeTime, encoder_B_period);
     }
 
 }
@@ -231,6 +233,11 @@ void task_encoder_B (void* p_params)
  */
 float convert_units(float value, uint8_t convert_mode)
 {
+    //Encoder and drive constants are settings (see settings.h), so a new machine can be set up without reflashing
+    float counts_per_pulse = get_setting(SETTING_COUNTS_PER_PULSE);
+    float pulses_per_rev = get_setting(SETTING_PULSES_PER_REV);
+    float gear_ratio = get_setting(SETTING_GEAR_RATIO);
+
     switch (convert_mode)
     {
         case ENC_POSITION_MODE_TICKS:           //starting with ticks
@@ -238,29 +245,29 @@ float convert_units(float value, uint8_t convert_mode)
             break; //No conversion necessary
         case ENC_POSITION_MODE_REVOUT:
             //      enc ticks / (      (ticks/pulse)      *    (pulse/enc rev) )    / (enc rev/output rev)
-            value =   value   / (ENCODER_COUNTS_PER_PULSE * ENCODER_PULSES_PER_REV) / REV_ENC_PER_REVOUT_MOTOR;
+            value =   value   / (counts_per_pulse * pulses_per_rev) / gear_ratio;
             break;
 
         case ENC_VELOCITY_MODE_RPMOUT:
             //      enc ticks/sec / (      (ticks/pulse)      *    (pulse/enc rev) )    / (enc rev/output rev)     * sec/min
-            value =   value       / (ENCODER_COUNTS_PER_PULSE * ENCODER_PULSES_PER_REV) / REV_ENC_PER_REVOUT_MOTOR * 60;
+            value =   value       / (counts_per_pulse * pulses_per_rev) / gear_ratio * 60;
             break;
 
         case ENC_POSITION_MODE_DEGOUT:         //starting with ticks
         case ENC_VELOCITY_MODE_DEGOUT_PER_SEC: //starting with ticks/sec
             //      enc ticks / (      (ticks/pulse)      *    (pulse/enc rev) )    / (enc rev/output rev)      * 360deg/rev
-            value =   value   / (ENCODER_COUNTS_PER_PULSE * ENCODER_PULSES_PER_REV) / REV_ENC_PER_REVOUT_MOTOR  * 360;
+            value =   value   / (counts_per_pulse * pulses_per_rev) / gear_ratio  * 360;
             break;
 
         case ENC_POSITION_MODE_BELT_MM:             //starting with ticks
         case ENC_VELOCITY_MODE_BELT_MM_PER_SEC:     //starting with ticks/sec
             // Convert to output revolutions fist:
             //      enc ticks / (      (ticks/pulse)      *    (pulse/enc rev) )    / (enc rev/output rev)
-            value =   value   / (ENCODER_COUNTS_PER_PULSE * ENCODER_PULSES_PER_REV) / REV_ENC_PER_REVOUT_MOTOR;
+            value =   value   / (counts_per_pulse * pulses_per_rev) / gear_ratio;
 
             //Convert from output rev to belt distance: s = r*theta (theta in radians)
             //       rev *     2pi rad/rev     *         r (mm)
-            value = value*(2*3.141592653589793)*OUTPUT_WHEEL_RADIUS_MM;
+            value = value*(2*3.141592653589793)*get_setting(SETTING_WHEEL_RADIUS);
             break;
 
         default:
@@ -273,7 +280,8 @@ float convert_units(float value, uint8_t convert_mode)
 
 
 /** @brief   Update the total time based on timing mode
- *  @details This function updates the total time based on what timing mode we're in. 
+ *  @details This function updates the total time based on what timing mode we're in. While running, time
+ *           goes faster or slower by the feed override, so every ramp segment runs at that percent of its feedrate.
  * 
  *  @param   total_time     previous total time
  *  @param   delta_time     time between calls
@@ -282,11 +290,12 @@ float convert_units(float value, uint8_t convert_mode)
  */
 float update_total_time(float total_time, uint32_t delta_time)
 {
-    // Define variables to hold share values
-    uint8_t timing_mode = TIMING_MODE_PAUSED;
+    // Get the timing mode and feed override together, so they're from the same moment
+    machine_state state;
+    machine_state_board.get(state);
+    uint8_t feed_override = state.feed_override;
 
-    timing_mode_share.get(timing_mode);
-    switch(timing_mode)
+    switch(state.timing_mode)
     {
         case TIMING_MODE_PAUSED:
             //Don't add to the total time; total time stays constant
@@ -299,7 +308,7 @@ float update_total_time(float total_time, uint32_t delta_time)
         case TIMING_MODE_RUNNING:
         default:
             //Update the total time (in seconds)
-            total_time += (float)delta_time/1000000;
+            total_time += (float)delta_time/1000000*feed_override/100;
             break;
 
     }
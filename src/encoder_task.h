@@ -18,6 +18,7 @@
 
 
 // ======== User Inputs ======== 
+// The filter constants are the defaults of settings $5 and $6 (see settings.h)
 #define FILTER_A_ALPHA 0.5
 #define FILTER_B_ALPHA 0.5
 
@@ -43,15 +44,13 @@
 #define ENC_VELOCITY_MODE_BELT_MM_PER_SEC 7
 
 
-// Constants as defined by system
+// Constants as defined by system; defaults of settings $9 to $12 (see settings.h)
 #define ENCODER_PULSES_PER_REV 11       //Our encoder specifically has 11 pulses per rev
 #define ENCODER_COUNTS_PER_PULSE 4      //Quadrature encoder reads 4 counts (ticks) for each full set of pulses from each encoder channel
 #define REV_ENC_PER_REVOUT_MOTOR 6.3    //Gear ratio of motor
 #define OUTPUT_WHEEL_RADIUS_MM 5.95     //Radius of belt wheel on output shaft (mm)
 
-// Task timing constants
-#define ENCODER_PERIOD_A 10     //Encoder A task period
-#define ENCODER_PERIOD_B 10     //Encoder B task period
+// The encoder tasks' periods, encoder_A_period and encoder_B_period, are in the task table in static_alloc.h
 
 
 // Struct for containing encoder output values
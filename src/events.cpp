@@ -0,0 +1,137 @@
+/** @file       events.cpp
+ *  @brief      This file contains the machine's events, which wake the tasks waiting for them as soon as they
+ *              happen.
+ *  @details    See events.h. The event group is made in static memory when the program starts, like the queues.
+ *
+ *  @date    10-19-2026 File Created
+ *
+*/
+
+#include "libraries&constants.h"
+
+///@cond
+// The machine's state, where jobs are counted
+extern blackboard<machine_state> machine_state_board;
+///@endcond
+
+
+///@cond
+// The machine's event group, and the memory it is made in
+static StaticEventGroup_t machine_events_memory;
+static EventGroupHandle_t machine_events = xEventGroupCreateStatic(&machine_events_memory);
+///@endcond
+
+
+/** @brief      Set up the events before any task runs
+ *  @details    Called from @c setup(), with the shares' first values. No job is running yet.
+ */
+void init_events(void)
+{
+    xEventGroupClearBits(machine_events, EVENTS_ALL);
+    xEventGroupSetBits(machine_events, EVENT_JOB_ENDED);
+}
+
+
+/** @brief      Set events, waking the tasks waiting for them
+ *  @details    A task waiting for one of them, with a higher priority than the caller, runs right away.
+ *  @param      bits The events
+ */
+void signal_events(EventBits_t bits)
+{
+    xEventGroupSetBits(machine_events, bits);
+}
+
+
+/** @brief      Clear events
+ *  @param      bits The events
+ */
+void clear_events(EventBits_t bits)
+{
+    xEventGroupClearBits(machine_events, bits);
+}
+
+
+/** @brief      Get the events which are set
+ *  @details    For tasks which run on a period and only need to look.
+ *  @returns    The events' bits
+ */
+EventBits_t get_events(void)
+{
+    return xEventGroupGetBits(machine_events);
+}
+
+
+/** @brief      Wait for any of some events
+ *  @details    The calling task uses no CPU while it waits. With a number of ticks this also serves as the delay
+ *              at the end of a task's loop, which is cut short by the events.
+ *  @param      bits The events to wait for
+ *  @param      clear @c true to clear the events waited for, if they came in time
+ *  @param      ticks Ticks to wait, or @c portMAX_DELAY to wait until one comes
+ *  @returns    The events set when they came or the time ran out
+ */
+EventBits_t wait_for_events(EventBits_t bits, bool clear, TickType_t ticks)
+{
+    return xEventGroupWaitBits(machine_events, bits, clear ? pdTRUE : pdFALSE, pdFALSE, ticks);
+}
+
+
+/** @brief      Mark a job as running, if it isn't yet
+ *  @details    Called by the translator for every move it queues, so the first move of a job starts it, whether
+ *              it came from G-code, a binary frame, a fill or a replay. The job is counted and the machine's mode
+ *              set in @c machine_state_board before the waiting tasks are woken.
+ */
+void start_job(void)
+{
+    if ((get_events() & EVENT_JOB_RUNNING) == 0)
+    {
+        machine_state_board.update_with([](machine_state &state)
+        {
+            state.mode = MACHINE_MODE_JOB;
+            state.jobs_started++;
+        });
+        trace_mark(TRACE_MARK_JOB_START);
+        xEventGroupClearBits(machine_events, EVENT_JOB_ENDED);
+        xEventGroupSetBits(machine_events, EVENT_JOB_RUNNING);
+    }
+}
+
+
+/** @brief      Mark the job as ended
+ *  @details    Called for @c M2 and for a soft reset, which also ends a reset's mode. A job is only counted as
+ *              ended if one was running.
+ */
+void end_job(void)
+{
+    bool was_running = get_events() & EVENT_JOB_RUNNING;
+    machine_state_board.update_with([was_running](machine_state &state)
+    {
+        state.mode = MACHINE_MODE_IDLE;
+        state.jobs_ended += was_running ? 1 : 0;
+    });
+    xEventGroupClearBits(machine_events, EVENT_JOB_RUNNING);
+    xEventGroupSetBits(machine_events, EVENT_JOB_ENDED);
+    trace_mark(TRACE_MARK_JOB_END);
+}
+
+
+/** @brief      Start homing, waking the check home task
+ *  @details    Called by the translator for a homing command. The machine's mode is set first, so a status
+ *              report never shows a request without it.
+ */
+void start_homing(void)
+{
+    machine_state_board.update(&machine_state::mode, MACHINE_MODE_HOMING);
+    xEventGroupSetBits(machine_events, EVENT_HOME_REQUEST);
+    trace_mark(TRACE_MARK_HOMING);
+}
+
+
+/** @brief      Mark homing as done
+ *  @details    Called by the check home task once both switches have been hit. The mode only goes back to idle if
+ *              it is still homing, so a reset or a job started in the meantime isn't undone.
+ */
+void end_homing(void)
+{
+    machine_state_board.compare_and_update(&machine_state::mode, MACHINE_MODE_HOMING, MACHINE_MODE_IDLE);
+    xEventGroupClearBits(machine_events, EVENT_HOME_REQUEST);
+}
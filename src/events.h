@@ -0,0 +1,65 @@
+/** @file       events.h
+ *  @brief      This file contains the header for the machine's events: homing, jobs starting and ending, and soft
+ *              resets, which wake the tasks waiting for them as soon as they happen.
+ *  @details    Each event is a bit of one FreeRTOS event group. A task which has nothing to do until an event
+ *              happens waits for its bit with @c wait_for_events() and uses no CPU until then; a task which runs
+ *              on a period anyway reads the bits with @c get_events(). This replaces the flags that used to be kept
+ *              in @c Share<bool>s, which every task that cared had to look at each period, so it heard about
+ *              them up to a period late and used CPU looking when nothing had happened.
+ *
+ *              | Bit                   | Set by                        | Waited for or read by         | Cleared by        |
+ *              |-----------------------|-------------------------------|-------------------------------|-------------------|
+ *              | @c EVENT_HOME_REQUEST | @c start_homing()             | check home (waits), control   | @c end_homing()   |
+ *              | @c EVENT_JOB_RUNNING  | @c start_job(), first move    | safety: fan (waits)           | @c end_job()      |
+ *              | @c EVENT_JOB_ENDED    | @c end_job(): @c M2, reset    | safety: fan (waits)           | @c start_job()    |
+ *              | @c EVENT_SOFT_RESET   | serial reader (Ctrl-X)        | translate (waits)             | translate         |
+ *
+ *              A feed hold stays in the timing mode in @c machine_state_board (see machine_state.h): everything
+ *              that reads it runs every encoder period anyway. The status report task is woken with a task
+ *              notification instead of an event, since only it waits for a change to its period (see
+ *              @c set_status_period()).
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include "libraries&constants.h"
+#include "event_groups.h"
+
+
+// Bits of the machine's event group
+#define EVENT_HOME_REQUEST  ((EventBits_t)1 << 0)   // Home the machine
+#define EVENT_JOB_RUNNING   ((EventBits_t)1 << 1)   // A job is running
+#define EVENT_JOB_ENDED     ((EventBits_t)1 << 2)   // No job is running; always the opposite of EVENT_JOB_RUNNING
+#define EVENT_SOFT_RESET    ((EventBits_t)1 << 3)   // A soft reset has been asked for
+#define EVENTS_ALL          (EVENT_HOME_REQUEST | EVENT_JOB_RUNNING | EVENT_JOB_ENDED | EVENT_SOFT_RESET)
+
+
+// Set up the events before any task runs: no job is running
+void init_events(void);
+
+// Set events, waking the tasks waiting for them
+void signal_events(EventBits_t bits);
+
+// Clear events
+void clear_events(EventBits_t bits);
+
+// Get the events which are set
+EventBits_t get_events(void);
+
+// Wait up to ticks for any of some events; returns the events set. Clears the ones waited for if clear is true
+EventBits_t wait_for_events(EventBits_t bits, bool clear, TickType_t ticks);
+
+// Mark a job as running, if it isn't yet, or as ended
+void start_job(void);
+void end_job(void);
+
+// Start homing, waking the check home task, or mark it as done
+void start_homing(void);
+void end_homing(void);
+
+
+#endif //EVENTS_H
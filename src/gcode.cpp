@@ -46,6 +46,7 @@ uint8_t decode::interpret_gcode_line(char *line)
 
     //Define state variables
     _move_type = MOVE_NONE;
+    _error_signal = NO_ERROR;
 
 
     //Start looping through the line, character by character. Check each character to match 
@@ -78,7 +79,7 @@ uint8_t decode::interpret_gcode_line(char *line)
             //If not a letter...
             if((letter < 'A') || (letter > 'Z')) 
             { 
-                print_serial("Error in Gcode: Not starting with letter");
+                print_serial("Error in Gcode: Not starting with letter\n");
                 _error_signal = SYNTAX_ERROR_LETTER;
                 return GC_CMD_ERROR; 
             }
@@ -90,7 +91,7 @@ uint8_t decode::interpret_gcode_line(char *line)
             //the first value after the number from Gcode. Returns false if error. 
             if ((!read_float(line, &char_counter, &value) ))
             {
-                print_serial("Error in Gcode: Letter not followed by number");
+                print_serial("Error in Gcode: Letter not followed by number\n");
                 _error_signal = SYNTAX_ERROR_NUMBER;
                 return GC_CMD_ERROR;
             }
@@ -124,7 +125,7 @@ uint8_t decode::interpret_gcode_line(char *line)
                             //Rapid movement (travel)
                             _move_type = MOVE_TRAVEL;
                             //set feedrate for traveling
-                            _XYSFval.F = TRAVEL_SPEED;
+                            _XYSFval.F = get_setting(SETTING_TRAVEL_SPEED);
                             output_signal = GC_CMD_UPDATE_XYSF;
                             break;
                         case 1: 
@@ -150,7 +151,7 @@ uint8_t decode::interpret_gcode_line(char *line)
                             break;
                         default:
                             //Error: Unsupported Gcode
-                            print_serial("ERROR: Unsupported G Command in line __");
+                            print_serial("ERROR: Unsupported G Command in line __\n");
                             _error_signal = G_COMMAND_ERROR;
                             output_signal = GC_CMD_ERROR;
                     }
@@ -176,7 +177,7 @@ uint8_t decode::interpret_gcode_line(char *line)
                             break;
                         default:
                             //ERROR: Unsupported Mcode
-                            print_serial("ERROR: Unsupported M Command in line __");
+                            print_serial("ERROR: Unsupported M Command in line __\n");
                             _error_signal = M_COMMAND_ERROR;
                             output_signal = GC_CMD_ERROR;
                     }
@@ -237,7 +238,7 @@ uint8_t decode::interpret_gcode_line(char *line)
 
                 default:
                     //ERROR: Unsupported command
-                     print_serial("ERROR: Unsupported Letter Command in line __");
+                     print_serial("ERROR: Unsupported Letter Command in line __\n");
                      _error_signal = LETTER_CMD_ERROR;
                      output_signal = GC_CMD_ERROR;
                     
@@ -254,9 +255,27 @@ uint8_t decode::interpret_gcode_line(char *line)
 /** @brief      Function which interprets a line containing a machine command.
  *  @details    This function takes in a line containing a command for the laser that begins with
  *              a @c $, signalling that it is a machine command and not a line of gcode. It then interprets
- *              the command in the line and returns on the information. 
- *              <b>Disclaimer: This function currently only supports homing commands. More will be added in the 
- *              future.</b>
+ *              the command in the line and returns on the information. Supported commands are:
+ *              - @c $H  Home the machine
+ *              - @c $FR Fill a rectangle: @c X @c Y corner, @c I width, @c J height, @c A hatch angle (deg),
+ *                       @c D line spacing (mm), @c S laser power, @c F feedrate
+ *              - @c $FP Start a polygon fill with hatch words @c A @c D @c S and @c F
+ *              - @c $FV Add a polygon vertex at @c X @c Y
+ *              - @c $FE End the polygon and run the fill
+ *              - @c $JR Start recording a job for more passes
+ *              - @c $JE Stop recording
+ *              - @c $JP Replay the recorded job: @c P passes, @c S power and @c F feedrate of cutting moves, @c I and
+ *                       @c J power and feedrate change on each pass
+ *              - @c $SR Print a status report every @c P ms (@c P0 for none), or with no @c P, print how they're set
+ *              - @c $TM Send binary telemetry: @c M fields (@c M0 for none), one frame every @c D control loop runs
+ *              - @c $$  List the settings (see settings.h)
+ *              - @c $n=value Set setting @c n
+ *              - @c $RST Put every setting back to its default
+ *              - @c $Q  Print what has been done with every queue and share: puts, gets, timeouts, time blocked
+ *                       and the most items held
+ *              - @c $S  Print how much of its stack each task has used, and a suggested size (see stack_monitor.h)
+ *              - @c $TR Print the trace of what the tasks did lately, and start a new one (see trace.h)
+ *              - @c $T  Print each task's share of the CPU over the last few seconds (see cpu_load.h)
  * 
  *  @param      line A line containing a command to be interpreted. 
  *  @returns    an indicator for the command that was entered
@@ -270,6 +289,79 @@ uint8_t decode::interpret_machinecmd_line(char *line)
         // print_serial("\nFOUND HOME CMD\n");
         cmd_indicator = MACHINE_CMD_HOME;
     }
+    //Hatch fill commands: the words after the command are read by read_command_words()
+    else if (strncmp(line,"$FR",3) == 0)
+    {
+        cmd_indicator = MACHINE_CMD_FILL_RECT;
+    }
+    else if (strncmp(line,"$FP",3) == 0)
+    {
+        cmd_indicator = MACHINE_CMD_FILL_POLY;
+    }
+    else if (strncmp(line,"$FV",3) == 0)
+    {
+        cmd_indicator = MACHINE_CMD_FILL_VERTEX;
+    }
+    else if (strcmp(line,"$FE") == 0)
+    {
+        cmd_indicator = MACHINE_CMD_FILL_EXECUTE;
+    }
+    //Job replay commands for multi-pass cutting
+    else if (strcmp(line,"$JR") == 0)
+    {
+        cmd_indicator = MACHINE_CMD_JOB_RECORD;
+    }
+    else if (strcmp(line,"$JE") == 0)
+    {
+        cmd_indicator = MACHINE_CMD_JOB_END;
+    }
+    else if (strncmp(line,"$JP",3) == 0)
+    {
+        cmd_indicator = MACHINE_CMD_JOB_REPLAY;
+    }
+    //Status report rate
+    else if (strncmp(line,"$SR",3) == 0)
+    {
+        cmd_indicator = MACHINE_CMD_STATUS_RATE;
+    }
+    //Binary telemetry of the control loop
+    else if (strncmp(line,"$TM",3) == 0)
+    {
+        cmd_indicator = MACHINE_CMD_TELEMETRY;
+    }
+    //Settings
+    else if (strcmp(line,"$$") == 0)
+    {
+        cmd_indicator = MACHINE_CMD_SETTINGS_LIST;
+    }
+    else if (line[1] >= '0' && line[1] <= '9')
+    {
+        cmd_indicator = MACHINE_CMD_SETTING_SET;
+    }
+    else if (strcmp(line,"$RST") == 0)
+    {
+        cmd_indicator = MACHINE_CMD_SETTINGS_RESET;
+    }
+    //Queue and share counts
+    else if (strcmp(line,"$Q") == 0)
+    {
+        cmd_indicator = MACHINE_CMD_QUEUE_STATS;
+    }
+    //Stack use of every task
+    else if (strcmp(line,"$S") == 0)
+    {
+        cmd_indicator = MACHINE_CMD_STACK_REPORT;
+    }
+    //Trace of what the tasks did
+    else if (strcmp(line,"$TR") == 0)
+    {
+        cmd_indicator = MACHINE_CMD_TRACE_DUMP;
+    }
+    //CPU use of every task
+    else if (strcmp(line,"$T") == 0)
+    {
+        cmd_indicator = MACHINE_CMD_CPU_LOAD;
+    }
     //Unsupported command
     else
     {
@@ -284,6 +376,99 @@ uint8_t decode::interpret_machinecmd_line(char *line)
 // ==================================================================================================================
 
 
+/** @brief      Function which checks the line number and checksum of a line, and takes them off
+ *  @details    Lines can be sent as @c N<line> @c <command> @c *<checksum>, where the checksum is the XOR of 
+ *              every character before the @c *, written in decimal. A line is accepted if its checksum is 
+ *              right and its number is one more than the last line accepted. The line number and checksum are
+ *              then taken off so the rest of the line reads like any other line. Special cases:
+ *              - A line with a number that was already accepted is one the host sent again after a resend; 
+ *                it is blanked so it answers @c ok without running twice.
+ *              - @c M110 @c N<n> sets the last line number to @c n, whatever number its own line has. Sent
+ *                without a line number, it also turns checking off again.
+ *              - Once the host has sent one numbered line, lines without a number are rejected, since a 
+ *                corrupted @c N would otherwise turn a checked line into an unchecked one.
+ * 
+ *  @param      line The line from the host; changed in place
+ *  @returns    @c NO_ERROR, @c CHECKSUM_ERROR or @c LINE_NUMBER_ERROR. On an error the host should resend 
+ *              from line @c get_line_number()+1.
+ */
+uint8_t decode::check_line(char *line)
+{
+    bool has_number = (line[0] == 'N');
+    uint32_t number = 0;
+
+    if (has_number)
+    {
+        //Checksum: XOR of everything before the last '*'
+        char *star = strrchr(line,'*');
+        if (star == NULL)
+        {
+            return CHECKSUM_ERROR;
+        }
+        uint8_t checksum = 0;
+        for (char *p_char = line; p_char < star; p_char++)
+        {
+            checksum ^= (uint8_t)*p_char;
+        }
+        char *end;
+        uint32_t sent_checksum = strtoul(star + 1, &end, 10);
+        if (end == star + 1 || *end != '\0' || sent_checksum != checksum)
+        {
+            return CHECKSUM_ERROR;
+        }
+        *star = '\0';
+
+        //Line number
+        number = strtoul(line + 1, &end, 10);
+        if (end == line + 1)
+        {
+            return LINE_NUMBER_ERROR;
+        }
+
+        //Move the command to the front of the line
+        while (*end == ' ')
+        {
+            end++;
+        }
+        memmove(line, end, strlen(end) + 1);
+    }
+    else if (_numbered && strncmp(line,"M110",4) != 0)
+    {
+        return LINE_NUMBER_ERROR;
+    }
+
+    //M110: set the line number
+    if (strncmp(line,"M110",4) == 0)
+    {
+        command_words words;
+        read_command_words(line, 4, &words);
+        _line_number = has_word(&words,'N') ? (uint32_t)word_value(&words,'N') : 0;
+        _numbered = has_number;
+        line[0] = '\0';
+        return NO_ERROR;
+    }
+
+    if (has_number)
+    {
+        if (number <= _line_number && _numbered)      //Already ran this one
+        {
+            line[0] = '\0';
+            return NO_ERROR;
+        }
+        if (number != _line_number + 1)
+        {
+            return LINE_NUMBER_ERROR;
+        }
+        _line_number = number;
+        _numbered = true;
+    }
+    return NO_ERROR;
+}
+
+
+// ==================================================================================================================
+
+
 /** @brief      Function which initializes the running of gcode
  *  @details    This function sets the class member variable @c _gcode_running to true, signaling
  *              the system that we are running gcode.
@@ -311,6 +496,35 @@ XYSFvalues decode::get_XYSF(void)
 // ==================================================================================================================
 
 
+/** @brief      Function which sets the current @c X and @c Y position held by the decoder
+ *  @details    Moves that are generated on the laser itself (such as hatch fills) don't go through the
+ *              decoder, so the translator and the decoder would disagree about where the laser head is. 
+ *              This function updates @c _XYSFval so the next gcode line that only specifies one axis
+ *              starts from the right place. 
+ *  @param      X The current X position
+ *  @param      Y The current Y position
+ */
+void decode::set_position(float X, float Y)
+{
+    _XYSFval.X = X;
+    _XYSFval.Y = Y;
+}
+
+
+/** @brief      Function which sets all of the current X, Y, S and F values
+ *  @details    Used to put things back the way they were after the lines of a subprogram definition, which are 
+ *              decoded but not run.
+ *  @param      XYSF The values to set
+ */
+void decode::set_XYSF(XYSFvalues XYSF)
+{
+    _XYSFval = XYSF;
+}
+
+
+// ==================================================================================================================
+
+
 /** @brief      Function which gets just the @c S value from the gcode decoder class
  *  @details    This function gets @c S (desired laser PWM value) out of the decoder class
  *              in order to pass the command to the laser. S bypasses all control loops, as it
@@ -322,6 +536,35 @@ uint8_t decode::get_S(void)
 }
 
 
+/** @brief      Function which gets the error code from the last line of gcode
+ *  @details    The error code is reset at the start of each line, so this is @c NO_ERROR unless the 
+ *              last call to @c interpret_gcode_line() returned @c GC_CMD_ERROR.
+ *  @returns    One of the error codes defined in gcode.h
+ */
+uint8_t decode::get_error(void)
+{
+    return _error_signal;
+}
+
+
+/** @brief      Function which gets the number of the last line accepted by @c check_line()
+ *  @returns    The line number; the host resends from the line after it
+ */
+uint32_t decode::get_line_number(void)
+{
+    return _line_number;
+}
+
+
+/** @brief      Function which gets whether the host is sending line numbers, so every line needs one
+ *  @returns    @c true once a numbered line has been accepted, until @c M110 is sent without a number
+ */
+bool decode::is_numbered(void)
+{
+    return _numbered;
+}
+
+
 
 // ==================================================================================================================
 // ================================================== SUBFUNCTIONS ================================================== 
@@ -409,4 +652,80 @@ uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr)
   *char_counter = ptr - line - 1; // Set char_counter to next statement
   
   return(true);
-}
\ No newline at end of file
+}
+
+
+
+// ==================================================================================================================
+
+
+/** @brief      Reads the letter-value words that follow a machine command.
+ *  @details    Machine commands such as @c $FR take their parameters as gcode-style words, like 
+ *              <tt>$FR X10 Y10 I40 J20 A45 D0.2 S0.50 F600</tt>. This function reads every word 
+ *              starting at @c char_counter and stores the values in @c words, marking each letter
+ *              that was found. 
+ *  @param      line A line containing the machine command
+ *  @param      char_counter The index of the first character after the command itself
+ *  @param      words Pointer to the struct in which the values are stored
+ *  @returns    @c true if all words were read, @c false if there was a syntax error
+ */
+bool read_command_words(char *line, uint8_t char_counter, command_words *words)
+{
+    char letter;
+    float value;
+
+    words->found = 0;
+
+    while(line[char_counter] != '\0')
+    {
+        letter = line[char_counter];
+
+        //Skip over spaces
+        if (letter == ' ')
+        {
+            char_counter++;
+        }
+        //Anything else must be a capital letter followed by a number
+        else
+        {
+            if((letter < 'A') || (letter > 'Z')) 
+            { 
+                return false; 
+            }
+            char_counter++;
+
+            if (!read_float(line, &char_counter, &value))
+            {
+                return false;
+            }
+
+            words->value[letter - 'A'] = value;
+            words->found |= ((uint32_t)1 << (letter - 'A'));
+        }
+    }
+    return true;
+}
+
+
+/** @brief      Checks if a letter was given in a set of command words
+ *  @param      words Pointer to the words read by @c read_command_words()
+ *  @param      letter The capital letter to look for
+ *  @returns    @c true if the letter was found on the line
+ */
+bool has_word(command_words *words, char letter)
+{
+    return (words->found & ((uint32_t)1 << (letter - 'A'))) != 0;
+}
+
+
+/** @brief      Gets the value of a letter in a set of command words
+ *  @details    Check that the letter was given with @c has_word() first; letters that weren't on the line
+ *              have no meaningful value.
+ *  @param      words Pointer to the words read by @c read_command_words()
+ *  @param      letter The capital letter to get the value of
+ *  @returns    The value that followed the letter
+ */
+float word_value(command_words *words, char letter)
+{
+    return words->value[letter - 'A'];
+}
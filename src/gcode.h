@@ -12,7 +12,7 @@
 ///@cond
 #define GCODE_COMMENT ';'
 
-#define TRAVEL_SPEED 600    // mm/min
+#define TRAVEL_SPEED 600    // mm/min; default of setting $7 (see settings.h)
 
 //Define travel types
 #define MOVE_NONE 0
@@ -31,6 +31,12 @@
 #define M_COMMAND_ERROR 4
 #define MOVE_ERROR 5
 #define LETTER_CMD_ERROR 6
+#define MACHINE_CMD_ERROR 7
+#define LINE_LENGTH_ERROR 8
+#define CHECKSUM_ERROR 9
+#define LINE_NUMBER_ERROR 10
+#define SUBPROGRAM_ERROR 11
+#define SETTING_ERROR 12
 
 
 // Define gcode output signals
@@ -43,6 +49,22 @@
 // Define machine commands
 #define MACHINE_CMD_NULL 0
 #define MACHINE_CMD_HOME 1
+#define MACHINE_CMD_FILL_RECT 2
+#define MACHINE_CMD_FILL_POLY 3
+#define MACHINE_CMD_FILL_VERTEX 4
+#define MACHINE_CMD_FILL_EXECUTE 5
+#define MACHINE_CMD_JOB_RECORD 6
+#define MACHINE_CMD_JOB_END 7
+#define MACHINE_CMD_JOB_REPLAY 8
+#define MACHINE_CMD_STATUS_RATE 9
+#define MACHINE_CMD_TELEMETRY 10
+#define MACHINE_CMD_SETTINGS_LIST 11
+#define MACHINE_CMD_SETTING_SET 12
+#define MACHINE_CMD_SETTINGS_RESET 13
+#define MACHINE_CMD_QUEUE_STATS 14
+#define MACHINE_CMD_STACK_REPORT 15
+#define MACHINE_CMD_TRACE_DUMP 16
+#define MACHINE_CMD_CPU_LOAD 17
 
 //For converting chars to floats:
 #define MAX_INT_DIGITS 8 // Maximum number of digits in int32 (and float)
@@ -58,6 +80,14 @@
         float F = 0;
     };
 
+    //Struct of letter-value words read from a machine command line, e.g. "$FR X0 Y0 I20 J10". 
+    //Bit n of found is set when the letter ('A'+n) was given on the line.
+    struct command_words
+    {
+        float value[26];
+        uint32_t found = 0;
+    };
+
 ///@endcond
 
 /** @brief   Class which implements decoding object which contains functions for decoding
@@ -87,6 +117,12 @@ protected:
     ///Signal when end of Gcode reached
     bool _gcode_running = 0;
 
+    ///Last line number accepted from the host
+    uint32_t _line_number = 0;
+
+    ///True once the host has started sending line numbers; from then on every line needs one
+    bool _numbered = 0;
+
 public:
     ///Constructor
     decode(void);
@@ -97,12 +133,24 @@ public:
     //Function which interprets a machine command
     uint8_t interpret_machinecmd_line(char *line);
 
+    //Function which checks the line number and checksum of a line, and takes them off
+    uint8_t check_line(char *line);
+
     ///Initialize gcode reading
     void gcode_initialize(void);
 
     ///Get-er functions:
     XYSFvalues get_XYSF(void);
     uint8_t get_S(void);
+    uint8_t get_error(void);
+    uint32_t get_line_number(void);
+    bool is_numbered(void);
+
+    ///Set the current X and Y position (after moves which were not made from gcode lines)
+    void set_position(float X, float Y);
+
+    ///Set all of X, Y, S and F (after a subprogram definition, whose lines don't change them)
+    void set_XYSF(XYSFvalues XYSF);
 
     ///Friend class Kinematics, so Kinematics can access the class member data:
     // friend class Kinematics_coreXY;
@@ -112,4 +160,11 @@ public:
 //Function to convert strings of numbers into floats (for gcode interpreting)
 uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr);  
 
+//Function to read the letter-value words that follow a machine command
+bool read_command_words(char *line, uint8_t char_counter, command_words *words);
+
+//Functions to check if a letter was given in a set of command words, and get its value
+bool has_word(command_words *words, char letter);
+float word_value(command_words *words, char letter);
+
 #endif //GCODE_H
\ No newline at end of file
@@ -0,0 +1,232 @@
+/** @file       hatch.cpp
+ *  @brief      This file contains the class which generates hatch fills for rectangles and polygons.
+ *  @details    The hatch lines are clipped against the polygon one line at a time, so only one line worth of
+ *              crossings is ever held in memory no matter how big the fill is.
+ *
+ *  @date    10-19-2026 File Created
+ *
+*/
+
+#include "libraries&constants.h"
+
+
+/** @brief      Constructor for the hatch_fill class
+ *  @details    Starts with an empty polygon and horizontal hatch lines 1 mm apart.
+ */
+hatch_fill::hatch_fill(void)
+{
+    reset();
+    set_hatch(0,1);
+}
+
+
+/** @brief      Forget the polygon and stop any fill that is running
+ */
+void hatch_fill::reset(void)
+{
+    _n_vertices = 0;
+    _n_crossings = 0;
+    _next_pair = 0;
+    _running = false;
+}
+
+
+/** @brief      Set the hatch angle and spacing
+ *  @details    The hatch frame is rotated by @c angle_deg from the X axis. Because vertices are stored in the
+ *              hatch frame, this function has to be called before any vertices are added.
+ *  @param      angle_deg Angle of the hatch lines from the X axis, in degrees
+ *  @param      spacing Distance between neighbouring hatch lines, in mm
+ *  @returns    @c false if the spacing is too small to be a real fill
+ */
+bool hatch_fill::set_hatch(float angle_deg, float spacing)
+{
+    if (spacing < HATCH_MIN_SPACING)
+    {
+        return false;
+    }
+    _cos_angle = cos(angle_deg*PI/180);
+    _sin_angle = sin(angle_deg*PI/180);
+    _spacing = spacing;
+    return true;
+}
+
+
+/** @brief      Add a corner to the polygon
+ *  @details    The corner is rotated into the hatch frame as it is stored. The polygon is closed automatically
+ *              between the last and the first corners.
+ *  @param      X X position of the corner
+ *  @param      Y Y position of the corner
+ *  @returns    @c false if the polygon already has @c HATCH_MAX_VERTICES corners
+ */
+bool hatch_fill::add_vertex(float X, float Y)
+{
+    if (_n_vertices >= HATCH_MAX_VERTICES)
+    {
+        return false;
+    }
+    // u =  x*cos + y*sin         (along the hatch lines)
+    // v = -x*sin + y*cos         (across the hatch lines)
+    _vertices[_n_vertices].X =  X*_cos_angle + Y*_sin_angle;
+    _vertices[_n_vertices].Y = -X*_sin_angle + Y*_cos_angle;
+    _n_vertices++;
+    return true;
+}
+
+
+/** @brief      Make the polygon a rectangle
+ *  @param      X X position of the first corner
+ *  @param      Y Y position of the first corner
+ *  @param      width Size of the rectangle in X
+ *  @param      height Size of the rectangle in Y
+ */
+void hatch_fill::set_rectangle(float X, float Y, float width, float height)
+{
+    reset();
+    add_vertex(X,         Y);
+    add_vertex(X + width, Y);
+    add_vertex(X + width, Y + height);
+    add_vertex(X,         Y + height);
+}
+
+
+/** @brief      Start handing out hatch segments for the polygon
+ *  @details    The first hatch line is put half a spacing inside the bottom of the polygon (in the hatch frame),
+ *              and the last one is the last line that still fits below the top.
+ *  @returns    @c false if the polygon doesn't have at least 3 corners, or has no area
+ */
+bool hatch_fill::begin(void)
+{
+    //Twice the polygon's area, by the shoelace formula; the hatch frame is only turned, so it's the same there
+    float area2 = 0;
+    for (uint8_t i = 0; i < _n_vertices; i++)
+    {
+        const hatch_point &next = _vertices[(i + 1) % _n_vertices];
+        area2 += _vertices[i].X*next.Y - next.X*_vertices[i].Y;
+    }
+    if (_n_vertices < 3 || fabs(area2) < HATCH_MIN_SPACING*HATCH_MIN_SPACING)
+    {
+        _running = false;
+        return false;
+    }
+
+    //Find the extent of the polygon across the hatch lines
+    float v_min = _vertices[0].Y;
+    _v_max = _vertices[0].Y;
+    for (uint8_t i = 1; i < _n_vertices; i++)
+    {
+        if (_vertices[i].Y < v_min) { v_min = _vertices[i].Y; }
+        if (_vertices[i].Y > _v_max) { _v_max = _vertices[i].Y; }
+    }
+
+    _v_line = v_min + _spacing/2;
+    _line_index = 0;
+    _running = true;
+    find_crossings();
+    return true;
+}
+
+
+/** @brief      Get the next hatch segment
+ *  @details    Segments are handed out in order along each line; every other line is handed out backwards (and with
+ *              its segments flipped) so the laser zig-zags across the fill.
+ *  @param      start Filled with the X and Y position where the segment starts
+ *  @param      end Filled with the X and Y position where the segment ends
+ *  @returns    @c true if a segment was found, @c false if the fill is finished
+ */
+bool hatch_fill::next_segment(hatch_point &start, hatch_point &end)
+{
+    while (_running)
+    {
+        //Hand out the next pair of crossings on this line, if there is one
+        if (_next_pair < _n_crossings/2)
+        {
+            uint8_t pair = _next_pair++;
+            float u_start;
+            float u_end;
+            if (_line_index % 2 == 0)   //Forward line
+            {
+                u_start = _crossings[2*pair];
+                u_end   = _crossings[2*pair + 1];
+            }
+            else                        //Backward line: go through the pairs from the end
+            {
+                pair = _n_crossings/2 - 1 - pair;
+                u_start = _crossings[2*pair + 1];
+                u_end   = _crossings[2*pair];
+            }
+            start = to_XY(u_start,_v_line);
+            end   = to_XY(u_end,_v_line);
+            return true;
+        }
+
+        //Line is finished; move on to the next one or stop if we're past the polygon
+        _v_line += _spacing;
+        _line_index++;
+        if (_v_line > _v_max)
+        {
+            _running = false;
+        }
+        else
+        {
+            find_crossings();
+        }
+    }
+    return false;
+}
+
+
+/** @brief      Check if a fill is running
+ *  @returns    @c true if there are hatch segments left to hand out
+ */
+bool hatch_fill::running(void)
+{
+    return _running;
+}
+
+
+/** @brief      Find and sort the places where the current hatch line crosses the polygon
+ *  @details    An edge is counted as crossed when the line is between its ends, including the lower end but not the
+ *              upper one. That way a line going exactly through a corner is counted once for the two edges that meet
+ *              there, and edges parallel to the hatch lines are never counted. Crossings with zero length between
+ *              them are dropped later by the caller since they make no move.
+ */
+void hatch_fill::find_crossings(void)
+{
+    _n_crossings = 0;
+    _next_pair = 0;
+
+    for (uint8_t i = 0; i < _n_vertices; i++)
+    {
+        hatch_point a = _vertices[i];
+        hatch_point b = _vertices[(i + 1) % _n_vertices];
+
+        if ((a.Y <= _v_line && _v_line < b.Y) || (b.Y <= _v_line && _v_line < a.Y))
+        {
+            float u = a.X + (_v_line - a.Y)*(b.X - a.X)/(b.Y - a.Y);
+
+            //Insertion sort: the list is never longer than the number of corners
+            uint8_t j = _n_crossings;
+            while (j > 0 && _crossings[j - 1] > u)
+            {
+                _crossings[j] = _crossings[j - 1];
+                j--;
+            }
+            _crossings[j] = u;
+            _n_crossings++;
+        }
+    }
+}
+
+
+/** @brief      Convert a point from the hatch frame back to X and Y
+ *  @param      u Position along the hatch line
+ *  @param      v Position across the hatch lines
+ *  @returns    The point in X and Y
+ */
+hatch_point hatch_fill::to_XY(float u, float v)
+{
+    hatch_point point;
+    point.X = u*_cos_angle - v*_sin_angle;
+    point.Y = u*_sin_angle + v*_cos_angle;
+    return point;
+}
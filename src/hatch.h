@@ -0,0 +1,97 @@
+/** @file       hatch.h
+ *  @brief      This file contains the header for the hatch.cpp file, which generates hatch fills on the laser.
+ *
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef HATCH_H
+#define HATCH_H
+
+#include "libraries&constants.h"
+
+// ========================================== Constants ==========================================
+
+// Maximum number of corners in a fill polygon (also the maximum number of crossings on one hatch line)
+#define HATCH_MAX_VERTICES 32
+
+// Smallest hatch spacing allowed, in mm. Anything smaller than this is a typo, not a fill.
+#define HATCH_MIN_SPACING 0.01
+
+
+// =========================================== Structs ===========================================
+
+/// A point in X and Y used to describe fill polygons and hatch segments
+struct hatch_point
+{
+    float X = 0;
+    float Y = 0;
+};
+
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which generates the hatch lines that fill a polygon.
+ *  @details    Instead of receiving hundreds of G0/G1 pairs from the CAM software, the laser can be given the outline
+ *              of a shape with a hatch angle and line spacing and make the fill itself. The polygon is stored rotated
+ *              into the hatch frame (@c u along the hatch lines, @c v across them) so that each hatch line is just a
+ *              line of constant @c v. Every line is clipped against all polygon edges with the even-odd rule, and
+ *              the clipped segments are handed out one at a time by @c next_segment(), so the translate task can
+ *              make them only as fast as space frees up in the ramp queue. Lines alternate direction to cut down on
+ *              travel moves.
+ */
+class hatch_fill
+{
+    protected:
+    hatch_point _vertices[HATCH_MAX_VERTICES];  // Polygon corners, in the rotated (u,v) hatch frame
+    uint8_t _n_vertices;                        // Number of corners in the polygon
+
+    float _cos_angle;                           // Cosine of the hatch angle
+    float _sin_angle;                           // Sine of the hatch angle
+    float _spacing;                             // Distance between hatch lines (mm)
+
+    float _v_line;                              // v position of the current hatch line
+    float _v_max;                               // Largest v position in the polygon
+    uint16_t _line_index;                       // Number of the current hatch line (used for direction)
+
+    float _crossings[HATCH_MAX_VERTICES];       // Sorted u positions where the current line crosses the polygon
+    uint8_t _n_crossings;                       // Number of crossings on the current line
+    uint8_t _next_pair;                         // Next pair of crossings to hand out
+
+    bool _running;                              // True while there are segments left to hand out
+
+    // Find where the current hatch line crosses the polygon
+    void find_crossings(void);
+
+    // Convert a point from the hatch frame back to X and Y
+    hatch_point to_XY(float u, float v);
+
+    public:
+    // Constructor
+    hatch_fill(void);
+
+    // Forget the polygon and stop any fill that is running
+    void reset(void);
+
+    // Set the hatch angle (deg) and line spacing (mm). Must be called before vertices are added.
+    bool set_hatch(float angle_deg, float spacing);
+
+    // Add a corner to the polygon
+    bool add_vertex(float X, float Y);
+
+    // Make the polygon a rectangle from a corner, a width, and a height
+    void set_rectangle(float X, float Y, float width, float height);
+
+    // Start handing out hatch segments for the polygon
+    bool begin(void);
+
+    // Get the next hatch segment; returns false once the fill is finished
+    bool next_segment(hatch_point &start, hatch_point &end);
+
+    // Check if a fill is running
+    bool running(void);
+};
+
+
+#endif //HATCH_H
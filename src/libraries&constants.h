@@ -23,6 +23,9 @@
 #endif
 #include "taskshare.h"
 #include "taskqueue.h"
+#include "spsc_ring.h"
+#include "seqlock_share.h"
+#include "blackboard.h"
 #include "baseshare.h"
 #include <HardwareTimer.h>
 #include <stdint.h>
@@ -35,14 +38,18 @@
 
 //ME507 Laser Library
 #include "control_2.h"
+#include "settings.h"
 #include "check_home.h"
 #include "debouncer.h"
 #include "encoder_task.h"
 #include "gcode.h"
+#include "binary_protocol.h"
+#include "telemetry.h"
 #include "Quad_Encoder.h"
 #include "TB6612FNG_Driver.h"
 #include "motor_task.h"
 #include "serial.h"
+#include "lz_decompress.h"
 // #include "kinematics.h"
 #include "stopwatch.h"
 #include "safetySupervisor.h"
@@ -50,9 +57,20 @@
 #include "temperature_task.h"
 #include "control_task.h"
 #include "motor_test_tasks.h"
+#include "benchmark_tasks.h"
+#include "hatch.h"
+#include "replay.h"
+#include "subprogram.h"
 #include "translate.h"
 #include "test_script.h"
 #include "laser.h"
+#include "stack_monitor.h"
+#include "cpu_load.h"
+#include "schedule.h"
+#include "machine_state.h"
+#include "events.h"
+#include "trace.h"
+#include "static_alloc.h"
 
 // ---------------------------------------------------------------------------------
 // -------------------- Define pin names as routed on the board -------------------- 
@@ -0,0 +1,204 @@
+/** @file       lz_decompress.cpp
+ *  @brief      This file contains the class which expands LZSS compressed gcode text sent by the host.
+ *  @details    The format is described in lz_decompress.h. The decoder works a few bits at a time and keeps its
+ *              place between calls, so it can be fed from the receive ring as bytes come in.
+ *
+ *  @date    10-19-2026 File Created
+ *
+*/
+
+#include "libraries&constants.h"
+
+
+/** @brief      Constructor for the lz_decoder class
+ */
+lz_decoder::lz_decoder(void)
+{
+    reset();
+}
+
+
+/** @brief      Start over with an empty window
+ *  @details    Called when the host switches to compressed text with @c $Z, since the host starts its own window
+ *              over at the same time.
+ */
+void lz_decoder::reset(void)
+{
+    memset(_window, 0, sizeof(_window));
+    _window_head = 0;
+    _input_bits = 0;
+    _bits = 0;
+    _n_bits = 0;
+    _state = LZ_STATE_TAG;
+    _count = 0;
+}
+
+
+/** @brief      Throw away leftover padding bits at the end of a block
+ *  @details    The host pads the last byte of each block with zeros. Those bits aren't an item, so they are dropped
+ *              and the next block starts with a new item. The window is kept.
+ */
+void lz_decoder::end_block(void)
+{
+    _input_bits = 0;
+    _bits = 0;
+    _n_bits = 0;
+    _state = LZ_STATE_TAG;
+}
+
+
+/** @brief      Check if the decoder has used up its input byte
+ *  @returns    @c true if @c put_input() should be called before @c get_output() can give more output
+ */
+bool lz_decoder::needs_input(void)
+{
+    return _input_bits == 0;
+}
+
+
+/** @brief      Give the decoder its next input byte
+ *  @param      byte The next byte of compressed text
+ */
+void lz_decoder::put_input(uint8_t byte)
+{
+    _input = byte;
+    _input_bits = 8;
+}
+
+
+/** @brief      Get the next byte of output
+ *  @param      byte Filled with the next byte of expanded text
+ *  @returns    @c true if a byte was output, @c false if the decoder needs more input first
+ */
+bool lz_decoder::get_output(uint8_t &byte)
+{
+    uint16_t bits;
+    for (;;)
+    {
+        switch (_state)
+        {
+            case LZ_STATE_TAG:
+                if (!get_bits(1, bits)) { return false; }
+                _state = bits ? LZ_STATE_LITERAL : LZ_STATE_INDEX;
+                break;
+
+            case LZ_STATE_LITERAL:
+                if (!get_bits(8, bits)) { return false; }
+                byte = (uint8_t)bits;
+                add_to_window(byte);
+                _state = LZ_STATE_TAG;
+                return true;
+
+            case LZ_STATE_INDEX:
+                if (!get_bits(LZ_WINDOW_BITS, bits)) { return false; }
+                _distance = bits + 1;
+                _state = LZ_STATE_COUNT;
+                break;
+
+            case LZ_STATE_COUNT:
+                if (!get_bits(LZ_LOOKAHEAD_BITS, bits)) { return false; }
+                _count = bits + 1;
+                _state = LZ_STATE_BACKREF;
+                break;
+
+            case LZ_STATE_BACKREF:
+                byte = _window[(_window_head - _distance) & (LZ_WINDOW_SIZE - 1)];
+                add_to_window(byte);
+                if (--_count == 0)
+                {
+                    _state = LZ_STATE_TAG;
+                }
+                return true;
+
+            default:
+                _state = LZ_STATE_TAG;
+        }
+    }
+}
+
+
+/** @brief      Read some bits of input
+ *  @details    Bits are read most significant first. If the input byte runs out part way, the bits read so far are
+ *              kept and the next call with the same number of bits carries on from there.
+ *  @param      n_bits Number of bits to read (up to 16)
+ *  @param      bits Filled with the bits once all of them have been read
+ *  @returns    @c true once all the bits have been read
+ */
+bool lz_decoder::get_bits(uint8_t n_bits, uint16_t &bits)
+{
+    while (_n_bits < n_bits)
+    {
+        if (_input_bits == 0)
+        {
+            return false;
+        }
+        _input_bits--;
+        _bits = (_bits << 1) | ((_input >> _input_bits) & 1);
+        _n_bits++;
+    }
+    bits = _bits;
+    _bits = 0;
+    _n_bits = 0;
+    return true;
+}
+
+
+/** @brief      Add a byte of output to the window
+ *  @param      byte The byte that was just output
+ */
+void lz_decoder::add_to_window(uint8_t byte)
+{
+    _window[_window_head] = byte;
+    _window_head = (_window_head + 1) & (LZ_WINDOW_SIZE - 1);
+}
+
+
+
+// ======================================== Subfunctions ========================================
+
+/** @brief      Get the next character of compressed text
+ *  @details    Output comes from the decompressor until it needs more input, which is taken from the ring. At the
+ *              end of each block, its padding bits are dropped and the length of the next block is read. A length
+ *              of 0 means the host is going back to plain text.
+ *  @param      lz The decompressor
+ *  @param      ring The receive ring the compressed bytes are in
+ *  @param      block_left Bytes left in the block being read; updated as they are used
+ *  @param      read_state State of the reader; set to READING at the end of compressed text
+ *  @param      byte Filled with the next character of text
+ *  @returns    @c true if there is a character, @c false if the ring ran out or compressed text ended
+ */
+bool next_compressed_char(lz_decoder &lz, byte_ring &ring, uint8_t &block_left, uint8_t &read_state, uint8_t &byte)
+{
+    uint8_t incoming;
+    for (;;)
+    {
+        if (lz.get_output(byte))
+        {
+            return true;
+        }
+
+        if (block_left > 0)         //The decompressor needs more of this block
+        {
+            if (!ring.get(incoming))
+            {
+                return false;
+            }
+            lz.put_input(incoming);
+            block_left--;
+        }
+        else                        //Block is finished; the next byte is the length of the next one
+        {
+            if (!ring.get(incoming))
+            {
+                return false;
+            }
+            lz.end_block();
+            block_left = incoming;
+            if (block_left == 0)
+            {
+                read_state = READING;
+                return false;
+            }
+        }
+    }
+}
@@ -0,0 +1,99 @@
+/** @file       lz_decompress.h
+ *  @brief      This file contains the header for the lz_decompress.cpp file, which expands compressed gcode text.
+ *  @details    The compression is LZSS in the same style as heatshrink: a stream of bits, most significant bit first,
+ *              made of two kinds of items:
+ *              - @c 1 followed by 8 bits: a literal byte
+ *              - @c 0 followed by @c LZ_WINDOW_BITS bits of (distance - 1) and @c LZ_LOOKAHEAD_BITS bits of
+ *                (count - 1): copy @c count bytes starting @c distance bytes back in what has already been output
+ *
+ *              The host sends the compressed text in blocks (see @c task_read_serial()). Each block holds whole lines,
+ *              and leftover bits at the end of a block are padding. The window carries on from one block to the next,
+ *              so later blocks can refer back to lines in earlier ones.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef LZ_DECOMPRESS_H
+#define LZ_DECOMPRESS_H
+
+#include "libraries&constants.h"
+
+// ========================================== Constants ==========================================
+
+// Size of the window of past output that back references can reach: 2^8 = 256 bytes
+#define LZ_WINDOW_BITS 8
+#define LZ_WINDOW_SIZE (1 << LZ_WINDOW_BITS)
+
+// Longest back reference: 2^4 = 16 bytes
+#define LZ_LOOKAHEAD_BITS 4
+
+// Largest block the host may send. A whole block has to fit in the receive buffer, with its length byte.
+#define LZ_MAX_BLOCK_SIZE (RX_BUFFER_SIZE - 1)
+
+// States of the decoder: what it is reading next
+#define LZ_STATE_TAG 0
+#define LZ_STATE_LITERAL 1
+#define LZ_STATE_INDEX 2
+#define LZ_STATE_COUNT 3
+#define LZ_STATE_BACKREF 4
+
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which expands LZSS compressed text one byte at a time.
+ *  @details    Input is given one byte at a time with @c put_input() whenever @c needs_input() says so, and output
+ *              is taken one byte at a time with @c get_output(). Nothing is ever expanded ahead of what is asked
+ *              for, so the reader can stop in the middle of a back reference when the read queue is full and carry
+ *              on later. The only memory used is the window of past output.
+ */
+class lz_decoder
+{
+    protected:
+    uint8_t _window[LZ_WINDOW_SIZE];    // Last LZ_WINDOW_SIZE bytes of output
+    uint16_t _window_head;              // Where the next byte of output goes in the window
+
+    uint8_t _input;                     // Input byte being read
+    uint8_t _input_bits;                // Bits of _input that haven't been read yet
+
+    uint16_t _bits;                     // Bits read so far for the item being read
+    uint8_t _n_bits;                    // Number of bits in _bits
+
+    uint8_t _state;                     // What the decoder is reading next
+    uint16_t _distance;                 // How far back the current back reference copies from
+    uint8_t _count;                     // Bytes left to copy in the current back reference
+
+    // Read some bits of input; returns false (and keeps the bits read so far) if the input runs out first
+    bool get_bits(uint8_t n_bits, uint16_t &bits);
+
+    // Add a byte of output to the window
+    void add_to_window(uint8_t byte);
+
+    public:
+    // Constructor
+    lz_decoder(void);
+
+    // Start over with an empty window
+    void reset(void);
+
+    // Throw away leftover padding bits at the end of a block
+    void end_block(void);
+
+    // Check if the decoder has used up its input byte
+    bool needs_input(void);
+
+    // Give the decoder its next input byte
+    void put_input(uint8_t byte);
+
+    // Get the next byte of output; returns false if the decoder needs more input first
+    bool get_output(uint8_t &byte);
+};
+
+
+// =========================================== Functions ===========================================
+
+// Get the next character of compressed text from the receive ring, for the reader task
+bool next_compressed_char(lz_decoder &lz, byte_ring &ring, uint8_t &block_left, uint8_t &read_state, uint8_t &byte);
+
+
+#endif //LZ_DECOMPRESS_H
@@ -0,0 +1,57 @@
+/** @file       machine_state.h
+ *  @brief      This file contains the machine's state, which every task reads from one blackboard.
+ *  @details    What the machine is doing, whether motion time runs and how fast, whether it is homed, its safety
+ *              warnings, the laser power and the jobs run are kept in one @c machine_state record in
+ *              @c machine_state_board, a @c blackboard (see blackboard.h) in the share table in static_alloc.h.
+ *              A task that needs several of them gets them all in one call, from one instant, and a task that
+ *              changes one changes just that field:
+ *
+ *              | Field             | Written by                                    | Read by                       |
+ *              |-------------------|-----------------------------------------------|-------------------------------|
+ *              | @c mode           | job and homing functions in events.h, reset   | status report                 |
+ *              | @c timing_mode    | real-time commands, reset, @c setup()         | encoders, status report       |
+ *              | @c feed_override  | real-time commands                            | encoders, status report       |
+ *              | @c homed_X/Y      | check home                                    |                               |
+ *              | @c warnings       | safety checks (none yet)                      |                               |
+ *              | @c laser_power    | the setpoint, every control period            | status report                 |
+ *              | @c jobs_started   | @c start_job()                                |                               |
+ *              | @c jobs_ended     | @c end_job()                                  |                               |
+ *
+ *              The events in events.h still wake the tasks waiting for something to happen; the blackboard is
+ *              for what is true now. The setpoint's positions stay in @c setpoint_share, which only the control
+ *              path writes, every period.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef MACHINE_STATE_H
+#define MACHINE_STATE_H
+
+#include "libraries&constants.h"
+
+
+// What the machine is doing
+#define MACHINE_MODE_IDLE 0         // No job is running
+#define MACHINE_MODE_JOB 1          // A job is running
+#define MACHINE_MODE_HOMING 2       // Homing
+#define MACHINE_MODE_RESET 3        // A soft reset has been asked for and isn't done yet
+#define MACHINE_MODE_ALARM 4        // A safety warning has stopped the machine
+
+
+/// The machine's state, kept in @c machine_state_board
+struct machine_state
+{
+    uint8_t mode = MACHINE_MODE_IDLE;           // MACHINE_MODE_...
+    uint8_t timing_mode = TIMING_MODE_PAUSED;   // TIMING_MODE_... from translate.h: whether motion time runs
+    uint8_t feed_override = 100;                // Percent of the programmed feed motion time runs at
+    bool homed_X = false;                       // Whether the X limit switch has been found since homing started
+    bool homed_Y = false;                       // Whether the Y limit switch has been found since homing started
+    uint8_t warnings = 0;                       // Safety warnings; 0 if there are none
+    uint8_t laser_power = 0;                    // Laser power of the segment being run in percent
+    uint16_t jobs_started = 0;                  // Jobs started since power on
+    uint16_t jobs_ended = 0;                    // Jobs ended (by M2 or a reset) since power on
+};
+
+
+#endif //MACHINE_STATE_H
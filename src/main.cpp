@@ -13,24 +13,13 @@
 
 #include "libraries&constants.h"
 
-//Shares and queues should go here
+#ifdef HOST_TASK_GRAPH
+#include "host_hal.h"
+#endif //HOST_TASK_GRAPH
 
-// Queues for serial printing and reading
-Queue<char[LINE_BUFFER_SIZE]> chars_to_print_queue(WRITE_Q_SIZE,"char array printer");
-Queue<char[LINE_BUFFER_SIZE]> read_chars_queue(READ_Q_SIZE,"read_val");
-
-// Shares for Encoder A and B
-Share<encoder_output> enc_A_output_share ("Encoder A variables");
-Share<encoder_output> enc_B_output_share ("Encoder B variables");
-
-// Queue for ramp segments
-Queue<ramp_segment_coefficients> ramp_segment_coefficient_queue(RAMP_COEFF_Q_SIZE,"Ramp Coefficients");
-
-// Share for signalling to check home
-Share<bool> check_home_share ("Homing Flag");
-
-// Share for signalling timing mode
-Share<uint8_t> timing_mode_share ("Timing Mode");
+//Shares and queues should go here: they are rows of the tables in static_alloc.h, made in static memory
+QUEUE_TABLE(DEFINE_QUEUE)
+SHARE_TABLE(DEFINE_SHARE)
 
 // Queue for Temperature Task 
 // Queue<float> temperature_data (10,"Temp C Data");  
@@ -65,9 +54,21 @@ void setup()
     delay (2000);
     Serial << endl << "\nLaser Program Initializing" << endl;
 
-    //Initialize shares
-    check_home_share.put(false);
-    timing_mode_share.put(TIMING_MODE_PAUSED);
+    //Load the settings saved in flash, before any task uses them
+    load_settings();
+
+    //Start the trace recorder, so it sees the tasks start
+    trace_start();
+
+    //Initialize shares and events
+    machine_state start_state;
+    machine_state_board.put(start_state);
+    init_events();
+    motor_setpoint start_setpoint;
+    setpoint_share.put(start_setpoint);
+    status_period_share.put(0);
+    telemetry_settings telemetry_off;
+    telemetry_settings_share.put(telemetry_off);
 
 
     //======================================================================================
@@ -77,8 +78,12 @@ void setup()
     // #define MATTHEW_TESTING 1
     // #define ETHAN_TESTING 2
     // #define TEST_CONST_VELOCITY 3
+    #if !defined(HOST_TASK_GRAPH) && !defined(TEST_BENCHMARK)
     #define TEST_CONTROL_PATH 4
+    #endif
     // #define TEST_SCRIPT 5
+    // #define TEST_BENCHMARK 6
+    // HOST_TASK_GRAPH is defined by the native build in platformio.ini, and TEST_BENCHMARK by the native_benchmark build
 
     //======================================================================================
     
@@ -104,6 +109,14 @@ void setup()
                  3,                             // Priority
                  NULL);                         // Task handle
 
+    // Create a task to print status reports at a fixed rate
+    xTaskCreate (task_status_report,            //Task Function name
+                 "Status Report",               // Name for printouts
+                 1000,                          // Stack size
+                 NULL,                          // Parameters for task fn.
+                 2,                             // Priority
+                 NULL);                         // Task handle
+
     // Create a task to translate command codes to the contorller
     xTaskCreate(task_translate,                 // Task Function name
                  "Translating",                 // Name for printouts
@@ -452,7 +465,7 @@ void setup()
 
     Serial << "Running Constant Velocity Test" << endl;
 
-    timing_mode_share.put(TIMING_MODE_RUNNING);
+    machine_state_board.update(&machine_state::timing_mode, TIMING_MODE_RUNNING);
 
 
     // Create a task to read inputs from the serial port
@@ -510,41 +523,18 @@ void setup()
 
     Serial << "Running Control Path Test" << endl;
 
-    timing_mode_share.put(TIMING_MODE_RUNNING);
-
-    // Create a task to read inputs from the serial port
-    xTaskCreate (task_print_serial,             //Task Function name
-                 "Printing Serial",             // Name for printouts
-                 1000,                          // Stack size
-                 NULL,                          // Parameters for task fn.
-                 3,                             // Priority
-                 NULL);                         // Task handle
-
-    // Create a task that test runs a single motor
-    xTaskCreate (task_test_control_path,        // Task Function name
-                 "Motor Test",                  // Name for printouts
-                 1000,                          // Stack size
-                 NULL,                          // Parameters for task fn.
-                 1,                             // Priority
-                 NULL);                         // Task handle
-
-    //Task to run encoder A
-    xTaskCreate(task_encoder_A,                 // Task Function name
-                "Run encoder A",                // Name for printouts
-                4096,                           // Stack size
-                NULL,                           // Parameters for task fn.
-                13,                             // Priority
-                NULL);                          // Task handle
+    machine_state_board.update(&machine_state::timing_mode, TIMING_MODE_RUNNING);
 
-    //Task to run encoder B
-    xTaskCreate(task_encoder_B,                 // Task Function name
-                "Run encoder B",                // Name for printouts
-                4096,                           // Stack size
-                NULL,                           // Parameters for task fn.
-                13,                             // Priority
-                NULL);                          // Task handle
+    // Tasks are made in their own memory, with the stacks and priorities in static_alloc.h
+    start_print_serial();                       // Print to the serial port
+    start_control_path();                       // Run the control path
+    start_encoder_A();                          // Run encoder A
+    start_encoder_B();                          // Run encoder B
+    start_stack_monitor();                      // Watch the tasks' stacks
+    start_cpu_load();                           // Keep each task's CPU use
     
     Serial << "Tasks created" << endl;
+    print_schedule_report();
 
     vTaskStartScheduler();
 
@@ -576,6 +566,75 @@ void setup()
 
 
     #endif //TEST_SCRIPT
+
+    //======================================================================================
+
+    #ifdef TEST_BENCHMARK
+
+    Serial << "Running Benchmarks" << endl;
+
+    // The benchmark tasks run above the printing task, so printing doesn't get in; the shares are timed after the
+    // queues, then moving items one at a time against in bulk
+    start_print_serial();
+    start_benchmark_queues();
+    start_benchmark_shares();
+    start_benchmark_bulk();
+
+    Serial << "Tasks created" << endl;
+    print_schedule_report();
+
+    vTaskStartScheduler();
+
+    #endif //TEST_BENCHMARK
+
+    //======================================================================================
+
+    //Whole task graph, for running on a PC with the native build (see lib/FreeRTOS_POSIX)
+    #ifdef HOST_TASK_GRAPH
+
+    Serial << "Running Host Task Graph" << endl;
+
+    machine_state_board.update(&machine_state::timing_mode, TIMING_MODE_RUNNING);
+
+    // Stand-in motors, so the control loops turn the encoders. A positive duty cycle drives the second direction pin
+    // HIGH (see TB6612FNG::setDutyCycle()), which is AIN1 and BIN1 the way the motors are made in the control task.
+    // Encoder B's pins are flipped on the board (see task_encoder_B()), so its motor counts down going forward.
+    // About 6000 rpm at full duty cycle, with 44 counts a motor rev; the time constant is a guess for a small motor.
+    host_motor_config motor_A_config = {PWM_A, AIN1, AIN2, STBY, TIM3, 4400, 0.05};
+    host_motor_config motor_B_config = {PWM_B, BIN2, BIN1, STBY, TIM1, 4400, 0.05};
+    host_motor_attach(motor_A_config);
+    host_motor_attach(motor_B_config);
+
+    // Make the tasks in their own memory (see static_alloc.h), keeping their handles to give them step costs for
+    // virtual time
+    TaskHandle_t read_serial_task = start_read_serial();
+    TaskHandle_t print_serial_task = start_print_serial();
+    TaskHandle_t status_report_task = start_status_report();
+    TaskHandle_t translate_task = start_translate();
+    TaskHandle_t control_task = start_control_path();
+    TaskHandle_t encoder_A_task = start_encoder_A();
+    TaskHandle_t encoder_B_task = start_encoder_B();
+    TaskHandle_t stack_monitor_task = start_stack_monitor();
+    TaskHandle_t cpu_load_task = start_cpu_load();
+
+    // Time each task's step takes on the board, besides its hardware calls, for runs on virtual time (see
+    // host_hal.h). Estimates for the 80 MHz core: the translate and control tasks do the floating point math.
+    vTaskHostSetStepCost(read_serial_task, 30000);
+    vTaskHostSetStepCost(print_serial_task, 20000);
+    vTaskHostSetStepCost(status_report_task, 40000);
+    vTaskHostSetStepCost(translate_task, 150000);
+    vTaskHostSetStepCost(control_task, 100000);
+    vTaskHostSetStepCost(encoder_A_task, 15000);
+    vTaskHostSetStepCost(encoder_B_task, 15000);
+    vTaskHostSetStepCost(stack_monitor_task, 50000);
+    vTaskHostSetStepCost(cpu_load_task, 50000);
+
+    Serial << "Tasks created" << endl;
+    print_schedule_report();
+
+    vTaskStartScheduler();
+
+    #endif //HOST_TASK_GRAPH
 }
 
 
@@ -81,6 +81,16 @@
  *  use this library on a different MCU be advised that there is no current existing support for this from our documentation,
  *  so, YMMV. 
  * 
+ *  The firmware can also be built and run on a Linux PC with @c pio @c run @c -e @c native. The @c FreeRTOS_POSIX
+ *  and @c Arduino_host libraries in @c lib/ stand in for STM32FreeRTOS and the Arduino core: tasks run on threads one
+ *  at a time by priority, and the serial port is standard input and output. The native build runs the whole task
+ *  graph (see @c HOST_TASK_GRAPH in main.cpp), so a G-code file can be piped in without the board. Stand-in motors
+ *  turn the encoders so the control loops close, the serial port can be a pseudo-terminal for the Python tools, and
+ *  every pin, PWM and timer call is counted per task and per loop (see host_hal.h). With @c LASER_VIRTUAL=1 the tasks
+ *  run on a virtual clock moved by modelled costs, so a long job runs in seconds, the same way every run, and reports
+ *  missed deadlines and how full each queue got over time. @c pio @c run @c -e @c native_benchmark instead runs the
+ *  benchmarks in benchmark_tasks.cpp, such as the lock-free ring of ramp segments (spsc_ring.h) against a @c Queue.
+ * 
  * 
  * 
  * 
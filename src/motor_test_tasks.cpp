@@ -11,15 +11,18 @@
 
 
 // Shares for Encoders A and B
-extern Share<encoder_output> enc_A_output_share;
-extern Share<encoder_output> enc_B_output_share;
+extern seqlock_share<encoder_output> enc_A_output_share;
+extern seqlock_share<encoder_output> enc_B_output_share;
 
 // Queue for Ramp Coefficients
-extern Queue<ramp_segment_coefficients> ramp_segment_coefficient_queue;
+extern spsc_ring<ramp_segment_coefficients, RAMP_COEFF_Q_SIZE> ramp_segment_coefficient_queue;
 
 //Queue that holds read character arrays (not necessary here except for testing)
 extern Queue<char[LINE_BUFFER_SIZE]> read_chars_queue;
 
+// Share for what binary telemetry sends
+extern Share<telemetry_settings> telemetry_settings_share;
+
 
 
 /** @brief      Task which runs a motor at a set duty cycle and reads average speed.
@@ -221,7 +224,7 @@ void task_test_control_path(void* p_params)
     uint8_t motA_pin_2 = AIN1;          uint8_t motB_pin_2 = BIN1;
 
     //Set up variables
-    float DC_A;                         float DC_B;
+    float DC_A = 0;                     float DC_B = 0;
     encoder_output enc_read_A;          encoder_output enc_read_B;
 
     //Create motor instances
@@ -235,9 +238,21 @@ void task_test_control_path(void* p_params)
     //Initialize setpoint of time class to calculate specific setpoints based on time
     setpoint_of_time xyoft;
 
-    //Set up controllers
-    PID_Controller control_A(PATH_TEST_CONTROL_KP, PATH_TEST_CONTROL_KI, PATH_TEST_CONTROL_KD, PATH_TEST_MOTOR_DEADBAND, 100, -100, PATH_TEST_DRV_FILTER_TAU);
-    PID_Controller control_B(PATH_TEST_CONTROL_KP, PATH_TEST_CONTROL_KI, PATH_TEST_CONTROL_KD, PATH_TEST_MOTOR_DEADBAND, 100, -100, PATH_TEST_DRV_FILTER_TAU);
+    //Binary telemetry of the control loop, sent when turned on with $TM
+    telemetry_recorder telemetry;
+    telemetry_sample sample;
+    telemetry_settings telemetry_now;
+
+    //Set up controllers from the settings (see settings.h); they're updated whenever a setting changes
+    PID_Controller control_A(get_setting(SETTING_KP), get_setting(SETTING_KI), get_setting(SETTING_KD), 
+                             get_setting(SETTING_DEADBAND), 100, -100, get_setting(SETTING_DRV_FILTER_TAU));
+    PID_Controller control_B(get_setting(SETTING_KP), get_setting(SETTING_KI), get_setting(SETTING_KD), 
+                             get_setting(SETTING_DEADBAND), 100, -100, get_setting(SETTING_DRV_FILTER_TAU));
+    uint16_t settings_version = get_settings_version();
+
+    //Versions of the encoder samples last used, so a sample isn't run through the controllers twice
+    uint32_t enc_version_A = 0;
+    uint32_t enc_version_B = 0;
 
     print_serial("Control Path Test Initialized\n");
 
@@ -293,10 +308,10 @@ void task_test_control_path(void* p_params)
             break;
     }
     // Printouts for reference
-    print_serial("\nKP: ");   print_serial((float)PATH_TEST_CONTROL_KP);
-    print_serial("\nKI: ");   print_serial((float)PATH_TEST_CONTROL_KI);
-    print_serial("\nKD: ");   print_serial((float)PATH_TEST_CONTROL_KD);
-    print_serial("\nMotor Deadband: ");   print_serial((float)PATH_TEST_MOTOR_DEADBAND); print_serial("\n\n");
+    print_serial("\nKP: ");   print_serial(control_A.get_KP());
+    print_serial("\nKI: ");   print_serial(control_A.get_KI());
+    print_serial("\nKD: ");   print_serial(control_A.get_KD());
+    print_serial("\nMotor Deadband: ");   print_serial(control_A.get_deadband()); print_serial("\n\n");
 
 
     // Create ramp coefficients for simulation
@@ -334,22 +349,45 @@ void task_test_control_path(void* p_params)
     //Task for loop
     for(;;)
     {
-        //Read off encoder position and velocity
+        //If a setting was changed with $n=value, put the new gains into the running controllers
+        if (get_settings_version() != settings_version)
+        {
+            settings_version = get_settings_version();
+            apply_pid_settings(control_A);
+            apply_pid_settings(control_B);
+        }
+
+        //Read off encoder position and velocity, if the encoder tasks have run since last time
+        bool new_sample = false;
         if(motor_choice == LASER_CUTTER_MOTOR_A || motor_choice == LASER_CUTTER_MOTOR_BOTH)
         {
-            enc_A_output_share.get(enc_read_A);
-            enc_read_A.pos = convert_units(enc_read_A.pos,ENC_POSITION_MODE_BELT_MM);
-            enc_read_A.vel = convert_units(enc_read_A.vel,ENC_VELOCITY_MODE_BELT_MM_PER_SEC);
-            // enc_read_A.pos = convert_units(enc_read_A.pos,ENC_POSITION_MODE_REVOUT);
-            // enc_read_A.vel = convert_units(enc_read_A.vel,ENC_VELOCITY_MODE_RPMOUT);
+            if (enc_A_output_share.get_if_newer(enc_read_A, enc_version_A))
+            {
+                new_sample = true;
+                enc_read_A.pos = convert_units(enc_read_A.pos,ENC_POSITION_MODE_BELT_MM);
+                enc_read_A.vel = convert_units(enc_read_A.vel,ENC_VELOCITY_MODE_BELT_MM_PER_SEC);
+                // enc_read_A.pos = convert_units(enc_read_A.pos,ENC_POSITION_MODE_REVOUT);
+                // enc_read_A.vel = convert_units(enc_read_A.vel,ENC_VELOCITY_MODE_RPMOUT);
+            }
         }
         if(motor_choice == LASER_CUTTER_MOTOR_B || motor_choice == LASER_CUTTER_MOTOR_BOTH)
         {
-            enc_B_output_share.get(enc_read_B);
-            enc_read_B.pos = convert_units(enc_read_B.pos,ENC_POSITION_MODE_BELT_MM);
-            enc_read_B.vel = convert_units(enc_read_B.vel,ENC_VELOCITY_MODE_BELT_MM_PER_SEC);
-            // enc_read_B.pos = convert_units(enc_read_B.pos,ENC_POSITION_MODE_REVOUT);
-            // enc_read_B.vel = convert_units(enc_read_B.vel,ENC_VELOCITY_MODE_RPMOUT);
+            if (enc_B_output_share.get_if_newer(enc_read_B, enc_version_B))
+            {
+                new_sample = true;
+                enc_read_B.pos = convert_units(enc_read_B.pos,ENC_POSITION_MODE_BELT_MM);
+                enc_read_B.vel = convert_units(enc_read_B.vel,ENC_VELOCITY_MODE_BELT_MM_PER_SEC);
+                // enc_read_B.pos = convert_units(enc_read_B.pos,ENC_POSITION_MODE_REVOUT);
+                // enc_read_B.vel = convert_units(enc_read_B.vel,ENC_VELOCITY_MODE_RPMOUT);
+            }
+        }
+
+        //A stale sample has the same time as the last one, which the controllers' derivative would divide by, so
+        //wait a tick for the encoders instead
+        if (!new_sample)
+        {
+            vTaskDelay(1);
+            continue;
         }
 
         // Get the setpoint for this moment in time. 
@@ -380,6 +418,22 @@ void task_test_control_path(void* p_params)
             Motor_B.setDutyCycle(DC_B);
         }
 
+        //Send this run of the control loop as telemetry
+        sample.time = (motor_choice == LASER_CUTTER_MOTOR_B) ? enc_read_B.time : enc_read_A.time;
+        sample.A_setpoint = setpoint.A_pos;         sample.B_setpoint = setpoint.B_pos;
+        sample.A_pos = enc_read_A.pos;              sample.B_pos = enc_read_B.pos;
+        sample.A_error = control_A.get_error();     sample.B_error = control_B.get_error();
+        sample.A_duty = DC_A;                       sample.B_duty = DC_B;
+        sample.S = setpoint.S;
+        telemetry.sample(sample);
+
+        //With telemetry on, it carries everything below, so run at the encoder rate and skip the text
+        telemetry_settings_share.get(telemetry_now);
+        if (telemetry_now.fields != 0)
+        {
+            vTaskDelay(control_path_period);
+            continue;
+        }
 
         //Print the encoder positions and velocity
         if(motor_choice == LASER_CUTTER_MOTOR_A)
@@ -465,13 +519,14 @@ void task_test_gcode_response(void* p_params)
         
         integral += (enc_read.time - last_time)*error;
 
-        DC = error*PATH_TEST_CONTROL_KP + integral*PATH_TEST_CONTROL_KI;
+        DC = error*get_setting(SETTING_KP) + integral*get_setting(SETTING_KI);
 
         last_time = enc_read.time;
 
         //Account for motor deadband
-        if(DC>=0)  {  DC = DC*( 100 - PATH_TEST_MOTOR_DEADBAND)/100 - PATH_TEST_MOTOR_DEADBAND;  }
-        else       {  DC = DC*( 100 - PATH_TEST_MOTOR_DEADBAND)/100 + PATH_TEST_MOTOR_DEADBAND;  }
+        float deadband = get_setting(SETTING_DEADBAND);
+        if(DC>=0)  {  DC = DC*( 100 - deadband)/100 - deadband;  }
+        else       {  DC = DC*( 100 - deadband)/100 + deadband;  }
         
         Motor.setDutyCycle(DC);
 
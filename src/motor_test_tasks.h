@@ -23,6 +23,7 @@
 
 // Parameters for path test
 #define PATH_TEST_MOTOR LASER_CUTTER_MOTOR_BOTH             // LASER_CUTTER_MOTOR_A, LASER_CUTTER_MOTOR_B, LASER_CUTTER_MOTOR_BOTH
+// Gains, deadband and filter are the defaults of settings $0 to $4; change them with $n=value (see settings.h)
 #define PATH_TEST_CONTROL_KP 1
 #define PATH_TEST_CONTROL_KI 0.5
 #define PATH_TEST_CONTROL_KD 0
@@ -0,0 +1,365 @@
+/** @file       replay.cpp
+ *  @brief      This file contains the class which packs moves into compact records, and the class which uses it to
+ *              record a job and play it back for multi-pass cutting.
+ *  @details    The commands and the recorded format are described in replay.h. Recording happens as moves go into
+ *              the ramp queue, and playback goes back through the same translator, so replayed passes run at motion
+ *              speed without the host sending or the decoder reading anything.
+ *
+ *  @date    10-19-2026 File Created
+ *
+*/
+
+#include "libraries&constants.h"
+
+
+// ========================================  Class: move_codec ========================================
+
+/** @brief      Constructor for the move_codec class
+ */
+move_codec::move_codec(void)
+{
+    XYSFvalues origin;
+    reset(origin);
+}
+
+
+/** @brief      Start over from a known position, power and feedrate
+ *  @param      start The values the first record is packed or unpacked against
+ */
+void move_codec::reset(XYSFvalues start)
+{
+    _X_fixed = lround(start.X*BIN_POS_SCALE);
+    _Y_fixed = lround(start.Y*BIN_POS_SCALE);
+    _S = start.S;
+    _F = constrain(lround(start.F), 1, 0xFFFF);
+}
+
+
+/** @brief      Pack a move into a record
+ *  @details    X and Y are rounded to 1/@c BIN_POS_SCALE mm and F to whole mm/min. Changes in X and Y are used
+ *              when they fit in an @c int16_t, and absolute positions when they don't.
+ *  @param      move The move to pack
+ *  @param      record Filled with the record; must have room for @c MOVE_RECORD_MAX_SIZE bytes
+ *  @returns    Size of the record in bytes
+ */
+uint8_t move_codec::encode(XYSFvalues move, uint8_t *record)
+{
+    int32_t X_fixed = lround(move.X*BIN_POS_SCALE);
+    int32_t Y_fixed = lround(move.Y*BIN_POS_SCALE);
+    int32_t dX = X_fixed - _X_fixed;
+    int32_t dY = Y_fixed - _Y_fixed;
+    uint16_t F = constrain(lround(move.F), 1, 0xFFFF);
+
+    uint8_t flags = BIN_OP_MOVE;
+    if (dX < INT16_MIN || dX > INT16_MAX || dY < INT16_MIN || dY > INT16_MAX)
+    {
+        flags |= BIN_FLAG_ABS;
+    }
+    if (move.S != _S)
+    {
+        flags |= BIN_FLAG_S;
+    }
+    if (F != _F)
+    {
+        flags |= BIN_FLAG_F;
+    }
+
+    //Write it, little endian like binary frames
+    uint8_t *p = record;
+    *p++ = flags;
+    if (flags & BIN_FLAG_ABS)
+    {
+        for (uint8_t i = 0; i < 4; i++) { *p++ = (uint8_t)(X_fixed >> (8*i)); }
+        for (uint8_t i = 0; i < 4; i++) { *p++ = (uint8_t)(Y_fixed >> (8*i)); }
+    }
+    else
+    {
+        *p++ = (uint8_t)dX;     *p++ = (uint8_t)(dX >> 8);
+        *p++ = (uint8_t)dY;     *p++ = (uint8_t)(dY >> 8);
+    }
+    if (flags & BIN_FLAG_S)
+    {
+        *p++ = move.S;
+    }
+    if (flags & BIN_FLAG_F)
+    {
+        *p++ = (uint8_t)F;      *p++ = (uint8_t)(F >> 8);
+    }
+
+    _X_fixed = X_fixed;
+    _Y_fixed = Y_fixed;
+    _S = move.S;
+    _F = F;
+    return p - record;
+}
+
+
+/** @brief      Unpack a record
+ *  @param      record The record, as packed by @c encode()
+ *  @param      move Filled with the move
+ *  @returns    Size of the record in bytes
+ */
+uint8_t move_codec::decode(const uint8_t *record, XYSFvalues &move)
+{
+    const uint8_t *p = record;
+    uint8_t flags = *p++;
+    if (flags & BIN_FLAG_ABS)
+    {
+        _X_fixed = (int32_t)((uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+        _Y_fixed = (int32_t)((uint32_t)p[4] | (uint32_t)p[5] << 8 | (uint32_t)p[6] << 16 | (uint32_t)p[7] << 24);
+        p += 8;
+    }
+    else
+    {
+        _X_fixed += (int16_t)(p[0] | p[1] << 8);
+        _Y_fixed += (int16_t)(p[2] | p[3] << 8);
+        p += 4;
+    }
+    if (flags & BIN_FLAG_S)
+    {
+        _S = *p++;
+    }
+    if (flags & BIN_FLAG_F)
+    {
+        _F = p[0] | p[1] << 8;
+        p += 2;
+    }
+
+    move.X = (float)_X_fixed/BIN_POS_SCALE;
+    move.Y = (float)_Y_fixed/BIN_POS_SCALE;
+    move.S = _S;
+    move.F = _F;
+    return p - record;
+}
+
+
+
+// ========================================  Class: job_replay ========================================
+
+/** @brief      Constructor for the job_replay class
+ */
+job_replay::job_replay(void)
+{
+    _length = 0;
+    _n_moves = 0;
+    _state = REPLAY_STATE_EMPTY;
+    _source_bytes = 0;
+    _last_record_size = 0;
+    _passes = 0;
+    _pass = 0;
+}
+
+
+/** @brief      Start recording moves
+ *  @details    Anything recorded before is thrown away. The position, power and feedrate at the start are kept, so
+ *              every pass can start from the same place and the first move only needs to carry what changed.
+ *  @param      start Where the laser head will be when the next move starts, from @c coreXY_to_AB::get_last_XYSF()
+ */
+void job_replay::start_recording(XYSFvalues start)
+{
+    _start = start;
+    _codec.reset(start);
+
+    _length = 0;
+    _n_moves = 0;
+    _source_bytes = 0;
+    _last_record_size = 0;
+    _state = REPLAY_STATE_RECORDING;
+}
+
+
+/** @brief      Stop recording moves
+ *  @returns    @c true if there is a job that can be replayed, @c false if nothing was recorded or the job didn't fit
+ *              in the buffer
+ */
+bool job_replay::stop_recording(void)
+{
+    if (_state == REPLAY_STATE_RECORDING)
+    {
+        _state = (_n_moves > 0) ? REPLAY_STATE_READY : REPLAY_STATE_EMPTY;
+    }
+    return _state == REPLAY_STATE_READY;
+}
+
+
+/** @brief      Record a move that was just put in the ramp queue
+ *  @details    Does nothing unless recording. If the move doesn't fit in the buffer, recording stops and the job is
+ *              marked as too big to replay; the move itself has still been run.
+ *  @param      move The move that was sent to the translator
+ */
+void job_replay::record(XYSFvalues move)
+{
+    if (_state != REPLAY_STATE_RECORDING)
+    {
+        return;
+    }
+
+    uint8_t record[MOVE_RECORD_MAX_SIZE];
+    uint8_t size = _codec.encode(move, record);
+    if (_length + size > REPLAY_BUFFER_SIZE)
+    {
+        _state = REPLAY_STATE_OVERFLOW;
+        return;
+    }
+
+    memcpy(&_data[_length], record, size);
+    _length += size;
+    _n_moves++;
+    _last_record_size = size;
+}
+
+
+/** @brief      Count bytes the host sent while recording
+ *  @details    These are the bytes each replayed pass saves the host from sending again. Does nothing unless
+ *              recording.
+ *  @param      n_bytes Number of bytes the host sent for a line or frame
+ */
+void job_replay::count_source_bytes(uint16_t n_bytes)
+{
+    if (_state == REPLAY_STATE_RECORDING)
+    {
+        _source_bytes += n_bytes;
+    }
+}
+
+
+/** @brief      Start playing the recording back
+ *  @param      passes Number of times to run the recorded moves
+ *  @param      S Power for cutting moves in percent, or less than 0 to use the recorded power
+ *  @param      F Feedrate for cutting moves in mm/min, or 0 or less to use the recorded feedrate
+ *  @param      S_step Power added on each pass after the first one, in percent
+ *  @param      F_step Feedrate added on each pass after the first one, in mm/min
+ *  @returns    @c true if playback started, @c false if there is no job to replay
+ */
+bool job_replay::start_replay(uint8_t passes, float S, float F, float S_step, float F_step)
+{
+    if (_state != REPLAY_STATE_READY || passes == 0)
+    {
+        return false;
+    }
+    _passes = passes;
+    _pass = 0;
+    _pass_started = false;
+    _S_set = S;
+    _F_set = F;
+    _S_step = S_step;
+    _F_step = F_step;
+    _state = REPLAY_STATE_REPLAYING;
+    return true;
+}
+
+
+/** @brief      Get the next move to play
+ *  @details    Each pass starts with a travel move back to where recording started, then runs the recorded moves.
+ *              Cutting moves get the power and feedrate asked for in @c start_replay(); travel moves (power 0)
+ *              are played as recorded. Moves can come out with no length (a travel to where the head already is,
+ *              or two points that round to the same place), so the caller should skip those.
+ *  @param      move Filled with the next move
+ *  @returns    @c true if there is a move, @c false once all passes are done
+ */
+bool job_replay::next_move(XYSFvalues &move)
+{
+    if (_state != REPLAY_STATE_REPLAYING)
+    {
+        return false;
+    }
+
+    while (_pass_started && _read_index >= _length)
+    {
+        //End of a pass
+        _pass++;
+        _pass_started = false;
+        if (_pass >= _passes)
+        {
+            _state = REPLAY_STATE_READY;
+            return false;
+        }
+    }
+
+    if (!_pass_started)
+    {
+        //Go back to the start with the laser off
+        _codec.reset(_start);
+        _read_index = 0;
+        _pass_started = true;
+
+        move.X = _start.X;      move.Y = _start.Y;      move.S = 0;     move.F = get_setting(SETTING_TRAVEL_SPEED);
+        return true;
+    }
+
+    //Read the next recorded move
+    XYSFvalues recorded;
+    _read_index += _codec.decode(&_data[_read_index], recorded);
+
+    move.X = recorded.X;
+    move.Y = recorded.Y;
+    if (recorded.S == 0)
+    {
+        move.S = 0;
+        move.F = recorded.F;
+    }
+    else
+    {
+        float S = ((_S_set >= 0) ? _S_set : recorded.S) + _pass*_S_step;
+        float F = ((_F_set > 0) ? _F_set : recorded.F) + _pass*_F_step;
+        move.S = constrain(lround(S), 0, 100);
+        move.F = (F < 1) ? 1 : F;
+    }
+    return true;
+}
+
+
+/** @brief      Stop recording or playing back
+ *  @details    Used by a soft reset. A recording that was cut short is thrown away, since it isn't the whole job; a
+ *              recording that was being played back is kept and can be played again.
+ */
+void job_replay::abort(void)
+{
+    if (_state == REPLAY_STATE_RECORDING)
+    {
+        _state = REPLAY_STATE_EMPTY;
+        _length = 0;
+        _n_moves = 0;
+    }
+    else if (_state == REPLAY_STATE_REPLAYING)
+    {
+        _state = REPLAY_STATE_READY;
+    }
+}
+
+
+
+/** @brief      Get the state of the job replay
+ *  @returns    One of the @c REPLAY_STATE_ values
+ */
+uint8_t job_replay::get_state(void)
+{
+    return _state;
+}
+
+
+/** @brief      Get the size of the last move recorded
+ *  @returns    Bytes used by the last move, or 0 if nothing has been recorded
+ */
+uint8_t job_replay::get_last_record_size(void)
+{
+    return _last_record_size;
+}
+
+
+/** @brief      Get the number of bytes the host didn't have to send again
+ *  @returns    Bytes sent for the recorded part of the job, times the number of passes played back so far
+ */
+uint32_t job_replay::get_bytes_saved(void)
+{
+    return _source_bytes*_pass;
+}
+
+
+/** @brief      Get the number of moves recorded
+ *  @returns    Number of moves in the recording
+ */
+uint16_t job_replay::get_n_moves(void)
+{
+    return _n_moves;
+}
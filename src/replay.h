@@ -0,0 +1,147 @@
+/** @file       replay.h
+ *  @brief      This file contains the header for the replay.cpp file, which records a job and runs it again for
+ *              multi-pass cutting.
+ *  @details    Cutting thick material takes the same outline several times. Instead of the host sending the whole
+ *              outline for every pass, it sends it once between @c $JR and @c $JE and then asks for more passes
+ *              with @c $JP:
+ *
+ *              | Command                          | Does                                                       |
+ *              |----------------------------------|------------------------------------------------------------|
+ *              | @c $JR                           | Start recording the moves that follow (they still run)     |
+ *              | @c $JE                           | Stop recording                                             |
+ *              | @c $JP @c P<passes> ...          | Run the recorded moves again @c P times                    |
+ *
+ *              @c $JP can also take @c S and @c F to set the power (1.00 is 100%) and feedrate of every cutting
+ *              move, and @c I and @c J to change the power and feedrate by that much more on each pass. Travel
+ *              moves are always run as they were recorded.
+ *
+ *              Moves are recorded by @c move_codec the same way binary frames carry them (see binary_protocol.h),
+ *              without the sync, sequence number and CRC: a flags byte, X and Y as @c int16_t changes in
+ *              1/@c BIN_POS_SCALE mm (or @c int32_t absolute positions with @c BIN_FLAG_ABS), then S and F only when
+ *              they change. Most moves take 5 or 6 bytes.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "libraries&constants.h"
+
+// ========================================== Constants ==========================================
+
+// Largest recorded move: flags, 2 x int32, S, F
+#define MOVE_RECORD_MAX_SIZE 12
+
+// Bytes of RAM for recorded moves: at 5 or 6 bytes a move, about 1500 moves
+#define REPLAY_BUFFER_SIZE 8192
+
+// Bytes a binary frame has on top of a recorded move: sync, sequence number and CRC
+#define REPLAY_BIN_FRAME_EXTRA 3
+
+// Most passes one $JP can ask for
+#define REPLAY_MAX_PASSES 100
+
+// States of the job replay
+#define REPLAY_STATE_EMPTY 0            // Nothing recorded
+#define REPLAY_STATE_RECORDING 1        // Moves are being recorded
+#define REPLAY_STATE_READY 2            // A job is recorded and can be replayed
+#define REPLAY_STATE_REPLAYING 3        // Recorded moves are being run again
+#define REPLAY_STATE_OVERFLOW 4         // The job didn't fit in the buffer; it can't be replayed
+
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which packs moves into compact records and unpacks them again.
+ *  @details    Records only hold what changed since the last move, so the codec keeps the last position, power and
+ *              feedrate. Records have to be unpacked in the same order they were packed, starting from the same
+ *              values given to @c reset().
+ */
+class move_codec
+{
+    protected:
+    int32_t _X_fixed;                   // Last X position in fixed point
+    int32_t _Y_fixed;                   // Last Y position in fixed point
+    uint8_t _S;                         // Last S
+    uint16_t _F;                        // Last F, rounded to mm/min
+
+    public:
+    // Constructor
+    move_codec(void);
+
+    // Start over from a known position, power and feedrate
+    void reset(XYSFvalues start);
+
+    // Pack a move into a record of up to MOVE_RECORD_MAX_SIZE bytes; returns its size
+    uint8_t encode(XYSFvalues move, uint8_t *record);
+
+    // Unpack a record; returns its size
+    uint8_t decode(const uint8_t *record, XYSFvalues &move);
+};
+
+
+/** @brief      Class which records moves into a compact stream in RAM and plays them back for extra passes.
+ *  @details    Moves are recorded as they go to the ramp queue, so text gcode, binary frames and hatch fills are
+ *              all recorded the same way. Playback hands out one move at a time with @c next_move(), so the
+ *              translate task can run it only as fast as the ramp queue frees up, like a hatch fill. Each pass
+ *              starts with a travel move back to where the recording started.
+ */
+class job_replay
+{
+    protected:
+    uint8_t _data[REPLAY_BUFFER_SIZE];  // Recorded moves
+    uint16_t _length;                   // Bytes of recorded moves
+    uint16_t _n_moves;                  // Number of recorded moves
+    uint8_t _state;                     // One of the REPLAY_STATE_ values
+
+    XYSFvalues _start;                  // Where the laser head was when recording started
+    move_codec _codec;                  // Packs moves while recording and unpacks them while playing
+
+    uint32_t _source_bytes;             // Bytes the host sent for the recorded part of the job
+    uint8_t _last_record_size;          // Size of the last move recorded
+
+    uint16_t _read_index;               // Next byte of _data to play
+    uint8_t _passes;                    // Passes asked for
+    uint8_t _pass;                      // Pass being played, counting from 0
+    bool _pass_started;                 // True once the travel to the start of this pass is done
+
+    float _S_set;                       // Power for cutting moves (percent), or < 0 to use the recorded power
+    float _F_set;                       // Feedrate for cutting moves, or <= 0 to use the recorded feedrate
+    float _S_step;                      // Power added on each pass (percent)
+    float _F_step;                      // Feedrate added on each pass
+
+    public:
+    // Constructor
+    job_replay(void);
+
+    // Start recording, from where the laser head is now
+    void start_recording(XYSFvalues start);
+
+    // Stop recording; returns false if the job didn't fit
+    bool stop_recording(void);
+
+    // Record a move that was just put in the ramp queue (does nothing unless recording)
+    void record(XYSFvalues move);
+
+    // Count bytes the host sent while recording, for the report
+    void count_source_bytes(uint16_t n_bytes);
+
+    // Start playing the recording back
+    bool start_replay(uint8_t passes, float S, float F, float S_step, float F_step);
+
+    // Get the next move to play; returns false once all passes are done
+    bool next_move(XYSFvalues &move);
+
+    // Stop recording or playing back, for a soft reset
+    void abort(void);
+
+    // Getters
+    uint8_t get_state(void);
+    uint8_t get_last_record_size(void);
+    uint32_t get_bytes_saved(void);
+    uint16_t get_n_moves(void);
+};
+
+
+#endif //REPLAY_H
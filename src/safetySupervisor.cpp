@@ -8,18 +8,15 @@
 #include "libraries&constants.h"
 
 
-// some extern share from the controller to tell the safety supervisor to turn on the fan
-extern Share<bool> fan_state;
-Share<uint8_t> warning_code ("Safety Event Flag");
-
 
 /** @brief   Safety Supervising Task. 
  *  @details This task monitors incoming results from our temperature sensor and limit switches and 
  *           if an error condition occurs this task sets different flags to make safety stuff happen 
  *           e.g. turning off the laser, turning on the fan before cutting begins, and not letting the 
  *           cutting start until the top of the laser's enclosure is closed. 
- *           Fan: The fan will turn on when the laser turns on (communicated through a flag). Then,
- *           when the laser is off for more than 3 seconds in a row, the fan will turn off.
+ *           Fan: The fan will turn on when a job starts (@c EVENT_JOB_RUNNING). Then, when no job has
+ *           run for @c FAN_RUN_ON_MS in a row, the fan will turn off. The task sleeps on the job events in
+ *           between, so it uses no CPU while nothing changes.
  *           Limit: 
  *  @param   p_params A pointer to function parameters which we don't use.
  */
@@ -32,88 +29,31 @@ void safety_task (void* p_params)
     // - - - - - FAN - - - - - 
 
 
-    // FAN STATE MACHINE PSEUDO CODE
-    // if laser is on (we get the flag from Control) change state to on state to turn on the fan.
-    // else if laser is done cutting change state to off state after delaying for a few seconds to clear out the enclosure 
-
-
-    // Initialize "state" to the default state of zero
-    uint8_t state = 0;
+    // FAN PSEUDO CODE
+    // when a job starts turn on the fan.
+    // when the job ends wait a few seconds to clear out the enclosure, unless another job starts, then turn it off
 
     uint8_t fan_pin = PB10;                 // PB10 = 6     This is the pin for the transistor gate
     // Set up pin for fan
     pinMode(fan_pin, OUTPUT);               // Do we need to set this up?
-
-    // This is where the fan state from the share will be put
-    bool fan_flag;
-
-    // Set up threshold and counter to make sure the fan will only turn off 
-    // once the laser has been off for a consecutive 3 seconds
-    float wait_time = 30000;                                // this is 3 seconds
-    float time_threshold = wait_time / float(safety_period);          // = 300000 (0.1ms) / 100 (ms/count)
-    // float time_threshold = wait_time / (safety_period);          // = 300000 (0.1ms) / 100 (ms/count)
-
-    // Serial << "time threshold = " << time_threshold << endl;         // For testing
-    uint32_t counter = 0;        
+    digitalWrite(fan_pin, LOW);             // Initialize fan in the off position
 
 
     for (;;)
     {
+        // Sleep until a job starts, then turn the fan on
+        wait_for_events(EVENT_JOB_RUNNING, false, portMAX_DELAY);
+        digitalWrite(fan_pin, HIGH);
 
-        // get the fan state from the share
-        fan_state.get(fan_flag);
-        // Serial << "Fan Flag = " << fan_flag << endl;
-        
-        // Initialize fan in the off position
-        bool fan_switch = 0;
-
-        // State 0
-        if (state == 0)                         // The fan is off in state 0
+        // Sleep until the job ends; if another starts within the run-on time, keep going
+        do
         {
-            if (fan_flag == 0)                  // Flag is down (0)
-            {
-                fan_switch = LOW;                   // Turn fan off
-                Serial << "Fan is off, fan switch = " << fan_switch << "            " << '\r';
-            }
-            
-            else if (fan_flag == 1)             // Flag is up (1)
-            {
-                state = 1;                      // Go to state 1 (which will turn the fan on)
-            }
+            wait_for_events(EVENT_JOB_ENDED, false, portMAX_DELAY);
         }
+        while (wait_for_events(EVENT_JOB_RUNNING, false, FAN_RUN_ON_MS) & EVENT_JOB_RUNNING);
 
-        // State 1
-        else if (state == 1)                    // The fan is on in state 1
-        {
-            
-            if (fan_flag == 0)
-            {   // This makes sure fan doesn't turn off for 3 seconds after the laser turns off
-                if (++counter >= time_threshold)     // Compare "counter" to "timethreshhold"
-                {
-                    state = 0;                  // If threshhold is met, reset back to State 0
-                    Serial << "Final count = " << counter << "            " << endl;
-
-                    counter = 0;                // Reset counter so it can be used again  
-                }
-                
-                else
-                {
-                    state = 1;                  // Stays in state 1
-                    Serial << "Counting... fan_switch = " << fan_switch << "            " << '\r';
-                }
-            }
-
-            if (fan_flag == 1)
-            {
-                fan_switch = HIGH;              // Turn fan on (this will at least happen the first time we go to state 1, because fan_flag = 1)
-                state = 1;                      // Keep in state 1
-                counter = 0;                    // Reset counter so it can be used again
-                Serial << "Fan is on, fan_switch = " << fan_switch << "            " << '\r';
-            }
-        }
-        
-        // give the fan either a HIGH or LOW command per each run of the loop
-        digitalWrite(fan_pin, fan_switch);      // write "fan_pin" to either HIGH or LOW (ON or OFF)
+        // No job for the whole run-on time, so turn the fan off
+        digitalWrite(fan_pin, LOW);
 
 
         
@@ -175,10 +115,6 @@ void safety_task (void* p_params)
 
         // digitalWrite (D4, HIGH);
 
-        // This type of delay waits until it has been the given number of RTOS
-        // ticks since the task previously began running. This prevents timing
-        // inaccuracy due to not accounting for how long the task took to run
-        vTaskDelay (safety_period);
     }
 
 }
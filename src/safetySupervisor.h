@@ -12,6 +12,8 @@
 
 #include "libraries&constants.h"
 void safety_task (void* p_params);
-const TickType_t safety_period = 100;                   // Try not to make this less than 50 (5ms) if possible cause the code doesn't like it    
+// The task sleeps on the job events in events.h rather than running on a period; the period in the task table in
+// static_alloc.h is the fan's run-on, the shortest time between its wakes
+#define FAN_RUN_ON_MS safety_period          // ms the fan stays on after a job ends, to clear out the enclosure
 
 #endif // _SAFETYSUPERVISOR_H
@@ -0,0 +1,175 @@
+/** @file       schedule.cpp
+ *  @brief      This file contains the check that every task can meet its deadline, which prints a schedulability
+ *              report before the scheduler starts.
+ *  @details    See schedule.h. The report is printed straight to the serial port, since the printing task isn't
+ *              running yet when it is made.
+ *
+ *  @date    10-19-2026 File Created
+ *
+*/
+
+#include "libraries&constants.h"
+#include <math.h>
+
+
+///@cond
+// What the check knows about one task
+struct schedule_record
+{
+    TaskHandle_t task;              // The task
+    uint32_t period_ms;             // Time between the starts of its loops; 0 if it runs once
+    uint32_t deadline_ms;           // Time each loop must be done in
+    uint32_t wcet_us;               // Longest time around its loop; 0 if not measured
+};
+
+static schedule_record schedule_records[SCHEDULE_TASKS];
+static uint8_t schedule_record_count = 0;
+///@endcond
+
+
+/** @brief      Add a task to the ones checked
+ *  @details    Called by the @c start_ function of every task in static_alloc.h. Tasks past @c SCHEDULE_TASKS
+ *              aren't checked.
+ *  @param      task The task's handle; nothing is added if it is NULL
+ *  @param      period_ms Time between the starts of its loops in ms, or 0 for a task which runs once
+ *  @param      deadline_ms Time each loop must be done in, in ms
+ *  @param      wcet_us Longest time around its loop in us, or 0 if it hasn't been measured
+ */
+void schedule_add(TaskHandle_t task, uint32_t period_ms, uint32_t deadline_ms, uint32_t wcet_us)
+{
+    if (task == NULL || schedule_record_count >= SCHEDULE_TASKS)
+    {
+        return;
+    }
+    schedule_records[schedule_record_count] = {task, period_ms, deadline_ms, wcet_us};
+    schedule_record_count++;
+}
+
+
+/** @brief      Work out a task's worst response time
+ *  @details    Starts with the task's own loop time and adds, for every other periodic task at its priority or
+ *              above, its loop time for each time it can start while the task waits, until the total stops
+ *              growing or passes the deadline.
+ *  @param      index The task's place in the records
+ *  @returns    The response time in us, or @c UINT32_MAX if it passes the deadline
+ */
+static uint32_t response_time(uint8_t index)
+{
+    const schedule_record &record = schedule_records[index];
+    UBaseType_t priority = uxTaskPriorityGet(record.task);
+    uint32_t deadline_us = record.deadline_ms * 1000;
+    uint32_t response = record.wcet_us;
+
+    for (;;)
+    {
+        uint32_t next = record.wcet_us;
+        for (uint8_t other = 0; other < schedule_record_count; other++)
+        {
+            const schedule_record &higher = schedule_records[other];
+            if (other == index || higher.period_ms == 0 || uxTaskPriorityGet(higher.task) < priority)
+            {
+                continue;
+            }
+            uint32_t period_us = higher.period_ms * 1000;
+            next += (response + period_us - 1) / period_us * higher.wcet_us;
+        }
+        if (next > deadline_us)
+        {
+            return UINT32_MAX;
+        }
+        if (next == response)
+        {
+            return response;
+        }
+        response = next;
+    }
+}
+
+
+/** @brief      Check every task added against its deadline and print the schedulability report
+ *  @details    The columns and checks are described in schedule.h. Each row ends with @c ok, @c MISS if the task
+ *              can pass its deadline, or @c ? if its loop time hasn't been measured, in which case the check counts
+ *              it as taking no time.
+ *  @returns    @c true if every periodic task meets its deadline
+ */
+bool print_schedule_report(void)
+{
+    char row[2*LINE_BUFFER_SIZE];
+    bool all_met = true;
+    uint32_t periodic = 0;
+    uint32_t load_ppm = 0;
+
+    Serial << "Schedule check" << endl;
+    Serial << "task             prio period deadline  wcet_us  resp_us" << endl;
+    for (uint8_t index = 0; index < schedule_record_count; index++)
+    {
+        const schedule_record &record = schedule_records[index];
+        if (record.period_ms == 0)
+        {
+            snprintf(row, sizeof(row), "%-16s %4lu   runs once, not checked", pcTaskGetName(record.task),
+                     (unsigned long)uxTaskPriorityGet(record.task));
+            Serial << row << endl;
+            continue;
+        }
+
+        uint32_t response = response_time(index);
+        const char *result = (response == UINT32_MAX) ? "MISS" : (record.wcet_us == 0) ? "?" : "ok";
+        char response_text[12];
+        if (response == UINT32_MAX)
+        {
+            strcpy(response_text, "-");
+            all_met = false;
+        }
+        else
+        {
+            snprintf(response_text, sizeof(response_text), "%lu", (unsigned long)response);
+        }
+        snprintf(row, sizeof(row), "%-16s %4lu %6lu %8lu %8lu %8s %s", pcTaskGetName(record.task),
+                 (unsigned long)uxTaskPriorityGet(record.task), (unsigned long)record.period_ms,
+                 (unsigned long)record.deadline_ms, (unsigned long)record.wcet_us, response_text, result);
+        Serial << row << endl;
+
+        periodic++;
+        load_ppm += record.wcet_us * 1000 / record.period_ms;
+    }
+    if (periodic == 0)
+    {
+        return all_met;
+    }
+
+    // The rate monotonic bound, n(2^(1/n) - 1), in parts per million
+    uint32_t bound_ppm = (uint32_t)(1e6f * periodic * (powf(2.0f, 1.0f / periodic) - 1.0f));
+    snprintf(row, sizeof(row), "CPU use %lu.%lu%%, rate monotonic bound %lu.%lu%% for %lu tasks",
+             (unsigned long)(load_ppm / 10000), (unsigned long)(load_ppm / 1000 % 10),
+             (unsigned long)(bound_ppm / 10000), (unsigned long)(bound_ppm / 1000 % 10), (unsigned long)periodic);
+    Serial << row << endl;
+    Serial << (all_met ? "Every task meets its deadline" : "Some tasks can miss their deadlines") << endl;
+
+    // Pairs where the task with the longer deadline has the higher priority
+    bool any_wrong = false;
+    for (uint8_t upper = 0; upper < schedule_record_count; upper++)
+    {
+        const schedule_record &above = schedule_records[upper];
+        for (uint8_t lower = 0; lower < schedule_record_count; lower++)
+        {
+            const schedule_record &below = schedule_records[lower];
+            if (above.period_ms == 0 || below.period_ms == 0
+                || uxTaskPriorityGet(above.task) <= uxTaskPriorityGet(below.task)
+                || above.deadline_ms <= below.deadline_ms)
+            {
+                continue;
+            }
+            if (!any_wrong)
+            {
+                Serial << "Priorities the wrong way round for their deadlines:" << endl;
+                any_wrong = true;
+            }
+            snprintf(row, sizeof(row), "  %.16s (%lu, %lu ms) is above %.16s (%lu, %lu ms)",
+                     pcTaskGetName(above.task), (unsigned long)uxTaskPriorityGet(above.task),
+                     (unsigned long)above.deadline_ms, pcTaskGetName(below.task),
+                     (unsigned long)uxTaskPriorityGet(below.task), (unsigned long)below.deadline_ms);
+            Serial << row << endl;
+        }
+    }
+    return all_met;
+}
@@ -0,0 +1,54 @@
+/** @file       schedule.h
+ *  @brief      This file contains the header for the check that every task can meet its deadline, which prints a
+ *              schedulability report before the scheduler starts.
+ *  @details    Every task made with a @c start_ function in static_alloc.h is added with the period, deadline and
+ *              longest loop time from its row in the task table. @c print_schedule_report() then works out each
+ *              task's worst response time: its own loop time, plus the loop times of every task at its priority or
+ *              above, as many times as each can run while it waits. It goes round until the time stops growing
+ *              or passes the deadline.
+ *
+ *              | Column    | Meaning                                                                   |
+ *              |-----------|---------------------------------------------------------------------------|
+ *              | prio      | FreeRTOS priority; higher runs first                                      |
+ *              | period    | Time between the starts of its loops in ms (the shortest, if it changes)  |
+ *              | deadline  | Time each loop must be done in, in ms                                     |
+ *              | wcet_us   | Longest time around its loop in us, from the table                        |
+ *              | resp_us   | Worst response time in us, or @c - if it passes the deadline              |
+ *
+ *              Tasks of the same priority take turns, so each is counted as holding up the other. Time in
+ *              interrupts, the scheduler and critical sections isn't counted, so a task should have some room left.
+ *              A task with a period of 0 runs once and isn't checked; nor does it hold up the others, since it is
+ *              only run in the benchmarks, on its own.
+ *
+ *              After the response times the report gives the share of the CPU the tasks take and the rate
+ *              monotonic bound for that many tasks, under which any set of periodic tasks fits, and lists the
+ *              pairs of tasks whose priorities are the wrong way round for their deadlines: a task with a shorter
+ *              deadline should be at a higher priority, or it waits behind tasks that have more time.
+ *
+ *              The loop times in the table are measured on a PC, on virtual time (see lib/FreeRTOS_POSIX), where
+ *              the host report prints each task's longest loop. They are the step costs and hardware call costs
+ *              of the model there, so they should be checked on the board. A loop time of 0 hasn't been measured,
+ *              and the task is marked @c ? in the report.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include "libraries&constants.h"
+
+
+// Most tasks the check keeps track of
+#define SCHEDULE_TASKS 16
+
+
+// Add a task to the ones checked, with its period and deadline in ms and its longest loop in us
+void schedule_add(TaskHandle_t task, uint32_t period_ms, uint32_t deadline_ms, uint32_t wcet_us);
+
+// Check every task added against its deadline and print the report; returns true if every task meets it
+bool print_schedule_report(void);
+
+
+#endif //SCHEDULE_H
@@ -0,0 +1,202 @@
+/** @file       seqlock_share.h
+ *  @brief      This file contains a share which one task writes and any task reads, without critical sections.
+ *  @details    A @c Share turns off interrupts while its data is copied in or out. For data like the encoder outputs,
+ *              which one task writes often and others read, a sequence count does the job instead. The writer keeps
+ *              two copies of the data and fills in the one readers aren't using, then counts up the sequence, which
+ *              points readers at it. A reader notes the sequence, copies the copy it points to, and checks the
+ *              sequence again; if it moved, the writer may have started on that copy in the meantime, so the reader
+ *              tries again.
+ *
+ *              The writer never waits. With two copies a reader also never waits on a writer that is partway through
+ *              a write, which matters on one core: a reader with a higher priority than the writer can't let the
+ *              writer finish, so with one copy it would try again forever. A reader only tries again when a whole
+ *              write finished while it was copying, which for an encoder writing every 10 ms is very rare; the
+ *              tries are counted, and shown in the list of shares.
+ *
+ *              Only one task (or ISR) may write to each share. The sequence also tells readers whether there is
+ *              new data: @c get_if_newer() only copies the data if it was written since the reader last looked.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef SEQLOCK_SHARE_H
+#define SEQLOCK_SHARE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "baseshare.h"
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which shares data from one writer task to any number of reader tasks, without locking.
+ *  @details    See the top of this file.
+ */
+template <class DataType> class seqlock_share : public BaseShare
+{
+    protected:
+    DataType _copies[2];                    // The data; readers use the one the sequence points to
+    std::atomic<uint32_t> _sequence;        // Writes so far; the newest data is in _copies[_sequence & 1]
+    std::atomic<uint32_t> _reads;           // Reads so far
+    std::atomic<uint32_t> _contended;       // Reads which had to try again because of a write
+
+    // Copy the data for a sequence, and check it wasn't written over while copying
+    bool try_read(uint32_t sequence, DataType &recv_data);
+
+    public:
+    // Constructor
+    seqlock_share(const char *p_name = NULL);
+
+    // Write the data; one task or ISR only
+    void put(const DataType &new_data);
+    void ISR_put(const DataType &new_data) { put(new_data); }
+
+    // Read the data
+    void get(DataType &recv_data);
+    void ISR_get(DataType &recv_data) { get(recv_data); }
+
+    // Read the data only if it was written since a version
+    bool get_if_newer(DataType &recv_data, uint32_t &version);
+
+    /** @brief      Get the version of the data, which counts up with every write
+     *  @returns    The version; 0 if nothing has been written yet
+     */
+    uint32_t version(void) { return _sequence.load(std::memory_order_acquire); }
+
+    /** @brief      Get the reads so far
+     *  @returns    Reads, including those from @c get_if_newer() which found new data
+     */
+    uint32_t reads(void) { return _reads.load(std::memory_order_relaxed); }
+
+    /** @brief      Get the reads so far which had to try again because the data was written while they copied it
+     *  @returns    Contended reads
+     */
+    uint32_t contended_reads(void) { return _contended.load(std::memory_order_relaxed); }
+
+    // Get the counts of what has been done with the share
+    void get_stats(share_stats &copy);
+
+    // Print the share in the list of shares
+    void print_in_list(Print &print_dev);
+};
+
+
+// ========================================  Class: seqlock_share ========================================
+
+/** @brief      Constructor for the seqlock_share class
+ *  @details    Like a @c Share, the data isn't set until the first @c put().
+ *  @param      p_name A name for the list of shares
+ */
+template <class DataType>
+seqlock_share<DataType>::seqlock_share(const char *p_name)
+    : BaseShare(p_name), _sequence(0), _reads(0), _contended(0)
+{
+    stats.kind = "seqlk";
+}
+
+
+/** @brief      Write the data; only one task or ISR may write to a share
+ *  @details    Fills in the copy readers aren't using, then points them at it.
+ *  @param      new_data The data
+ */
+template <class DataType>
+void seqlock_share<DataType>::put(const DataType &new_data)
+{
+    uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+    _copies[(sequence + 1) & 1] = new_data;
+    _sequence.store(sequence + 1, std::memory_order_release);
+}
+
+
+/** @brief      Copy the data for a sequence, and check the writer didn't start on that copy while copying
+ *  @param      sequence The sequence read before copying
+ *  @param      recv_data Filled with the data
+ *  @returns    @c true if the copy is whole; @c false if it must be tried again
+ */
+template <class DataType>
+bool seqlock_share<DataType>::try_read(uint32_t sequence, DataType &recv_data)
+{
+    recv_data = _copies[sequence & 1];
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return _sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+
+/** @brief      Read the data
+ *  @details    Tries again if the writer wrote the copy being read while copying it, and counts the read as
+ *              contended if so.
+ *  @param      recv_data Filled with the data
+ */
+template <class DataType>
+void seqlock_share<DataType>::get(DataType &recv_data)
+{
+    _reads.fetch_add(1, std::memory_order_relaxed);
+    if (try_read(_sequence.load(std::memory_order_acquire), recv_data))
+    {
+        return;
+    }
+    _contended.fetch_add(1, std::memory_order_relaxed);
+    while (!try_read(_sequence.load(std::memory_order_acquire), recv_data)) {}
+}
+
+
+/** @brief      Read the data only if it was written since a version
+ *  @details    Lets a task skip work on data it has already seen. Start with a version of 0 to get the first data.
+ *  @param      recv_data Filled with the data if it is newer, and left alone if not
+ *  @param      version The version the caller last read; set to the version read, if it is newer
+ *  @returns    @c true if the data was newer and was read
+ */
+template <class DataType>
+bool seqlock_share<DataType>::get_if_newer(DataType &recv_data, uint32_t &version)
+{
+    uint32_t sequence = _sequence.load(std::memory_order_acquire);
+    if (sequence == version)
+    {
+        return false;
+    }
+    _reads.fetch_add(1, std::memory_order_relaxed);
+    if (!try_read(sequence, recv_data))
+    {
+        _contended.fetch_add(1, std::memory_order_relaxed);
+        do
+        {
+            sequence = _sequence.load(std::memory_order_acquire);
+        }
+        while (!try_read(sequence, recv_data));
+    }
+    version = sequence;
+    return true;
+}
+
+
+/** @brief      Get the counts of what has been done with the share
+ *  @details    Writes are counted by the version, and reads by the share's own counters. A seqlock share never
+ *              waits, so the reads which had to try again are shown as its failed gets.
+ *  @param      copy Filled with the counts
+ */
+template <class DataType>
+void seqlock_share<DataType>::get_stats(share_stats &copy)
+{
+    copy = stats;
+    copy.puts = version();
+    copy.gets = reads();
+    copy.failed_gets = contended_reads();
+}
+
+
+/** @brief      Print the share's name and contended reads out of all reads, then the next share in the list
+ *  @param      print_dev Where to print
+ */
+template <class DataType>
+void seqlock_share<DataType>::print_in_list(Print &print_dev)
+{
+    print_dev.printf("%-16sseqshare\t", name);
+    print_dev << contended_reads() << '/' << reads() << endl;
+
+    if (p_next != NULL)
+    {
+        p_next->print_in_list(print_dev);
+    }
+}
+
+#endif //SEQLOCK_SHARE_H
@@ -16,21 +16,65 @@
 //Shares and queues should go here
 extern Queue<char[LINE_BUFFER_SIZE]> chars_to_print_queue;
 extern Queue<char[LINE_BUFFER_SIZE]> read_chars_queue;
+extern Queue<XYSFvalues> binary_move_queue;
+extern spsc_ring<ramp_segment_coefficients, RAMP_COEFF_Q_SIZE> ramp_segment_coefficient_queue;
+extern blackboard<machine_state> machine_state_board;
+extern seqlock_share<encoder_output> enc_A_output_share;
+extern seqlock_share<encoder_output> enc_B_output_share;
+extern Share<uint16_t> status_period_share;
+extern Queue<telemetry_frame> telemetry_queue;
 
 ///@endcond
 
+//Time taken to build the last status report and the longest one so far, in microseconds
+static uint32_t status_build_time = 0;
+static uint32_t status_build_time_max = 0;
+
+//The status report task, so it can be woken when the period is set; NULL until it runs
+static TaskHandle_t status_report_handle = NULL;
+
 
 //---------------------------PYTHON SCRIPT COMMUNICATION FILES---------------------------
 
 
 
 /** @brief      Task which reads the serial port and puts it in a queue.
- *  @details    This task reads an input into the serial port (from the python UI
- *              script presumably) and reads it. The task has 3 main states, which are READY,
- *              READING, and NOT_READY. The task will remain in READY initially until it is 
- *              asked "Ready?" through the serial port, in which case it will transition to
- *              READING to read the data and put it into the read_chars queue. If the read_chars
- *              queue is full, the task will go to the NOT_READY state until space has been cleared.
+ *  @details    This task reads an input into the serial port (from the python UI script 
+ *              presumably) and splits it into lines for the read_chars queue. Instead of asking
+ *              for each line with a "Ready?"/"Ready" handshake, the host streams lines using 
+ *              character counting: it keeps track of how many bytes it has sent which haven't
+ *              been answered yet, and keeps that at or below @c RX_BUFFER_SIZE, which the task
+ *              announces when it starts with @c [RX:<size>]. Each line is answered with @c ok or
+ *              @c error:N by the translate task once it has been used (see @c acknowledge_line()),
+ *              which is what frees up its bytes on the host side.
+ * 
+ *              Every time the task runs, all waiting bytes are moved from the serial port into a
+ *              ring of @c RX_BUFFER_SIZE bytes, and lines are taken out of the ring for as long as
+ *              the read_chars queue has room. Lines end with @c \n or @c \0; @c \r is ignored.
+ * 
+ *              Real-time commands (see serial.h) are picked out as bytes come off the serial port in the
+ *              READING state, before they get to the ring, so they act within one task period however
+ *              full the ring and queues are. A @c ? right after @c Ready is left alone for older hosts.
+ *              In the BINARY and COMPRESSED states every byte is data, so real-time commands aren't
+ *              looked for there. A soft reset throws away every line in the ring and the read_chars
+ *              queue, and the line being split off along with the rest of it still to come, without an
+ *              @c ok or @c error for any of them. The @c [RX:<size>] the translate task prints once it has
+ *              reset tells the host that none of the lines it was waiting on will be answered, so it
+ *              should start its count from an empty buffer.
+ *              The task has 3 states:
+ *              - READING: Bytes are text lines. A @c Ready? line is still answered with @c Ready
+ *                for older hosts, a @c $B line switches to the BINARY state, and a @c $Z line 
+ *                switches to the COMPRESSED state. None of these are queued or answered with @c ok.
+ *              - BINARY: Bytes are binary motion frames (see binary_protocol.h), decoded straight 
+ *                into the binary_move queue. Each frame is acknowledged with @c b<seq> once its 
+ *                move is queued, and a frame with a bad CRC or sequence number is answered with 
+ *                @c rb<seq>, the sequence number the host should resend from. An end frame takes
+ *                the task back to the READING state.
+ *              - COMPRESSED: Bytes are blocks of compressed text (see lz_decompress.h), each one a
+ *                length byte followed by that many bytes. The text that comes out is split into 
+ *                lines exactly like in the READING state. A block length of 0 goes back to READING.
+ *                The host counts each block against the receive buffer until the last line in it
+ *                has been answered.
  *  @param      p_params A pointer to function parameters which we don't use.
  */
 void task_read_serial(void* p_params)
@@ -40,154 +84,618 @@ void task_read_serial(void* p_params)
     // possible value, essentially forever for a real-time control program
     Serial.setTimeout (0xFFFFFFFF);
 
-    //incoming byte data variable (comes as bytes, need to translate to char)
-    int16_t incomingByte = -1;
+    //Receive ring: the host may fill this without waiting for an answer
+    byte_ring rx_ring;
 
-    // String line = "\0";
+    //Line being put together from the ring
     char line[LINE_BUFFER_SIZE];
-    //Set all values in line to null character
     memset(line,'\0',sizeof(line));
+    uint8_t line_length = 0;
+    bool line_overflow = false;             //Set if the line was longer than the line buffer
+
+    //Last byte from the host that went into the ring, and whether to drop bytes up to the next line end because a
+    //soft reset threw away the start of their line
+    uint8_t last_received = '\n';
+    bool skip_to_line_end = false;
+
+    //State variable: reading text lines, binary frames or compressed text
+    uint8_t read_state = READING;
+
+    //Decoder for binary motion frames
+    binary_decoder bin_decoder;
 
-    ///@cond
-    //For testing
-    #define TESTING_WITHOUT_PYTHON
-    bool line_one = 1;
-    ///@endcond
+    //Decompressor for compressed text, and the bytes left in the block being read
+    lz_decoder lz;
+    uint8_t block_left = 0;
 
-    //State variable to continue to read or not (if read queue gets close to full)
-    uint8_t read_state = READY;
-    // bool state_state = true;
-    //Sign that we need to update python that we're ready
-    // bool update_input = true;
+    //Number of letters of "Ready" just received, so the ? of an older host's Ready? isn't taken as a status request
+    const char ready_text[] = "Ready";
+    uint8_t ready_match = 0;
 
     //Turn off LED to start
     pinMode(LED_BUILTIN,OUTPUT);
     digitalWrite(LED_BUILTIN,LOW);
 
+    //Tell the host how many bytes it may have waiting for an answer
+    print_serial("[RX:" + String(RX_BUFFER_SIZE) + "]\n");
+
     //Task for loop
     for(;;)
     {
-        switch (read_state)
+        //Move everything waiting in the serial port into the ring, picking out real-time commands on the way
+        while (Serial.available() > 0)
         {
-            // State READY means that the mc is ready and waiting for python to tell it that it has something 
-            // to send. Python will ask "Ready?" when it has something to send. 
-            case READY:
-
-                // if (state_state)
-                // {
-                //     print_serial("READY STATE");
-                //     state_state = false;
-                // }
-                
-                if (Serial.available() > 0)     //If there's something coming from python...
-                { 
-                    incomingByte = Serial.read();               //Read the incoming byte
-                    line[strlen(line)] = (char)incomingByte;    //Add character to line
+            uint8_t incoming = (uint8_t)Serial.peek();
+            if (read_state == READING && is_realtime_command(incoming) 
+                && !(incoming == RT_STATUS && ready_match == sizeof(ready_text) - 1))
+            {
+                Serial.read();
+                if (incoming == RT_SOFT_RESET)
+                {
+                    //Throw away everything that hasn't been used yet; the translate task does the rest. If the
+                    //reset came in the middle of a line, the rest of that line is thrown away when it comes too.
+                    skip_to_line_end = (last_received != '\n' && last_received != '\0');
+                    rx_ring.clear();
+                    memset(line,'\0',sizeof(line));
+                    line_length = 0;
+                    line_overflow = false;
+                    read_chars_queue.drain_into([](const char *dump_line) { (void)dump_line; });
                 }
-                
-                if (incomingByte == int16_t('\0'))      //If we get the end of a line...
+                run_realtime_command(incoming);
+            }
+            else if (rx_ring.space() > 0)
+            {
+                rx_ring.put((uint8_t)Serial.read());
+                last_received = incoming;
+                if (incoming == (uint8_t)ready_text[ready_match])
+                {
+                    ready_match++;
+                }
+                else
+                {
+                    ready_match = (incoming == (uint8_t)ready_text[0]) ? 1 : 0;
+                }
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        switch (read_state)
+        {
+            // States READING and COMPRESSED split text into lines and put them in the read_chars queue. If the 
+            // queue is full, bytes wait in the ring until the translate task has used some lines.
+            case READING:
+            case COMPRESSED:
+                while (read_chars_queue.available() < READ_Q_SIZE)
                 {
-                    line[strlen(line)] = '\n';       //Add a newline (\n) char to the end to signify to the python script that the line has ended
-                    // print_serial("LINE RECIEVED: \n");
-                    // print_serial(line);              //Temporarily echo
-                    if (strcmp(line,"Ready?\0"))
+                    //Get the next character of text, straight from the ring or through the decompressor
+                    uint8_t incoming;
+                    if (read_state == READING)
+                    {
+                        if (!rx_ring.get(incoming))
+                        {
+                            break;
+                        }
+                    }
+                    else if (!next_compressed_char(lz, rx_ring, block_left, read_state, incoming))
                     {
-                        read_state = READING; //Change state to ready
+                        if (read_state == COMPRESSED)
+                        {
+                            break;              //Waiting for more of the block
+                        }
+                        continue;               //Host went back to plain text
+                    }
 
-                        // Reset line and incomingByte for next time
+                    if (skip_to_line_end)                       //Rest of a line cut by a soft reset: drop it
+                    {
+                        skip_to_line_end = (incoming != '\n' && incoming != '\0');
+                    }
+                    else if (incoming == '\n' || incoming == '\0')   //If we get the end of a line...
+                    {
+                        if (line_overflow)                      //Too long: queue it so its error comes back in order
+                        {
+                            line[0] = LINE_OVERFLOW_MARK;
+                            line[1] = '\0';
+                            read_chars_queue.put(line);
+                        }
+                        else if (strcmp(line,"Ready?") == 0)    //Older host asking before each line
+                        {
+                            print_serial("Ready\n");
+                        }
+                        else if (strcmp(line,"$B") == 0)        //Host wants to switch to binary frames
+                        {
+                            bin_decoder.reset();
+                            read_state = BINARY;
+                            print_serial("Binary\n");
+                        }
+                        else if (strcmp(line,"$Z") == 0)        //Host wants to switch to compressed text
+                        {
+                            lz.reset();
+                            block_left = 0;
+                            read_state = COMPRESSED;
+                            print_serial("Compressed\n");
+                        }
+                        else
+                        {
+                            read_chars_queue.put(line);         //Put line data into the read_string
+                        }
+
+                        // Reset line for next time
                         memset(line,'\0',sizeof(line));
-                        incomingByte = -1;
+                        line_length = 0;
+                        line_overflow = false;
 
-                        digitalWrite(LED_BUILTIN,HIGH);     //Turn on LED: We're ready!
-                        print_serial("Ready\n");            //Send signal to python that we're ready
+                        if (read_state == BINARY)
+                        {
+                            break;
+                        }
+                    }
+                    else if (incoming == '\r')                  //Windows line endings: ignore
+                    {
+                    }
+                    else if (line_length < LINE_BUFFER_SIZE - 1)
+                    {
+                        line[line_length++] = (char)incoming;   //Add character to line
                     }
-                    //If line was somthing other than "Ready\0", then it wasn't intended for us. 
-                    //For now, just reset line and start counting again.
                     else
                     {
-                        // Reset line and incomingByte for next time
-                        memset(line,'\0',sizeof(line));
-                        incomingByte = -1;
+                        line_overflow = true;
                     }
                 }
                 break;
 
-            // State READING is where a real input command line will be read. We transition to this state
-            // after we get the "Ready?" command from the python script, and have told the python script
-            // that we are indeed ready.
-            case READING:
-                
-                if (Serial.available() > 0)         //If there's something coming from python...
-                { 
-                    incomingByte = Serial.read();               //Read the incoming byte
-                    line[strlen(line)] = (char)incomingByte;    //Add character to line
-                }
-
-                if (incomingByte == int16_t('\0'))   //If we get the end of a line...
+            // State BINARY reads bytes in the ring as binary frames, for as long as there is room in the 
+            // binary_move queue. 
+            case BINARY:
+                while (binary_move_queue.available() < BIN_MOVE_Q_SIZE - BIN_MOVE_Q_PAUSE_LIMIT)
                 {
-                    read_chars_queue.put(line);       //Put line data into the read_string
-
-                    // line[strlen(line)] = '\n';       //Add a newline (\n) char to the end to signify to the python script that the line has ended
-                    // print_serial(line);              //Temporarily echo
-
-                    // Reset line and incomingByte for next time
-                    memset(line,'\0',sizeof(line));
-                    incomingByte = -1;
-
-                    digitalWrite(LED_BUILTIN,LOW);  //Signal recieved, turn light off
-
-                    //If the queue is filling and we aren't ready for more data: Go to NOT_READY state
-                    if (read_chars_queue.available() >= READ_Q_SIZE - READ_Q_PAUSE_LIMIT)      //NOT ready: queue is close to full
+                    uint8_t incoming;
+                    if (!rx_ring.get(incoming))
                     {
-                        read_state = NOT_READY;         //Switch state to NOT_READY
+                        break;
                     }
-                    //If the queue has no issues, go back to the READY state
-                    else
+
+                    switch (bin_decoder.feed(incoming))
                     {
-                        read_state = READY;
+                        case BIN_FRAME_MOVE:
+                            binary_move_queue.put(bin_decoder.get_XYSF());
+                            print_serial("b" + String(bin_decoder.get_seq()) + "\n");
+                            break;
+
+                        case BIN_FRAME_END:
+                            print_serial("b" + String(bin_decoder.get_seq()) + "\n");
+                            read_state = READING;
+                            break;
+
+                        case BIN_FRAME_ERROR:
+                            print_serial("rb" + String(bin_decoder.get_next_seq()) + "\n");
+                            break;
+
+                        case BIN_FRAME_NONE:
+                        default:
+                            break;
                     }
-                }   
-                break;
-
-            // State NOT_READY is a waiting sate that we'll sit in and effectively, do nothing. That is, until
-            // the queue has opened up enough to where we can be ready again, in which case we'll go back to 
-            // the READY state.
-            case NOT_READY:
-                if (read_chars_queue.available() < READ_Q_SIZE - READ_Q_PAUSE_LIMIT)      //Ready to go; queue has enough space
+                    if (read_state != BINARY)
                     {
-                        read_state = READY;         //Switch state to READY
+                        break;
                     }
+                }
                 break;
 
             //We should never get here, right?
             default:
-                read_state = NOT_READY;
+                read_state = READING;
 
         } //Switch case for read_state
-        
 
+        //LED on while there are bytes waiting for room in the queues
+        digitalWrite(LED_BUILTIN, rx_ring.count() > 0 ? HIGH : LOW);
+
+        //Task delay
+        vTaskDelay(read_serial_period);
+    }
+}
+
+
+
+// ========================================  Class: byte_ring ========================================
+
+/** @brief      Constructor for the byte_ring class
+ */
+byte_ring::byte_ring(void)
+{
+    _head = 0;
+    _tail = 0;
+    _count = 0;
+}
 
 
-        //testing mode: Not taking inputs from python (enable above)
-        #ifdef TESTING_WITHOUT_PYTHON
-            if (line_one)
+/** @brief      Put a byte in the ring
+ *  @param      byte The byte to add
+ *  @returns    @c false if the ring was full and the byte wasn't added
+ */
+bool byte_ring::put(uint8_t byte)
+{
+    if (_count >= RX_BUFFER_SIZE)
+    {
+        return false;
+    }
+    _buffer[_head] = byte;
+    _head = (_head + 1) % RX_BUFFER_SIZE;
+    _count++;
+    return true;
+}
+
+
+/** @brief      Take the oldest byte out of the ring
+ *  @param      byte Filled with the byte
+ *  @returns    @c false if the ring was empty
+ */
+bool byte_ring::get(uint8_t &byte)
+{
+    if (_count == 0)
+    {
+        return false;
+    }
+    byte = _buffer[_tail];
+    _tail = (_tail + 1) % RX_BUFFER_SIZE;
+    _count--;
+    return true;
+}
+
+
+/** @brief      Get the number of bytes in the ring
+ *  @returns    Number of bytes waiting to be used
+ */
+uint16_t byte_ring::count(void)
+{
+    return _count;
+}
+
+
+/** @brief      Get the number of free places in the ring
+ *  @returns    Number of bytes that can still be put in
+ */
+uint16_t byte_ring::space(void)
+{
+    return RX_BUFFER_SIZE - _count;
+}
+
+
+
+/** @brief      Throw away everything in the ring
+ */
+void byte_ring::clear(void)
+{
+    _head = 0;
+    _tail = 0;
+    _count = 0;
+}
+
+
+
+/** @brief      Check if a byte is a real-time command
+ *  @param      byte A byte from the host
+ *  @returns    @c true for the bytes listed under real-time commands in serial.h
+ */
+bool is_realtime_command(uint8_t byte)
+{
+    switch (byte)
+    {
+        case RT_STATUS:
+        case RT_FEED_HOLD:
+        case RT_RESUME:
+        case RT_SOFT_RESET:
+        case RT_FEED_100:
+        case RT_FEED_PLUS_10:
+        case RT_FEED_MINUS_10:
+        case RT_FEED_PLUS_1:
+        case RT_FEED_MINUS_1:
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+
+/** @brief      Carry out a real-time command
+ *  @details    Motion follows the ramp segments in time, so feed hold and resume pause and restart the time the
+ *              encoder tasks keep, and the feed override changes how fast that time runs. Both take effect on the
+ *              next encoder tick. A soft reset holds motion right away and leaves the rest to the translate task,
+ *              which empties the motion queues and starts over from where the laser head stopped.
+ *  @param      byte A byte for which @c is_realtime_command() is true
+ */
+void run_realtime_command(uint8_t byte)
+{
+    switch (byte)
+    {
+        case RT_STATUS:
+            report_status();
+            break;
+
+        case RT_FEED_HOLD:
+            machine_state_board.update(&machine_state::timing_mode, TIMING_MODE_PAUSED);
+            break;
+
+        case RT_RESUME:
+            machine_state_board.update(&machine_state::timing_mode, TIMING_MODE_RUNNING);
+            break;
+
+        case RT_SOFT_RESET:
+            //Hold motion and show the reset together, then wake the translate task to do it
+            machine_state_board.update_with([](machine_state &state)
+            {
+                state.timing_mode = TIMING_MODE_PAUSED;
+                state.mode = MACHINE_MODE_RESET;
+            });
+            signal_events(EVENT_SOFT_RESET);
+            break;
+
+        case RT_FEED_100:
+        case RT_FEED_PLUS_10:
+        case RT_FEED_MINUS_10:
+        case RT_FEED_PLUS_1:
+        case RT_FEED_MINUS_1:
+            //A feed override step, worked out from the override in the record so none are lost
+            machine_state_board.update_with([byte](machine_state &state)
             {
-                String test_line = "G1 X46.12 Y39.20 S1.00 F600";
-                // test_line = "$H";
-                //Set each character in static char line to match our test string, just like it 
-                //would in the parser (once that's finished)
-                for (uint8_t char_counter = 0; char_counter<=test_line.length();  char_counter++)
+                int16_t feed_override = state.feed_override;
+                switch (byte)
                 {
-                    line[char_counter] = test_line[char_counter];
+                    case RT_FEED_100:       feed_override = 100;                                             break;
+                    case RT_FEED_PLUS_10:   feed_override = min(feed_override + 10, FEED_OVERRIDE_MAX);      break;
+                    case RT_FEED_MINUS_10:  feed_override = max(feed_override - 10, FEED_OVERRIDE_MIN);      break;
+                    case RT_FEED_PLUS_1:    feed_override = min(feed_override + 1, FEED_OVERRIDE_MAX);       break;
+                    case RT_FEED_MINUS_1:   feed_override = max(feed_override - 1, FEED_OVERRIDE_MIN);       break;
+                    default:                                                                                 break;
                 }
-                // Put line data into the read_string
-                read_chars_queue.put(line);
-                line_one = false;
-            }
-        #endif //TESTING_WITHOUT_PYTHON
+                state.feed_override = feed_override;
+            });
+            break;
 
-        //Task delay
-        vTaskDelay(2);
+        default:
+            break;
+    }
+}
+
+
+
+/** @brief      Print a status report
+ *  @details    The report is one message, like @c <Run|MPos:12.345,-3.000|Buf:12|FS:20,50|Ov:100>:
+ *              - The state: @c Reset while a soft reset is being done, @c Hold while motion is held, @c Idle
+ *                when there is nothing left to run and @c Run otherwise.
+ *              - @c MPos: where the encoders say the laser head is, in mm. The A and B belt positions are
+ *                turned back into X and Y with the inverse CoreXY transform.
+ *              - @c Buf: the number of ramp segments waiting to run.
+ *              - @c FS: the speed the encoders say the head is moving at, in the units the translator takes
+ *                the F word in, and the laser power of the segment being run in percent.
+ *              - @c Ov: the feed override in percent.
+ * 
+ *              The state, laser power and feed override come from one read of @c machine_state_board, so they
+ *              always go together. The report is built in a fixed buffer with integer formatting, so it never takes more than
+ *              @c STATUS_REPORT_SIZE bytes and a bounded time to build. The time is kept for @c $SR to print.
+ */
+void report_status(void)
+{
+    uint32_t start_time = micros();
+
+    machine_state machine;
+    encoder_output enc_A;
+    encoder_output enc_B;
+    machine_state_board.get(machine);
+    enc_A_output_share.get(enc_A);
+    enc_B_output_share.get(enc_B);
+
+    uint16_t buffered = ramp_segment_coefficient_queue.available();
+
+    const char *state;
+    if (machine.mode == MACHINE_MODE_RESET)                 { state = "Reset"; }
+    else if (machine.timing_mode != TIMING_MODE_RUNNING)    { state = "Hold"; }
+    else if (buffered == 0)                                 { state = "Idle"; }
+    else                                                    { state = "Run"; }
+
+    // Inverse CoreXY: X = 1/2*(A - B), Y = 1/2*(-A - B)
+    float pos_A = convert_units(enc_A.pos, ENC_POSITION_MODE_BELT_MM);
+    float pos_B = convert_units(enc_B.pos, ENC_POSITION_MODE_BELT_MM);
+    float vel_A = convert_units(enc_A.vel, ENC_VELOCITY_MODE_BELT_MM_PER_SEC);
+    float vel_B = convert_units(enc_B.vel, ENC_VELOCITY_MODE_BELT_MM_PER_SEC);
+    float X = 0.5*( pos_A - pos_B);
+    float Y = 0.5*(-pos_A - pos_B);
+    float speed = 0.5*sqrt(pow(vel_A - vel_B,2) + pow(vel_A + vel_B,2));
+
+    char report[STATUS_REPORT_SIZE];
+    char *p = report;
+    *p++ = '<';
+    append_text(p, state);
+    append_text(p, "|MPos:");       append_fixed(p, X, 3);
+    *p++ = ',';                     append_fixed(p, Y, 3);
+    append_text(p, "|Buf:");        append_fixed(p, buffered, 0);
+    append_text(p, "|FS:");         append_fixed(p, speed, 0);
+    *p++ = ',';                     append_fixed(p, machine.laser_power, 0);
+    append_text(p, "|Ov:");         append_fixed(p, machine.feed_override, 0);
+    append_text(p, ">\n");
+    *p = '\0';
+
+    status_build_time = micros() - start_time;
+    status_build_time_max = max(status_build_time, status_build_time_max);
+
+    print_serial((const char*)report);
+}
+
+
+
+/** @brief      Task which prints a status report at a fixed rate
+ *  @details    The period comes from @c status_period_share and is set with @c $SR @c P<ms>; a period of 0
+ *              turns the reports off. Reports are timed with @c vTaskDelayUntil() so the rate doesn't drift
+ *              with the time each one takes. While reports are off the task sleeps until @c set_status_period()
+ *              wakes it with a task notification, so it uses no CPU.
+ *  @param      p_params A pointer to function parameters which we don't use.
+ */
+void task_status_report(void* p_params)
+{
+    (void)p_params;                   // Does nothing but shut up a compiler warning
+
+    status_report_handle = xTaskGetCurrentTaskHandle();
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    uint16_t period = 0;
+
+    for(;;)
+    {
+        status_period_share.get(period);
+        if (period == 0)
+        {
+            //Reports are off; sleep until the period is set
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            xLastWakeTime = xTaskGetTickCount();
+        }
+        else
+        {
+            report_status();
+            vTaskDelayUntil(&xLastWakeTime, period);
+        }
+    }
+}
+
+
+
+/** @brief      Set how often status reports are printed, or print how they're set
+ *  @details    This is what @c $SR does. With a period, it is checked and put in @c status_period_share, and the
+ *              status report task is woken in case reports were off. With no
+ *              period, the period, the size of the last report and the time the last and longest reports took
+ *              to build are printed.
+ *  @param      period The period in ms, 0 to turn reports off, or less than 0 to print the settings
+ *  @returns    @c false if the period is shorter than @c STATUS_REPORT_MIN_PERIOD or longer than
+ *              @c STATUS_REPORT_MAX_PERIOD
+ */
+bool set_status_period(int32_t period)
+{
+    if (period < 0)
+    {
+        uint16_t now_period;
+        status_period_share.get(now_period);
+        print_serial("Status every " + String(now_period) + " ms, built in " + String(status_build_time) 
+                     + " us (longest " + String(status_build_time_max) + " us), at most " 
+                     + String(STATUS_REPORT_SIZE - 1) + " bytes\n");
+        return true;
+    }
+    if (period != 0 && (period < STATUS_REPORT_MIN_PERIOD || period > STATUS_REPORT_MAX_PERIOD))
+    {
+        return false;
+    }
+    status_period_share.put((uint16_t)period);
+    if (status_report_handle != NULL)
+    {
+        xTaskNotifyGive(status_report_handle);
+    }
+    return true;
+}
+
+
+
+/** @brief      Print a table of what has been done with every queue and share
+ *  @details    This is what @c $Q does. One row is printed for each item in the list of shares, newest first:
+ *              its name and kind, the items put in and taken out (writes and reads for a share), the puts and
+ *              gets which timed out, the time tasks spent blocked on each side in ms, and the most items it has
+ *              held out of its size. A seqlock share never blocks, so its failed gets are reads it tried again.
+ *              The counts are read one item at a time while the tasks run, so they aren't from one instant.
+ */
+void print_share_stats(void)
+{
+    char row[2*LINE_BUFFER_SIZE];
+    print_serial("name            kind      puts     gets fput fget put_ms  get_ms most/size\n");
+    for (BaseShare *p_share = BaseShare::get_newest(); p_share != NULL; p_share = p_share->get_next())
+    {
+        share_stats stats;
+        p_share->get_stats(stats);
+        snprintf(row, sizeof(row), "%-15s %-5s %8lu %8lu %4lu %4lu %7lu %7lu %3u/%-3u\n", p_share->get_name(),
+                 stats.kind, (unsigned long)stats.puts, (unsigned long)stats.gets, (unsigned long)stats.failed_puts,
+                 (unsigned long)stats.failed_gets, (unsigned long)(stats.put_wait_us / 1000),
+                 (unsigned long)(stats.get_wait_us / 1000), stats.most, stats.size);
+        if (strlen(row) > LINE_BUFFER_SIZE - 1)             // Counts too big for their columns; cut to one line
+        {
+            row[LINE_BUFFER_SIZE - 2] = '\n';
+            row[LINE_BUFFER_SIZE - 1] = '\0';
+        }
+        print_serial((const char*)row);
+    }
+}
+
+
+
+/** @brief      Add text to a report being built
+ *  @param      p Where the text goes; moved past it
+ *  @param      text The text to add
+ */
+void append_text(char *&p, const char *text)
+{
+    while (*text != '\0')
+    {
+        *p++ = *text++;
+    }
+}
+
+
+
+/** @brief      Add a number to a report being built, with a fixed number of decimal places
+ *  @details    Uses only integer math, so it takes about the same time for every number, and clamps the number
+ *              to +/-@c STATUS_REPORT_MAX_VALUE so it never takes more than 10 characters plus the decimals.
+ *  @param      p Where the number goes; moved past it
+ *  @param      value The number to add
+ *  @param      decimals Number of decimal places, 0 to 3
+ */
+void append_fixed(char *&p, float value, uint8_t decimals)
+{
+    uint32_t scale = 1;
+    for (uint8_t i = 0; i < decimals; i++)
+    {
+        scale *= 10;
+    }
+    value = constrain(value, -STATUS_REPORT_MAX_VALUE, STATUS_REPORT_MAX_VALUE);
+    uint32_t fixed = (uint32_t)(fabs(value)*scale + 0.5);
+    if (value < 0 && fixed > 0)
+    {
+        *p++ = '-';
+    }
+
+    //Digits come out backwards, so write them into a scratch buffer first
+    char digits[12];
+    uint8_t n_digits = 0;
+    do
+    {
+        digits[n_digits++] = '0' + fixed % 10;
+        fixed /= 10;
+    } while (fixed > 0 || n_digits <= decimals);
+
+    while (n_digits > 0)
+    {
+        if (n_digits == decimals)
+        {
+            *p++ = '.';
+        }
+        *p++ = digits[--n_digits];
+    }
+}
+
+
+
+/** @brief      Answer a line from the host once it has been used
+ *  @details    Every line the host sends gets exactly one answer, in the order the lines were sent,
+ *              so the host can free up that line's bytes in its count of what is in @c RX_BUFFER_SIZE.
+ *  @param      error_code @c NO_ERROR to answer @c ok, or one of the error codes in gcode.h to 
+ *              answer @c error:N
+ */
+void acknowledge_line(uint8_t error_code)
+{
+    if (error_code == NO_ERROR)
+    {
+        print_serial("ok\n");
+    }
+    else
+    {
+        print_serial("error:" + String(error_code) + "\n");
     }
 }
 
@@ -195,7 +703,10 @@ void task_read_serial(void* p_params)
 
 /** @brief      Task which prints any string that is sent to the chars_to_print queue. 
  *  @details    This task reads checks if there is anything in the chars_to_print queue, 
- *              and if there is something, it prints it to the serial port. 
+ *              and if there is something, it prints it to the serial port. Everything in
+ *              the queue is printed each time the task runs, so that acknowledgements for
+ *              fast binary streams don't back up behind the task period. Binary telemetry frames
+ *              (see telemetry.h) are written after the text, each one whole.
  *  @param      p_params A pointer to function parameters which we don't use.
  */
 void task_print_serial(void* p_params)
@@ -205,21 +716,15 @@ void task_print_serial(void* p_params)
     // possible value, essentially forever for a real-time control program
     Serial.setTimeout (0xFFFFFFFF);
 
-    //Initialize string to print
-    char print_string[LINE_BUFFER_SIZE];
-
     for(;;)
     {
-        //When you get a string in the string_to_print queue...
-        if (chars_to_print_queue.any())
-        {
-            //Get it from the queue...
-            chars_to_print_queue.get(print_string);
-            
-            //Then print it!
-            Serial << print_string;
-        }
-        vTaskDelay(10);
+        //Print every string in the string_to_print queue, taking them out a few at a time
+        chars_to_print_queue.drain_into([](const char *print_string) { Serial << print_string; });
+
+        //Binary telemetry frames go out whole, between lines
+        telemetry_queue.drain_into([](const telemetry_frame &frame) { Serial.write(frame.data, frame.length); });
+
+        vTaskDelay(print_serial_period);
     }
 
 }
@@ -20,13 +20,74 @@
 #define LINE_BUFFER_SIZE 80
 #define READ_Q_SIZE 32
 #define WRITE_Q_SIZE 32
-#define READ_Q_PAUSE_LIMIT 4
+
+//Receive buffer which the host counts characters against. The host may have this many bytes sent 
+//but not yet answered with "ok" or "error:N". It has to be no bigger than what the reader can 
+//hold: the ring itself, plus READ_Q_SIZE lines of at least 2 bytes each sitting in the read queue.
+#define RX_BUFFER_SIZE 128
+
+//First character of a line that was too long for the line buffer. The line is still queued (as just
+//this character) so that its error is reported in order with the other lines.
+#define LINE_OVERFLOW_MARK '\x01'
+
+
+//Real-time commands: single bytes picked out of the incoming text as soon as they arrive, before 
+//they get to the ring, so they don't wait behind queued lines. The host sends them at any time 
+//without counting them against RX_BUFFER_SIZE, and they are never answered with "ok".
+#define RT_STATUS '?'               // Print a status report
+#define RT_FEED_HOLD '!'            // Stop motion where it is
+#define RT_RESUME '~'               // Carry on after a feed hold (or a soft reset)
+#define RT_SOFT_RESET 0x18          // Ctrl-X: drop everything queued, without answering it, and stop
+#define RT_FEED_100 0x90            // Feed override back to 100%
+#define RT_FEED_PLUS_10 0x91        // Feed override +10%
+#define RT_FEED_MINUS_10 0x92       // Feed override -10%
+#define RT_FEED_PLUS_1 0x93         // Feed override +1%
+#define RT_FEED_MINUS_1 0x94        // Feed override -1%
+
+//Limits of the feed override, in percent
+#define FEED_OVERRIDE_MIN 10
+#define FEED_OVERRIDE_MAX 200
+
+//Status reports: the biggest one is <Reset|MPos:-99999.000,-99999.000|Buf:32|FS:99999,100|Ov:200>
+//and a newline, which is 62 bytes; numbers are clamped so it can't get any longer.
+#define STATUS_REPORT_SIZE 72
+#define STATUS_REPORT_MAX_VALUE 99999.0
+#define STATUS_REPORT_MIN_PERIOD ((int32_t)status_report_period) // ms, from static_alloc.h; a report takes ~6 ms
+#define STATUS_REPORT_MAX_PERIOD 60000      // ms
 
 
 //States of the reader
-#define READY 0
-#define READING 1
-#define NOT_READY 2
+#define READING 0
+#define BINARY 1
+#define COMPRESSED 2
+
+
+/** @brief      Ring of bytes received from the host which haven't been used yet
+ *  @details    Only the reader task uses it, so it needs no protection between tasks.
+ */
+class byte_ring
+{
+    protected:
+    uint8_t _buffer[RX_BUFFER_SIZE];    // Bytes in the ring
+    uint16_t _head;                     // Where the next byte from the serial port goes
+    uint16_t _tail;                     // Where the next byte to use comes from
+    uint16_t _count;                    // Number of bytes in the ring
+
+    public:
+    // Constructor
+    byte_ring(void);
+
+    // Put a byte in, or take the oldest one out; both return false if they can't
+    bool put(uint8_t byte);
+    bool get(uint8_t &byte);
+
+    // Number of bytes in the ring, and number of free places
+    uint16_t count(void);
+    uint16_t space(void);
+
+    // Throw away everything in the ring
+    void clear(void);
+};
 
 
 //Function to read incomming messages from the serial port
@@ -35,6 +96,27 @@ void task_read_serial(void* p_params);
 //Function to write outgoing messages to the serial port
 void task_print_serial(void* p_params);
 
+//Function to answer a line from the host once it has been used
+void acknowledge_line(uint8_t error_code);
+
+//Functions to check for and carry out real-time commands
+bool is_realtime_command(uint8_t byte);
+void run_realtime_command(uint8_t byte);
+
+//Function to print a status report, and the task which prints one at a fixed rate
+void report_status(void);
+void task_status_report(void* p_params);
+
+//Function to set how often status reports are printed (from $SR)
+bool set_status_period(int32_t period);
+
+//Function to print what has been done with every queue and share (from $Q)
+void print_share_stats(void);
+
+//Functions to build a status report without String or printf
+void append_text(char *&p, const char *text);
+void append_fixed(char *&p, float value, uint8_t decimals);
+
 //Function to add items to the serial print queue to be executed by the printing task function
 void print_serial(String string_to_print);
 void print_serial(float printed_float);
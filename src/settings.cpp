@@ -0,0 +1,231 @@
+/** @file       settings.cpp
+ *  @brief      This file contains the settings registry: the table of settings, and the functions which check, set,
+ *              list, save and load them.
+ *  @details    The commands are described in settings.h. Settings are only changed by the translate task, which
+ *              reads the @c $ lines, and are read by any task. Each value is one aligned @c float, which the
+ *              Cortex-M4 reads and writes in one go, so a task never sees half of a change.
+ *
+ *  @date    10-19-2026 File Created
+ *
+*/
+
+#include "libraries&constants.h"
+
+#ifdef ARDUINO
+    #include <EEPROM.h>
+#else
+    #include <stdio.h>
+#endif
+
+
+///@cond
+// Name, default, min, max and integer-only for every setting, in setting number order
+static const setting_info setting_table[SETTINGS_COUNT] =
+{
+    {"KP",                  PATH_TEST_CONTROL_KP,       0,      1000,                   false},
+    {"KI",                  PATH_TEST_CONTROL_KI,       0,      1000,                   false},
+    {"KD",                  PATH_TEST_CONTROL_KD,       0,      1000,                   false},
+    {"Deadband %",          PATH_TEST_MOTOR_DEADBAND,   0,      50,                     false},
+    {"Drv filter tau s",    PATH_TEST_DRV_FILTER_TAU,   0.001,  10,                     false},
+    {"Enc A filter alpha",  FILTER_A_ALPHA,             0.01,   1,                      false},
+    {"Enc B filter alpha",  FILTER_B_ALPHA,             0.01,   1,                      false},
+    {"Travel speed",        TRAVEL_SPEED,               1,      10000,                  false},
+    {"Ramp Q pause limit",  RAMP_COEFF_Q_PAUSE_LIMIT,   1,      RAMP_COEFF_Q_SIZE - 2,  true},
+    {"Enc counts/pulse",    ENCODER_COUNTS_PER_PULSE,   1,      4,                      true},
+    {"Enc pulses/rev",      ENCODER_PULSES_PER_REV,     1,      10000,                  true},
+    {"Gear ratio",          REV_ENC_PER_REVOUT_MOTOR,   0.01,   1000,                   false},
+    {"Wheel radius mm",     OUTPUT_WHEEL_RADIUS_MM,     0.1,    100,                    false},
+};
+
+// Settings in use, and a count that goes up every time one changes
+static saved_settings settings_now;
+static volatile uint16_t settings_version = 0;
+///@endcond
+
+
+// ======================================== Subfunctions ========================================
+
+/** @brief      Work out the CRC of saved settings
+ *  @param      settings The settings; everything before @c crc is checked
+ *  @returns    CRC-8, the same as binary frames use
+ */
+static uint8_t settings_crc(saved_settings &settings)
+{
+    return crc8((const uint8_t*)&settings, offsetof(saved_settings, crc));
+}
+
+
+/** @brief      Save the settings in use
+ *  @details    On the board this goes through the STM32 core's buffered EEPROM emulation, so the flash page is only
+ *              erased and written once for all the settings. Off the board they go in @c SETTINGS_HOST_FILE.
+ */
+static void save_settings(void)
+{
+    settings_now.magic = SETTINGS_MAGIC;
+    settings_now.count = SETTINGS_COUNT;
+    settings_now.crc = settings_crc(settings_now);
+    const uint8_t *bytes = (const uint8_t*)&settings_now;
+
+    #ifdef ARDUINO
+        eeprom_buffer_fill();
+        for (uint16_t i = 0; i < sizeof(saved_settings); i++)
+        {
+            eeprom_buffered_write_byte(i, bytes[i]);
+        }
+        eeprom_buffer_flush();
+    #else
+        FILE *file = fopen(SETTINGS_HOST_FILE, "wb");
+        if (file != NULL)
+        {
+            fwrite(bytes, 1, sizeof(saved_settings), file);
+            fclose(file);
+        }
+    #endif
+}
+
+
+
+// ======================================== Functions ========================================
+
+/** @brief      Load saved settings, or the defaults if none are saved
+ *  @details    Called once in @c setup(), before the tasks start. Saved settings are only used if the magic number,
+ *              number of settings and CRC are right and every value is in its range; otherwise the defaults are used.
+ */
+void load_settings(void)
+{
+    saved_settings loaded;
+    uint8_t *bytes = (uint8_t*)&loaded;
+    bool found = false;
+
+    #ifdef ARDUINO
+        eeprom_buffer_fill();
+        for (uint16_t i = 0; i < sizeof(saved_settings); i++)
+        {
+            bytes[i] = eeprom_buffered_read_byte(i);
+        }
+        found = true;
+    #else
+        FILE *file = fopen(SETTINGS_HOST_FILE, "rb");
+        if (file != NULL)
+        {
+            found = (fread(bytes, 1, sizeof(saved_settings), file) == sizeof(saved_settings));
+            fclose(file);
+        }
+    #endif
+
+    bool good = found && loaded.magic == SETTINGS_MAGIC && loaded.count == SETTINGS_COUNT
+                && loaded.crc == settings_crc(loaded);
+    for (uint8_t n = 0; good && n < SETTINGS_COUNT; n++)
+    {
+        good = loaded.value[n] >= setting_table[n].min && loaded.value[n] <= setting_table[n].max;
+    }
+
+    for (uint8_t n = 0; n < SETTINGS_COUNT; n++)
+    {
+        settings_now.value[n] = good ? loaded.value[n] : setting_table[n].default_value;
+    }
+    settings_version++;
+}
+
+
+/** @brief      Get a setting
+ *  @param      number One of the @c SETTING_ numbers
+ *  @returns    The value in use
+ */
+float get_setting(uint8_t number)
+{
+    return settings_now.value[number];
+}
+
+
+/** @brief      Get a count that goes up every time a setting changes
+ *  @details    Tasks that copy settings into objects, like the control task with its PID controllers, keep the
+ *              last count they saw and copy the settings again when it changes.
+ *  @returns    The count
+ */
+uint16_t get_settings_version(void)
+{
+    return settings_version;
+}
+
+
+/** @brief      Check and set a setting, and save every setting
+ *  @param      number One of the @c SETTING_ numbers
+ *  @param      value The new value
+ *  @returns    @c false if there's no such setting, or the value is out of its range or not a whole number when it
+ *              has to be
+ */
+bool set_setting(uint8_t number, float value)
+{
+    if (number >= SETTINGS_COUNT || !(value >= setting_table[number].min && value <= setting_table[number].max)
+        || (setting_table[number].integer && value != floor(value)))
+    {
+        return false;
+    }
+    settings_now.value[number] = value;
+    settings_version++;
+    save_settings();
+    return true;
+}
+
+
+/** @brief      Put every setting back to its default and save them
+ */
+void reset_settings(void)
+{
+    for (uint8_t n = 0; n < SETTINGS_COUNT; n++)
+    {
+        settings_now.value[n] = setting_table[n].default_value;
+    }
+    settings_version++;
+    save_settings();
+}
+
+
+/** @brief      Print every setting, one line each, like @c $0=1.000 @c (KP)
+ */
+void print_settings(void)
+{
+    for (uint8_t n = 0; n < SETTINGS_COUNT; n++)
+    {
+        print_serial("$" + String(n) + "=" + String(settings_now.value[n], setting_table[n].integer ? 0 : 3)
+                     + " (" + setting_table[n].name + ")\n");
+    }
+}
+
+
+/** @brief      Read and carry out a @c $n=value line
+ *  @param      line The line, starting with @c $ and a digit
+ *  @returns    @c false if the line isn't @c $n=value or the setting can't be set to that value
+ */
+bool setting_line(char *line)
+{
+    uint8_t char_counter = 1;
+    float number;
+    float value;
+
+    if (!read_float(line, &char_counter, &number) || line[char_counter] != '=' || number != floor(number))
+    {
+        return false;
+    }
+    char_counter++;
+    if (!read_float(line, &char_counter, &value) || line[char_counter] != '\0')
+    {
+        return false;
+    }
+    // Checked before the cast, which would wrap $256 round to $0
+    return number >= 0 && number < SETTINGS_COUNT && set_setting((uint8_t)number, value);
+}
+
+
+/** @brief      Put the controller settings into a PID controller with its setters
+ *  @param      controller A running controller; its errors and integral are left alone
+ */
+void apply_pid_settings(PID_Controller &controller)
+{
+    controller.set_KP(get_setting(SETTING_KP));
+    controller.set_KI(get_setting(SETTING_KI));
+    controller.set_KD(get_setting(SETTING_KD));
+    controller.set_deadband(get_setting(SETTING_DEADBAND));
+    controller.set_drv_filt_tau(get_setting(SETTING_DRV_FILTER_TAU));
+}
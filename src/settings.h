@@ -0,0 +1,106 @@
+/** @file       settings.h
+ *  @brief      This file contains the header for the settings.cpp file, which keeps machine and controller
+ *              parameters that can be changed without reflashing.
+ *  @details    Each setting has a number, and is read and changed with machine commands like GRBL's:
+ *
+ *              | Command                 | Does                                                              |
+ *              |-------------------------|-------------------------------------------------------------------|
+ *              | @c $$                   | List every setting as @c $n=value @c (name)                       |
+ *              | @c $n=value             | Set setting @c n, if the value is in its range, and save it       |
+ *              | @c $RST                 | Put every setting back to its default and save them               |
+ *
+ *              The defaults are the @c #defines the settings used to be (PATH_TEST_CONTROL_KP and so on), so a
+ *              machine with nothing saved runs like it always did. Settings are saved to flash through the
+ *              STM32 core's EEPROM emulation, or to @c SETTINGS_HOST_FILE when built off the board, and loaded
+ *              when the machine starts. Saved settings with the wrong magic number, number of settings or CRC are
+ *              ignored.
+ *
+ *              Changes take effect right away: the controller gains, deadband and filter are put into the running
+ *              @c PID_Controller objects with their setters by @c apply_pid_settings(), and everything else is
+ *              read with @c get_setting() where it is used.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include "libraries&constants.h"
+
+// ========================================== Constants ==========================================
+
+// Setting numbers
+#define SETTING_KP 0                    // Proportional gain
+#define SETTING_KI 1                    // Integral gain
+#define SETTING_KD 2                    // Derivative gain
+#define SETTING_DEADBAND 3              // Motor deadband, percent
+#define SETTING_DRV_FILTER_TAU 4        // Derivative filter time constant, s
+#define SETTING_FILTER_ALPHA_A 5        // Encoder A velocity filter, 0 to 1
+#define SETTING_FILTER_ALPHA_B 6        // Encoder B velocity filter, 0 to 1
+#define SETTING_TRAVEL_SPEED 7          // Speed of travel moves
+#define SETTING_RAMP_PAUSE_LIMIT 8      // Free ramp queue places kept when reading lines
+#define SETTING_COUNTS_PER_PULSE 9      // Encoder counts per pulse
+#define SETTING_PULSES_PER_REV 10       // Encoder pulses per encoder rev
+#define SETTING_GEAR_RATIO 11           // Encoder revs per output rev
+#define SETTING_WHEEL_RADIUS 12         // Belt wheel radius, mm
+#define SETTINGS_COUNT 13
+
+// Where settings are kept when built off the board
+#define SETTINGS_HOST_FILE "laser_settings.bin"
+
+// Marks saved settings as ours, and changes whenever the layout does
+#define SETTINGS_MAGIC 0x4C533031       // "LS01"
+
+
+// =========================================== Structs ===========================================
+
+/// What is known about a setting: its name, default and range
+struct setting_info
+{
+    const char *name;                   // Short name printed by $$
+    float default_value;                // Value with nothing saved
+    float min;                          // Smallest value allowed
+    float max;                          // Largest value allowed
+    bool integer;                       // True if only whole numbers are allowed
+};
+
+
+/// Settings as they are saved
+struct saved_settings
+{
+    uint32_t magic = SETTINGS_MAGIC;
+    uint16_t count = SETTINGS_COUNT;    // Settings saved, so a build with more or fewer ignores them
+    float value[SETTINGS_COUNT];
+    uint8_t crc = 0;
+};
+
+
+// =========================================== Functions ===========================================
+
+// Load saved settings, or the defaults if none are saved
+void load_settings(void);
+
+// Get a setting
+float get_setting(uint8_t number);
+
+// Get a count that goes up every time a setting changes
+uint16_t get_settings_version(void);
+
+// Check and set a setting, and save every setting
+bool set_setting(uint8_t number, float value);
+
+// Put every setting back to its default and save them
+void reset_settings(void);
+
+// Print every setting (for $$)
+void print_settings(void);
+
+// Read and carry out a $n=value line
+bool setting_line(char *line);
+
+// Put the controller settings into a PID controller with its setters
+void apply_pid_settings(PID_Controller &controller);
+
+
+#endif //SETTINGS_H
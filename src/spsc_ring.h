@@ -0,0 +1,392 @@
+/** @file       spsc_ring.h
+ *  @brief      This file contains a ring buffer which passes items from one task to one other task without locking.
+ *  @details    A @c Queue goes through the FreeRTOS queue functions, so every @c is_empty(), @c put() and @c get()
+ *              enters a critical section, and every item is copied in and out. When only one task puts items in
+ *              (the producer) and only one task takes them out (the consumer), neither is needed: the producer is
+ *              the only one that writes @c _head and the consumer the only one that writes @c _tail, and each
+ *              only reads the other's. An item is written before @c _head moves past it and read before @c _tail
+ *              does, so neither task ever sees a half written item.
+ *
+ *              Besides the @c Queue methods, the consumer can look at items where they are with @c front() and
+ *              @c peek(n), and let go of the front one with @c pop(), without copying them. Any task may call
+ *              @c available(), @c any() and @c is_empty() to see how full the ring is.
+ *
+ *              The size must be a power of two, so the 16-bit counts of items put and taken can wrap freely.
+ *              There is no kernel object to block on, so waiting (for room in @c put() and @c wait_for_space(),
+ *              for an item in @c get()) checks once a tick.
+ *
+ *              The producer can throw away everything in the ring with @c flush(). It can't move @c _tail itself,
+ *              as the consumer may be using the front item, so it leaves a note of where its @c _head was, and
+ *              the consumer skips up to there the next time it looks. A flush can come while the consumer is
+ *              copying the front item, so a consumer which copies it and then lets go of it checks
+ *              @c flush_pending() before using the copy; if a flush came, the copy is thrown away too.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "baseshare.h"
+#include "trace.h"
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which passes items of one type from one producer task to one consumer task, without locking.
+ *  @details    See the top of this file.
+ */
+template <class dataType, uint16_t ring_size> class spsc_ring : public BaseShare
+{
+    static_assert(ring_size > 0 && (ring_size & (ring_size - 1)) == 0, "An spsc_ring's size must be a power of two");
+
+    protected:
+    dataType _buffer[ring_size];            // The items
+    std::atomic<uint16_t> _head;            // Items ever put in; written only by the producer
+    std::atomic<uint16_t> _tail;            // Items ever taken out; written only by the consumer
+    std::atomic<uint16_t> _flush_to;        // What _head was at the producer's last flush()
+    std::atomic<uint16_t> _flushes;         // Flushes asked for by the producer
+    std::atomic<uint16_t> _flushes_done;    // Flushes carried out by the consumer
+    TickType_t _ticks_to_wait;              // Ticks put() and get() wait for room or an item
+    uint16_t _max_full;                     // Most items the ring has held
+    uint16_t _front_tail;                   // What _tail was when front() last gave out an item; consumer only
+    bool _front_given;                      // Whether front() has given out an item pop() hasn't let go of
+
+    // Skip the items the producer has flushed; consumer only
+    void catch_up(void);
+
+    public:
+    // Constructor
+    spsc_ring(const char *p_name = NULL, TickType_t wait_time = portMAX_DELAY);
+
+    // Producer: put an item in the back, wait for room, or throw away everything in the ring
+    bool put(const dataType &item);
+    bool wait_for_space(uint16_t count, TickType_t ticks_to_wait);
+    void flush(void);
+
+    // Consumer: take the front item out, or copy it without taking it
+    bool get(dataType &item);
+    bool peek(dataType &item);
+
+    // Consumer: use items where they are, then let go of the front one
+    dataType *front(void);
+    dataType *peek(uint16_t index);
+    void pop(void);
+
+    // Consumer: whether the producer has flushed since the consumer last looked
+    bool flush_pending(void);
+
+    // Anyone: how full the ring is
+    uint16_t available(void);
+    uint16_t space(void);
+    bool any(void) { return available() != 0; }
+    bool is_empty(void) { return available() == 0; }
+    uint16_t size(void) { return ring_size; }
+
+    // Get the counts of what has been done with the ring
+    void get_stats(share_stats &copy);
+
+    // Print the ring in the list of shares
+    void print_in_list(Print &print_dev);
+};
+
+
+// ========================================  Class: spsc_ring ========================================
+
+/** @brief      Constructor for the spsc_ring class
+ *  @param      p_name A name for the list of shares
+ *  @param      wait_time Ticks @c put() waits for room and @c get() waits for an item; the default is forever
+ */
+template <class dataType, uint16_t ring_size>
+spsc_ring<dataType, ring_size>::spsc_ring(const char *p_name, TickType_t wait_time)
+    : BaseShare(p_name), _head(0), _tail(0), _flush_to(0), _flushes(0), _flushes_done(0)
+{
+    _ticks_to_wait = wait_time;
+    _max_full = 0;
+    _front_tail = 0;
+    _front_given = false;
+    stats.kind = "ring";
+    stats.size = ring_size;
+}
+
+
+/** @brief      Move @c _tail up to the producer's last flush, if that hasn't been done yet
+ *  @details    The flush count is read before the place, so the place is from that flush or a later one; either
+ *              way it is no further on than @c _head, and @c _tail only ever moves forward. The items skipped go
+ *              in the trace as taken out, so the trace's count of items in the ring stays right.
+ */
+template <class dataType, uint16_t ring_size>
+void spsc_ring<dataType, ring_size>::catch_up(void)
+{
+    uint16_t flushes = _flushes.load(std::memory_order_acquire);
+    if (flushes != _flushes_done.load(std::memory_order_relaxed))
+    {
+        uint16_t flush_to = _flush_to.load(std::memory_order_acquire);
+        uint16_t tail = _tail.load(std::memory_order_relaxed);
+        if ((int16_t)(flush_to - tail) > 0)
+        {
+            _tail.store(flush_to, std::memory_order_release);
+            trace_record(TRACE_QUEUE_GET, trace_id, (uint16_t)(flush_to - tail));
+        }
+        _flushes_done.store(flushes, std::memory_order_release);
+    }
+}
+
+
+/** @brief      Put an item in the back of the ring, waiting for room; producer only
+ *  @param      item The item, copied in
+ *  @returns    @c true if it went in, @c false if there was no room in the wait time
+ */
+template <class dataType, uint16_t ring_size>
+bool spsc_ring<dataType, ring_size>::put(const dataType &item)
+{
+    if (!wait_for_space(1, _ticks_to_wait))
+    {
+        return false;
+    }
+    uint16_t head = _head.load(std::memory_order_relaxed);
+    _buffer[head & (ring_size - 1)] = item;
+    _head.store(head + 1, std::memory_order_release);
+    stats.puts++;
+    trace_record(TRACE_QUEUE_PUT, trace_id, 1);
+
+    uint16_t fill = (uint16_t)(head + 1 - _tail.load(std::memory_order_acquire));
+    if (fill > _max_full)
+    {
+        _max_full = fill;
+    }
+    return true;
+}
+
+
+/** @brief      Wait until there is room for a number of items; producer only
+ *  @details    Lets a producer check there's room for a whole run of items before it starts on them. Time spent
+ *              waiting counts as the put side's blocked time, and running out of time as a failed put.
+ *  @param      count Items to make room for
+ *  @param      ticks_to_wait Ticks to wait, or @c portMAX_DELAY to wait forever
+ *  @returns    @c true if there is room
+ */
+template <class dataType, uint16_t ring_size>
+bool spsc_ring<dataType, ring_size>::wait_for_space(uint16_t count, TickType_t ticks_to_wait)
+{
+    if (space() >= count)
+    {
+        return true;
+    }
+
+    TickType_t waited = 0;
+    uint32_t start = micros();
+    bool room = true;
+    while (space() < count)
+    {
+        if (ticks_to_wait != portMAX_DELAY && waited++ >= ticks_to_wait)
+        {
+            room = false;
+            stats.failed_puts++;
+            break;
+        }
+        vTaskDelay(1);
+    }
+    stats.put_wait_us += micros() - start;
+    return room;
+}
+
+
+/** @brief      Throw away everything in the ring; producer only
+ *  @details    The consumer skips the items the next time it looks, so until then they still take up room.
+ */
+template <class dataType, uint16_t ring_size>
+void spsc_ring<dataType, ring_size>::flush(void)
+{
+    _flush_to.store(_head.load(std::memory_order_relaxed), std::memory_order_release);
+    _flushes.store(_flushes.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+
+/** @brief      Take the front item out of the ring, waiting for one; consumer only
+ *  @details    If the ring is flushed while the item is being copied, the copy is thrown away and the next item
+ *              taken, if there is one.
+ *  @param      item Filled with the item
+ *  @returns    @c true if there was an item in the wait time
+ */
+template <class dataType, uint16_t ring_size>
+bool spsc_ring<dataType, ring_size>::get(dataType &item)
+{
+    dataType *p_front = front();
+    if (p_front == NULL)
+    {
+        TickType_t waited = 0;
+        uint32_t start = micros();
+        while ((p_front = front()) == NULL)
+        {
+            if (_ticks_to_wait != portMAX_DELAY && waited++ >= _ticks_to_wait)
+            {
+                break;
+            }
+            vTaskDelay(1);
+        }
+        stats.get_wait_us += micros() - start;
+        if (p_front == NULL)
+        {
+            stats.failed_gets++;
+            return false;
+        }
+    }
+    item = *p_front;
+    pop();
+
+    // A flush while the item was being copied threw it away too; take the next one if one is there already,
+    // without waiting, as whoever flushed may not put any more in
+    while (flush_pending())
+    {
+        p_front = front();
+        if (p_front == NULL)
+        {
+            return false;
+        }
+        item = *p_front;
+        pop();
+    }
+    return true;
+}
+
+
+/** @brief      Copy the front item without taking it out; consumer only
+ *  @param      item Filled with the item, if there is one
+ *  @returns    @c true if there was an item
+ */
+template <class dataType, uint16_t ring_size>
+bool spsc_ring<dataType, ring_size>::peek(dataType &item)
+{
+    dataType *p_front = front();
+    if (p_front == NULL)
+    {
+        return false;
+    }
+    item = *p_front;
+    return true;
+}
+
+
+/** @brief      Get the front item where it is; consumer only
+ *  @details    The item stays in place, and the producer won't write over it, until @c pop(). Which item it is
+ *              is kept, so @c pop() lets go of that one and no other.
+ *  @returns    A pointer to the item, or NULL if the ring is empty
+ */
+template <class dataType, uint16_t ring_size>
+dataType *spsc_ring<dataType, ring_size>::front(void)
+{
+    dataType *p_front = peek((uint16_t)0);
+    _front_tail = _tail.load(std::memory_order_relaxed);
+    _front_given = (p_front != NULL);
+    return p_front;
+}
+
+
+/** @brief      Get an item where it is, counting from the front; consumer only
+ *  @param      index 0 for the front item, 1 for the one behind it, and so on
+ *  @returns    A pointer to the item, or NULL if there aren't that many items
+ */
+template <class dataType, uint16_t ring_size>
+dataType *spsc_ring<dataType, ring_size>::peek(uint16_t index)
+{
+    catch_up();
+    uint16_t tail = _tail.load(std::memory_order_relaxed);
+    uint16_t count = (uint16_t)(_head.load(std::memory_order_acquire) - tail);
+    if (index >= count)
+    {
+        return NULL;
+    }
+    return &_buffer[(uint16_t)(tail + index) & (ring_size - 1)];
+}
+
+
+/** @brief      Let go of the item @c front() last gave out, so the producer can use its place; consumer only
+ *  @details    It doesn't skip flushed items first: if it did, a flush since @c front() would move @c _tail past
+ *              the item given out, and the item let go of would be the first one put in after the flush. If the
+ *              item given out was flushed, letting go of it is what the flush would have done anyway. Nothing is
+ *              done if @c front() hasn't given out an item since the last @c pop().
+ */
+template <class dataType, uint16_t ring_size>
+void spsc_ring<dataType, ring_size>::pop(void)
+{
+    uint16_t tail = _tail.load(std::memory_order_relaxed);
+    if (_front_given && tail == _front_tail)
+    {
+        _tail.store(tail + 1, std::memory_order_release);
+        stats.gets++;
+        trace_record(TRACE_QUEUE_GET, trace_id, 1);
+    }
+    _front_given = false;
+}
+
+
+/** @brief      Check whether the producer has flushed the ring since the consumer last looked; consumer only
+ *  @details    A consumer which copied the front item and let go of it calls this before using the copy: if a
+ *              flush is pending, it came after @c front(), so the copy was flushed and must be thrown away.
+ *  @returns    @c true if there is a flush the consumer hasn't caught up with
+ */
+template <class dataType, uint16_t ring_size>
+bool spsc_ring<dataType, ring_size>::flush_pending(void)
+{
+    return _flushes.load(std::memory_order_acquire) != _flushes_done.load(std::memory_order_relaxed);
+}
+
+
+/** @brief      Get the number of items waiting to be used, not counting flushed ones
+ *  @details    From a task other than the producer and consumer, this is a snapshot which may already be old.
+ *  @returns    Items waiting
+ */
+template <class dataType, uint16_t ring_size>
+uint16_t spsc_ring<dataType, ring_size>::available(void)
+{
+    uint16_t flushes = _flushes.load(std::memory_order_acquire);
+    uint16_t tail = (flushes != _flushes_done.load(std::memory_order_acquire))
+                  ? _flush_to.load(std::memory_order_acquire) : _tail.load(std::memory_order_acquire);
+    uint16_t count = (uint16_t)(_head.load(std::memory_order_acquire) - tail);
+    return count <= ring_size ? count : 0;
+}
+
+
+/** @brief      Get the room left in the ring
+ *  @details    Flushed items the consumer hasn't skipped yet still take up room.
+ *  @returns    Items that can be put in
+ */
+template <class dataType, uint16_t ring_size>
+uint16_t spsc_ring<dataType, ring_size>::space(void)
+{
+    uint16_t count = (uint16_t)(_head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire));
+    return ring_size - count;
+}
+
+
+/** @brief      Get the counts of what has been done with the ring
+ *  @details    The producer writes the put side's counts and the consumer the get side's, so neither is locked.
+ *  @param      copy Filled with the counts
+ */
+template <class dataType, uint16_t ring_size>
+void spsc_ring<dataType, ring_size>::get_stats(share_stats &copy)
+{
+    copy = stats;
+    copy.most = _max_full;
+}
+
+
+/** @brief      Print the ring's name and how full it has been, then the next share in the list
+ *  @param      print_dev Where to print
+ */
+template <class dataType, uint16_t ring_size>
+void spsc_ring<dataType, ring_size>::print_in_list(Print &print_dev)
+{
+    print_dev.printf("%-16sring\t", name);
+    print_dev << _max_full << '/' << ring_size << endl;
+
+    if (p_next != NULL)
+    {
+        p_next->print_in_list(print_dev);
+    }
+}
+
+#endif //SPSC_RING_H
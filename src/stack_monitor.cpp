@@ -0,0 +1,146 @@
+/** @file       stack_monitor.cpp
+ *  @brief      This file contains the task which watches how much of its stack each task uses, and the report which
+ *              suggests a stack size for each one.
+ *  @details    See stack_monitor.h. Tasks are added before the scheduler starts, and only the monitor task changes
+ *              the peaks after that; the report reads them and looks at the stacks again itself, so it is up to
+ *              date even if the monitor hasn't run in a while.
+ *
+ *  @date    10-19-2026 File Created
+ *
+*/
+
+#include "libraries&constants.h"
+
+
+///@cond
+// What the monitor knows about one task's stack
+struct stack_record
+{
+    TaskHandle_t task;              // The task
+    uint32_t size;                  // Stack it was given in words
+    uint32_t peak;                  // Most of it used so far in words
+    uint32_t peak_ms;               // Time the peak was reached
+    bool warned;                    // Whether it has been warned about being low on stack
+};
+
+static stack_record stack_records[STACK_MONITOR_TASKS];
+static uint8_t stack_record_count = 0;
+///@endcond
+
+
+/** @brief      Add a task to the ones the monitor watches
+ *  @details    Called by the @c start_ function of every task in static_alloc.h. Tasks past
+ *              @c STACK_MONITOR_TASKS aren't watched. On a PC every task gets the same big stack, whatever it was
+ *              given on the board, so that is its size.
+ *  @param      task The task's handle; nothing is added if it is NULL
+ *  @param      stack_words Stack the task was given, in words
+ */
+void stack_monitor_add(TaskHandle_t task, uint32_t stack_words)
+{
+    if (task == NULL || stack_record_count >= STACK_MONITOR_TASKS)
+    {
+        return;
+    }
+    #ifdef HOST_TASK_STACK_SIZE
+    stack_words = HOST_TASK_STACK_SIZE / sizeof(StackType_t);
+    #endif
+    stack_records[stack_record_count] = {task, stack_words, 0, 0, false};
+    stack_record_count++;
+}
+
+
+/** @brief      Find how much of a task's stack it has used so far
+ *  @param      record The task
+ *  @returns    Most stack ever used, in words
+ */
+static uint32_t stack_used(const stack_record &record)
+{
+    uint32_t free_words = uxTaskGetStackHighWaterMark(record.task);
+    return (free_words < record.size) ? record.size - free_words : 0;
+}
+
+
+/** @brief      Suggest a stack size for a task from its peak use
+ *  @param      peak Most stack the task has used, in words
+ *  @returns    The peak plus @c STACK_MARGIN_PERCENT, rounded up to a multiple of @c STACK_ROUND_WORDS, and at
+ *              least @c STACK_MIN_WORDS
+ */
+static uint32_t stack_suggestion(uint32_t peak)
+{
+    uint32_t words = (peak * (100 + STACK_MARGIN_PERCENT) + 99) / 100;
+    words = (words + STACK_ROUND_WORDS - 1) / STACK_ROUND_WORDS * STACK_ROUND_WORDS;
+    return (words < STACK_MIN_WORDS) ? STACK_MIN_WORDS : words;
+}
+
+
+/** @brief      Task which looks at every task's stack and keeps the peaks
+ *  @details    A task whose free stack falls under @c STACK_LOW_WORDS gets one warning printed. The monitor is at
+ *              the lowest priority of the tasks, so it looks between the others' loops and doesn't hold them up.
+ *  @param      p_params A pointer to function parameters which we don't use.
+ */
+void task_stack_monitor(void* p_params)
+{
+    (void)p_params;                   // Does nothing but shut up a compiler warning
+
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    char warning[LINE_BUFFER_SIZE];
+
+    for(;;)
+    {
+        for (uint8_t index = 0; index < stack_record_count; index++)
+        {
+            stack_record &record = stack_records[index];
+            uint32_t used = stack_used(record);
+            if (used > record.peak)
+            {
+                record.peak = used;
+                record.peak_ms = millis();
+            }
+            if (!record.warned && record.size - record.peak < STACK_LOW_WORDS)
+            {
+                record.warned = true;
+                snprintf(warning, sizeof(warning), "Stack low: %.16s has %lu of %lu words free\n",
+                         pcTaskGetName(record.task), (unsigned long)(record.size - record.peak),
+                         (unsigned long)record.size);
+                print_serial((const char*)warning);
+            }
+        }
+        vTaskDelayUntil(&xLastWakeTime, stack_monitor_period);
+    }
+}
+
+
+/** @brief      Print each task's stack size, peak use and suggested size
+ *  @details    This is what @c $S does; the columns are described in stack_monitor.h. Each stack is looked at
+ *              again for the report, so a task is only missing a peak if the monitor hasn't run since it was
+ *              reached, in which case its time is the time of the report.
+ */
+void print_stack_report(void)
+{
+    char row[2*LINE_BUFFER_SIZE];
+    #ifdef HOST_TASK_STACK_SIZE
+    print_serial("Stack use on the PC, an estimate for the board\n");
+    #endif
+    print_serial("task                 size     peak     free  suggest      at_ms\n");
+    for (uint8_t index = 0; index < stack_record_count; index++)
+    {
+        const stack_record &record = stack_records[index];
+        uint32_t peak = record.peak;
+        uint32_t peak_ms = record.peak_ms;
+        uint32_t used = stack_used(record);
+        if (used > peak)
+        {
+            peak = used;
+            peak_ms = millis();
+        }
+        snprintf(row, sizeof(row), "%-16s %8lu %8lu %8lu %8lu %10lu\n", pcTaskGetName(record.task),
+                 (unsigned long)record.size, (unsigned long)peak, (unsigned long)(record.size - peak),
+                 (unsigned long)stack_suggestion(peak), (unsigned long)peak_ms);
+        if (strlen(row) > LINE_BUFFER_SIZE - 1)             // Numbers too big for their columns; cut to one line
+        {
+            row[LINE_BUFFER_SIZE - 2] = '\n';
+            row[LINE_BUFFER_SIZE - 1] = '\0';
+        }
+        print_serial((const char*)row);
+    }
+}
@@ -0,0 +1,62 @@
+/** @file       stack_monitor.h
+ *  @brief      This file contains the header for the task which watches how much of its stack each task uses, and
+ *              the report which suggests a stack size for each one.
+ *  @details    Every task made with a @c start_ function in static_alloc.h is added to the monitor as it is made.
+ *              The monitor task reads each task's high water mark (the least free stack it has ever had) a few
+ *              times a second, keeps the peak use and when it was reached, and prints a warning once if a task gets
+ *              close to the end of its stack. @c $S prints the report:
+ *
+ *              | Column    | Meaning                                                                   |
+ *              |-----------|---------------------------------------------------------------------------|
+ *              | size      | Stack the task was given, in words                                        |
+ *              | peak      | Most of it ever used, in words                                            |
+ *              | free      | Size minus peak                                                           |
+ *              | suggest   | Peak plus @c STACK_MARGIN_PERCENT, rounded up, at least @c STACK_MIN_WORDS |
+ *              | at_ms     | Time the peak was reached, in ms since starting                           |
+ *
+ *              Run a real job before reading the report: a task's peak is only as deep as the deepest path it has
+ *              taken so far. A suggested size smaller than the size is RAM that can go to buffers.
+ *
+ *              On a PC (see lib/FreeRTOS_POSIX) each task runs on a big painted stack of its own, and the report
+ *              gives the bytes it used there in words of the board's size. PC code is 64 bit and built differently,
+ *              so it is an estimate of the board's use, not a measure of it; the sizes in static_alloc.h should be
+ *              checked on the board before they are cut.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+#include "libraries&constants.h"
+
+#if (defined STM32L4xx || defined STM32F4xx) && !INCLUDE_uxTaskGetStackHighWaterMark
+    #error "The stack monitor needs INCLUDE_uxTaskGetStackHighWaterMark set to 1 in the FreeRTOS config"
+#endif
+
+
+// Most tasks the monitor keeps track of
+#define STACK_MONITOR_TASKS 12
+
+// Room added to the peak use for a suggested size, in percent; suggested sizes are rounded up to a multiple of
+// STACK_ROUND_WORDS and are never under STACK_MIN_WORDS (FreeRTOS's smallest stack on the Cortex-M4)
+#define STACK_MARGIN_PERCENT 25
+#define STACK_ROUND_WORDS 16
+#define STACK_MIN_WORDS 128
+
+// Free stack in words under which a task gets a warning
+#define STACK_LOW_WORDS 64
+
+
+// Add a task to the ones the monitor watches; stack_words is the stack it was given
+void stack_monitor_add(TaskHandle_t task, uint32_t stack_words);
+
+// Look at each task's stack every stack_monitor_period ms, keep the peaks, and warn about tasks low on stack
+void task_stack_monitor(void* p_params);
+
+// Print each task's stack size, peak use and suggested size
+void print_stack_report(void);
+
+
+#endif //STACK_MONITOR_H
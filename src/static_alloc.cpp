@@ -0,0 +1,64 @@
+/** @file       static_alloc.cpp
+ *  @brief      This file contains the memory of every task in the task table, and the functions which make them.
+ *  @details    See static_alloc.h. On the board FreeRTOS also asks for memory for its own idle task, and the timer
+ *              task if timers are used, when tasks can be made in static memory; that is set aside here too.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include "libraries&constants.h"
+#include "static_alloc.h"
+
+
+// ========================================== Tasks ==========================================
+
+///@cond
+TASK_TABLE(DEFINE_TASK)
+///@endcond
+
+
+// ================================= FreeRTOS's Own Tasks =================================
+
+#if (defined STM32L4xx || defined STM32F4xx)
+
+///@cond
+static StaticTask_t idle_task_tcb;
+static StackType_t idle_task_stack[configMINIMAL_STACK_SIZE];
+///@endcond
+
+/** @brief      Give FreeRTOS memory for the idle task
+ *  @param      pp_tcb Set to the idle task's control block
+ *  @param      pp_stack Set to the idle task's stack
+ *  @param      p_stack_words Set to the size of the stack, in words
+ */
+extern "C" void vApplicationGetIdleTaskMemory(StaticTask_t **pp_tcb, StackType_t **pp_stack, uint32_t *p_stack_words)
+{
+    *pp_tcb = &idle_task_tcb;
+    *pp_stack = idle_task_stack;
+    *p_stack_words = configMINIMAL_STACK_SIZE;
+}
+
+
+#if (configUSE_TIMERS == 1)
+
+///@cond
+static StaticTask_t timer_task_tcb;
+static StackType_t timer_task_stack[configTIMER_TASK_STACK_DEPTH];
+///@endcond
+
+/** @brief      Give FreeRTOS memory for the timer task
+ *  @param      pp_tcb Set to the timer task's control block
+ *  @param      pp_stack Set to the timer task's stack
+ *  @param      p_stack_words Set to the size of the stack, in words
+ */
+extern "C" void vApplicationGetTimerTaskMemory(StaticTask_t **pp_tcb, StackType_t **pp_stack, uint32_t *p_stack_words)
+{
+    *pp_tcb = &timer_task_tcb;
+    *pp_stack = timer_task_stack;
+    *p_stack_words = configTIMER_TASK_STACK_DEPTH;
+}
+
+#endif //configUSE_TIMERS
+
+#endif //STM32L4xx || STM32F4xx
@@ -0,0 +1,123 @@
+/** @file       static_alloc.h
+ *  @brief      This file contains the table of every task, queue and share, which are all made in memory set aside
+ *              when the program is built instead of on the heap.
+ *  @details    Each row of a table gives a task, queue or share its name, the part of the firmware it belongs to,
+ *              and what it needs. The rows are turned into code by the @c DEFINE_ macros:
+ *
+ *              | Table             | Made with                 | Memory                                        |
+ *              |-------------------|---------------------------|-----------------------------------------------|
+ *              | @c TASK_TABLE     | @c start_<name>()         | @c <name>_stack and @c <name>_tcb             |
+ *              | @c QUEUE_TABLE    | @c DEFINE_QUEUE           | The queue, @c <name>_items, @c <name>_control |
+ *              | @c SHARE_TABLE    | @c DEFINE_SHARE           | The share or ring itself                      |
+ *
+ *              Tasks are made with @c xTaskCreateStatic() in static_alloc.cpp, one @c start_ function each, and
+ *              queues with @c xQueueCreateStatic() where main.cpp defines them. A task's stack is only kept in the
+ *              program if its @c start_ function is called, so a build only sets aside the stacks of the tasks it
+ *              runs. Stack sizes are in words, like @c xTaskCreate() takes them; @c $S prints how much of each
+ *              stack its task has used (see stack_monitor.h).
+ *
+ *              Every task's timing is in its row too: the period its loop waits for (the @c <name>_period
+ *              constant), its deadline, and the longest time it takes around its loop. Before the scheduler starts,
+ *              the tasks made so far are checked against their deadlines (see schedule.h).
+ *
+ *              After each build ram_map.py reads these tables and the program's symbols, and prints the RAM each
+ *              part of the firmware takes, what else is in RAM, and on the board how much is left for the heap and
+ *              the main stack.
+ *
+ *              The tasks made in the testing sections of main.cpp which aren't built by any environment in
+ *              platformio.ini still use @c xTaskCreate().
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef STATIC_ALLOC_H
+#define STATIC_ALLOC_H
+
+#include "libraries&constants.h"
+
+#if (defined STM32L4xx || defined STM32F4xx) && (configSUPPORT_STATIC_ALLOCATION != 1)
+    #error "Tasks and queues are made in static memory: build with -D configSUPPORT_STATIC_ALLOCATION=1"
+#endif
+
+
+// ========================================== Tables ==========================================
+
+// Every task: name, part of the firmware, task function, name for printouts, stack in words, priority, period and
+// deadline in ms (a period of 0 for a task which runs once), and longest time around its loop in us (0 if not measured)
+#define TASK_TABLE(TASK) \
+    TASK(read_serial,       serial,     task_read_serial,       "Reading Serial",   1000,   8,  2,      2,      810)    \
+    TASK(print_serial,      serial,     task_print_serial,      "Printing Serial",  1000,   3,  10,     10,     100)    \
+    TASK(status_report,     serial,     task_status_report,     "Status Report",    1000,   2,  20,     20,     50)     \
+    TASK(translate,         motion,     task_translate,         "Translating",      1000,   9,  100,    100,    750)    \
+    TASK(control_path,      control,    task_test_control_path, "Motor Test",       1000,   1,  10,     10,     120)    \
+    TASK(encoder_A,         control,    task_encoder_A,         "Run encoder A",    4096,   13, 10,     10,     20)     \
+    TASK(encoder_B,         control,    task_encoder_B,         "Run encoder B",    4096,   13, 10,     10,     20)     \
+    TASK(control,           control,    control_task,           "Control",          1000,   12, 30,     30,     0)      \
+    TASK(check_home,        motion,     check_home_task,        "Check Home",       1000,   5,  100,    100,    0)      \
+    TASK(safety,            safety,     safety_task,            "Safety",           4096,   3,  3000,   3000,   0)      \
+    TASK(benchmark_queues,  benchmark,  task_benchmark_queues,  "Benchmark",        1000,   4,  0,      0,      0)      \
+    TASK(benchmark_shares,  benchmark,  task_benchmark_shares,  "Benchmark shares", 1000,   4,  0,      0,      0)      \
+    TASK(benchmark_bulk,    benchmark,  task_benchmark_bulk,    "Benchmark bulk",   1000,   4,  0,      0,      0)      \
+    TASK(stack_monitor,     diagnostics, task_stack_monitor,    "Stack Monitor",    384,    1,  250,    250,    50)     \
+    TASK(cpu_load,          diagnostics, task_cpu_load,         "CPU Load",         384,    1,  500,    500,    50)
+
+// Every queue: name, part of the firmware, item type, items, name for printouts, ticks to wait for room or an item
+#define QUEUE_TABLE(QUEUE) \
+    QUEUE(chars_to_print_queue, serial, char[LINE_BUFFER_SIZE], WRITE_Q_SIZE,    "char array printer", portMAX_DELAY) \
+    QUEUE(read_chars_queue,     serial, char[LINE_BUFFER_SIZE], READ_Q_SIZE,     "read_val",           portMAX_DELAY) \
+    QUEUE(binary_move_queue,    motion, XYSFvalues,             BIN_MOVE_Q_SIZE, "Binary Moves",       portMAX_DELAY) \
+    QUEUE(telemetry_queue,      serial, telemetry_frame,        TELEM_Q_SIZE,    "Telemetry",          0)
+
+// Every share and ring: name, part of the firmware, type, name for printouts
+#define SHARE_TABLE(SHARE) \
+    SHARE(enc_A_output_share,               control,    seqlock_share<encoder_output>,  "Encoder A variables")  \
+    SHARE(enc_B_output_share,               control,    seqlock_share<encoder_output>,  "Encoder B variables")  \
+    SHARE(ramp_segment_coefficient_queue,   motion,     ramp_segment_ring,              "Ramp Coefficients")    \
+    SHARE(machine_state_board,              motion,     blackboard<machine_state>,      "Machine State")        \
+    SHARE(setpoint_share,                   motion,     Share<motor_setpoint>,          "Setpoint")             \
+    SHARE(status_period_share,              serial,     Share<uint16_t>,                "Status Period")        \
+    SHARE(telemetry_settings_share,         serial,     Share<telemetry_settings>,      "Telemetry Settings")
+
+
+// ====================================== Turning Rows Into Code ======================================
+
+// Declare the function which makes a task in its own memory, and the task's period in ticks (ms), which its loop
+// waits for
+#define DECLARE_TASK(name, subsystem, function, print_name, stack_words, priority, period, deadline, wcet_us) \
+    TaskHandle_t start_##name(void *p_params = NULL); \
+    const TickType_t name##_period = period;
+
+// Set aside a task's stack and control block, and write the function which makes the task in them, has the stack
+// monitor and the CPU load monitor watch it, adds it to the schedule check and numbers it for the trace
+#define DEFINE_TASK(name, subsystem, function, print_name, stack_words, priority, period, deadline, wcet_us) \
+    static StackType_t name##_stack[stack_words]; \
+    static StaticTask_t name##_tcb; \
+    TaskHandle_t start_##name(void *p_params) \
+    { \
+        TaskHandle_t task = xTaskCreateStatic(function, print_name, stack_words, p_params, priority, \
+                                              name##_stack, &name##_tcb); \
+        stack_monitor_add(task, stack_words); \
+        cpu_load_add(task); \
+        schedule_add(task, period, deadline, wcet_us); \
+        trace_add_task(task); \
+        return task; \
+    }
+
+// Set aside a queue's items and control block, and make the queue in them
+#define DEFINE_QUEUE(name, subsystem, type, items, print_name, wait) \
+    static uint8_t name##_items[(items)*sizeof(type)]; \
+    static StaticQueue_t name##_control; \
+    Queue<type> name(items, print_name, wait, name##_items, &name##_control);
+
+// Make a share or ring
+#define DEFINE_SHARE(name, subsystem, type, print_name) \
+    type name(print_name);
+
+
+// ========================================= Functions =========================================
+
+// Make each task in its own memory; each returns the task's handle. Each task's period is <name>_period
+TASK_TABLE(DECLARE_TASK)
+
+#endif //STATIC_ALLOC_H
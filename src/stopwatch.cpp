@@ -10,6 +10,7 @@
 
 #include "stopwatch.h"
 #include "libraries&constants.h"
+#include <new>
 
 /** @brief      Creates a StopWatch constructor
  *  @details    Uses the HardwareTimer methods and user passed hardware timer (TIM1, TIM2, etc)
@@ -19,10 +20,10 @@
  *  @param      tmrpin the channel pin specifically assigned to the chosen timer
  */ 
 
-//If the pin is set to the uint8_t pin name variable, use this function
-StopWatch::StopWatch(TIM_TypeDef* p_Stpwtch, uint8_t tmrpin)
+//If the pin is set to the uint8_t pin name variable, use this function. It hands over to the PinName constructor;
+//calling that in the body would only set up a temporary StopWatch and leave this one empty.
+StopWatch::StopWatch(TIM_TypeDef* p_Stpwtch, uint8_t tmrpin) : StopWatch(p_Stpwtch, digitalPinToPinName(tmrpin))
 {
-    StopWatch(p_Stpwtch, digitalPinToPinName(tmrpin));
 }
 
 //Otherwise, we want the true PinName of the pin we're using
@@ -31,8 +32,8 @@ StopWatch::StopWatch(TIM_TypeDef* p_Stpwtch, PinName tmrpin)
     // save inputs to class member data 
     _p_Stpwtch = p_Stpwtch;
     _tmrpin = tmrpin;
-    // create a new HardwareTimer instance
-    a_Tmr = new HardwareTimer(_p_Stpwtch);
+    // create a new HardwareTimer instance, in this object's memory instead of the heap
+    a_Tmr = new (_timer_memory) HardwareTimer(_p_Stpwtch);
     // Initialize the timer into OUTPUT_COMPARE with on output
     // and set it to count at 1 MHz
     a_Tmr -> pause();
@@ -32,6 +32,7 @@ class StopWatch
     //Timer initialization arugments
     TIM_TypeDef* _p_Stpwtch;   ///< pointer to user-passed hardware timer (TIM1,TIM2, etc) 
     HardwareTimer* a_Tmr;      ///< pointer to HardwareTimer class instance
+    alignas(HardwareTimer) uint8_t _timer_memory[sizeof(HardwareTimer)]; ///< where @c a_Tmr is made, so it isn't on the heap
     PinName _tmrpin;           ///< the channel pin specifically assigned to the chosen timer
     
     // Class member data
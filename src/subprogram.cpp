@@ -0,0 +1,271 @@
+/** @file       subprogram.cpp
+ *  @brief      This file contains the class which keeps subprograms and runs them with an offset, rotation and scale.
+ *  @details    The lines used to define and call subprograms are described in subprogram.h. Each subprogram is
+ *              decoded once when it is defined, so a call costs the host one short line no matter how big the shape
+ *              is, and costs the laser no gcode decoding at all.
+ *
+ *  @date    10-19-2026 File Created
+ *
+*/
+
+#include "libraries&constants.h"
+
+
+/** @brief      Constructor for the subprogram_store class
+ */
+subprogram_store::subprogram_store(void)
+{
+    _length = 0;
+    _n_programs = 0;
+    _defining = false;
+    _overflow = false;
+    _read_index = 0;
+    _read_end = 0;
+}
+
+
+/** @brief      Start defining a subprogram
+ *  @details    If a subprogram with the same number is already defined, it is thrown away first and the ones after
+ *              it in the buffer are moved down to fill the gap.
+ *  @param      number The O-word number of the subprogram
+ *  @returns    @c false if a subprogram is already being defined or there is no room for another one
+ */
+bool subprogram_store::begin_define(uint16_t number)
+{
+    if (_defining)
+    {
+        return false;
+    }
+
+    //Replace an old definition with the same number
+    uint8_t index = find(number);
+    if (index < _n_programs)
+    {
+        subprogram_entry old = _programs[index];
+        memmove(&_data[old.start], &_data[old.start + old.length], _length - old.start - old.length);
+        _length -= old.length;
+        for (uint8_t i = index; i + 1 < _n_programs; i++)
+        {
+            _programs[i] = _programs[i + 1];
+            _programs[i].start -= old.length;
+        }
+        _n_programs--;
+    }
+
+    if (_n_programs >= SUB_MAX_PROGRAMS)
+    {
+        return false;
+    }
+
+    _new.number = number;
+    _new.start = _length;
+    _new.length = 0;
+    _new.n_moves = 0;
+    _codec.reset(origin());
+    _last = origin();
+    _overflow = false;
+    _defining = true;
+    return true;
+}
+
+
+/** @brief      Check if a subprogram is being defined
+ *  @returns    @c true between @c O<n> and @c M99
+ */
+bool subprogram_store::is_defining(void)
+{
+    return _defining;
+}
+
+
+/** @brief      Add a move to the subprogram being defined
+ *  @details    Moves with no length are skipped since they would make a ramp with no time; a change in power alone
+ *              is carried by the next move. If the subprogram runs out of room, the rest of its moves are dropped
+ *              and @c end_define() reports it.
+ *  @param      move The move, in subprogram coordinates
+ */
+void subprogram_store::add_move(XYSFvalues move)
+{
+    if (!_defining || _overflow || (move.X == _last.X && move.Y == _last.Y))
+    {
+        return;
+    }
+
+    uint8_t record[MOVE_RECORD_MAX_SIZE];
+    uint8_t size = _codec.encode(move, record);
+    if (_new.start + _new.length + size > SUB_BUFFER_SIZE)
+    {
+        _overflow = true;
+        return;
+    }
+
+    memcpy(&_data[_new.start + _new.length], record, size);
+    _new.length += size;
+    _new.n_moves++;
+    _last = move;
+}
+
+
+/** @brief      Finish defining a subprogram
+ *  @returns    @c true if the subprogram was kept, @c false if it didn't fit in the buffer or has no moves
+ */
+bool subprogram_store::end_define(void)
+{
+    if (!_defining)
+    {
+        return false;
+    }
+    _defining = false;
+
+    if (_overflow || _new.n_moves == 0)
+    {
+        return false;
+    }
+    _programs[_n_programs++] = _new;
+    _length += _new.length;
+    return true;
+}
+
+
+/** @brief      Start running a subprogram
+ *  @param      number The O-word number of the subprogram
+ *  @param      X Where the subprogram's origin goes in X
+ *  @param      Y Where the subprogram's origin goes in Y
+ *  @param      angle Rotation about the origin, in degrees counterclockwise
+ *  @param      scale Scale about the origin
+ *  @returns    @c false if the subprogram isn't defined, or one is being defined
+ */
+bool subprogram_store::start_call(uint16_t number, float X, float Y, float angle, float scale)
+{
+    uint8_t index = find(number);
+    if (_defining || index >= _n_programs)
+    {
+        return false;
+    }
+
+    _read_index = _programs[index].start;
+    _read_end = _read_index + _programs[index].length;
+    _X0 = X;
+    _Y0 = Y;
+    _cos_angle = scale*cos(angle*PI/180);
+    _sin_angle = scale*sin(angle*PI/180);
+    _codec.reset(origin());
+    _call_started = false;
+    return true;
+}
+
+
+/** @brief      Get the next move of a call
+ *  @details    If the subprogram starts with a cutting move, the call first travels to the subprogram's origin with
+ *              the laser off, so the cut starts where it did in the definition.
+ *  @param      move Filled with the next move, where the call puts it
+ *  @returns    @c true if there is a move, @c false once the call is done
+ */
+bool subprogram_store::next_move(XYSFvalues &move)
+{
+    if (_read_index >= _read_end)
+    {
+        return false;
+    }
+
+    if (!_call_started)
+    {
+        _call_started = true;
+        move_codec peek = _codec;
+        peek.decode(&_data[_read_index], move);
+        if (move.S != 0)
+        {
+            move = origin();
+            place(move);
+            return true;
+        }
+    }
+
+    _read_index += _codec.decode(&_data[_read_index], move);
+    place(move);
+    return true;
+}
+
+
+/** @brief      Stop defining or calling a subprogram
+ *  @details    Used by a soft reset. A subprogram that was being defined is thrown away; ones already defined are kept.
+ */
+void subprogram_store::abort(void)
+{
+    _defining = false;
+    _read_index = _read_end;
+}
+
+
+/** @brief      Get the number of bytes used by all subprograms
+ *  @returns    Bytes of the buffer in use
+ */
+uint16_t subprogram_store::get_bytes_used(void)
+{
+    return _length;
+}
+
+
+/** @brief      Find a subprogram by number
+ *  @param      number The O-word number of the subprogram
+ *  @returns    Index in @c _programs, or @c SUB_MAX_PROGRAMS if it isn't defined
+ */
+uint8_t subprogram_store::find(uint16_t number)
+{
+    for (uint8_t i = 0; i < _n_programs; i++)
+    {
+        if (_programs[i].number == number)
+        {
+            return i;
+        }
+    }
+    return SUB_MAX_PROGRAMS;
+}
+
+
+/** @brief      Move a point from subprogram coordinates to where the call puts it
+ *  @param      move The move to change in place
+ */
+void subprogram_store::place(XYSFvalues &move)
+{
+    float X = move.X;
+    float Y = move.Y;
+    move.X = _X0 + _cos_angle*X - _sin_angle*Y;
+    move.Y = _Y0 + _sin_angle*X + _cos_angle*Y;
+}
+
+
+/** @brief      Get the origin every subprogram is packed from
+ *  @returns    Position 0,0 with the laser off at travel speed
+ */
+XYSFvalues subprogram_store::origin(void)
+{
+    XYSFvalues start;
+    start.F = get_setting(SETTING_TRAVEL_SPEED);
+    return start;
+}
+
+
+
+// ======================================== Subfunctions ========================================
+
+/** @brief      Check if a line defines, ends or calls a subprogram
+ *  @param      line A line from the host, after its line number and checksum are taken off
+ *  @returns    One of the @c SUB_CMD_ values
+ */
+uint8_t find_subprogram_cmd(char *line)
+{
+    if (line[0] == 'O')
+    {
+        return SUB_CMD_DEFINE;
+    }
+    if (strncmp(line,"M99",3) == 0 && (line[3] < '0' || line[3] > '9'))
+    {
+        return SUB_CMD_END;
+    }
+    if (strncmp(line,"M98",3) == 0 && (line[3] < '0' || line[3] > '9'))
+    {
+        return SUB_CMD_CALL;
+    }
+    return SUB_CMD_NULL;
+}
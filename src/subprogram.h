@@ -0,0 +1,128 @@
+/** @file       subprogram.h
+ *  @brief      This file contains the header for the subprogram.cpp file, which keeps shapes defined once and runs
+ *              them wherever they are called.
+ *  @details    Subprograms are written the Fanuc way, with O-word numbers:
+ *
+ *              | Line                                        | Does                                              |
+ *              |---------------------------------------------|---------------------------------------------------|
+ *              | @c O<n>                                     | Start defining subprogram @c n (lines don't run)  |
+ *              | @c M99                                      | End the definition                                |
+ *              | @c M98 @c P<n> @c X @c Y @c R @c Q          | Run subprogram @c n                               |
+ *
+ *              The lines of a definition are ordinary gcode, with positions relative to the subprogram's own origin.
+ *              They are decoded once and kept as compact move records (see @c move_codec). A call places the origin
+ *              at @c X @c Y, turns the shape by @c R degrees counterclockwise and scales it by @c Q (1 if not given),
+ *              then sends the moves through the translator like any others. Defining a number again replaces it.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef SUBPROGRAM_H
+#define SUBPROGRAM_H
+
+#include "libraries&constants.h"
+
+// ========================================== Constants ==========================================
+
+// Bytes of RAM for all subprograms together
+#define SUB_BUFFER_SIZE 4096
+
+// Most subprograms that can be defined at once
+#define SUB_MAX_PROGRAMS 16
+
+// Subprogram lines, from find_subprogram_cmd()
+#define SUB_CMD_NULL 0              // Not a subprogram line
+#define SUB_CMD_DEFINE 1            // O<n>
+#define SUB_CMD_END 2               // M99
+#define SUB_CMD_CALL 3              // M98
+
+
+// =========================================== Structs ===========================================
+
+/// Where one subprogram's moves are kept in the subprogram buffer
+struct subprogram_entry
+{
+    uint16_t number = 0;            // O-word number
+    uint16_t start = 0;             // First byte in the buffer
+    uint16_t length = 0;            // Bytes of moves
+    uint16_t n_moves = 0;           // Number of moves
+};
+
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which stores subprograms as compact move records and plays them back with an offset, rotation
+ *              and scale.
+ *  @details    All subprograms share one buffer, packed one after another. Every subprogram is packed from the
+ *              origin with the laser off, so each one can be unpacked on its own. A call hands out one move at a
+ *              time with @c next_move(), so the translate task can run it only as fast as the ramp queue frees up.
+ */
+class subprogram_store
+{
+    protected:
+    uint8_t _data[SUB_BUFFER_SIZE];                 // Moves of all subprograms
+    uint16_t _length;                               // Bytes used in _data
+    subprogram_entry _programs[SUB_MAX_PROGRAMS];   // Subprograms that have been defined
+    uint8_t _n_programs;                            // Number of subprograms defined
+
+    bool _defining;                                 // True between O<n> and M99
+    bool _overflow;                                 // True if the subprogram being defined didn't fit
+    subprogram_entry _new;                          // Subprogram being defined
+    XYSFvalues _last;                               // Last move added to the subprogram being defined
+
+    move_codec _codec;                              // Packs moves while defining and unpacks them while calling
+    uint16_t _read_index;                           // Next byte to play in a call
+    uint16_t _read_end;                             // Byte after the last one to play
+    bool _call_started;                             // True once a call has handed out its first move
+    float _X0;                                      // Where the subprogram origin goes
+    float _Y0;
+    float _cos_angle;                               // Rotation and scale of the call, put together
+    float _sin_angle;
+
+    // Find a subprogram by number; returns its index or SUB_MAX_PROGRAMS if it isn't defined
+    uint8_t find(uint16_t number);
+
+    // Move a point from subprogram coordinates to where the call puts it
+    void place(XYSFvalues &move);
+
+    // Origin, with the laser off, that every subprogram is packed from
+    XYSFvalues origin(void);
+
+    public:
+    // Constructor
+    subprogram_store(void);
+
+    // Start defining a subprogram
+    bool begin_define(uint16_t number);
+
+    // Check if a subprogram is being defined
+    bool is_defining(void);
+
+    // Add a move, in subprogram coordinates, to the subprogram being defined
+    void add_move(XYSFvalues move);
+
+    // Finish defining; returns false if it didn't fit or has no moves
+    bool end_define(void);
+
+    // Start running a subprogram
+    bool start_call(uint16_t number, float X, float Y, float angle, float scale);
+
+    // Get the next move of the call; returns false once it is done
+    bool next_move(XYSFvalues &move);
+
+    // Stop defining or calling, for a soft reset
+    void abort(void);
+
+    // Get the number of bytes used by all subprograms
+    uint16_t get_bytes_used(void);
+};
+
+
+// =========================================== Functions ===========================================
+
+// Check if a line defines, ends or calls a subprogram
+uint8_t find_subprogram_cmd(char *line);
+
+
+#endif //SUBPROGRAM_H
@@ -33,6 +33,13 @@
 #include <Arduino.h>
 #include <FreeRTOS.h>                       // Main header for FreeRTOS
 #include "baseshare.h"
+#include "trace.h"                          // Puts and gets go in the trace
+
+/** @brief   Items @c Queue::drain_into() takes out of the queue at a time.
+ *  @details They are copied onto the calling task's stack, so this times the
+ *           size of an item must fit there with room to spare.
+ */
+#define QUEUE_DRAIN_BATCH 4
 
 
 //-----------------------------------------------------------------------------
@@ -135,6 +142,17 @@ template <class dataType> class Queue : public BaseShare
         uint16_t buf_size;                ///< Size of queue buffer in bytes
         uint16_t max_full;                ///< Maximum number of bytes in queue
 
+        // Put an item in, waiting for room if there isn't any, and count it
+        bool send_counted (const void* p_item, TickType_t ticks, 
+                           bool to_front);
+
+        // Take an item out or copy it, waiting for one if there isn't one,
+        // and count it
+        bool receive_counted (void* p_item, TickType_t ticks, bool remove);
+
+        // Register the FreeRTOS queue and set up the counts
+        void set_up (BaseType_t queue_size, TickType_t wait_time);
+
     // Public methods can be called from anywhere in the program where there is
     // a pointer or reference to an object of this class
     public:
@@ -142,6 +160,13 @@ template <class dataType> class Queue : public BaseShare
         Queue (BaseType_t queue_size, const char* p_name = NULL, 
                TickType_t = portMAX_DELAY);
 
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+        // This constructor creates a FreeRTOS queue in memory it is given
+        Queue (BaseType_t queue_size, const char* p_name, 
+               TickType_t wait_time, uint8_t* p_storage, 
+               StaticQueue_t* p_control);
+#endif
+
         // Put an item into the queue behind other items.
         bool put (const dataType& item);
 
@@ -166,7 +191,7 @@ template <class dataType> class Queue : public BaseShare
          */
         bool butt_in (const dataType& item)
         {
-            return ((bool)(xQueueSendToFront (handle, &item, ticks_to_wait)));
+            return (send_counted (&item, ticks_to_wait, true));
         }
 
         // This method puts an item into the front of the queue from within 
@@ -208,6 +233,18 @@ template <class dataType> class Queue : public BaseShare
         // service routine
         void ISR_peek (dataType& recv_item);
 
+        // Put a number of items into the back of the queue, many for each
+        // critical section
+        size_t put_n (const dataType* p_items, size_t count, 
+                      TickType_t ticks);
+
+        // Get up to a number of items from the queue, many for each critical
+        // section
+        size_t get_n (dataType* p_items, size_t max_count, TickType_t ticks);
+
+        // Take every item out of the queue and give each one to a function
+        template <class Callback> size_t drain_into (Callback callback);
+
         /** @brief   Return true if the queue has contents which can be read.
          *  @details This method allows one to check if the queue has any 
          *           contents. It must @b not be called from within an 
@@ -286,6 +323,16 @@ template <class dataType> class Queue : public BaseShare
         {
             return handle;
         }
+
+        /** @brief   Get the counts of what has been done with the queue.
+         *  @details Fills in the most items it has held from @c max_full.
+         *  @param   copy Filled with the counts
+         */
+        void get_stats (share_stats& copy)
+        {
+            copy = stats;
+            copy.most = max_full;
+        }
 }; // class Queue 
 
 
@@ -308,6 +355,51 @@ Queue<dataType>::Queue (BaseType_t queue_size, const char* p_name,
     // Create a FreeRTOS queue object with space for the data items
     handle = xQueueCreate (queue_size, sizeof (dataType));
 
+    set_up (queue_size, wait_time);
+}
+
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+/** @brief   Construct a queue object in memory which is given to it.
+ *  @details This constructor creates the FreeRTOS queue in memory which has
+ *           been set aside when the program was built, so nothing comes from
+ *           the heap and the map file shows where the memory went. The 
+ *           memory is usually made with @c DEFINE_QUEUE (see static_alloc.h).
+ *  @param   queue_size The number of items which can be stored in the queue
+ *  @param   p_name A name to be shown in the list of task shares
+ *  @param   wait_time How long, in RTOS ticks, to wait for room in the queue
+ *           or for an item to come
+ *  @param   p_storage Memory for the items, @c queue_size times the size of
+ *           an item in bytes
+ *  @param   p_control Memory for the FreeRTOS queue's own data
+ */
+template <class dataType>
+Queue<dataType>::Queue (BaseType_t queue_size, const char* p_name, 
+                        TickType_t wait_time, uint8_t* p_storage, 
+                        StaticQueue_t* p_control)
+    : BaseShare (p_name)
+{
+    handle = xQueueCreateStatic (queue_size, sizeof (dataType), p_storage, 
+                                 p_control);
+
+    set_up (queue_size, wait_time);
+}
+#endif
+
+
+/** @brief   Register the FreeRTOS queue and set up the counts.
+ *  @details This is the part of construction which doesn't depend on where
+ *           the queue's memory came from.
+ *  @param   queue_size The number of items which can be stored in the queue
+ *  @param   wait_time How long, in RTOS ticks, to wait for room or an item
+ */
+template <class dataType>
+void Queue<dataType>::set_up (BaseType_t queue_size, TickType_t wait_time)
+{
+    // Name it for debuggers and the PC build's queue report; does nothing 
+    // when configQUEUE_REGISTRY_SIZE is 0
+    vQueueAddToRegistry (handle, name);
+
     // Store the wait time; it will be used when writing to the queue
     ticks_to_wait = wait_time;
 
@@ -316,6 +408,80 @@ Queue<dataType>::Queue (BaseType_t queue_size, const char* p_name,
 
     // We haven't stored any items in the queue yet
     max_full = 0;
+    stats.kind = "queue";
+    stats.size = queue_size;
+}
+
+
+/** @brief   Put an item into the queue, and count it.
+ *  @details The item is tried without waiting first, so only a put which 
+ *           really has to wait for room reads the clock; the time it waits
+ *           is added to the put side's blocked time. 
+ *  @param   p_item Pointer to the item
+ *  @param   ticks How long, in RTOS ticks, to wait for room
+ *  @param   to_front @c true to put the item in front of the others
+ *  @return  @c true if the item was put in
+ */
+template <class dataType>
+bool Queue<dataType>::send_counted (const void* p_item, TickType_t ticks, 
+                                    bool to_front)
+{
+    bool sent = to_front ? xQueueSendToFront (handle, p_item, 0)
+                         : xQueueSendToBack (handle, p_item, 0);
+    if (!sent && ticks > 0)
+    {
+        uint32_t start = micros ();
+        sent = to_front ? xQueueSendToFront (handle, p_item, ticks)
+                        : xQueueSendToBack (handle, p_item, ticks);
+        stats.put_wait_us += micros () - start;
+    }
+
+    if (sent)
+    {
+        stats.puts++;
+        trace_record (TRACE_QUEUE_PUT, trace_id, 1);
+    }
+    else
+    {
+        stats.failed_puts++;
+    }
+    return (sent);
+}
+
+
+/** @brief   Take an item out of the queue or copy it, and count it.
+ *  @details Like @c send_counted(), only a get which really has to wait for
+ *           an item reads the clock. Copying an item with @c peek() doesn't
+ *           count as a get, but its wait is counted.
+ *  @param   p_item Pointer to where the item goes
+ *  @param   ticks How long, in RTOS ticks, to wait for an item
+ *  @param   remove @c true to take the item out, @c false to only copy it
+ *  @return  @c true if there was an item
+ */
+template <class dataType>
+bool Queue<dataType>::receive_counted (void* p_item, TickType_t ticks, 
+                                       bool remove)
+{
+    bool got = remove ? xQueueReceive (handle, p_item, 0)
+                      : xQueuePeek (handle, p_item, 0);
+    if (!got && ticks > 0)
+    {
+        uint32_t start = micros ();
+        got = remove ? xQueueReceive (handle, p_item, ticks)
+                     : xQueuePeek (handle, p_item, ticks);
+        stats.get_wait_us += micros () - start;
+    }
+
+    if (!got)
+    {
+        stats.failed_gets++;
+    }
+    else if (remove)
+    {
+        stats.gets++;
+        trace_record (TRACE_QUEUE_GET, trace_id, 1);
+    }
+    return (got);
 }
 
 
@@ -333,7 +499,7 @@ inline void Queue<dataType>::get (dataType& recv_item)
 {
     // If xQueueReceive doesn't return pdTrue, nothing was found in the queue, 
     // so no changes are made to the item
-    xQueueReceive (handle, &recv_item, ticks_to_wait);
+    receive_counted (&recv_item, ticks_to_wait, true);
 }
 
 
@@ -351,7 +517,15 @@ inline void Queue<dataType>::ISR_get (dataType& recv_item)
 
     // If xQueueReceive doesn't return pdTrue, nothing was found in the queue,
     // so we'll return the item as created by its default constructor
-    xQueueReceiveFromISR (handle, &recv_item, &task_awakened);
+    if (xQueueReceiveFromISR (handle, &recv_item, &task_awakened))
+    {
+        stats.gets++;
+        trace_record (TRACE_QUEUE_GET, trace_id, 1);
+    }
+    else
+    {
+        stats.failed_gets++;
+    }
 }
 
 
@@ -371,7 +545,7 @@ inline void Queue<dataType>::peek (dataType& recv_item)
 {
     // If xQueueReceive doesn't return pdTrue, nothing was found in the queue,
     // so don't change the item
-    xQueuePeek (handle, &recv_item, ticks_to_wait);
+    receive_counted (&recv_item, ticks_to_wait, false);
 }
 
 
@@ -409,8 +583,7 @@ inline void Queue<dataType>::ISR_peek (dataType& recv_item)
 template <class dataType>
 bool Queue<dataType>::put (const dataType& item)
 {
-    bool return_value = (bool)(xQueueSendToBack (handle, &item, 
-                                                 ticks_to_wait));
+    bool return_value = send_counted (&item, ticks_to_wait, false);
 
     // Keep track of the maximum fillage of the queue
     uint16_t fillage = uxQueueMessagesWaiting (handle);
@@ -441,6 +614,15 @@ inline bool Queue<dataType>::ISR_put (const dataType& item)
     // Call the FreeRTOS function and save its return value
     return_value = (bool)(xQueueSendToBackFromISR (handle, &item, 
                                                    &shouldSwitch));
+    if (return_value)
+    {
+        stats.puts++;
+        trace_record (TRACE_QUEUE_PUT, trace_id, 1);
+    }
+    else
+    {
+        stats.failed_puts++;
+    }
 
     // Keep track of the maximum fillage of the queue. BUG: max_full isn't
     // thread safe (but getting max_full corrupted shouldn't cause a calamity)
@@ -473,12 +655,173 @@ bool Queue<dataType>::ISR_butt_in (const dataType& item)
     // Call the FreeRTOS function and save its return value
     return_value = (bool)(xQueueSendToFrontFromISR (handle, &item, 
                                                     &shouldSwitch));
+    if (return_value)
+    {
+        stats.puts++;
+        trace_record (TRACE_QUEUE_PUT, trace_id, 1);
+    }
+    else
+    {
+        stats.failed_puts++;
+    }
 
     // Return the return value saved from the call to xQueueSendToBackFromISR()
     return (return_value);
 }
 
 
+/** @brief   Put a number of items into the back of the queue, many for each 
+ *           critical section.
+ *  @details Each @c put() is a trip through the kernel, with a critical 
+ *           section of its own and a check for a task switch. This method 
+ *           waits for room for one item, the way @c put() does, then puts in
+ *           as many more as there is room for inside one critical section, 
+ *           and switches tasks at most once at the end; then it waits for 
+ *           room again if there are items left. It must @b not be used 
+ *           within an ISR. 
+ *  @param   p_items Pointer to the first of the items to put in
+ *  @param   count The number of items
+ *  @param   ticks How long, in RTOS ticks, to wait each time the queue is
+ *           full, or @c portMAX_DELAY to wait forever
+ *  @return  The number of items put into the queue; less than @c count only
+ *           if the queue stayed full for @c ticks
+ */
+template <class dataType>
+size_t Queue<dataType>::put_n (const dataType* p_items, size_t count, 
+                               TickType_t ticks)
+{
+    size_t sent = 0;                        // Items put in so far
+
+    while (sent < count)
+    {
+        // Wait for room for the first item, like put() does
+        if (!send_counted (&p_items[sent], ticks, false))
+        {
+            break;
+        }
+        sent++;
+        size_t run_start = sent;
+
+        // Then put in as many more as fit without leaving the critical section
+        signed portBASE_TYPE shouldSwitch = pdFALSE;
+        portENTER_CRITICAL ();
+        while (sent < count)
+        {
+            signed portBASE_TYPE itemSwitch = pdFALSE;
+            if (!xQueueSendToBackFromISR (handle, &p_items[sent], &itemSwitch))
+            {
+                break;
+            }
+            shouldSwitch |= itemSwitch;
+            sent++;
+        }
+        uint16_t fillage = uxQueueMessagesWaiting (handle);
+        portEXIT_CRITICAL ();
+        stats.puts += sent - run_start;
+        if (sent > run_start)
+        {
+            trace_record (TRACE_QUEUE_PUT, trace_id, sent - run_start);
+        }
+
+        // Keep track of the maximum fillage of the queue
+        if (fillage > max_full)
+        {
+            max_full = fillage;
+        }
+
+        // Let a task which was waiting for these items run if it should
+        portYIELD_FROM_ISR (shouldSwitch);
+    }
+
+    return (sent);
+}
+
+
+/** @brief   Get up to a number of items from the queue, many for each 
+ *           critical section.
+ *  @details This method waits for one item, the way @c get() does, then takes
+ *           as many more as are there, up to @c max_count, inside one critical
+ *           section, and switches tasks at most once at the end. It must 
+ *           @b not be used within an ISR. 
+ *  @param   p_items Pointer to room for @c max_count items
+ *  @param   max_count The most items to get
+ *  @param   ticks How long, in RTOS ticks, to wait for the first item, or 0
+ *           to not wait
+ *  @return  The number of items gotten, which is 0 if the queue stayed empty
+ */
+template <class dataType>
+size_t Queue<dataType>::get_n (dataType* p_items, size_t max_count, 
+                               TickType_t ticks)
+{
+    // Wait for the first item, like get() does
+    if (max_count == 0 || !receive_counted (&p_items[0], ticks, true))
+    {
+        return (0);
+    }
+    size_t got = 1;                         // Items gotten so far
+
+    // Then take what else is there without leaving the critical section
+    signed portBASE_TYPE shouldSwitch = pdFALSE;
+    portENTER_CRITICAL ();
+    while (got < max_count)
+    {
+        signed portBASE_TYPE itemSwitch = pdFALSE;
+        if (!xQueueReceiveFromISR (handle, &p_items[got], &itemSwitch))
+        {
+            break;
+        }
+        shouldSwitch |= itemSwitch;
+        got++;
+    }
+    portEXIT_CRITICAL ();
+    stats.gets += got - 1;
+    if (got > 1)
+    {
+        trace_record (TRACE_QUEUE_GET, trace_id, got - 1);
+    }
+
+    // Let a task which was waiting for room in the queue run if it should
+    portYIELD_FROM_ISR (shouldSwitch);
+
+    return (got);
+}
+
+
+/** @brief   Take every item out of the queue and give each one to a function.
+ *  @details This method replaces <tt>while (q.any ()) { q.get (x); ... }</tt>.
+ *           Items are taken @c QUEUE_DRAIN_BATCH at a time with @c get_n(), 
+ *           and the function is called outside the critical section, so it 
+ *           may print or block. Items put in while draining are taken too. 
+ *           It must @b not be used within an ISR. 
+ *           @code
+ *           chars_to_print_queue.drain_into ([](const char* line)
+ *               { Serial << line; });
+ *           @endcode
+ *  @param   callback A function or lambda which takes one item; to just 
+ *           throw the items away, give it one which does nothing
+ *  @return  The number of items taken out
+ */
+template <class dataType>
+template <class Callback>
+size_t Queue<dataType>::drain_into (Callback callback)
+{
+    dataType batch[QUEUE_DRAIN_BATCH];      // Items taken out but not used yet
+    size_t total = 0;                       // Items taken out so far
+    size_t got;                             // Items in the batch
+
+    while ((got = get_n (batch, QUEUE_DRAIN_BATCH, 0)) > 0)
+    {
+        for (size_t index = 0; index < got; index++)
+        {
+            callback (batch[index]);
+        }
+        total += got;
+    }
+
+    return (total);
+}
+
+
 /** @brief   Print the queue's status to a serial device.
  *  @details This method makes a printout of the queue's status on the given
  *           serial device, then calls this same method for the next item of 
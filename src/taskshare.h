@@ -211,6 +211,7 @@ inline void Share<DataType>::put (DataType new_data)
 {
     portENTER_CRITICAL ();
     the_data = new_data;
+    stats.puts++;
     portEXIT_CRITICAL ();
 }
 
@@ -228,6 +229,7 @@ template <class DataType>
 void Share<DataType>::ISR_put (DataType new_data)
 {
     the_data = new_data;
+    stats.puts++;
 }
 
 
@@ -246,6 +248,7 @@ void Share<DataType>::get (DataType& recv_data)
     // Copy the data from the queue into the receiving variable
     portENTER_CRITICAL ();
     recv_data = the_data;
+    stats.gets++;
     portEXIT_CRITICAL ();
 }
 
@@ -264,6 +267,7 @@ template <class DataType>
 void Share<DataType>::ISR_get (DataType& recv_data)
 {
     recv_data = the_data;
+    stats.gets++;
 }
 
 
@@ -0,0 +1,195 @@
+/** @file       telemetry.cpp
+ *  @brief      This file contains the class and functions which pack the state of the control loop into binary
+ *              telemetry frames.
+ *  @details    The frame layout is described in telemetry.h. Frames are packed by the control task and written out
+ *              by the print task, the only task that writes to the serial port.
+ *
+ *  @date    10-19-2026 File Created
+ *
+*/
+
+#include "libraries&constants.h"
+
+///@cond
+// Queue of frames waiting for the print task
+extern Queue<telemetry_frame> telemetry_queue;
+
+// Share for what telemetry sends
+extern Share<telemetry_settings> telemetry_settings_share;
+///@endcond
+
+
+// ========================================  Class: telemetry_recorder ========================================
+
+/** @brief      Constructor for the telemetry_recorder class
+ */
+telemetry_recorder::telemetry_recorder(void)
+{
+    _sequence = 0;
+    _skipped = 0;
+    _dropped = 0;
+}
+
+
+/** @brief      Take a sample of the control loop
+ *  @details    Every sample counts up the sequence number, whether it is sent or not, so the host can tell from
+ *              gaps how many samples it is missing. Only every @c decimation-th sample is packed and queued.
+ *  @param      sample The values from this run of the control loop
+ */
+void telemetry_recorder::sample(telemetry_sample &sample)
+{
+    telemetry_settings settings;
+    telemetry_settings_share.get(settings);
+
+    uint8_t sequence = _sequence++;
+    if (settings.fields == 0)
+    {
+        _skipped = 0;
+        return;
+    }
+    if (_skipped + 1 < settings.decimation)
+    {
+        _skipped++;
+        return;
+    }
+    _skipped = 0;
+
+    telemetry_frame frame;
+    frame.length = pack_telemetry(sample, settings.fields, sequence, frame.data);
+    //The queue doesn't wait, so a full queue drops the frame instead of holding up the control loop
+    if (!telemetry_queue.put(frame))
+    {
+        _dropped++;
+    }
+}
+
+
+/** @brief      Get the number of frames dropped because the queue was full
+ *  @returns    Frames dropped since the recorder was made
+ */
+uint32_t telemetry_recorder::get_dropped(void)
+{
+    return _dropped;
+}
+
+
+
+// ======================================== Subfunctions ========================================
+
+/** @brief      Put a @c float into a frame, little endian
+ *  @param      p Where the bytes go; moved past them
+ *  @param      value The number
+ */
+static void pack_float(uint8_t *&p, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, 4);
+    for (uint8_t i = 0; i < 4; i++) { *p++ = (uint8_t)(bits >> (8*i)); }
+}
+
+
+/** @brief      Pack a sample into a telemetry frame
+ *  @param      sample The values from the control loop
+ *  @param      fields The @c TELEM_FIELD_ bits to put in the frame
+ *  @param      sequence The sequence number of the sample
+ *  @param      frame Filled with the frame; must have room for @c TELEM_MAX_FRAME_SIZE bytes
+ *  @returns    Length of the frame in bytes
+ */
+uint8_t pack_telemetry(telemetry_sample &sample, uint8_t fields, uint8_t sequence, uint8_t *frame)
+{
+    uint8_t *p = frame;
+    *p++ = TELEM_SYNC;
+    *p++ = fields;
+    *p++ = sequence;
+
+    if (fields & TELEM_FIELD_TIME)
+    {
+        uint32_t time_us = (uint32_t)(sample.time*1000000);
+        for (uint8_t i = 0; i < 4; i++) { *p++ = (uint8_t)(time_us >> (8*i)); }
+    }
+    if (fields & TELEM_FIELD_SETPOINT)
+    {
+        pack_float(p, sample.A_setpoint);
+        pack_float(p, sample.B_setpoint);
+    }
+    if (fields & TELEM_FIELD_POSITION)
+    {
+        pack_float(p, sample.A_pos);
+        pack_float(p, sample.B_pos);
+    }
+    if (fields & TELEM_FIELD_ERROR)
+    {
+        pack_float(p, sample.A_error);
+        pack_float(p, sample.B_error);
+    }
+    if (fields & TELEM_FIELD_DUTY)
+    {
+        int16_t duty_A = (int16_t)lround(constrain(sample.A_duty, -100, 100)*100);
+        int16_t duty_B = (int16_t)lround(constrain(sample.B_duty, -100, 100)*100);
+        *p++ = (uint8_t)duty_A;     *p++ = (uint8_t)(duty_A >> 8);
+        *p++ = (uint8_t)duty_B;     *p++ = (uint8_t)(duty_B >> 8);
+    }
+    if (fields & TELEM_FIELD_S)
+    {
+        *p++ = sample.S;
+    }
+
+    *p = crc8(&frame[1], p - frame - 1);
+    p++;
+    return p - frame;
+}
+
+
+/** @brief      Get the size of a telemetry frame
+ *  @param      fields The @c TELEM_FIELD_ bits in the frame
+ *  @returns    Bytes in the frame, including sync, fields byte, sequence number and CRC
+ */
+uint8_t telemetry_frame_size(uint8_t fields)
+{
+    uint8_t size = 4;
+    if (fields & TELEM_FIELD_TIME)      { size += 4; }
+    if (fields & TELEM_FIELD_SETPOINT)  { size += 8; }
+    if (fields & TELEM_FIELD_POSITION)  { size += 8; }
+    if (fields & TELEM_FIELD_ERROR)     { size += 8; }
+    if (fields & TELEM_FIELD_DUTY)      { size += 4; }
+    if (fields & TELEM_FIELD_S)         { size += 1; }
+    return size;
+}
+
+
+/** @brief      Check and set what telemetry sends
+ *  @details    This is what @c $TM does. The settings are only taken if the frames fit in
+ *              @c TELEM_MAX_BYTES_PER_SEC with the control loop at its fastest, so text answers always have room.
+ *              Either way, what telemetry is set to is printed.
+ *  @param      fields The @c TELEM_FIELD_ bits to send, or 0 for none
+ *  @param      decimation Send one frame every this many samples
+ *  @returns    @c false if a field isn't known, the decimation is out of range, or the link can't carry it
+ */
+bool set_telemetry(uint8_t fields, uint8_t decimation)
+{
+    telemetry_settings settings;
+    settings.fields = fields;
+    settings.decimation = decimation;
+    bool ok = (settings.fields & ~TELEM_FIELD_ALL) == 0
+              && settings.decimation >= 1 && settings.decimation <= TELEM_MAX_DECIMATION
+              && (uint32_t)telemetry_frame_size(settings.fields)*TELEM_MAX_SAMPLE_RATE/settings.decimation
+                 <= TELEM_MAX_BYTES_PER_SEC;
+    if (ok)
+    {
+        telemetry_settings_share.put(settings);
+    }
+
+    telemetry_settings_share.get(settings);
+    if (settings.fields == 0)
+    {
+        print_serial("Telemetry off\n");
+    }
+    else
+    {
+        uint8_t size = telemetry_frame_size(settings.fields);
+        print_serial("Telemetry: fields " + String(settings.fields) + ", 1 frame every " + String(settings.decimation)
+                     + ", " + String(size) + " bytes a frame, up to "
+                     + String((uint32_t)size*TELEM_MAX_SAMPLE_RATE/settings.decimation) + " bytes/s\n");
+    }
+    return ok;
+}
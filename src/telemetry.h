@@ -0,0 +1,143 @@
+/** @file       telemetry.h
+ *  @brief      This file contains the header for the telemetry.cpp file, which sends the state of the control loop
+ *              as packed binary frames.
+ *  @details    Printing the control loop as text takes about 80 bytes a line, which is more than the link can carry
+ *              at the control rate. Binary telemetry sends only the fields asked for, packed, with a frame laid
+ *              out like this:
+ *
+ *              | Byte      | Contents                                                                  |
+ *              |-----------|---------------------------------------------------------------------------|
+ *              | 0         | @c TELEM_SYNC                                                             |
+ *              | 1         | Fields in the frame, as @c TELEM_FIELD_ bits                              |
+ *              | 2         | Sequence number, counting up by one per sample taken (wraps at 255)       |
+ *              | 3...      | The fields, in the order of their bits                                    |
+ *              | last      | CRC-8 (same as binary_protocol.h) of the fields byte, sequence and fields |
+ *
+ *              | Field                     | Bytes | Contents                                                  |
+ *              |---------------------------|-------|-----------------------------------------------------------|
+ *              | @c TELEM_FIELD_TIME       | 4     | @c uint32_t control loop time in microseconds             |
+ *              | @c TELEM_FIELD_SETPOINT   | 8     | @c float A and B position setpoints in mm                 |
+ *              | @c TELEM_FIELD_POSITION   | 8     | @c float A and B measured positions in mm                 |
+ *              | @c TELEM_FIELD_ERROR      | 8     | @c float A and B errors from the PID controllers in mm    |
+ *              | @c TELEM_FIELD_DUTY       | 4     | @c int16_t A and B duty cycles in 1/100 %                 |
+ *              | @c TELEM_FIELD_S          | 1     | @c uint8_t laser power in percent                         |
+ *
+ *              Everything is little endian. The sequence number counts samples, not frames sent, so a frame that
+ *              was dropped because the telemetry queue was full shows up on the host as a gap. Telemetry is
+ *              turned on with @c $TM @c M<fields> @c D<decimation>, which sends one frame every @c D control loop
+ *              runs, and turned off with @c $TM @c M0. It is checked against what the link can carry at
+ *              @c TELEM_MAX_SAMPLE_RATE before it is turned on. Text lines still go out between frames; the host
+ *              finds frames by the sync byte and CRC (see tools/telemetry_to_csv.cpp).
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "libraries&constants.h"
+
+// ========================================== Constants ==========================================
+
+// First byte of every frame; not a text character, so it can't be mistaken for the start of a line
+#define TELEM_SYNC 0xA6
+
+// Fields that can be put in a frame
+#define TELEM_FIELD_TIME 0x01
+#define TELEM_FIELD_SETPOINT 0x02
+#define TELEM_FIELD_POSITION 0x04
+#define TELEM_FIELD_ERROR 0x08
+#define TELEM_FIELD_DUTY 0x10
+#define TELEM_FIELD_S 0x20
+#define TELEM_FIELD_ALL 0x3F
+
+// Largest frame: sync, fields, sequence, every field, CRC
+#define TELEM_MAX_FRAME_SIZE 37
+
+// Fastest the control loop can take samples: once per encoder update
+#define TELEM_MAX_SAMPLE_RATE (1000/encoder_A_period)
+
+// Bytes a second telemetry may use: 3/4 of 115200 baud (10 bits a byte), leaving room for text
+#define TELEM_MAX_BYTES_PER_SEC (115200/10*3/4)
+
+// Most samples that can be skipped between frames
+#define TELEM_MAX_DECIMATION 250
+
+// Frames waiting for the print task. At 10 ms a print task run, 16 is plenty at the full rate.
+#define TELEM_Q_SIZE 16
+
+
+// =========================================== Structs ===========================================
+
+/// One run of the control loop, as the control task sees it
+struct telemetry_sample
+{
+    float time = 0;             // Control loop time in seconds
+    float A_setpoint = 0;       // Position setpoints in mm
+    float B_setpoint = 0;
+    float A_pos = 0;            // Measured positions in mm
+    float B_pos = 0;
+    float A_error = 0;          // Errors from the PID controllers in mm
+    float B_error = 0;
+    float A_duty = 0;           // Duty cycles in percent
+    float B_duty = 0;
+    uint8_t S = 0;              // Laser power in percent
+};
+
+
+/// A packed frame waiting in the telemetry queue
+struct telemetry_frame
+{
+    uint8_t data[TELEM_MAX_FRAME_SIZE];
+    uint8_t length = 0;
+};
+
+
+/// What telemetry sends; set with $TM
+struct telemetry_settings
+{
+    uint8_t fields = 0;         // TELEM_FIELD_ bits, 0 for off
+    uint8_t decimation = 1;     // Send one frame every this many samples
+};
+
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which packs samples of the control loop into telemetry frames.
+ *  @details    The control task makes one of these and gives it every sample. Frames go into a queue for the print
+ *              task, which writes them out between text lines, so the control task never waits on the serial port.
+ *              If the queue is full the frame is dropped and counted.
+ */
+class telemetry_recorder
+{
+    protected:
+    uint8_t _sequence;                  // Sequence number of the next sample
+    uint8_t _skipped;                   // Samples skipped since the last frame
+    uint32_t _dropped;                  // Frames dropped because the queue was full
+
+    public:
+    // Constructor
+    telemetry_recorder(void);
+
+    // Take a sample; sends a frame if telemetry is on and it's this sample's turn
+    void sample(telemetry_sample &sample);
+
+    // Get the number of frames dropped because the queue was full
+    uint32_t get_dropped(void);
+};
+
+
+// =========================================== Functions ===========================================
+
+// Pack a sample into a frame; returns its length
+uint8_t pack_telemetry(telemetry_sample &sample, uint8_t fields, uint8_t sequence, uint8_t *frame);
+
+// Get the size of a frame with the given fields
+uint8_t telemetry_frame_size(uint8_t fields);
+
+// Check and set what telemetry sends (from $TM)
+bool set_telemetry(uint8_t fields, uint8_t decimation);
+
+
+#endif //TELEMETRY_H
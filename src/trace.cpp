@@ -0,0 +1,132 @@
+/** @file       trace.cpp
+ *  @brief      This file contains the trace recorder, which keeps the last few hundred things the tasks did in a
+ *              ring in RAM, with the time of each, to be dumped over serial.
+ *  @details    See trace.h. The printout is text, so it goes through the printing task like every other report:
+ *
+ *              | Line                      | Meaning                                                       |
+ *              |---------------------------|---------------------------------------------------------------|
+ *              | @c TRACE @c hz @c events  | Start, with the clock's counts a second and events to come    |
+ *              | @c T @c id @c name        | A task's number and name                                      |
+ *              | @c Q @c id @c name        | A queue's or share's number and name                          |
+ *              | @c E @c event...          | Up to four events, oldest first, 16 hex digits each           |
+ *              | @c END                    | The end                                                       |
+ *
+ *              An event's hex digits are its time (8), kind (2), id (2) and arg (4). Recording stops while the
+ *              ring is printed, so nothing written over is printed half old and half new; the events that would
+ *              have been recorded then are lost.
+ *
+ *  @date    10-19-2026 File Created
+ *
+*/
+
+#include "libraries&constants.h"
+
+
+///@cond
+trace_event trace_ring[TRACE_EVENTS];
+std::atomic<uint32_t> trace_head(0);
+std::atomic<bool> trace_recording(false);
+
+// The tasks numbered for the trace, in number order from 1
+static TaskHandle_t trace_tasks[TRACE_TASKS];
+static uint8_t trace_task_count = 0;
+///@endcond
+
+
+/** @brief      Start the trace clock and start recording
+ *  @details    Called from @c setup(). Events from before it aren't recorded.
+ */
+void trace_start(void)
+{
+    #if (defined STM32L4xx || defined STM32F4xx)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    #endif
+    trace_recording.store(true, std::memory_order_relaxed);
+}
+
+
+/** @brief      Number a task for the trace and keep its name for the printout
+ *  @details    Called by the @c start_ function of every task in static_alloc.h. Tasks past @c TRACE_TASKS are
+ *              left as 0, like the tasks FreeRTOS makes.
+ *  @param      task The task's handle; nothing is done if it is NULL
+ */
+void trace_add_task(TaskHandle_t task)
+{
+    if (task == NULL || trace_task_count >= TRACE_TASKS)
+    {
+        return;
+    }
+    trace_tasks[trace_task_count] = task;
+    trace_task_count++;
+    vTaskSetTaskNumber(task, trace_task_count);
+}
+
+
+/** @brief      Record a task getting the CPU; called by FreeRTOS through @c traceTASK_SWITCHED_IN()
+ *  @param      task_number The task's number
+ */
+extern "C" void trace_task_switched_in(uint32_t task_number)
+{
+    trace_record(TRACE_TASK_IN, (uint8_t)task_number, 0);
+}
+
+
+/** @brief      Record a task giving up the CPU; called by FreeRTOS through @c traceTASK_SWITCHED_OUT()
+ *  @param      task_number The task's number
+ */
+extern "C" void trace_task_switched_out(uint32_t task_number)
+{
+    trace_record(TRACE_TASK_OUT, (uint8_t)task_number, 0);
+}
+
+
+/** @brief      Print the ring over serial and start it again
+ *  @details    This is what @c $TR does; the lines are described at the top of this file. Four events go on a line,
+ *              so a full ring takes a second or so to print at 115200 baud, during which the caller waits for room
+ *              in the print queue.
+ */
+void print_trace(void)
+{
+    char row[LINE_BUFFER_SIZE];
+
+    trace_recording.store(false, std::memory_order_relaxed);
+    uint32_t head = trace_head.load(std::memory_order_relaxed);
+    uint32_t count = (head < TRACE_EVENTS) ? head : TRACE_EVENTS;
+    #if (defined STM32L4xx || defined STM32F4xx)
+    unsigned long clock_rate = SystemCoreClock;
+    #else
+    unsigned long clock_rate = 1000000000;
+    #endif
+
+    snprintf(row, sizeof(row), "TRACE %lu %lu\n", clock_rate, (unsigned long)count);
+    print_serial((const char*)row);
+    for (uint8_t index = 0; index < trace_task_count; index++)
+    {
+        snprintf(row, sizeof(row), "T %u %.16s\n", (unsigned)(index + 1), pcTaskGetName(trace_tasks[index]));
+        print_serial((const char*)row);
+    }
+    for (BaseShare *p_share = BaseShare::get_newest(); p_share != NULL; p_share = p_share->get_next())
+    {
+        snprintf(row, sizeof(row), "Q %u %.16s\n", (unsigned)p_share->get_trace_id(), p_share->get_name());
+        print_serial((const char*)row);
+    }
+
+    char *p = row;
+    for (uint32_t index = 0; index < count; index++)
+    {
+        const trace_event &event = trace_ring[(head - count + index) & (TRACE_EVENTS - 1)];
+        p += sprintf(p, (p == row) ? "E %08lx%02x%02x%04x" : " %08lx%02x%02x%04x", (unsigned long)event.time,
+                     (unsigned)event.kind, (unsigned)event.id, (unsigned)event.arg);
+        if (index % 4 == 3 || index == count - 1)
+        {
+            strcpy(p, "\n");
+            print_serial((const char*)row);
+            p = row;
+        }
+    }
+    print_serial("END\n");
+
+    trace_head.store(0, std::memory_order_relaxed);
+    trace_recording.store(true, std::memory_order_relaxed);
+}
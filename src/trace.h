@@ -0,0 +1,148 @@
+/** @file       trace.h
+ *  @brief      This file contains the header for the trace recorder, which keeps the last few hundred things the
+ *              tasks did in a ring in RAM, with the time of each, to be dumped over serial.
+ *  @details    Each event is 8 bytes: a 32 bit time, what happened, which task, queue or marker it was, and a
+ *              16 bit number that goes with it:
+ *
+ *              | Kind                | id                        | arg                                   |
+ *              |---------------------|---------------------------|---------------------------------------|
+ *              | @c TRACE_TASK_IN    | Task number               | -                                     |
+ *              | @c TRACE_TASK_OUT   | Task number               | -                                     |
+ *              | @c TRACE_QUEUE_PUT  | Queue or ring             | Items put in                          |
+ *              | @c TRACE_QUEUE_GET  | Queue or ring             | Items taken out                       |
+ *              | @c TRACE_SEGMENT    | -                         | Ramp segments started, counting up    |
+ *              | @c TRACE_LASER      | -                         | New laser power                       |
+ *              | @c TRACE_MARK       | A @c TRACE_MARK_ number   | Anything the marker wants             |
+ *
+ *              Task switches come from the FreeRTOS trace hooks in trace_hooks.h, which platformio.ini puts in
+ *              front of every file, FreeRTOS's own included. Tasks made with a @c start_ function in static_alloc.h
+ *              are numbered from 1 in the order they are made; the idle task and the timer task are 0. Queues and
+ *              rings record their own puts and gets, numbered in the order they are made (see baseshare.h).
+ *
+ *              Recording an event is an atomic add to the ring's head and an 8 byte store, with the time read from
+ *              the core's cycle counter on the board: a few tens of cycles, with no critical section, so it is safe
+ *              from tasks and interrupts alike and is left on all the time. The ring keeps the newest
+ *              @c TRACE_EVENTS events; older ones are written over.
+ *
+ *              @c $TR prints the ring (see @c print_trace()) and starts it again. tools/trace_to_chrome.cpp turns
+ *              the printout into a trace for chrome://tracing or ui.perfetto.dev.
+ *
+ *              On a PC (see lib/FreeRTOS_POSIX) the time is the stand-in's clock in ns, which is the virtual clock
+ *              when it runs on virtual time, and the stand-in calls the same hooks when it hands a task the CPU.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+#include <FreeRTOS.h>
+#include <atomic>
+
+#if (defined STM32L4xx || defined STM32F4xx) && !configUSE_TRACE_FACILITY
+    #error "The trace recorder needs configUSE_TRACE_FACILITY set to 1 in the FreeRTOS config"
+#endif
+
+
+// Events the ring holds; a power of 2
+#define TRACE_EVENTS 512
+
+// Most tasks which get a number and a name in the printout
+#define TRACE_TASKS 16
+
+// Kinds of event
+#define TRACE_TASK_IN 1                     // A task got the CPU
+#define TRACE_TASK_OUT 2                    // A task gave up the CPU
+#define TRACE_QUEUE_PUT 3                   // Items were put in a queue or ring
+#define TRACE_QUEUE_GET 4                   // Items were taken out of a queue or ring
+#define TRACE_SEGMENT 5                     // A ramp segment started
+#define TRACE_LASER 6                       // The laser power changed
+#define TRACE_MARK 7                        // A marker
+
+// Markers
+#define TRACE_MARK_LINE 1                   // A line was read; arg counts lines
+#define TRACE_MARK_RESET 2                  // A soft reset
+#define TRACE_MARK_JOB_START 3              // A job started
+#define TRACE_MARK_JOB_END 4                // A job ended
+#define TRACE_MARK_HOMING 5                 // Homing started
+
+
+///@cond
+// One event in the ring
+struct trace_event
+{
+    uint32_t time;                          // Trace clock when it happened
+    uint8_t kind;                           // TRACE_ kind
+    uint8_t id;                             // Task, queue or marker
+    uint16_t arg;                           // Number that goes with it
+};
+
+extern trace_event trace_ring[TRACE_EVENTS];
+extern std::atomic<uint32_t> trace_head;
+extern std::atomic<bool> trace_recording;
+///@endcond
+
+
+#if (defined STM32L4xx || defined STM32F4xx)
+
+/** @brief      Read the trace clock, which is the core's cycle counter on the board
+ *  @returns    Clock counts; it wraps about once a minute at 80 MHz
+ */
+static inline uint32_t trace_clock(void)
+{
+    return DWT->CYCCNT;
+}
+
+#else
+
+/** @brief      Read the trace clock, which is the stand-in's clock in nanoseconds on the host
+ *  @returns    Clock counts; it wraps about every 4 seconds
+ */
+static inline uint32_t trace_clock(void)
+{
+    return (uint32_t)ullTaskHostTime();
+}
+
+#endif
+
+
+/** @brief      Put an event in the ring
+ *  @details    Safe from any task or interrupt. Two at once each get their own place from the atomic add.
+ *  @param      kind What happened, a @c TRACE_ kind
+ *  @param      id The task, queue or marker
+ *  @param      arg A number that goes with it
+ */
+static inline void trace_record(uint8_t kind, uint8_t id, uint16_t arg)
+{
+    if (!trace_recording.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    uint32_t place = trace_head.fetch_add(1, std::memory_order_relaxed) & (TRACE_EVENTS - 1);
+    trace_ring[place] = {trace_clock(), kind, id, arg};
+}
+
+
+/** @brief      Put a marker in the ring
+ *  @param      marker Which marker, a @c TRACE_MARK_ number
+ *  @param      arg A number that goes with it
+ */
+static inline void trace_mark(uint8_t marker, uint16_t arg = 0)
+{
+    trace_record(TRACE_MARK, marker, arg);
+}
+
+
+// Start the trace clock and start recording
+void trace_start(void);
+
+// Number a task for the trace and keep its name for the printout
+void trace_add_task(TaskHandle_t task);
+
+// Print the ring over serial and start it again
+void print_trace(void);
+
+
+#endif //TRACE_H
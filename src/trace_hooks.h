@@ -0,0 +1,52 @@
+/** @file       trace_hooks.h
+ *  @brief      This file contains the FreeRTOS trace hooks, which tell the trace recorder when a task gets or gives
+ *              up the CPU, and the clock FreeRTOS measures each task's run time with.
+ *  @details    FreeRTOS calls @c traceTASK_SWITCHED_OUT() and @c traceTASK_SWITCHED_IN() in the scheduler, with
+ *              @c pxCurrentTCB pointing at the task going out or coming in, and leaves them empty unless they are
+ *              defined before its headers. platformio.ini puts this file in front of every file it builds with
+ *              @c -include, so FreeRTOS's tasks.c gets them too. It is C, since tasks.c is, and is skipped in
+ *              assembly files.
+ *
+ *              A task's number is set by @c trace_add_task() (see trace.h), and is 0 for the tasks FreeRTOS makes
+ *              itself. The hooks run in the scheduler, which is an interrupt on the board, so all they do is record
+ *              an event.
+ *
+ *              With @c configGENERATE_RUN_TIME_STATS, FreeRTOS reads a clock at every task switch and adds the time
+ *              since the last one to the task going out (see cpu_load.h). On the board that clock is the core's
+ *              cycle counter, which the trace recorder starts; it is read at its fixed address since CMSIS isn't
+ *              included in tasks.c. On a PC the stand-in has its own.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef TRACE_HOOKS_H
+#define TRACE_HOOKS_H
+
+#ifndef __ASSEMBLER__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Record a task getting the CPU, and giving it up
+void trace_task_switched_in(uint32_t task_number);
+void trace_task_switched_out(uint32_t task_number);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define traceTASK_SWITCHED_IN() trace_task_switched_in((uint32_t)pxCurrentTCB->uxTaskNumber)
+#define traceTASK_SWITCHED_OUT() trace_task_switched_out((uint32_t)pxCurrentTCB->uxTaskNumber)
+
+#if (defined STM32L4xx || defined STM32F4xx)
+    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+    #define portGET_RUN_TIME_COUNTER_VALUE() (*(volatile uint32_t *)0xE0001004UL)    // DWT->CYCCNT
+#endif
+
+#endif //__ASSEMBLER__
+
+#endif //TRACE_HOOKS_H
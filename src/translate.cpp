@@ -16,16 +16,19 @@
 
 // Share for ramp segment coefficients: Coefficients for both motors are passed in a struct from the kinematic translation
 // to the ramp translation.
-extern Queue<ramp_segment_coefficients> ramp_segment_coefficient_queue;
-
-// Share for signalling to check home
-extern Share<bool> check_home_share;
+extern spsc_ring<ramp_segment_coefficients, RAMP_COEFF_Q_SIZE> ramp_segment_coefficient_queue;
 
 // Queue that holds read character arrays
 extern Queue<char[LINE_BUFFER_SIZE]> read_chars_queue;
 
-// Share for timing mode
-extern Share<uint8_t> timing_mode_share;
+// Queue that holds moves decoded from binary frames
+extern Queue<XYSFvalues> binary_move_queue;
+
+// The machine's state, for the timing mode, the mode and the laser power
+extern blackboard<machine_state> machine_state_board;
+
+// Share for the last motor setpoint, which is where motion stopped
+extern Share<motor_setpoint> setpoint_share;
 
 // ========================================  Class: coreXY_to_AB ========================================
 
@@ -43,8 +46,15 @@ void coreXY_to_AB::translate_to_queue(XYSFvalues XYSF_input)
     //Translate XYSF values into ramp coefficients
     ramp_segment_coefficients ramp_coeff = calc_ramp_coeff(XYSF_input);
 
-    //Put ramp coefficients into the queue
+    //Put ramp coefficients into the queue; the first move of a job starts it
     ramp_segment_coefficient_queue.put(ramp_coeff);
+    start_job();
+
+    //Keep a copy of the move if a job is being recorded
+    if (_recorder != NULL)
+    {
+        _recorder->record(XYSF_input);
+    }
 }
 
 
@@ -111,6 +121,46 @@ void coreXY_to_AB::reset(void)
 
 
 
+/** @brief      Get the last XYSF values that were translated
+ *  @details    This is the point the laser head will be at once everything in the ramp queue has been run. 
+ *  @returns    The last set of XYSF values put through @c calc_ramp_coeff()
+ */
+XYSFvalues coreXY_to_AB::get_last_XYSF(void)
+{
+    return _last_XYSF;
+}
+
+
+
+/** @brief      Start the next move from somewhere else
+ *  @details    Used after a soft reset, when the moves that were queued never finished and the laser head is
+ *              somewhere along the way. Power and feedrate are left as they were.
+ *  @param      X Where the laser head is in X
+ *  @param      Y Where the laser head is in Y
+ */
+void coreXY_to_AB::set_position(float X, float Y)
+{
+    _last_XYSF.X = X;
+    _last_XYSF.Y = Y;
+}
+
+
+
+/** @brief      Record every move sent to the queue in a job replay
+ *  @details    The job replay only keeps moves while it is recording, so this can be set once and left alone.
+ *  @param      recorder The job replay to record to, or @c NULL to stop
+ */
+void coreXY_to_AB::record_to(job_replay *recorder)
+{
+    _recorder = recorder;
+}
+
+
+
+
+
+
+
 // =========================================  Class: setpoint_of_time =========================================
 
 
@@ -132,6 +182,10 @@ setpoint_of_time::setpoint_of_time(void)
  *              found to be valid, at which point the setpoint is calculated and returned; or, if the 
  *              @c ramp_segment_coefficient_queue is empty, the function returns a velocity of 0 and holds the last ending 
  *              position of the last set of coefficients. 
+ *              If time goes backwards, the timing was reset (after a soft reset), so the segment being run is dropped
+ *              and the position where it stopped is held until new segments start from time 0. Every setpoint is
+ *              put in @c setpoint_share so the translate task knows where motion stopped, and its laser power in
+ *              @c machine_state_board when it changes.
  */
 motor_setpoint setpoint_of_time::get_desired_pos_vel(float time)
 {
@@ -143,12 +197,26 @@ motor_setpoint setpoint_of_time::get_desired_pos_vel(float time)
 
     bool checking_coefficients = true;
 
+    //If the time was reset, hold where we are now; new segments start from time 0
+    if (time < _last_time)
+    {
+        _seg_coeff.pos_A0 = _seg_coeff.vel_A * (_last_time - _seg_coeff.t0)  + _seg_coeff.pos_A0;
+        _seg_coeff.pos_B0 = _seg_coeff.vel_B * (_last_time - _seg_coeff.t0)  + _seg_coeff.pos_B0;
+        _seg_coeff.vel_A = 0;
+        _seg_coeff.vel_B = 0;
+        _seg_coeff.S = 0;
+        _seg_coeff.t0 = 0;
+        _seg_coeff.t_end = 0;
+    }
+    _last_time = time;
+
     //Find out which segment we're looking at
     while(checking_coefficients)    //Loop used to continuously check the coefficients until we find a set that is within our time range
     {
         if(time > _seg_coeff.t_end)     //We've passed the end of the current ramp segment; we may need to update coefficients
         {
-            if(ramp_segment_coefficient_queue.is_empty())
+            ramp_segment_coefficients *p_next_segment = ramp_segment_coefficient_queue.front();
+            if(p_next_segment == NULL)
             {
                 //If there are no new coefficients available, set positions to the final desired position and then 
                 //set velocities to 0 to keep the position steady
@@ -157,13 +225,23 @@ motor_setpoint setpoint_of_time::get_desired_pos_vel(float time)
 
                 _seg_coeff.vel_A = 0;
                 _seg_coeff.vel_B = 0;
+                _seg_coeff.S = 0;
 
                 //Get us out of the checking loop
                 checking_coefficients = false;
             }
-            else //We have new coefficients in the queue; get it and replace the old _seg_coeff with this new set.
+            else //We have new coefficients in the queue; replace the old _seg_coeff with this new set and let it go
             {
-                ramp_segment_coefficient_queue.get(_seg_coeff);
+                ramp_segment_coefficients next_segment = *p_next_segment;
+                ramp_segment_coefficient_queue.pop();
+
+                //A soft reset flushed the queue while we were copying; the copy is stale, so look again
+                if (ramp_segment_coefficient_queue.flush_pending())
+                {
+                    continue;
+                }
+                _seg_coeff = next_segment;
+                trace_record(TRACE_SEGMENT, 0, ++_segments_started);
             }
         }
         else //If time <= t_end of the current segment, we don't have to change the segment coefficients. 
@@ -181,7 +259,13 @@ motor_setpoint setpoint_of_time::get_desired_pos_vel(float time)
     // setpoint.A_vel = _seg_coeff.vel_A;
     setpoint.A_vel = _seg_coeff.vel_A;
     setpoint.B_vel = _seg_coeff.vel_B;
+    setpoint.S = _seg_coeff.S;
 
+    setpoint_share.put(setpoint);
+    if (machine_state_board.update(&machine_state::laser_power, setpoint.S))
+    {
+        trace_record(TRACE_LASER, 0, (uint16_t)setpoint.S);
+    }
     return setpoint;
 }
 
@@ -195,7 +279,9 @@ motor_setpoint setpoint_of_time::get_desired_pos_vel(float time)
 /** @brief      Task which reads data from the serial port, translates it, and sends it where it needs to go.
  *  @details    This task function reads a line from the read_chars queue of gcode or other commands 
  *              and splits it up into the separate commands. Commands are then sent to the control task via queues
- *              and shares. Gcode is translated into @c X @c Y @c S and @c F values by the decoder class
+ *              and shares. Gcode is translated into @c X @c Y @c S and @c F values by the decoder class.
+ *              Each line is answered with @c ok or @c error:N once it has been used, which is how the
+ *              host knows it can send more (see @c task_read_serial()).
  * 
  *  @param      p_params A pointer to function parameters which we don't use.
  */
@@ -275,44 +361,246 @@ void task_translate(void* p_params)
     uint8_t machine_cmd = MACHINE_CMD_NULL;
     uint8_t gcode_cmd = GC_CMD_NULL;
 
-    //Check if there is space in ramp coeff queue
-    bool ramp_q_full = false;
+    //Error code sent back to the host for each line
+    uint8_t line_error = NO_ERROR;
+
+    //Lines read, for the trace
+    uint16_t lines_read = 0;
 
     //Main states of function
     uint8_t translate_state = TRANSLATE_STATE_NORMAL_OPERATION;
 
+    //Hatch fill generator and the words read from fill commands
+    hatch_fill hatcher;
+    command_words words;
+    uint8_t fill_S = 0;
+    float fill_F = get_setting(SETTING_TRAVEL_SPEED);
+
+    //Job replay for multi-pass cutting. Static so its buffer isn't on the task's stack.
+    static job_replay replay;
+    translator.record_to(&replay);
+
+    //Subprograms, also static for their buffer, and the decoder's values from before a definition started
+    static subprogram_store subprograms;
+    XYSFvalues before_define;
+
     for(;;)
     {   
-        //At the beginning of each loop, check to see if we should pause:
-        //(insert code here)
+        //At the beginning of each loop, check for a soft reset from the real-time commands
+        if (get_events() & EVENT_SOFT_RESET)
+        {
+            clear_events(EVENT_SOFT_RESET);
+            soft_reset_to_start(translator, decoder, hatcher, replay, subprograms);
+            translate_state = TRANSLATE_STATE_NORMAL_OPERATION;
+        }
 
         //Switch case for the main states of the translate task
         switch(translate_state)
         {
             case TRANSLATE_STATE_NORMAL_OPERATION:
-                //Read a line, interpret it, and move from there.
+                //Read lines, interpret them, and move from there. Keep going for as long as there are lines and
+                //room in the ramp queue, so a streaming host isn't held to one line per task period.
 
                 //If there is a line in the read_chars_queue...
-                if (read_chars_queue.any())
+                while (translate_state == TRANSLATE_STATE_NORMAL_OPERATION && read_chars_queue.any()
+                       && ramp_segment_coefficient_queue.available() < RAMP_COEFF_Q_SIZE - get_setting(SETTING_RAMP_PAUSE_LIMIT))
                 {
                     //Read the line
                     read_chars_queue.get(line);
+                    trace_mark(TRACE_MARK_LINE, ++lines_read);
+                    line_error = NO_ERROR;
+                    replay.count_source_bytes(strlen(line) + 1);
+
+                    //if the line was too long for the reader's line buffer. Its number was lost with it, so a 
+                    //host sending numbered lines is asked to go back as for a bad checksum; a line ending hurt 
+                    //on the way joins two lines into one too long, and the next line would only be rejected.
+                    if (line[0] == LINE_OVERFLOW_MARK)
+                    {
+                        line_error = LINE_LENGTH_ERROR;
+                        if (decoder.is_numbered())
+                        {
+                            print_serial("Resend:" + String(decoder.get_line_number() + 1) + "\n");
+                        }
+                    }
+
+                    //if the line number or checksum is wrong, ask for the line again. Lines the host sent after 
+                    //it are rejected too (they're out of order), so the host just goes back and sends from here.
+                    else if ((line_error = decoder.check_line(line)) != NO_ERROR)
+                    {
+                        print_serial("Resend:" + String(decoder.get_line_number() + 1) + "\n");
+                    }
+
+                    //if the line defines, ends or calls a subprogram:
+                    else if (find_subprogram_cmd(line) != SUB_CMD_NULL)
+                    {
+                        line_error = subprogram_line(line, subprograms, decoder, before_define);
+                        if (line_error == NO_ERROR && find_subprogram_cmd(line) == SUB_CMD_CALL)
+                        {
+                            translate_state = TRANSLATE_STATE_CALLING;
+                        }
+                    }
+
+                    //if a subprogram is being defined, its lines are decoded and kept instead of being run
+                    else if (subprograms.is_defining())
+                    {
+                        if (line[0] == '$')
+                        {
+                            print_serial("Error: machine commands can't go in a subprogram\n");
+                            line_error = SUBPROGRAM_ERROR;
+                        }
+                        else
+                        {
+                            switch (decoder.interpret_gcode_line(line))
+                            {
+                                case GC_CMD_UPDATE_XYSF:
+                                    subprograms.add_move(decoder.get_XYSF());
+                                    break;
+
+                                case GC_CMD_ERROR:
+                                    line_error = decoder.get_error();
+                                    break;
+
+                                case GC_CMD_HOME:
+                                case GC_CMD_END_PROGRAM:
+                                    print_serial("Error: homing and M2 can't go in a subprogram\n");
+                                    line_error = SUBPROGRAM_ERROR;
+                                    break;
+
+                                case GC_CMD_NULL:
+                                default:
+                                    break;
+                            }
+                        }
+                    }
 
                     //if the line is actually a machine command:
-                    if (line[0] == '$')
+                    else if (line[0] == '$')
                     {
                         machine_cmd = decoder.interpret_machinecmd_line(line);
                         switch (machine_cmd)
                         {
                             //Go into homing cycle
                             case MACHINE_CMD_HOME:
+                                start_homing();
                                 translate_state = TRANSLATE_STATE_HOMING;
                                 break;
 
+                            //Start a rectangle or polygon fill, add a corner to the polygon, or start filling it
+                            case MACHINE_CMD_FILL_RECT:
+                            case MACHINE_CMD_FILL_POLY:
+                            case MACHINE_CMD_FILL_VERTEX:
+                            case MACHINE_CMD_FILL_EXECUTE:
+                                line_error = fill_line(line, machine_cmd, hatcher, decoder, fill_S, fill_F);
+                                if (line_error == NO_ERROR && hatcher.running())
+                                {
+                                    translate_state = TRANSLATE_STATE_FILLING;
+                                }
+                                break;
+
+                            //Record the moves that follow, for more passes later
+                            case MACHINE_CMD_JOB_RECORD:
+                                replay.start_recording(translator.get_last_XYSF());
+                                break;
+
+                            case MACHINE_CMD_JOB_END:
+                                if (!replay.stop_recording())
+                                {
+                                    print_serial(replay.get_state() == REPLAY_STATE_OVERFLOW ? "Error: job too big to replay\n" 
+                                                                                             : "Error: no moves recorded\n");
+                                    line_error = MACHINE_CMD_ERROR;
+                                }
+                                break;
+
+                            //Run the recorded moves again, with new power and feedrate if given
+                            case MACHINE_CMD_JOB_REPLAY:
+                                if (!read_command_words(line, 3, &words) || !has_word(&words,'P')
+                                    || word_value(&words,'P') < 1 || word_value(&words,'P') > REPLAY_MAX_PASSES)
+                                {
+                                    print_serial("Error in replay command: needs P1 to P" + String(REPLAY_MAX_PASSES) + "\n");
+                                    line_error = MACHINE_CMD_ERROR;
+                                }
+                                //Same power scaling as the gcode S word: S1.00 is 100%
+                                else if (!replay.start_replay(word_value(&words,'P'),
+                                                              has_word(&words,'S') ? 100*word_value(&words,'S') : -1,
+                                                              has_word(&words,'F') ? word_value(&words,'F') : 0,
+                                                              has_word(&words,'I') ? 100*word_value(&words,'I') : 0,
+                                                              has_word(&words,'J') ? word_value(&words,'J') : 0))
+                                {
+                                    print_serial("Error: no job recorded to replay\n");
+                                    line_error = MACHINE_CMD_ERROR;
+                                }
+                                else
+                                {
+                                    translate_state = TRANSLATE_STATE_REPLAYING;
+                                }
+                                break;
+
+                            //Print status reports at a fixed rate
+                            case MACHINE_CMD_STATUS_RATE:
+                                if (!read_command_words(line, 3, &words) || (has_word(&words,'P') && word_value(&words,'P') < 0)
+                                    || !set_status_period(has_word(&words,'P') ? word_value(&words,'P') : -1))
+                                {
+                                    print_serial("Error in status rate: needs P0, or P" + String(STATUS_REPORT_MIN_PERIOD) 
+                                                 + " to P" + String(STATUS_REPORT_MAX_PERIOD) + " ms\n");
+                                    line_error = MACHINE_CMD_ERROR;
+                                }
+                                break;
+
+                            //Send binary telemetry of the control loop
+                            case MACHINE_CMD_TELEMETRY:
+                                if (!read_command_words(line, 3, &words) || !has_word(&words,'M')
+                                    || word_value(&words,'M') < 0 || word_value(&words,'M') > TELEM_FIELD_ALL
+                                    || (has_word(&words,'D') && (word_value(&words,'D') < 1 
+                                                                 || word_value(&words,'D') > TELEM_MAX_DECIMATION))
+                                    || !set_telemetry(word_value(&words,'M'), has_word(&words,'D') ? word_value(&words,'D') : 1))
+                                {
+                                    print_serial("Error in telemetry: needs M0 to M" + String(TELEM_FIELD_ALL) 
+                                                 + " and D1 to D" + String(TELEM_MAX_DECIMATION) + ", within the link\n");
+                                    line_error = MACHINE_CMD_ERROR;
+                                }
+                                break;
+
+                            //Settings: list, set one, or put them all back to their defaults
+                            case MACHINE_CMD_SETTINGS_LIST:
+                                print_settings();
+                                break;
+
+                            case MACHINE_CMD_SETTING_SET:
+                                if (!setting_line(line))
+                                {
+                                    print_serial("Error in setting: needs $n=value with n and value in range (see $$)\n");
+                                    line_error = SETTING_ERROR;
+                                }
+                                break;
+
+                            case MACHINE_CMD_SETTINGS_RESET:
+                                reset_settings();
+                                break;
+
+                            //Counts for every queue and share
+                            case MACHINE_CMD_QUEUE_STATS:
+                                print_share_stats();
+                                break;
+
+                            //Stack use of every task
+                            case MACHINE_CMD_STACK_REPORT:
+                                print_stack_report();
+                                break;
+
+                            //Trace of what the tasks did
+                            case MACHINE_CMD_TRACE_DUMP:
+                                print_trace();
+                                break;
+
+                            //CPU use of every task
+                            case MACHINE_CMD_CPU_LOAD:
+                                print_cpu_load();
+                                break;
+
                             //Error in command: Command not supported
                             case MACHINE_CMD_NULL:
                             default:
-                                //Print an error?
+                                line_error = MACHINE_CMD_ERROR;
                                 break;
                         };
                     }
@@ -325,49 +613,110 @@ void task_translate(void* p_params)
                         switch(gcode_cmd)
                         {
                             case GC_CMD_UPDATE_XYSF:
-                                // Update XYSF values in the queue
-                                ramp_q_full = true;
-                                while(ramp_q_full)      //If queue isn't full, we get out of the loop and translate. Otherwise, we pause and check again. 
-                                {
-                                    if(ramp_segment_coefficient_queue.available() < RAMP_COEFF_Q_SIZE - RAMP_COEFF_Q_PAUSE_LIMIT)   //There is space in the queue
-                                    {
-                                        ramp_q_full = false;
-                                    }
-                                    else    //No space in the queue; can't translate just yet. Initiate task delay so we can continue
-                                    {
-                                        vTaskDelay(TRANSLATE_TASK_TIMING);
-                                    }  
-                                }
-                                // Once we're here (out of the while loop), we know that there's space in the queue; ok to translate to it. 
+                                // The while loop only gets here when there is space in the ramp queue; ok to translate to it. 
                                 translator.translate_to_queue(decoder.get_XYSF());
-
                                 break;
                             
                             case GC_CMD_HOME:
                                 //Go into homing state
+                                start_homing();
                                 translate_state = TRANSLATE_STATE_HOMING;
                                 break;
                             
                             case GC_CMD_END_PROGRAM:
-                                //Somehow signal to python that we're done with the gcode...
+                                //The ok for this line tells python that we're done with the gcode
+                                end_job();
                                 break;
 
                             case GC_CMD_ERROR:
-                                //Get and print error message?
+                                line_error = decoder.get_error();
+                                break;
 
                             case GC_CMD_NULL:
                             default:
-                                //Print an error?
+                                //Nothing to do: comments, blank lines and settings like G21 or M3
                                 break;
                         }//switch(gcode_cmd)
                     }//reading gcode commands
-                }//if(read_chars.any())
+
+                    //Tell the host this line has been used so it can send more
+                    acknowledge_line(line_error);
+                }//while(read_chars.any())
+
+                //Moves from binary frames are already decoded, so send as many as the ramp queue has room for.
+                //Text lines queued before the switch to binary are always finished first.
+                if (translate_state == TRANSLATE_STATE_NORMAL_OPERATION && !read_chars_queue.any() && binary_move_queue.any())
+                {
+                    //Each move makes one ramp, so take as many moves at a time as there's room for ramps
+                    XYSFvalues bin_moves[QUEUE_DRAIN_BATCH];
+                    size_t got = 1;
+                    while (got > 0 
+                           && ramp_segment_coefficient_queue.available() < RAMP_COEFF_Q_SIZE - get_setting(SETTING_RAMP_PAUSE_LIMIT))
+                    {
+                        float room = ceilf(RAMP_COEFF_Q_SIZE - get_setting(SETTING_RAMP_PAUSE_LIMIT) 
+                                           - ramp_segment_coefficient_queue.available());
+                        got = binary_move_queue.get_n(bin_moves, min((size_t)room, (size_t)QUEUE_DRAIN_BATCH), 0);
+                        for (size_t index = 0; index < got; index++)
+                        {
+                            XYSFvalues last = translator.get_last_XYSF();
+                            if (bin_moves[index].X != last.X || bin_moves[index].Y != last.Y)   //Moves with no length make ramps with no time
+                            {
+                                translator.translate_to_queue(bin_moves[index]);
+                                replay.count_source_bytes(replay.get_last_record_size() + REPLAY_BIN_FRAME_EXTRA);
+                            }
+                        }
+                    }
+                    //Keep the gcode decoder's position up to date in case text lines come next
+                    XYSFvalues last = translator.get_last_XYSF();
+                    decoder.set_position(last.X, last.Y);
+                }
                 break;  //case TRANSLATE_STATE_NORMAL_OPERATION
             
 
+            case TRANSLATE_STATE_FILLING:
+                //Make hatch segments for as long as the ramp queue has room. Once the fill is done, tell the
+                //decoder where we ended up and go back to reading lines.
+                if (fill_to_queue(hatcher, translator, fill_S, fill_F))
+                {
+                    XYSFvalues last = translator.get_last_XYSF();
+                    decoder.set_position(last.X, last.Y);
+                    translate_state = TRANSLATE_STATE_NORMAL_OPERATION;
+                }
+                break;
+
+
+            case TRANSLATE_STATE_REPLAYING:
+                //Run recorded moves for as long as the ramp queue has room. Once all passes are done, tell the
+                //decoder where we ended up, report what the host didn't have to send, and go back to reading lines.
+                if (replay_to_queue(replay, translator))
+                {
+                    XYSFvalues last = translator.get_last_XYSF();
+                    decoder.set_position(last.X, last.Y);
+                    print_serial("Replay done: " + String(replay.get_n_moves()) + " moves a pass, " 
+                                 + String(replay.get_bytes_saved()) + " bytes not sent again\n");
+                    translate_state = TRANSLATE_STATE_NORMAL_OPERATION;
+                }
+                break;
+
+
+            case TRANSLATE_STATE_CALLING:
+                //Run the moves of a subprogram call for as long as the ramp queue has room, then tell the decoder
+                //where we ended up and go back to reading lines.
+                if (subprogram_to_queue(subprograms, translator))
+                {
+                    XYSFvalues last = translator.get_last_XYSF();
+                    decoder.set_position(last.X, last.Y);
+                    translate_state = TRANSLATE_STATE_NORMAL_OPERATION;
+                }
+                break;
+
+
             case TRANSLATE_STATE_HOMING:
-                //Send the commands to home the machine
-                check_home_share.put(true);
+                //The check home task is homing the machine; go back to reading lines once it's done
+                if ((get_events() & EVENT_HOME_REQUEST) == 0)
+                {
+                    translate_state = TRANSLATE_STATE_NORMAL_OPERATION;
+                }
                 break;
 
 
@@ -376,7 +725,8 @@ void task_translate(void* p_params)
                 break;
         }
 
-        vTaskDelay(TRANSLATE_TASK_TIMING);
+        //Wait for the next period, or less if a soft reset comes in first
+        wait_for_events(EVENT_SOFT_RESET, false, translate_period);
     }// for loop
 }//task_translate
 
@@ -418,4 +768,284 @@ void task_translate(void* p_params)
 
 
 
-// ======================================== Subfunctions ========================================
\ No newline at end of file
+// ======================================== Subfunctions ========================================
+
+
+/** @brief      Send hatch fill segments to the ramp queue for as long as there is space
+ *  @details    Each hatch segment becomes a travel move (laser off) to the start of the segment, unless we're already
+ *              there, and a cutting move to its end. Segments are only made when both moves fit in the queue, so a
+ *              fill of any size takes no more memory than one hatch line. Segments with no length are skipped since
+ *              they would make a ramp with no time. 
+ *  @param      hatcher The hatch fill generator, already started with @c begin()
+ *  @param      translator The translator used for all other moves
+ *  @param      S Laser power while cutting
+ *  @param      F Feedrate while cutting
+ *  @returns    @c true once the fill is finished
+ */
+bool fill_to_queue(hatch_fill &hatcher, coreXY_to_AB &translator, uint8_t S, float F)
+{
+    hatch_point start;
+    hatch_point end;
+    XYSFvalues move;
+
+    //Two moves per segment, so leave room for both
+    while(ramp_segment_coefficient_queue.available() + 1 < RAMP_COEFF_Q_SIZE - get_setting(SETTING_RAMP_PAUSE_LIMIT))
+    {
+        if (!hatcher.next_segment(start, end))
+        {
+            return true;
+        }
+        if (start.X == end.X && start.Y == end.Y)
+        {
+            continue;
+        }
+
+        //Travel to the start of the segment with the laser off
+        XYSFvalues last = translator.get_last_XYSF();
+        if (last.X != start.X || last.Y != start.Y)
+        {
+            move.X = start.X;   move.Y = start.Y;   move.S = 0;     move.F = get_setting(SETTING_TRAVEL_SPEED);
+            translator.translate_to_queue(move);
+        }
+
+        //Cut to the end of the segment
+        move.X = end.X;         move.Y = end.Y;     move.S = S;     move.F = F;
+        translator.translate_to_queue(move);
+    }
+    return false;
+}
+
+
+/** @brief      Start a rectangle or polygon fill, add a corner to the polygon, or start filling it
+ *  @details    @c $FR and @c $FP set the spacing, angle, power and speed; @c $FR also gives the rectangle and starts
+ *              it, while a polygon's corners come in @c $FV lines and @c $FE starts it. A fill with no area, fewer
+ *              than 3 corners or too small a spacing is an error, so the host isn't told @c ok for a fill that
+ *              never runs.
+ *  @param      line A @c $FR, @c $FP, @c $FV or @c $FE line
+ *  @param      machine_cmd What @c interpret_machinecmd_line() said the line is
+ *  @param      hatcher The hatch fill generator
+ *  @param      decoder The gcode decoder, for the speed when the line doesn't give one
+ *  @param      S Set to the fill's laser power by @c $FR and @c $FP
+ *  @param      F Set to the fill's speed by @c $FR and @c $FP
+ *  @returns    @c NO_ERROR, or @c MACHINE_CMD_ERROR if the line can't be done. A fill that has been started is
+ *              @c running(), and its segments can be sent with @c fill_to_queue().
+ */
+uint8_t fill_line(char *line, uint8_t machine_cmd, hatch_fill &hatcher, decode &decoder, uint8_t &S, float &F)
+{
+    command_words words;
+
+    switch (machine_cmd)
+    {
+        case MACHINE_CMD_FILL_RECT:
+        case MACHINE_CMD_FILL_POLY:
+            hatcher.reset();
+            if (!read_command_words(line, 3, &words) || !has_word(&words,'D')
+                || !hatcher.set_hatch(has_word(&words,'A') ? word_value(&words,'A') : 0, word_value(&words,'D')))
+            {
+                print_serial("Error in fill command: needs a D spacing\n");
+                return MACHINE_CMD_ERROR;
+            }
+            //Same power scaling as the gcode S word: S1.00 is 100%, and no more
+            S = has_word(&words,'S') ? constrain(lround(100*word_value(&words,'S')), 0, 100) : 0;
+            F = has_word(&words,'F') ? word_value(&words,'F') : decoder.get_XYSF().F;
+            if (F <= 0)
+            {
+                F = get_setting(SETTING_TRAVEL_SPEED);
+            }
+            if (machine_cmd == MACHINE_CMD_FILL_POLY)
+            {
+                return NO_ERROR;
+            }
+
+            if (!has_word(&words,'X') || !has_word(&words,'Y') || !has_word(&words,'I') || !has_word(&words,'J'))
+            {
+                print_serial("Error in fill command: rectangle needs X Y I J\n");
+                return MACHINE_CMD_ERROR;
+            }
+            hatcher.set_rectangle(word_value(&words,'X'), word_value(&words,'Y'),
+                                  word_value(&words,'I'), word_value(&words,'J'));
+            if (!hatcher.begin())
+            {
+                print_serial("Error in fill: rectangle has no area\n");
+                return MACHINE_CMD_ERROR;
+            }
+            return NO_ERROR;
+
+        case MACHINE_CMD_FILL_VERTEX:
+            if (!read_command_words(line, 3, &words) || !has_word(&words,'X') || !has_word(&words,'Y')
+                || !hatcher.add_vertex(word_value(&words,'X'), word_value(&words,'Y')))
+            {
+                print_serial("Error in fill vertex\n");
+                return MACHINE_CMD_ERROR;
+            }
+            return NO_ERROR;
+
+        case MACHINE_CMD_FILL_EXECUTE:
+            if (!hatcher.begin())
+            {
+                print_serial("Error in fill: polygon needs 3 vertices and some area\n");
+                return MACHINE_CMD_ERROR;
+            }
+            return NO_ERROR;
+
+        default:
+            return MACHINE_CMD_ERROR;
+    }
+}
+
+
+/** @brief      Send replayed moves to the ramp queue for as long as there is space
+ *  @details    Moves with no length are skipped since they would make a ramp with no time. 
+ *  @param      replay The job replay, already started with @c start_replay()
+ *  @param      translator The translator used for all other moves
+ *  @returns    @c true once all passes are finished
+ */
+bool replay_to_queue(job_replay &replay, coreXY_to_AB &translator)
+{
+    XYSFvalues move;
+    while(ramp_segment_coefficient_queue.available() < RAMP_COEFF_Q_SIZE - get_setting(SETTING_RAMP_PAUSE_LIMIT))
+    {
+        if (!replay.next_move(move))
+        {
+            return true;
+        }
+        XYSFvalues last = translator.get_last_XYSF();
+        if (move.X != last.X || move.Y != last.Y)
+        {
+            translator.translate_to_queue(move);
+        }
+    }
+    return false;
+}
+
+
+
+/** @brief      Send the moves of a subprogram call to the ramp queue for as long as there is space
+ *  @details    Moves with no length are skipped since they would make a ramp with no time. 
+ *  @param      subprograms The subprograms, with a call already started with @c start_call()
+ *  @param      translator The translator used for all other moves
+ *  @returns    @c true once the call is finished
+ */
+bool subprogram_to_queue(subprogram_store &subprograms, coreXY_to_AB &translator)
+{
+    XYSFvalues move;
+    while(ramp_segment_coefficient_queue.available() < RAMP_COEFF_Q_SIZE - get_setting(SETTING_RAMP_PAUSE_LIMIT))
+    {
+        if (!subprograms.next_move(move))
+        {
+            return true;
+        }
+        XYSFvalues last = translator.get_last_XYSF();
+        if (move.X != last.X || move.Y != last.Y)
+        {
+            translator.translate_to_queue(move);
+        }
+    }
+    return false;
+}
+
+
+
+/** @brief      Define, end or call a subprogram
+ *  @details    When a definition starts, the decoder is moved to the subprogram's origin so the lines that follow
+ *              are read in subprogram coordinates, and its values from before are kept in @c before_define. When the
+ *              definition ends they are put back, since the lines in between don't run.
+ *  @param      line A line that @c find_subprogram_cmd() says is a subprogram line
+ *  @param      subprograms The subprograms
+ *  @param      decoder The gcode decoder
+ *  @param      before_define The decoder's values from before the definition started
+ *  @returns    @c NO_ERROR, or @c SUBPROGRAM_ERROR if the line can't be done. A call that returns @c NO_ERROR has
+ *              been started and its moves can be sent with @c subprogram_to_queue().
+ */
+uint8_t subprogram_line(char *line, subprogram_store &subprograms, decode &decoder, XYSFvalues &before_define)
+{
+    command_words words;
+
+    switch (find_subprogram_cmd(line))
+    {
+        case SUB_CMD_DEFINE:
+            if (!read_command_words(line, 0, &words) || !has_word(&words,'O') || word_value(&words,'O') < 0
+                || !subprograms.begin_define(word_value(&words,'O')))
+            {
+                print_serial("Error in subprogram: bad O number, or no room\n");
+                return SUBPROGRAM_ERROR;
+            }
+            before_define = decoder.get_XYSF();
+            decoder.set_position(0, 0);
+            return NO_ERROR;
+
+        case SUB_CMD_END:
+            if (!subprograms.is_defining())
+            {
+                print_serial("Error in subprogram: M99 without O\n");
+                return SUBPROGRAM_ERROR;
+            }
+            decoder.set_XYSF(before_define);
+            if (!subprograms.end_define())
+            {
+                print_serial("Error in subprogram: too big, or no moves\n");
+                return SUBPROGRAM_ERROR;
+            }
+            return NO_ERROR;
+
+        case SUB_CMD_CALL:
+            if (!read_command_words(line, 0, &words) || !has_word(&words,'P')
+                || (has_word(&words,'Q') && word_value(&words,'Q') <= 0)
+                || !subprograms.start_call(word_value(&words,'P'),
+                                           has_word(&words,'X') ? word_value(&words,'X') : 0,
+                                           has_word(&words,'Y') ? word_value(&words,'Y') : 0,
+                                           has_word(&words,'R') ? word_value(&words,'R') : 0,
+                                           has_word(&words,'Q') ? word_value(&words,'Q') : 1))
+            {
+                print_serial("Error in subprogram call: needs P of a defined subprogram\n");
+                return SUBPROGRAM_ERROR;
+            }
+            return NO_ERROR;
+
+        default:
+            return SUBPROGRAM_ERROR;
+    }
+}
+
+
+
+/** @brief      Throw away all queued motion and start over from where the laser head stopped
+ *  @details    Done when the host sends the soft reset real-time command. The serial task has already held motion and
+ *              thrown away the lines it had; this empties the motion queues, stops any fill, replay or subprogram,
+ *              and sets the decoder and translator to where the last setpoint left the laser head. Timing is reset so
+ *              new moves start from time 0, and stays held until the host sends resume. Lines thrown away aren't
+ *              answered, so it ends by printing @c [RX:<size>] as at start up, after which the host clears the lines
+ *              it had in flight and their bytes.
+ *  @param      translator The translator used for all moves
+ *  @param      decoder The gcode decoder
+ *  @param      hatcher The hatch fill generator
+ *  @param      replay The job replay
+ *  @param      subprograms The subprograms
+ */
+void soft_reset_to_start(coreXY_to_AB &translator, decode &decoder, hatch_fill &hatcher, job_replay &replay, 
+                         subprogram_store &subprograms)
+{
+    trace_mark(TRACE_MARK_RESET);
+    ramp_segment_coefficient_queue.flush();
+    binary_move_queue.drain_into([](const XYSFvalues &dump_move) { (void)dump_move; });
+
+    hatcher.reset();
+    replay.abort();
+    subprograms.abort();
+
+    //Where motion stopped, from A and B back to X and Y
+    motor_setpoint stopped;
+    setpoint_share.get(stopped);
+    float X = 0.5*( stopped.A_pos - stopped.B_pos);
+    float Y = 0.5*(-stopped.A_pos - stopped.B_pos);
+
+    decoder = decode();
+    decoder.set_position(X, Y);
+    translator.reset();
+    translator.set_position(X, Y);
+
+    machine_state_board.update(&machine_state::timing_mode, TIMING_MODE_RESET);
+    end_job();
+    print_serial("Reset: held at X" + String(X,3) + " Y" + String(Y,3) + ", send ~ to resume\n");
+    print_serial("[RX:" + String(RX_BUFFER_SIZE) + "]\n");
+}
@@ -20,19 +20,19 @@
 #define TRANSLATE_STATE_NORMAL_OPERATION 0
 #define TRANSLATE_STATE_HOMING 1
 #define TRANSLATE_STATE_PAUSED 2
+#define TRANSLATE_STATE_FILLING 3
+#define TRANSLATE_STATE_REPLAYING 4
+#define TRANSLATE_STATE_CALLING 5
 
 // Managing Queues
-#define RAMP_COEFF_Q_SIZE 32
-#define RAMP_COEFF_Q_PAUSE_LIMIT 4
+#define RAMP_COEFF_Q_SIZE 64
+#define RAMP_COEFF_Q_PAUSE_LIMIT 4     // Default of setting $8 (see settings.h)
 
 // Define timing modes
 #define TIMING_MODE_PAUSED 0
 #define TIMING_MODE_RUNNING 1
 #define TIMING_MODE_RESET 2
 
-// Define task run time, in ms
-#define TRANSLATE_TASK_TIMING 100
-
 
 // =========================================== Structs =========================================== 
 
@@ -45,6 +45,7 @@ struct motor_setpoint
     float B_pos = 0;
     float A_vel = 0;
     float B_vel = 0;
+    uint8_t S = 0;      //Laser power of the segment being run, 0 once the queue runs out
 };
 
 
@@ -60,6 +61,9 @@ struct ramp_segment_coefficients
     uint8_t S    = 0;   //Laser PWM signal
 };
 
+//Ring the ramp segments go through, from the translate task to the control path
+typedef spsc_ring<ramp_segment_coefficients, RAMP_COEFF_Q_SIZE> ramp_segment_ring;
+
 
 
 
@@ -77,6 +81,8 @@ class setpoint_of_time
 {
     protected:
     ramp_segment_coefficients _seg_coeff;       //Saved segment coefficients (all values initialized as 0)
+    float _last_time = 0;                       //Time of the last setpoint, to see when time has been reset
+    uint16_t _segments_started = 0;             //Segments started, for the trace
 
     public: 
     //Contstuctor of the class
@@ -103,6 +109,8 @@ class coreXY_to_AB
 
     ramp_segment_coefficients _ramp_coeff;  // Struct of ramp coefficients to transform to
 
+    job_replay *_recorder = NULL;           // Job replay that moves are recorded to, if any
+
     public:
     // Constructor:
     coreXY_to_AB(void);
@@ -117,6 +125,15 @@ class coreXY_to_AB
     // Reset class data
     void reset(void);  
 
+    // Get the last XYSF values that were translated (where the laser head will be once the queue is done)
+    XYSFvalues get_last_XYSF(void);
+
+    // Start the next move from somewhere else, like where the laser head stopped after a soft reset
+    void set_position(float X, float Y);
+
+    // Record every move sent to the queue in a job replay
+    void record_to(job_replay *recorder);
+
 };
 
 
@@ -125,6 +142,25 @@ class coreXY_to_AB
 
 //Task function to translate and send out necessary control data
 void task_translate(void* p_params);
+
+//Send hatch fill segments to the queue for as long as there is space
+bool fill_to_queue(hatch_fill &hatcher, coreXY_to_AB &translator, uint8_t S, float F);
+
+//Start a rectangle or polygon fill, add a corner to the polygon, or start filling it
+uint8_t fill_line(char *line, uint8_t machine_cmd, hatch_fill &hatcher, decode &decoder, uint8_t &S, float &F);
+
+//Send replayed moves to the queue for as long as there is space
+bool replay_to_queue(job_replay &replay, coreXY_to_AB &translator);
+
+//Send the moves of a subprogram call to the queue for as long as there is space
+bool subprogram_to_queue(subprogram_store &subprograms, coreXY_to_AB &translator);
+
+//Define, end or call a subprogram
+uint8_t subprogram_line(char *line, subprogram_store &subprograms, decode &decoder, XYSFvalues &before_define);
+
+//Throw away all queued motion and start over from where the laser head stopped
+void soft_reset_to_start(coreXY_to_AB &translator, decode &decoder, hatch_fill &hatcher, job_replay &replay, 
+                         subprogram_store &subprograms);
 // void task_translate_test(void* p_params);
 
 
@@ -0,0 +1,147 @@
+/** @file       test_binary_protocol.cpp
+ *  @brief      This file contains the host tests of the binary motion protocol: frames made by the reference
+ *              encoder in tools/ are fed through the laser's decoder.
+ *  @details    Run on a PC with @c pio @c test @c -e @c native.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include <unity.h>
+#include "libraries&constants.h"
+#include "../../tools/binary_encoder.h"
+
+
+// ==================================== Functions ====================================
+
+/** @brief      Feed a whole frame into the decoder
+ *  @param      decoder The decoder
+ *  @param      frame The frame
+ *  @returns    What the decoder made of the frame's last byte
+ */
+static uint8_t feed_frame(binary_decoder &decoder, const std::vector<uint8_t> &frame)
+{
+    uint8_t result = BIN_FRAME_NONE;
+    for (uint8_t byte : frame)
+    {
+        result = decoder.feed(byte);
+    }
+    return result;
+}
+
+
+void setUp(void)
+{
+}
+
+
+void tearDown(void)
+{
+}
+
+
+/** @brief      Absolute and relative moves, with S and F only when they change, come out where they were sent
+ */
+void test_round_trip(void)
+{
+    binary_encoder encoder;
+    binary_decoder decoder;
+
+    TEST_ASSERT_EQUAL(BIN_FRAME_MOVE, feed_frame(decoder, encoder.move(46.12, 39.20, 100, 600)));
+    XYSFvalues XYSF = decoder.get_XYSF();
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 46.12, XYSF.X);
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 39.20, XYSF.Y);
+    TEST_ASSERT_EQUAL(100, XYSF.S);
+    TEST_ASSERT_EQUAL(600, XYSF.F);
+
+    std::vector<uint8_t> frame = encoder.move(46.37, 39.10, 100, 600);
+    TEST_ASSERT_EQUAL(8, frame.size());
+    TEST_ASSERT_EQUAL(BIN_FRAME_MOVE, feed_frame(decoder, frame));
+    XYSF = decoder.get_XYSF();
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 46.37, XYSF.X);
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 39.10, XYSF.Y);
+    TEST_ASSERT_EQUAL(100, XYSF.S);
+
+    TEST_ASSERT_EQUAL(BIN_FRAME_MOVE, feed_frame(decoder, encoder.move(46.37, 41.00, 50, 1200)));
+    XYSF = decoder.get_XYSF();
+    TEST_ASSERT_EQUAL(50, XYSF.S);
+    TEST_ASSERT_EQUAL(1200, XYSF.F);
+    TEST_ASSERT_FALSE(decoder.is_travel());
+
+    //Too far for an int16 change, so absolute again
+    frame = encoder.move(-300.00, 41.00, -1, -1, true);
+    TEST_ASSERT_TRUE(frame[1] & BIN_FLAG_ABS);
+    TEST_ASSERT_EQUAL(BIN_FRAME_MOVE, feed_frame(decoder, frame));
+    TEST_ASSERT_TRUE(decoder.is_travel());
+    TEST_ASSERT_FLOAT_WITHIN(0.005, -300.00, decoder.get_XYSF().X);
+    TEST_ASSERT_EQUAL(0, decoder.get_XYSF().S);
+
+    TEST_ASSERT_EQUAL(BIN_FRAME_END, feed_frame(decoder, encoder.end()));
+    TEST_ASSERT_EQUAL(4, decoder.get_seq());
+}
+
+
+/** @brief      A relative move before any absolute one is rejected, and the absolute one is still wanted next
+ */
+void test_first_move_absolute(void)
+{
+    binary_encoder encoder;
+    binary_decoder decoder;
+    std::vector<uint8_t> absolute = encoder.move(10, 10);
+    std::vector<uint8_t> relative = encoder.move(11, 12);
+    TEST_ASSERT_TRUE(absolute[1] & BIN_FLAG_ABS);
+    TEST_ASSERT_FALSE(relative[1] & BIN_FLAG_ABS);
+
+    //A host out of step with the laser sends the relative move first: number it 0 and make its CRC again
+    relative[2] = 0;
+    relative.back() = binary_encoder::crc8(&relative[1], relative.size() - 2);
+    TEST_ASSERT_EQUAL(BIN_FRAME_ERROR, feed_frame(decoder, relative));
+    TEST_ASSERT_EQUAL(0, decoder.get_next_seq());
+
+    TEST_ASSERT_EQUAL(BIN_FRAME_MOVE, feed_frame(decoder, absolute));
+    TEST_ASSERT_EQUAL(1, decoder.get_next_seq());
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 10, decoder.get_XYSF().X);
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 10, decoder.get_XYSF().Y);
+}
+
+
+/** @brief      A frame with a byte hurt on the way, or out of order, is rejected without changing anything, and
+ *              the decoder takes the frame again when it is resent
+ */
+void test_bad_frames(void)
+{
+    binary_encoder encoder;
+    binary_decoder decoder;
+    std::vector<uint8_t> first = encoder.move(1, 2, 30, 900);
+    std::vector<uint8_t> second = encoder.move(3, 4);
+
+    std::vector<uint8_t> hurt = first;
+    hurt[4] ^= 0x10;
+    TEST_ASSERT_EQUAL(BIN_FRAME_ERROR, feed_frame(decoder, hurt));
+    TEST_ASSERT_EQUAL(BIN_FRAME_ERROR, feed_frame(decoder, second));
+    TEST_ASSERT_EQUAL(0, decoder.get_next_seq());
+
+    TEST_ASSERT_EQUAL(BIN_FRAME_MOVE, feed_frame(decoder, first));
+    TEST_ASSERT_EQUAL(BIN_FRAME_MOVE, feed_frame(decoder, second));
+    XYSFvalues XYSF = decoder.get_XYSF();
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 3, XYSF.X);
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 4, XYSF.Y);
+    TEST_ASSERT_EQUAL(30, XYSF.S);
+    TEST_ASSERT_EQUAL(900, XYSF.F);
+}
+
+
+/** @brief      Run the binary protocol tests
+ *  @returns    The number of tests which failed
+ */
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    load_settings();                // The decoder starts at the travel speed setting, as after setup()
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_first_move_absolute);
+    RUN_TEST(test_bad_frames);
+    return UNITY_END();
+}
@@ -0,0 +1,259 @@
+/** @file       test_drivers.cpp
+ *  @brief      This file contains the host tests of the hardware drivers: the TB6612FNG motor driver, the
+ *              quadrature encoder, the stopwatch, the debouncer and the laser's PWM, run against the host
+ *              stand-in of the Arduino core.
+ *  @details    Run on a PC with @c pio @c test @c -e @c native. The tests check what each driver writes to its
+ *              pins and timers with @c host_pin_value(), turn encoders with @c host_encoder_move() or a motor
+ *              tied to a timer, and move the clock on with @c vTaskHostCharge(), as the tests run on virtual time.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include <unity.h>
+#include "libraries&constants.h"
+#include "host_hal.h"
+
+
+///@cond
+// Microseconds of virtual time, for moving the clock on
+#define US 1000ULL
+///@endcond
+
+
+// ==================================== Functions ====================================
+
+/** @brief      Update a debouncer a number of times with its pin at one level
+ *  @param      debouncer The debouncer
+ *  @param      pin The debouncer's pin
+ *  @param      level @c HIGH or @c LOW
+ *  @param      times How many updates
+ *  @returns    What the last update returned
+ */
+static bool update_at(Debouncer &debouncer, uint32_t pin, uint32_t level, uint8_t times)
+{
+    bool result = false;
+    host_pin_set(pin, level);
+    for (uint8_t update = 0; update < times; update++)
+    {
+        result = debouncer.update();
+    }
+    return result;
+}
+
+
+/** @brief      Run a motor for a while, reading its encoder every millisecond like the encoder task does
+ *  @param      encoder The motor's encoder
+ *  @param      ms Milliseconds to run for
+ *  @returns    The encoder's position at the end
+ */
+static int32_t run_motor(Quad_Encoder &encoder, uint32_t ms)
+{
+    int32_t position = encoder.enc_read();
+    for (uint32_t tick = 0; tick < ms; tick++)
+    {
+        vTaskHostCharge(1000*US);
+        position = encoder.enc_read();
+    }
+    return position;
+}
+
+
+void setUp(void)
+{
+    // The debouncer prints its state; keep it out of the test results
+    Serial.use_memory(false, true);
+}
+
+
+void tearDown(void)
+{
+    Serial.take_output();
+}
+
+
+/** @brief      The motor driver starts stopped, sets the direction pins by the sign of the duty cycle, scales and
+ *              limits the PWM to 0 to 255, and turns the H-bridge off and on with the standby pin
+ */
+void test_TB6612FNG(void)
+{
+    TB6612FNG motor(STBY, BIN1, BIN2, PWM_B);
+    TEST_ASSERT_EQUAL(HIGH, host_pin_value(STBY));
+    TEST_ASSERT_EQUAL(LOW, host_pin_value(BIN1));
+    TEST_ASSERT_EQUAL(LOW, host_pin_value(BIN2));
+    TEST_ASSERT_EQUAL(0, host_pin_value(PWM_B));
+
+    uint32_t PWM_writes = host_hal_total(HAL_ANALOG_WRITE);
+    motor.setDutyCycle(50);
+    TEST_ASSERT_EQUAL(LOW, host_pin_value(BIN1));
+    TEST_ASSERT_EQUAL(HIGH, host_pin_value(BIN2));
+    TEST_ASSERT_EQUAL(127, host_pin_value(PWM_B));
+    TEST_ASSERT_EQUAL(PWM_writes + 1, host_hal_total(HAL_ANALOG_WRITE));
+
+    motor.setDutyCycle(-25);
+    TEST_ASSERT_EQUAL(HIGH, host_pin_value(BIN1));
+    TEST_ASSERT_EQUAL(LOW, host_pin_value(BIN2));
+    TEST_ASSERT_EQUAL(63, host_pin_value(PWM_B));
+
+    motor.setDutyCycle(-150);
+    TEST_ASSERT_EQUAL(255, host_pin_value(PWM_B));
+    motor.setDutyCycle(150);
+    TEST_ASSERT_EQUAL(LOW, host_pin_value(BIN1));
+    TEST_ASSERT_EQUAL(255, host_pin_value(PWM_B));
+
+    motor.setDutyCycle(0);
+    TEST_ASSERT_EQUAL(LOW, host_pin_value(BIN1));
+    TEST_ASSERT_EQUAL(LOW, host_pin_value(BIN2));
+    TEST_ASSERT_EQUAL(0, host_pin_value(PWM_B));
+
+    motor.disable();
+    TEST_ASSERT_EQUAL(LOW, host_pin_value(STBY));
+    motor.enable();
+    TEST_ASSERT_EQUAL(HIGH, host_pin_value(STBY));
+}
+
+
+/** @brief      The encoder adds up counts both ways, inverted if asked, and across the timer wrapping at 65535
+ */
+void test_Quad_Encoder(void)
+{
+    Quad_Encoder encoder(A_C1, A_C2, 1, 2, TIM3);
+    TEST_ASSERT_EQUAL(0, encoder.enc_read());
+
+    host_encoder_move(TIM3, 500);
+    TEST_ASSERT_EQUAL(500, encoder.enc_read());
+    TEST_ASSERT_EQUAL(500, encoder.get_delta());
+    host_encoder_move(TIM3, -200);
+    TEST_ASSERT_EQUAL(300, encoder.enc_read());
+    TEST_ASSERT_EQUAL(-200, encoder.get_delta());
+
+    //Down through 0 to 65535 and back up; every count is a count
+    host_encoder_move(TIM3, -311);
+    TEST_ASSERT_EQUAL(65525, encoder.enc_test());
+    TEST_ASSERT_EQUAL(-11, encoder.enc_read());
+    host_encoder_move(TIM3, 20);
+    TEST_ASSERT_EQUAL(9, encoder.enc_read());
+    TEST_ASSERT_EQUAL(20, encoder.get_delta());
+
+    encoder.enc_zero();
+    TEST_ASSERT_EQUAL(0, encoder.get_delta());
+    host_encoder_move(TIM3, 7);
+    TEST_ASSERT_EQUAL(7, encoder.enc_read());
+
+    Quad_Encoder inverted(B_C1, B_C2, 1, 2, TIM4, 1000, true);
+    host_encoder_move(TIM4, 40);
+    TEST_ASSERT_EQUAL(-40, inverted.enc_read());
+}
+
+
+/** @brief      A motor driven through the TB6612FNG turns its encoder forward for a positive duty cycle, back for a
+ *              negative one, and not under power while the H-bridge is on standby
+ */
+void test_motor_and_encoder(void)
+{
+    // Wired like motor A in main.cpp, on a timer of its own
+    host_motor_config config = {PWM_A, AIN1, AIN2, STBY, TIM1, 4400, 0.05};
+    TEST_ASSERT_TRUE(host_motor_attach(config));
+    TB6612FNG motor(STBY, AIN2, AIN1, PWM_A);
+    Quad_Encoder encoder(A_C1, A_C2, 1, 2, TIM1);
+
+    //Full speed less what the lag loses getting there: 4400*(1 - 0.05)
+    motor.setDutyCycle(100);
+    int32_t forward = run_motor(encoder, 1000);
+    TEST_ASSERT_INT_WITHIN(20, 4180, forward);
+
+    motor.setDutyCycle(-100);
+    int32_t back = run_motor(encoder, 1000);
+    TEST_ASSERT_INT_WITHIN(20, forward - 4400 + 440, back);
+
+    motor.setDutyCycle(0);
+    int32_t stopped = run_motor(encoder, 500);     // Coasts to a stop, to within a count
+    motor.setDutyCycle(50);
+    motor.disable();
+    TEST_ASSERT_INT_WITHIN(1, stopped, run_motor(encoder, 500));
+    motor.enable();
+    TEST_ASSERT_GREATER_THAN(stopped, run_motor(encoder, 500));
+    motor.setDutyCycle(0);
+}
+
+
+/** @brief      The stopwatch counts microseconds from a restart, and laps measure the time between calls
+ */
+void test_StopWatch(void)
+{
+    StopWatch watch(TIM6, (uint8_t)PA0);
+    watch.restart();
+    vTaskHostCharge(1500*US);
+    TEST_ASSERT_INT_WITHIN(2, 1500, watch.now_time());
+    vTaskHostCharge(250*US);
+    TEST_ASSERT_INT_WITHIN(2, 250, watch.elapsed_time());
+
+    watch.restart();
+    vTaskHostCharge(100*US);
+    TEST_ASSERT_INT_WITHIN(2, 100, watch.lap());
+    vTaskHostCharge(400*US);
+    TEST_ASSERT_INT_WITHIN(2, 400, watch.lap());
+
+    watch.temp_stop();
+    vTaskHostCharge(300*US);
+    TEST_ASSERT_INT_WITHIN(2, 0, watch.lap());
+}
+
+
+/** @brief      The debouncer only goes true after the pin has been low for its threshold of updates, ignores a
+ *              bounce, and only goes false again after the pin has been high as long
+ */
+void test_Debouncer(void)
+{
+    Debouncer button(PC13, 5);
+    TEST_ASSERT_EQUAL(HIGH, host_pin_value(PC13));
+    TEST_ASSERT_FALSE(update_at(button, PC13, HIGH, 10));
+
+    //A bounce: low, then high again before the threshold
+    TEST_ASSERT_FALSE(update_at(button, PC13, LOW, 3));
+    TEST_ASSERT_FALSE(update_at(button, PC13, HIGH, 1));
+
+    //One update to see the low, five to count it, and the next one reports it
+    TEST_ASSERT_FALSE(update_at(button, PC13, LOW, 6));
+    TEST_ASSERT_TRUE(update_at(button, PC13, LOW, 1));
+
+    //High too briefly to count, then long enough
+    TEST_ASSERT_TRUE(update_at(button, PC13, HIGH, 4));
+    TEST_ASSERT_TRUE(update_at(button, PC13, LOW, 1));
+    TEST_ASSERT_TRUE(update_at(button, PC13, HIGH, 5));
+    TEST_ASSERT_FALSE(update_at(button, PC13, HIGH, 1));
+}
+
+
+/** @brief      The laser's power in percent is scaled to 0 to 255 on its PWM pin, and limited to 100%
+ */
+void test_laser(void)
+{
+    set_laser_PWM(0);
+    TEST_ASSERT_EQUAL(0, host_pin_value(L_PWM));
+    set_laser_PWM(50);
+    TEST_ASSERT_EQUAL(127, host_pin_value(L_PWM));
+    set_laser_PWM(100);
+    TEST_ASSERT_EQUAL(255, host_pin_value(L_PWM));
+    set_laser_PWM(200);
+    TEST_ASSERT_EQUAL(255, host_pin_value(L_PWM));
+}
+
+
+/** @brief      Run the driver tests on virtual time
+ *  @returns    The number of tests which failed
+ */
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    vTaskHostUseVirtualTime();
+    UNITY_BEGIN();
+    RUN_TEST(test_TB6612FNG);
+    RUN_TEST(test_Quad_Encoder);
+    RUN_TEST(test_motor_and_encoder);
+    RUN_TEST(test_StopWatch);
+    RUN_TEST(test_Debouncer);
+    RUN_TEST(test_laser);
+    return UNITY_END();
+}
@@ -0,0 +1,237 @@
+/** @file       test_hatch.cpp
+ *  @brief      This file contains the host tests of the hatch fill generator, which check the segments it makes
+ *              against reference hatches worked out by hand.
+ *  @details    Run on a PC with @c pio @c test @c -e @c native. Each reference is the list of segments, in order,
+ *              that the fill should hand out: lines half a spacing in from the edge, every other one backwards.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include <unity.h>
+#include "libraries&constants.h"
+
+
+// ========================================== Constants ==========================================
+
+///@cond
+// How far a segment's ends may be from the reference, in mm
+#define HATCH_TOLERANCE 1e-4
+
+// One segment of a reference hatch
+struct reference_segment
+{
+    float X_start;
+    float Y_start;
+    float X_end;
+    float Y_end;
+};
+///@endcond
+
+
+// ==================================== Functions ====================================
+
+/** @brief      Check that a started fill hands out exactly the reference segments, in order
+ *  @param      hatcher The fill, with @c begin() already called
+ *  @param      reference The segments it should hand out
+ *  @param      count Number of segments in the reference
+ */
+static void check_hatch(hatch_fill &hatcher, const reference_segment *reference, uint8_t count)
+{
+    hatch_point start;
+    hatch_point end;
+    for (uint8_t index = 0; index < count; index++)
+    {
+        TEST_ASSERT_TRUE(hatcher.next_segment(start, end));
+        TEST_ASSERT_FLOAT_WITHIN(HATCH_TOLERANCE, reference[index].X_start, start.X);
+        TEST_ASSERT_FLOAT_WITHIN(HATCH_TOLERANCE, reference[index].Y_start, start.Y);
+        TEST_ASSERT_FLOAT_WITHIN(HATCH_TOLERANCE, reference[index].X_end, end.X);
+        TEST_ASSERT_FLOAT_WITHIN(HATCH_TOLERANCE, reference[index].Y_end, end.Y);
+    }
+    TEST_ASSERT_FALSE(hatcher.next_segment(start, end));
+    TEST_ASSERT_FALSE(hatcher.running());
+}
+
+
+void setUp(void)
+{
+}
+
+
+void tearDown(void)
+{
+}
+
+
+/** @brief      A rectangle with horizontal lines zig-zags across it, one segment a line
+ */
+void test_rectangle_horizontal(void)
+{
+    static const reference_segment reference[] =
+    {
+        { 0, 0.5, 10, 0.5},
+        {10, 1.5,  0, 1.5},
+        { 0, 2.5, 10, 2.5},
+        {10, 3.5,  0, 3.5},
+    };
+    hatch_fill hatcher;
+    TEST_ASSERT_TRUE(hatcher.set_hatch(0, 1));
+    hatcher.set_rectangle(0, 0, 10, 4);
+    TEST_ASSERT_TRUE(hatcher.begin());
+    check_hatch(hatcher, reference, sizeof(reference)/sizeof(reference[0]));
+}
+
+
+/** @brief      At 90 degrees the lines run along Y, starting from the right hand side of the rectangle
+ */
+void test_rectangle_vertical(void)
+{
+    static const reference_segment reference[] =
+    {
+        {3,  0, 3, 10},
+        {1, 10, 1,  0},
+    };
+    hatch_fill hatcher;
+    TEST_ASSERT_TRUE(hatcher.set_hatch(90, 2));
+    hatcher.set_rectangle(0, 0, 4, 10);
+    TEST_ASSERT_TRUE(hatcher.begin());
+    check_hatch(hatcher, reference, sizeof(reference)/sizeof(reference[0]));
+}
+
+
+/** @brief      A U shape gives two segments on the lines through its arms, and the backward lines take them
+ *              from the right
+ */
+void test_concave_polygon(void)
+{
+    static const reference_segment reference[] =
+    {
+        {0, 0.5, 6, 0.5},
+        {6, 1.5, 0, 1.5},
+        {0, 2.5, 2, 2.5},
+        {4, 2.5, 6, 2.5},
+        {6, 3.5, 4, 3.5},
+        {2, 3.5, 0, 3.5},
+    };
+    static const float corners[][2] = {{0,0}, {6,0}, {6,4}, {4,4}, {4,2}, {2,2}, {2,4}, {0,4}};
+    hatch_fill hatcher;
+    TEST_ASSERT_TRUE(hatcher.set_hatch(0, 1));
+    for (const float *corner : corners)
+    {
+        TEST_ASSERT_TRUE(hatcher.add_vertex(corner[0], corner[1]));
+    }
+    TEST_ASSERT_TRUE(hatcher.begin());
+    check_hatch(hatcher, reference, sizeof(reference)/sizeof(reference[0]));
+}
+
+
+/** @brief      At 45 degrees a diamond is a square in the hatch frame, so the lines go from side to side
+ *  @details    The diamond has its corners on the axes at 2 mm, so in the hatch frame it is a square of side
+ *              2*sqrt(2), and lines sqrt(2) apart are a quarter and three quarters of the way across it.
+ */
+void test_diamond_diagonal(void)
+{
+    static const reference_segment reference[] =
+    {
+        {-0.5, -1.5,  1.5,  0.5},
+        { 0.5,  1.5, -1.5, -0.5},
+    };
+    hatch_fill hatcher;
+    TEST_ASSERT_TRUE(hatcher.set_hatch(45, sqrt(2)));
+    TEST_ASSERT_TRUE(hatcher.add_vertex( 0, -2));
+    TEST_ASSERT_TRUE(hatcher.add_vertex( 2,  0));
+    TEST_ASSERT_TRUE(hatcher.add_vertex( 0,  2));
+    TEST_ASSERT_TRUE(hatcher.add_vertex(-2,  0));
+    TEST_ASSERT_TRUE(hatcher.begin());
+    check_hatch(hatcher, reference, sizeof(reference)/sizeof(reference[0]));
+}
+
+
+/** @brief      Bad fills are refused: too small a spacing, too few corners and too many
+ */
+void test_bad_fills(void)
+{
+    hatch_fill hatcher;
+    TEST_ASSERT_FALSE(hatcher.set_hatch(0, HATCH_MIN_SPACING/2));
+
+    TEST_ASSERT_TRUE(hatcher.add_vertex(0, 0));
+    TEST_ASSERT_TRUE(hatcher.add_vertex(1, 0));
+    TEST_ASSERT_FALSE(hatcher.begin());
+    TEST_ASSERT_FALSE(hatcher.running());
+
+    hatcher.reset();
+    for (uint8_t index = 0; index < HATCH_MAX_VERTICES; index++)
+    {
+        TEST_ASSERT_TRUE(hatcher.add_vertex(index, index % 2));
+    }
+    TEST_ASSERT_FALSE(hatcher.add_vertex(0, 0));
+}
+
+
+/** @brief      Carry out a fill command line like the translate task does
+ *  @param      text The line
+ *  @param      hatcher The fill
+ *  @returns    What @c fill_line() returned
+ */
+static uint8_t run_fill_line(const char *text, hatch_fill &hatcher)
+{
+    decode decoder;
+    char line[LINE_BUFFER_SIZE];
+    uint8_t S = 0;
+    float F = 0;
+    strncpy(line, text, sizeof(line) - 1);
+    line[sizeof(line) - 1] = '\0';
+    return fill_line(line, decoder.interpret_machinecmd_line(line), hatcher, decoder, S, F);
+}
+
+
+/** @brief      Fill commands for fills that can't be done are answered with an error, not @c ok: a rectangle with
+ *              no area, a polygon with fewer than 3 corners or none of them apart, and a spacing of 0 or less
+ */
+void test_fill_errors(void)
+{
+    hatch_fill hatcher;
+    TEST_ASSERT_EQUAL(NO_ERROR, run_fill_line("$FR X0 Y0 I10 J5 D1", hatcher));
+    TEST_ASSERT_TRUE(hatcher.running());
+
+    TEST_ASSERT_EQUAL(MACHINE_CMD_ERROR, run_fill_line("$FR X0 Y0 I0 J5 D1", hatcher));
+    TEST_ASSERT_FALSE(hatcher.running());
+    TEST_ASSERT_EQUAL(MACHINE_CMD_ERROR, run_fill_line("$FR X0 Y0 I10 J0 D1", hatcher));
+    TEST_ASSERT_EQUAL(MACHINE_CMD_ERROR, run_fill_line("$FR X0 Y0 I10 J5 D0", hatcher));
+    TEST_ASSERT_EQUAL(MACHINE_CMD_ERROR, run_fill_line("$FR X0 Y0 I10 J5 D-1", hatcher));
+    TEST_ASSERT_EQUAL(MACHINE_CMD_ERROR, run_fill_line("$FP D0", hatcher));
+    TEST_ASSERT_FALSE(hatcher.running());
+
+    TEST_ASSERT_EQUAL(NO_ERROR, run_fill_line("$FP D1", hatcher));
+    TEST_ASSERT_EQUAL(NO_ERROR, run_fill_line("$FV X0 Y0", hatcher));
+    TEST_ASSERT_EQUAL(NO_ERROR, run_fill_line("$FV X10 Y0", hatcher));
+    TEST_ASSERT_EQUAL(MACHINE_CMD_ERROR, run_fill_line("$FE", hatcher));
+    TEST_ASSERT_EQUAL(NO_ERROR, run_fill_line("$FV X20 Y0", hatcher));
+    TEST_ASSERT_EQUAL(MACHINE_CMD_ERROR, run_fill_line("$FE", hatcher));
+    TEST_ASSERT_FALSE(hatcher.running());
+
+    TEST_ASSERT_EQUAL(NO_ERROR, run_fill_line("$FP D1", hatcher));
+    TEST_ASSERT_EQUAL(NO_ERROR, run_fill_line("$FV X0 Y0", hatcher));
+    TEST_ASSERT_EQUAL(NO_ERROR, run_fill_line("$FV X10 Y0", hatcher));
+    TEST_ASSERT_EQUAL(NO_ERROR, run_fill_line("$FV X0 Y10", hatcher));
+    TEST_ASSERT_EQUAL(NO_ERROR, run_fill_line("$FE", hatcher));
+    TEST_ASSERT_TRUE(hatcher.running());
+}
+
+
+/** @brief      Run the hatch tests
+ *  @returns    The number of tests which failed
+ */
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_rectangle_horizontal);
+    RUN_TEST(test_rectangle_vertical);
+    RUN_TEST(test_concave_polygon);
+    RUN_TEST(test_diamond_diagonal);
+    RUN_TEST(test_bad_fills);
+    RUN_TEST(test_fill_errors);
+    return UNITY_END();
+}
@@ -0,0 +1,105 @@
+/** @file       test_settings.cpp
+ *  @brief      This file contains the host tests of the settings registry: @c $n=value lines, and settings saved
+ *              and loaded again.
+ *  @details    Run on a PC with @c pio @c test @c -e @c native. Off the board the settings are saved in
+ *              @c SETTINGS_HOST_FILE, which each test starts without.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include <unity.h>
+#include "libraries&constants.h"
+#include <stdio.h>
+
+
+// ==================================== Functions ====================================
+
+/** @brief      Carry out a @c $n=value line
+ *  @param      text The line
+ *  @returns    What @c setting_line() returned
+ */
+static bool run_line(const char *text)
+{
+    char line[LINE_BUFFER_SIZE];
+    strncpy(line, text, sizeof(line) - 1);
+    line[sizeof(line) - 1] = '\0';
+    return setting_line(line);
+}
+
+
+void setUp(void)
+{
+    remove(SETTINGS_HOST_FILE);
+    load_settings();
+}
+
+
+void tearDown(void)
+{
+    remove(SETTINGS_HOST_FILE);
+}
+
+
+/** @brief      A setting in range is set; numbers past the last setting, including ones a @c uint8_t would wrap
+ *              round to a real setting, are rejected and change nothing
+ */
+void test_setting_numbers(void)
+{
+    TEST_ASSERT_TRUE(run_line("$0=3"));
+    TEST_ASSERT_EQUAL_FLOAT(3, get_setting(SETTING_KP));
+    TEST_ASSERT_TRUE(run_line("$12=2.5"));
+    TEST_ASSERT_EQUAL_FLOAT(2.5, get_setting(SETTING_WHEEL_RADIUS));
+
+    uint16_t version = get_settings_version();
+    TEST_ASSERT_FALSE(run_line("$13=1"));
+    TEST_ASSERT_FALSE(run_line("$255=1"));
+    TEST_ASSERT_FALSE(run_line("$256=7"));
+    TEST_ASSERT_FALSE(run_line("$268=2"));
+    TEST_ASSERT_FALSE(run_line("$65536=5"));
+    TEST_ASSERT_FALSE(run_line("$-1=1"));
+    TEST_ASSERT_FALSE(run_line("$0.5=1"));
+    TEST_ASSERT_EQUAL(version, get_settings_version());
+    TEST_ASSERT_EQUAL_FLOAT(3, get_setting(SETTING_KP));
+    TEST_ASSERT_EQUAL_FLOAT(2.5, get_setting(SETTING_WHEEL_RADIUS));
+}
+
+
+/** @brief      Settings saved are loaded again, and saved settings with another number of settings in them are
+ *              ignored
+ */
+void test_saved_settings(void)
+{
+    TEST_ASSERT_TRUE(set_setting(SETTING_TRAVEL_SPEED, 1200));
+    load_settings();
+    TEST_ASSERT_EQUAL_FLOAT(1200, get_setting(SETTING_TRAVEL_SPEED));
+
+    // The same file but for a build with one more setting, its CRC worked out again
+    saved_settings saved;
+    FILE *file = fopen(SETTINGS_HOST_FILE, "rb");
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_EQUAL(sizeof(saved), fread(&saved, 1, sizeof(saved), file));
+    fclose(file);
+    saved.count = SETTINGS_COUNT + 1;
+    saved.crc = crc8((const uint8_t*)&saved, offsetof(saved_settings, crc));
+    file = fopen(SETTINGS_HOST_FILE, "wb");
+    fwrite(&saved, 1, sizeof(saved), file);
+    fclose(file);
+
+    load_settings();
+    TEST_ASSERT_EQUAL_FLOAT(TRAVEL_SPEED, get_setting(SETTING_TRAVEL_SPEED));
+}
+
+
+/** @brief      Run the settings tests
+ *  @returns    The number of tests which failed
+ */
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_setting_numbers);
+    RUN_TEST(test_saved_settings);
+    return UNITY_END();
+}
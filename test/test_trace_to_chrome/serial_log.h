@@ -0,0 +1,145 @@
+/** @file       serial_log.h
+ *  @brief      This file contains a serial log saved from the laser built for a PC, for the trace tool's test.
+ *  @details    The motor test was running and printing its status, and @c $TR was sent part way through, so the
+ *              printout comes straight after a status line which ends with only a @c \r. Long lines are split
+ *              in two; the log is otherwise as it was read from the port.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef SERIAL_LOG_H
+#define SERIAL_LOG_H
+
+///@cond
+static const char serial_log[] =
+    "\r\n"
+    "\n"
+    "Laser Program Initializing\r\n"
+    "Running Host Task Graph\r\n"
+    "Tasks created\r\n"
+    "Schedule check\r\n"
+    "task             prio period deadline  wcet_us  resp_us\r\n"
+    "Reading Serial      8      2        2      810     1600 ok\r\n"
+    "Printing Serial     3     10       10      100     1700 ok\r\n"
+    "Status Report       2     20       20       50     1750 ok\r\n"
+    "Translating         9    100      100      750      790 ok\r\n"
+    "Motor Test          1     10       10      120     1920 ok\r\n"
+    "Run encoder A      13     10       10       20       40 ok\r\n"
+    "Run encoder B      13     10       10       20       40 ok\r\n"
+    "Stack Monitor       1    250      250       50     1920 ok\r\n"
+    "CPU use 44.1%, rate monotonic bound 72.4% for 8 tasks\r\n"
+    "Every task meets its deadline\r\n"
+    "Priorities the wrong way round for their deadlines:\r\n"
+    "  Status Report (2, 20 ms) is above Motor Test (1, 10 ms)\r\n"
+    "  Translating (9, 100 ms) is above Reading Serial (8, 2 ms)\r\n"
+    "  Translating (9, 100 ms) is above Printing Serial (3, 10 ms)\r\n"
+    "  Translating (9, 100 ms) is above Status Report (2, 20 ms)\r\n"
+    "  Translating (9, 100 ms) is above Motor Test (1, 10 ms)\r\n"
+    "  Run encoder A (13, 10 ms) is above Reading Serial (8, 2 ms)\r\n"
+    "  Run encoder B (13, 10 ms) is above Reading Serial (8, 2 ms)\r\n"
+    "Encoder A initialized\n"
+    "Encoder B initialized\n"
+    "[RX:128]\n"
+    "Control Path Test Initialized\n"
+    "\n"
+    "Running Motor: A & B\n"
+    "KP: 1.00\n"
+    "KI: 0.50\n"
+    "KD: 0.00\n"
+    "Motor Deadband: 9.00\n"
+    "\n"
+    "Position: 0.67 (A)  0.81 (B)    Velocity: -1788.19 (A)  -1787.40 (B)    Error:  -20.52 (A)  19.0"
+    "4 (B)    Time:  0.04                                \r"
+    "TRACE 1000000000 237\n"
+    "T 1 Reading Serial\n"
+    "T 2 Printing Serial\n"
+    "T 3 Status Report\n"
+    "T 4 Translating\n"
+    "T 5 Motor Test\n"
+    "T 6 Run encoder A\n"
+    "T 7 Run encoder B\n"
+    "T 8 Stack Monitor\n"
+    "Q 14 Power\n"
+    "Q 13 Telemetry Setti\n"
+    "Q 12 Status Period\n"
+    "Q 11 Setpoint\n"
+    "Q 10 Machine State\n"
+    "Q 9 Ramp Coefficien\n"
+    "Q 8 Encoder B varia\n"
+    "Q 7 Encoder A varia\n"
+    "Q 6 Telemetry\n"
+    "Q 5 Binary Moves\n"
+    "Q 4 read_val\n"
+    "Q 3 char array prin\n"
+    "Q 2 Motor B DutyCyc\n"
+    "Q 1 Motor A DutyCyc\n"
+    "E 7767ab7001060000 7767d8b403030001 7768122202060000 77682a8101070000\n"
+    "E 77682fc903030001 7768465c02070000 77685e6101040000 7768935002040000\n"
+    "E 77689fac01010000 7768d73a03030001 776908b703040001 7769195702010000\n"
+    "E 77692c8201020000 77692fd604030001 776931d404030002 776987c702020000\n"
+    "E 776996eb01030000 7769acb602030000 7769b67d01050000 7769bb2503030001\n"
+    "E 7769bdce03030001 7769be5a03030001 7769cf5f03030001 7769d06303030001\n"
+    "E 7769d59703030001 7769d61003030001 7769d7aa03030001 7769d86803030001\n"
+    "E 7769daa303030001 7769db2503030001 7769dd1003090001 7769ddba07030000\n"
+    "E 7769dea103090001 7769ee5b02050000 776a10be01080000 77785e7d02080000\n"
+    "E 77813e4b01010000 778167eb02010000 779fc4df01010000 77a0102e02010000\n"
+    "E 77be69b101010000 77bea39702010000 77dcdcb501010000 77dd1bf702010000\n"
+    "E 77fb7c8501070000 77fbb95a02070000 77fbd48a01020000 77fbd9fa04030001\n"
+    "E 77fbdde404030003 77fcc02104030001 77fcc11b04030003 77fcd2c004030001\n"
+    "E 77fcd3b004030002 77fd127002020000 77fd173601010000 77fd259c02010000\n"
+    "E 77fd4c8901060000 77fd764702060000 7819f7a201010000 781a406602010000\n"
+    "E 78388a1001010000 7838d16c02010000 7856f74001010000 78572c4d02010000\n"
+    "E 78755ab301010000 78757e4302010000 7894085c01020000 78942fdf02020000\n"
+    "E 7894496101070000 78946ff402070000 7894747301010000 789484f602010000\n"
+    "E 7894a42401060000 7894c27502060000 78b26c3c01010000 78b28d2302010000\n"
+    "E 78d10aa301010000 78d1401e02010000 78ef6c6701010000 78ef8b8102010000\n"
+    "E 790e2a1a01010000 790e63c402010000 792cb67801070000 792ce6f102070000\n"
+    "E 792d011301020000 792d219502020000 792d261f01010000 792d380a02010000\n"
+    "E 792d59d701060000 792d7b9a02060000 794b28c801010000 794b5ef702010000\n"
+    "E 7969be6201010000 796a021a02010000 79884ab601010000 79889c2902010000\n"
+    "E 79a6b81801010000 79a6febf02010000 79c54acc01020000 79c5773402020000\n"
+    "E 79c591ba01060000 79c5be8f02060000 79c5c33701010000 79c5ce8f02010000\n"
+    "E 79c5ea9c01070000 79c6084d02070000 79e3c55e01010000 79e4119d02010000\n"
+    "E 7a024c6a01010000 7a02880902010000 7a20ae0f01010000 7a20cd4702010000\n"
+    "E 7a3f454e01010000 7a3f7bd702010000 7a5dc18e01050000 7a5dca5b04090001\n"
+    "E 7a5dca8305000001 7a5dd9e303030001 7a5e017a03030001 7a5e02a703030001\n"
+    "E 7a5e040503030001 7a5e047303030001 7a5e04d703030001 7a5e0a7a03030001\n"
+    "E 7a5e0ad403030001 7a5e0c8c03030001 7a5e0cf103030001 7a5e0d5f03030001\n"
+    "E 7a5e0eef03030001 7a5e0f5303030001 7a5e10a803030001 7a5e110c03030001\n"
+    "E 7a5e117003030001 7a5e133303030001 7a5e149103030001 7a5e248802050000\n"
+    "E 7a5e3bb001020000 7a5e3f2c04030001 7a5e406c04030003 7a5fb0e804030001\n"
+    "E 7a5fb1d804030003 7a5fc2fb04030001 7a5fc3e104030003 7a5fd40904030001\n"
+    "E 7a5fd4f004030003 7a5fe5f404030001 7a5fe6a904030001 7a601d0902020000\n"
+    "E 7a60259b01010000 7a60345a02010000 7a60498401070000 7a605fe502070000\n"
+    "E 7a607fa901060000 7a60a0ae02060000 7a7c575901010000 7a7c93b602010000\n"
+    "E 7a9ac00a01010000 7a9adef202010000 7ab95a5501010000 7ab9914c02010000\n"
+    "E 7ad7cb8d01010000 7ad7f41402010000 7af67b4801070000 7af694ca02070000\n"
+    "E 7af6b6b501020000 7af6dc1c02020000 7af6e0eb01010000 7af6ec9e02010000\n"
+    "E 7af708b501060000 7af7268e02060000 7b14d09101010000 7b14ef2902010000\n"
+    "E 7b33749a01010000 7b33aff302010000 7b51effe01010000 7b5222da02010000\n"
+    "E 7b70726c01010000 7b70aa7c02010000 7b8edd1b01020000 7b8ee54902020000\n"
+    "E 7b8ef98201060000 7b8f1ed502060000 7b8f233601010000 7b8f2fbb02010000\n"
+    "E 7b8f528d01070000 7b8f74e602070000 7bad8cf501010000 7badcbc902010000\n"
+    "E 7bcc025c01010000 7bcc395302010000 7bea70d701010000 7bea904102010000\n"
+    "E 7c090d2b01010000 7c0949ba02010000 7c2775f001020000 7c27915c02020000\n"
+    "E 7c27a7c701060000 7c27ce8c02060000 7c27d26101010000 7c27d6d702010000\n"
+    "E 7c27f31601070000 7c28109f02070000 7c4649e501010000 7c467ded02010000\n"
+    "E 7c64902801010000 7c64bf0602010000 7c82fab901010000 7c83166202010000\n"
+    "E 7ca1753701010000 7ca18fbd02010000 7cc0014f01060000 7cc0259302060000\n"
+    "E 7cc03ff101070000 7cc05f3302070000 7cc0633a01010000 7cc067f602010000\n"
+    "E 7cc0881e01020000 7cc0aa6e02020000 7cde7c6201010000 7cde97e302010000\n"
+    "E 7cfd0c9601010000 7cfd2e4f02010000 7d1b7f5e01010000 7d1b9a0c02010000\n"
+    "E 7d3a06ba01010000 7d3a25ac02010000 7d5914aa01060000 7d5967ea02060000\n"
+    "E 7d5980c101020000 7d59a5ce02020000 7d59aa4301070000 7d59af8b02070000\n"
+    "E 7d59b2d501010000 7d59ca4402010000 7d59ecd901040000 7d59f74104040001\n"
+    "E 7d59f75f07010001\n"
+    "END\n"
+    "ok\n"
+    "Position: -22.66 (A)  26.16 (B)    Velocity: -159.72 (A)  152.68 (B)    Error:  -97.18 (A)  93.6"
+    "8 (B)    Time:  0.24                                \r"
+    "Position: -120.03 (A)  129.20 (B)    Velocity: -579.24 (A)  586.51 (B)    Error:  -99.79 (A)  90"
+    ".62 (B)    Time:  0.44                                \r";
+///@endcond
+
+#endif //SERIAL_LOG_H
@@ -0,0 +1,124 @@
+/** @file       test_trace_to_chrome.cpp
+ *  @brief      This file contains the host tests of the trace tool in tools/: a serial log saved from the laser,
+ *              with a @c $TR printout in among the motor test's status lines, is fed through it.
+ *  @details    Run on a PC with @c pio @c test @c -e @c native.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include <unity.h>
+#include "libraries&constants.h"
+#include "../../tools/trace_to_chrome.cpp"
+#include "serial_log.h"
+
+
+// ==================================== Functions ====================================
+
+/** @brief      Put some text in a temporary file, ready to read
+ *  @param      text The text
+ *  @returns    The file
+ */
+static FILE *file_of(const char *text)
+{
+    FILE *file = tmpfile();
+    fputs(text, file);
+    rewind(file);
+    return file;
+}
+
+
+void setUp(void)
+{
+}
+
+
+void tearDown(void)
+{
+}
+
+
+/** @brief      The printout is found in the saved log, though the status line before it ends with only a @c \r, and
+ *              all its tasks, queues and events are read
+ */
+void test_serial_log(void)
+{
+    const char *start = strstr(serial_log, "TRACE ");
+    TEST_ASSERT_NOT_NULL(start);
+    TEST_ASSERT_EQUAL('\r', start[-1]);
+
+    printout trace;
+    FILE *file = file_of(serial_log);
+    TEST_ASSERT_TRUE(read_printout(file, trace));
+    fclose(file);
+
+    TEST_ASSERT_EQUAL(1000000000, trace.clock_rate);
+    TEST_ASSERT_EQUAL(237, trace.events.size());
+    TEST_ASSERT_EQUAL(8, trace.tasks.size());
+    TEST_ASSERT_EQUAL_STRING("Reading Serial", trace.tasks[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("Motor Test", trace.tasks[5].c_str());
+    TEST_ASSERT_EQUAL_STRING("Setpoint", trace.queues[11].c_str());
+    for (size_t index = 1; index < trace.events.size(); index++)
+    {
+        TEST_ASSERT_TRUE(trace.events[index].time >= trace.events[index - 1].time);
+    }
+}
+
+
+/** @brief      The Chrome trace made from the log is one JSON object, with a row for each task
+ */
+void test_chrome_trace(void)
+{
+    printout trace;
+    FILE *file = file_of(serial_log);
+    TEST_ASSERT_TRUE(read_printout(file, trace));
+    fclose(file);
+
+    file = tmpfile();
+    write_chrome_trace(trace, file);
+    std::string json(ftell(file), '\0');
+    rewind(file);
+    TEST_ASSERT_EQUAL(json.size(), fread(&json[0], 1, json.size(), file));
+    fclose(file);
+
+    TEST_ASSERT_EQUAL(0, json.find("{\"displayTimeUnit\""));
+    TEST_ASSERT_EQUAL(json.size() - 4, json.rfind("\n]}\n"));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, json.find("\"args\":{\"name\":\"Motor Test\"}"));
+    TEST_ASSERT_EQUAL(std::count(json.begin(), json.end(), '{'), std::count(json.begin(), json.end(), '}'));
+}
+
+
+/** @brief      A log cut off before the printout's @c END has no whole printout, and a log with two has the last one
+ */
+void test_whole_printouts(void)
+{
+    printout trace;
+    FILE *file = file_of("ok\r\nTRACE 1000 1\nT 1 First\nE 0000000001010000\n");
+    TEST_ASSERT_FALSE(read_printout(file, trace));
+    fclose(file);
+
+    file = file_of("TRACE 1000 1\nT 1 First\nEND\nStatus\rTRACE 2000 2\nT 1 Second\n"
+                   "E 0000000001010000 0000000502010000\nEND\r\n");
+    TEST_ASSERT_TRUE(read_printout(file, trace));
+    fclose(file);
+    TEST_ASSERT_EQUAL(2000, trace.clock_rate);
+    TEST_ASSERT_EQUAL_STRING("Second", trace.tasks[1].c_str());
+    TEST_ASSERT_EQUAL(2, trace.events.size());
+    TEST_ASSERT_EQUAL(5, trace.events[1].time);
+    TEST_ASSERT_EQUAL(TRACE_TASK_OUT, trace.events[1].kind);
+}
+
+
+/** @brief      Run the trace tool's tests
+ *  @returns    The number of tests which failed
+ */
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_serial_log);
+    RUN_TEST(test_chrome_trace);
+    RUN_TEST(test_whole_printouts);
+    return UNITY_END();
+}
@@ -0,0 +1,200 @@
+/** @file       binary_benchmark.cpp
+ *  @brief      This file contains a PC program which works out how many moves a second a 115200 baud link carries
+ *              as text gcode, with and without the @c Ready? handshake, and as binary frames.
+ *  @details    Run it on a gcode file, or with no file on a test path of short engraving moves:
+ *
+ *                  g++ -std=c++17 -O2 -o binary_benchmark tools/binary_benchmark.cpp
+ *                  ./binary_benchmark job.gcode
+ *
+ *              The frames are made with the reference encoder in binary_encoder.h, and every one is checked the
+ *              way the laser checks it, so the benchmark also catches an encoder which makes bad frames. The link
+ *              is simulated: each byte takes 10 bits at 115200 baud, and with the handshake every line also waits
+ *              for @c Ready? and @c Ready to cross and for the laser's reader task to see them.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "binary_encoder.h"
+
+
+///@cond
+// Serial link: 115200 baud, 8N1 is 10 bits a byte
+#define BYTES_PER_SECOND (115200/10)
+
+// Time the host waits between hearing Ready and sending the line, plus the time the laser takes to see Ready?
+#define HANDSHAKE_TURNAROUND 0.012
+///@endcond
+
+
+// ==================================== Functions ====================================
+
+/** @brief      Read the words of a G0 or G1 line
+ *  @details    S is scaled like the laser does it: S1.00 is 100%.
+ *  @param      line The line
+ *  @param      words Filled with each letter's number
+ *  @returns    @c true for a G0 or G1 line
+ */
+static bool read_move(const std::string &line, std::map<char, double> &words)
+{
+    words.clear();
+    std::string text = line.substr(0, line.find(';'));
+    const char *p = text.c_str();
+    while (*p != '\0')
+    {
+        if (isspace((unsigned char)*p))
+        {
+            p++;
+            continue;
+        }
+        char letter = (char)toupper((unsigned char)*p);
+        char *end;
+        double value = strtod(p + 1, &end);
+        if (end == p + 1)
+        {
+            return false;
+        }
+        words[letter] = value;
+        p = end;
+    }
+    if (words.count('G') == 0 || (words['G'] != 0 && words['G'] != 1))
+    {
+        return false;
+    }
+    if (words.count('S'))
+    {
+        words['S'] *= 100;
+    }
+    return true;
+}
+
+
+/** @brief      Check a frame the way the laser's decoder does
+ *  @param      frame The frame
+ *  @param      seq The sequence number it should have
+ *  @returns    @c true if its sync byte, length, sequence number and CRC are right
+ */
+static bool check_frame(const std::vector<uint8_t> &frame, uint8_t seq)
+{
+    if (frame.size() < 4 || frame[0] != BIN_SYNC || frame[2] != seq)
+    {
+        return false;
+    }
+    uint8_t opcode = frame[1];
+    size_t length = 4;
+    if ((opcode & 0x0F) == BIN_OP_MOVE)
+    {
+        length += ((opcode & BIN_FLAG_ABS) ? 8 : 4) + ((opcode & BIN_FLAG_S) ? 1 : 0) + ((opcode & BIN_FLAG_F) ? 2 : 0);
+    }
+    return frame.size() == length && binary_encoder::crc8(&frame[1], frame.size() - 2) == frame.back();
+}
+
+
+/** @brief      Make a test path of short cutting moves and the travel between them, like an engraved raster
+ *  @returns    The gcode lines
+ */
+static std::vector<std::string> test_path(void)
+{
+    std::vector<std::string> data = {"G21", "G90", "G0 X0.00 Y0.00"};
+    char line[64];
+    for (int row = 0; row < 50; row++)
+    {
+        double y = row*0.2;
+        snprintf(line, sizeof(line), "G0 X0.00 Y%.2f", y);
+        data.push_back(line);
+        for (int col = 1; col < 40; col++)
+        {
+            snprintf(line, sizeof(line), "G1 X%.2f Y%.2f S%.2f F1200", col*0.25, y + 0.01*(col % 3),
+                     0.5 + 0.01*(col % 5));
+            data.push_back(line);
+        }
+    }
+    return data;
+}
+
+
+/** @brief      Encode a job as binary frames and print how fast each way of sending it goes
+ *  @param      argc Number of arguments
+ *  @param      argv A gcode file, optional
+ *  @returns    0, or 1 if the file couldn't be read or a frame was bad
+ */
+int main(int argc, char **argv)
+{
+    std::vector<std::string> data;
+    if (argc > 1)
+    {
+        FILE *file = fopen(argv[1], "r");
+        if (file == NULL)
+        {
+            fprintf(stderr, "Can't open %s\n", argv[1]);
+            return 1;
+        }
+        char line[256];
+        while (fgets(line, sizeof(line), file) != NULL)
+        {
+            line[strcspn(line, "\r\n")] = '\0';
+            data.push_back(line);
+        }
+        fclose(file);
+    }
+    else
+    {
+        data = test_path();
+    }
+
+    binary_encoder encoder;
+    std::map<char, double> words;
+    size_t moves = 0;
+    size_t text_bytes = 0;
+    size_t binary_bytes = 0;
+    double X = 0;
+    double Y = 0;
+    uint8_t seq = 0;
+    for (const std::string &line : data)
+    {
+        if (!read_move(line, words))
+        {
+            continue;
+        }
+        X = words.count('X') ? words['X'] : X;
+        Y = words.count('Y') ? words['Y'] : Y;
+        std::vector<uint8_t> frame = encoder.move(X, Y, words.count('S') ? words['S'] : -1,
+                                                  words.count('F') ? words['F'] : -1, words['G'] == 0);
+        if (!check_frame(frame, seq++))
+        {
+            fprintf(stderr, "Bad frame for \"%s\"\n", line.c_str());
+            return 1;
+        }
+        moves++;
+        text_bytes += line.size() + 1;          // +1 for the end of the line
+        binary_bytes += frame.size();
+    }
+    binary_bytes += encoder.end().size();
+    if (moves == 0)
+    {
+        fprintf(stderr, "No G0 or G1 moves\n");
+        return 1;
+    }
+
+    //Handshake: every line waits for the question and the answer to cross the link, one after the other
+    size_t handshake_bytes = moves*(strlen("Ready?") + 1 + strlen("Ready\n"));
+    double text_time = (double)(text_bytes + handshake_bytes)/BYTES_PER_SECOND + moves*HANDSHAKE_TURNAROUND;
+    double stream_time = (double)text_bytes/BYTES_PER_SECOND;
+    double binary_time = (double)binary_bytes/BYTES_PER_SECOND;
+
+    printf("Moves:                   %zu\n", moves);
+    printf("Text bytes per move:     %.1f\n", (double)text_bytes/moves);
+    printf("Binary bytes per move:   %.1f\n", (double)binary_bytes/moves);
+    printf("Text with handshake:     %.0f moves/s\n", moves/text_time);
+    printf("Text without handshake:  %.0f moves/s\n", moves/stream_time);
+    printf("Binary frames:           %.0f moves/s\n", moves/binary_time);
+    return 0;
+}
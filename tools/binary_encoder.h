@@ -0,0 +1,187 @@
+/** @file       binary_encoder.h
+ *  @brief      This file contains the reference encoder for the binary motion protocol, for PC programs which send
+ *              moves to the laser as binary frames instead of text gcode.
+ *  @details    The frame layout is described in src/binary_protocol.h, and the constants here must match it. The
+ *              encoder keeps the last position, S, F and sequence number, the same way @c binary_decoder does on
+ *              the laser, so each frame only carries what changed. The first move, and any move too far from the
+ *              last one for an @c int16_t change, is sent absolute.
+ *
+ *              It is only this header, with nothing from the firmware, so a host program just includes it; see
+ *              binary_benchmark.cpp. Binary_coms.py has the same encoder in Python for the laser's GUI.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#ifndef BINARY_ENCODER_H
+#define BINARY_ENCODER_H
+
+#include <stdint.h>
+#include <math.h>
+#include <vector>
+
+// ========================================== Constants ==========================================
+
+///@cond
+// These must match src/binary_protocol.h
+#define BIN_SYNC 0xA5
+#define BIN_OP_MOVE 0x01
+#define BIN_OP_END 0x0F
+#define BIN_FLAG_TRAVEL 0x10
+#define BIN_FLAG_ABS 0x20
+#define BIN_FLAG_S 0x40
+#define BIN_FLAG_F 0x80
+#define BIN_POS_SCALE 100
+
+// Feedrate the laser starts with, from gcode.h
+#define BIN_START_F 600
+///@endcond
+
+
+// =========================================== Classes ===========================================
+
+/** @brief      Class which turns moves into binary frames for the laser.
+ *  @details    See the top of this file. @c S and @c F are left out of a frame unless they change; pass a negative
+ *              number for one which isn't given.
+ */
+class binary_encoder
+{
+    protected:
+    uint8_t _seq;                           // Sequence number of the next frame
+    bool _position_known;                   // True once a move has been made since reset()
+    int32_t _X_fixed;                       // Last X position in fixed point
+    int32_t _Y_fixed;                       // Last Y position in fixed point
+    uint8_t _S;                             // Last S, in percent
+    uint16_t _F;                            // Last F, in mm/min
+
+    /** @brief      Finish a frame: put the sync byte in front and the CRC and sequence number in
+     *  @param      opcode The opcode byte, with its flags
+     *  @param      payload The payload
+     *  @returns    The frame
+     */
+    std::vector<uint8_t> frame(uint8_t opcode, const std::vector<uint8_t> &payload)
+    {
+        std::vector<uint8_t> bytes;
+        bytes.reserve(payload.size() + 4);
+        bytes.push_back(BIN_SYNC);
+        bytes.push_back(opcode);
+        bytes.push_back(_seq);
+        for (uint8_t byte : payload)
+        {
+            bytes.push_back(byte);
+        }
+        bytes.push_back(crc8(&bytes[1], bytes.size() - 1));
+        _seq++;
+        return bytes;
+    }
+
+    /** @brief      Add a number to a payload, little endian
+     *  @param      payload The payload
+     *  @param      value The number
+     *  @param      size Bytes to add
+     */
+    static void put_bytes(std::vector<uint8_t> &payload, uint32_t value, uint8_t size)
+    {
+        for (uint8_t index = 0; index < size; index++)
+        {
+            payload.push_back((uint8_t)(value >> (8*index)));
+        }
+    }
+
+    public:
+    /** @brief      Constructor for the binary_encoder class
+     */
+    binary_encoder(void)
+    {
+        reset();
+    }
+
+    /** @brief      Start over, as when @c $B is sent; the next move is absolute
+     */
+    void reset(void)
+    {
+        _seq = 0;
+        _position_known = false;
+        _X_fixed = 0;
+        _Y_fixed = 0;
+        _S = 0;
+        _F = BIN_START_F;
+    }
+
+    /** @brief      Make a move frame
+     *  @param      X X position in mm
+     *  @param      Y Y position in mm
+     *  @param      S Power in percent, 0 to 100, or negative if not given; not used for travel moves
+     *  @param      F Feedrate in mm/min, or negative if not given; not used for travel moves
+     *  @param      travel @c true for a G0 travel move, @c false for a G1 cutting move
+     *  @returns    The frame
+     */
+    std::vector<uint8_t> move(double X, double Y, double S = -1, double F = -1, bool travel = false)
+    {
+        int32_t X_fixed = (int32_t)lround(X*BIN_POS_SCALE);
+        int32_t Y_fixed = (int32_t)lround(Y*BIN_POS_SCALE);
+        int64_t dX = (int64_t)X_fixed - _X_fixed;
+        int64_t dY = (int64_t)Y_fixed - _Y_fixed;
+        uint8_t opcode = BIN_OP_MOVE | (travel ? BIN_FLAG_TRAVEL : 0);
+        std::vector<uint8_t> payload;
+
+        if (!_position_known || dX < INT16_MIN || dX > INT16_MAX || dY < INT16_MIN || dY > INT16_MAX)
+        {
+            opcode |= BIN_FLAG_ABS;
+            put_bytes(payload, (uint32_t)X_fixed, 4);
+            put_bytes(payload, (uint32_t)Y_fixed, 4);
+        }
+        else
+        {
+            put_bytes(payload, (uint32_t)(int16_t)dX, 2);
+            put_bytes(payload, (uint32_t)(int16_t)dY, 2);
+        }
+        _X_fixed = X_fixed;
+        _Y_fixed = Y_fixed;
+        _position_known = true;
+
+        if (!travel && S >= 0 && lround(S) != _S)
+        {
+            _S = (uint8_t)lround(S);
+            opcode |= BIN_FLAG_S;
+            put_bytes(payload, _S, 1);
+        }
+        if (!travel && F >= 0 && lround(F) != _F)
+        {
+            _F = (uint16_t)lround(F);
+            opcode |= BIN_FLAG_F;
+            put_bytes(payload, _F, 2);
+        }
+        return frame(opcode, payload);
+    }
+
+    /** @brief      Make the frame which ends binary mode
+     *  @returns    The frame
+     */
+    std::vector<uint8_t> end(void)
+    {
+        return frame(BIN_OP_END, std::vector<uint8_t>());
+    }
+
+    /** @brief      Calculate the CRC-8 (polynomial 0x07) of some bytes, the same as @c crc8() on the laser
+     *  @param      data The bytes
+     *  @param      length Number of bytes
+     *  @returns    The CRC
+     */
+    static uint8_t crc8(const uint8_t *data, size_t length)
+    {
+        uint8_t crc = 0;
+        for (size_t index = 0; index < length; index++)
+        {
+            crc ^= data[index];
+            for (uint8_t bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+            }
+        }
+        return crc;
+    }
+};
+
+
+#endif //BINARY_ENCODER_H
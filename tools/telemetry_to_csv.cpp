@@ -0,0 +1,443 @@
+/** @file       telemetry_to_csv.cpp
+ *  @brief      This file contains a PC program which decodes the binary telemetry the laser sends after @c $TM and
+ *              writes it to a CSV file, one row a frame, for tuning the control loop.
+ *  @details    Save a raw capture of the serial port and run:
+ *
+ *                  g++ -std=c++17 -O2 -o telemetry_to_csv tools/telemetry_to_csv.cpp
+ *                  ./telemetry_to_csv capture.bin telemetry.csv [decimation]
+ *
+ *              With no files it checks the decoder on made up frames and prints the link budget of each set of
+ *              fields at the full control rate.
+ *
+ *              The frame layout is described in src/telemetry.h, and the constants here must match it. Frames
+ *              come mixed in with text lines on the same port; a frame starts with the sync byte and is only taken
+ *              if its CRC is right, so text which happens to hold the sync byte is passed over. The sequence
+ *              number counts control loop samples, so gaps bigger than the decimation are frames that were lost.
+ *              If the decimation isn't given, the smallest gap is taken to be it.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+
+///@cond
+// These must match src/telemetry.h
+#define TELEM_SYNC 0xA6
+#define TELEM_FIELD_TIME 0x01
+#define TELEM_FIELD_SETPOINT 0x02
+#define TELEM_FIELD_POSITION 0x04
+#define TELEM_FIELD_ERROR 0x08
+#define TELEM_FIELD_DUTY 0x10
+#define TELEM_FIELD_S 0x20
+#define TELEM_FIELD_ALL 0x3F
+#define TELEM_MAX_SAMPLE_RATE 100                   // 1000/encoder_A_period
+#define TELEM_MAX_BYTES_PER_SEC (115200/10*3/4)
+
+// Each field: its bit, its CSV columns and its bytes, in the order fields are packed
+struct field_layout
+{
+    uint8_t bit;
+    const char *columns[2];
+    uint8_t size;
+};
+
+static const field_layout fields_packed[] =
+{
+    {TELEM_FIELD_TIME,     {"time_s", NULL},             4},
+    {TELEM_FIELD_SETPOINT, {"A_setpoint", "B_setpoint"}, 8},
+    {TELEM_FIELD_POSITION, {"A_pos", "B_pos"},           8},
+    {TELEM_FIELD_ERROR,    {"A_error", "B_error"},       8},
+    {TELEM_FIELD_DUTY,     {"A_duty", "B_duty"},         4},
+    {TELEM_FIELD_S,        {"S", NULL},                  1},
+};
+
+// One decoded frame; a field's values are only meaningful if its bit is in fields
+struct telemetry_row
+{
+    uint8_t fields;
+    uint8_t seq;
+    double values[6][2];                    // By field, in the order of fields_packed
+};
+///@endcond
+
+
+// ==================================== Functions ====================================
+
+/** @brief      Calculate the CRC-8 (polynomial 0x07) of some bytes, the same as @c crc8() on the laser
+ *  @param      data The bytes
+ *  @param      length Number of bytes
+ *  @returns    The CRC
+ */
+static uint8_t crc8(const uint8_t *data, size_t length)
+{
+    uint8_t crc = 0;
+    for (size_t index = 0; index < length; index++)
+    {
+        crc ^= data[index];
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+
+/** @brief      Work out how many bytes a frame with some fields takes
+ *  @param      fields The @c TELEM_FIELD_ bits
+ *  @returns    Bytes in the frame, including sync, fields byte, sequence number and CRC
+ */
+static size_t frame_size(uint8_t fields)
+{
+    size_t size = 4;
+    for (const field_layout &field : fields_packed)
+    {
+        size += (fields & field.bit) ? field.size : 0;
+    }
+    return size;
+}
+
+
+/** @brief      Read a little endian number from a frame
+ *  @param      p Where it starts
+ *  @param      size Bytes in it
+ *  @returns    The number
+ */
+static uint32_t read_bytes(const uint8_t *p, uint8_t size)
+{
+    uint32_t value = 0;
+    for (uint8_t index = 0; index < size; index++)
+    {
+        value |= (uint32_t)p[index] << (8*index);
+    }
+    return value;
+}
+
+
+/** @brief      Read a @c float from a frame
+ *  @param      p Where it starts
+ *  @returns    The number
+ */
+static double read_float(const uint8_t *p)
+{
+    uint32_t bits = read_bytes(p, 4);
+    float value;
+    memcpy(&value, &bits, 4);
+    return value;
+}
+
+
+/** @brief      Find and unpack every frame in a stream of bytes
+ *  @param      data The bytes
+ *  @param      bad Set to the number of sync bytes which didn't start a frame with a good CRC
+ *  @returns    The frames, in order
+ */
+static std::vector<telemetry_row> decode_stream(const std::vector<uint8_t> &data, size_t &bad)
+{
+    std::vector<telemetry_row> rows;
+    bad = 0;
+    size_t index = 0;
+    while (index < data.size())
+    {
+        if (data[index] != TELEM_SYNC || index + 3 > data.size())
+        {
+            index++;
+            continue;
+        }
+        uint8_t fields = data[index + 1];
+        size_t size = frame_size(fields);
+        if ((fields & ~TELEM_FIELD_ALL) != 0 || index + size > data.size()
+            || crc8(&data[index + 1], size - 2) != data[index + size - 1])
+        {
+            bad++;
+            index++;
+            continue;
+        }
+
+        telemetry_row row = {};
+        row.fields = fields;
+        row.seq = data[index + 2];
+        const uint8_t *p = &data[index + 3];
+        for (uint8_t field = 0; field < 6; field++)
+        {
+            uint8_t bit = fields_packed[field].bit;
+            if (!(fields & bit))
+            {
+                continue;
+            }
+            if (bit == TELEM_FIELD_TIME)
+            {
+                row.values[field][0] = read_bytes(p, 4)/1e6;
+            }
+            else if (bit == TELEM_FIELD_DUTY)
+            {
+                row.values[field][0] = (int16_t)read_bytes(p, 2)/100.0;
+                row.values[field][1] = (int16_t)read_bytes(p + 2, 2)/100.0;
+            }
+            else if (bit == TELEM_FIELD_S)
+            {
+                row.values[field][0] = *p;
+            }
+            else
+            {
+                row.values[field][0] = read_float(p);
+                row.values[field][1] = read_float(p + 4);
+            }
+            p += fields_packed[field].size;
+        }
+        rows.push_back(row);
+        index += size;
+    }
+    return rows;
+}
+
+
+/** @brief      Count frames lost from the gaps in the sequence numbers
+ *  @param      rows The frames
+ *  @param      decimation The gap between frames that come one after the other, or 0 to take the smallest gap
+ *  @returns    Frames lost
+ */
+static long count_lost(const std::vector<telemetry_row> &rows, int decimation)
+{
+    std::vector<int> gaps;
+    for (size_t index = 1; index < rows.size(); index++)
+    {
+        gaps.push_back((uint8_t)(rows[index].seq - rows[index - 1].seq));
+    }
+    if (decimation <= 0)
+    {
+        decimation = 256;
+        for (int gap : gaps)
+        {
+            decimation = (gap > 0 && gap < decimation) ? gap : decimation;
+        }
+        decimation = (decimation == 256) ? 1 : decimation;
+    }
+    long lost = 0;
+    for (int gap : gaps)
+    {
+        long missing = lround((double)gap/decimation) - 1;
+        lost += (missing > 0) ? missing : 0;
+    }
+    return lost;
+}
+
+
+/** @brief      Write frames to a CSV file, with a column for every field in any frame
+ *  @param      rows The frames
+ *  @param      file Where to write
+ */
+static void write_csv(const std::vector<telemetry_row> &rows, FILE *file)
+{
+    uint8_t used = 0;
+    for (const telemetry_row &row : rows)
+    {
+        used |= row.fields;
+    }
+
+    fprintf(file, "seq");
+    for (const field_layout &field : fields_packed)
+    {
+        for (uint8_t column = 0; column < 2 && (used & field.bit) && field.columns[column] != NULL; column++)
+        {
+            fprintf(file, ",%s", field.columns[column]);
+        }
+    }
+    fprintf(file, "\n");
+
+    for (const telemetry_row &row : rows)
+    {
+        fprintf(file, "%u", (unsigned)row.seq);
+        for (uint8_t field = 0; field < 6; field++)
+        {
+            for (uint8_t column = 0; column < 2 && (used & fields_packed[field].bit)
+                                     && fields_packed[field].columns[column] != NULL; column++)
+            {
+                if (row.fields & fields_packed[field].bit)
+                {
+                    fprintf(file, ",%.9g", row.values[field][column]);
+                }
+                else
+                {
+                    fprintf(file, ",");
+                }
+            }
+        }
+        fprintf(file, "\n");
+    }
+}
+
+
+/** @brief      Pack a frame the same way @c pack_telemetry() does on the laser, to check the decoder with
+ *  @param      fields The @c TELEM_FIELD_ bits to put in
+ *  @param      seq The sequence number
+ *  @param      row The values, by field like a decoded frame
+ *  @returns    The frame
+ */
+static std::vector<uint8_t> pack_frame(uint8_t fields, uint8_t seq, const telemetry_row &row)
+{
+    std::vector<uint8_t> frame = {TELEM_SYNC, fields, seq};
+    auto put = [&frame](uint32_t value, uint8_t size)
+    {
+        for (uint8_t index = 0; index < size; index++)
+        {
+            frame.push_back((uint8_t)(value >> (8*index)));
+        }
+    };
+    for (uint8_t field = 0; field < 6; field++)
+    {
+        uint8_t bit = fields_packed[field].bit;
+        if (!(fields & bit))
+        {
+            continue;
+        }
+        if (bit == TELEM_FIELD_TIME)
+        {
+            put((uint32_t)(row.values[field][0]*1e6), 4);
+        }
+        else if (bit == TELEM_FIELD_DUTY)
+        {
+            put((uint16_t)(int16_t)lround(row.values[field][0]*100), 2);
+            put((uint16_t)(int16_t)lround(row.values[field][1]*100), 2);
+        }
+        else if (bit == TELEM_FIELD_S)
+        {
+            put((uint8_t)row.values[field][0], 1);
+        }
+        else
+        {
+            for (uint8_t column = 0; column < 2; column++)
+            {
+                float value = (float)row.values[field][column];
+                uint32_t bits;
+                memcpy(&bits, &value, 4);
+                put(bits, 4);
+            }
+        }
+    }
+    frame.push_back(crc8(&frame[1], frame.size() - 1));
+    return frame;
+}
+
+
+/** @brief      Check the decoder on made up frames mixed with text, some dropped
+ *  @returns    @c true if every frame sent was decoded and the lost ones were counted
+ */
+static bool self_test(void)
+{
+    static const char text[] = "ok\n<Idle|MPos:0.000,0.000|Buf:0|FS:0,0|Ov:100>\n\xA6x\n";
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> sent;
+    long lost = 0;
+    uint32_t random = 507;
+    for (int seq = 0; seq < 1000; seq += 2)
+    {
+        random = random*1103515245 + 12345;
+        if ((random >> 16) % 100 == 0)
+        {
+            lost++;
+            continue;
+        }
+        telemetry_row row = {};
+        row.values[0][0] = seq*0.01;
+        row.values[1][0] = seq*0.1;         row.values[1][1] = -seq*0.1;
+        row.values[2][0] = seq*0.1 - 0.05;  row.values[2][1] = -seq*0.1 + 0.05;
+        row.values[3][0] = 0.05;            row.values[3][1] = -0.05;
+        row.values[4][0] = 12.34;           row.values[4][1] = -56.78;
+        row.values[5][0] = seq % 101;
+        std::vector<uint8_t> frame = pack_frame(TELEM_FIELD_ALL, (uint8_t)seq, row);
+        stream.insert(stream.end(), frame.begin(), frame.end());
+        sent.push_back((uint8_t)seq);
+        if ((random >> 16) % 20 == 1)
+        {
+            stream.insert(stream.end(), text, text + sizeof(text) - 1);
+        }
+    }
+
+    size_t bad;
+    std::vector<telemetry_row> rows = decode_stream(stream, bad);
+    bool match = (rows.size() == sent.size());
+    for (size_t index = 0; match && index < rows.size(); index++)
+    {
+        match = (rows[index].seq == sent[index]) && fabs(rows[index].values[4][1] + 56.78) < 1e-9;
+    }
+    long found = count_lost(rows, 2);
+    printf("Self test: %zu frames sent, %zu decoded, %s, %ld lost frames found of %ld, %zu false syncs passed over\n",
+           sent.size(), rows.size(), match ? "all match" : "FRAMES DO NOT MATCH", found, lost, bad);
+    return match && found == lost;
+}
+
+
+/** @brief      Print how many bytes a second each set of fields takes at the full control rate
+ */
+static void link_budget(void)
+{
+    static const struct { const char *name; uint8_t fields; } sets[] =
+    {
+        {"time, setpoints, positions",          0x07},
+        {"time, positions, duty",               0x15},
+        {"time, setpoints, positions, duty, S", 0x37},
+        {"all",                                 TELEM_FIELD_ALL},
+    };
+    printf("Fields                               Bytes  Bytes/s at %d Hz  (limit %d)\n", TELEM_MAX_SAMPLE_RATE,
+           TELEM_MAX_BYTES_PER_SEC);
+    for (const auto &set : sets)
+    {
+        size_t rate = frame_size(set.fields)*TELEM_MAX_SAMPLE_RATE;
+        printf("%-36s %5zu  %16zu  %s\n", set.name, frame_size(set.fields), rate,
+               rate <= TELEM_MAX_BYTES_PER_SEC ? "ok" : "too much");
+    }
+    printf("Text lines of about 80 bytes at %d Hz would need %d bytes/s\n", TELEM_MAX_SAMPLE_RATE,
+           80*TELEM_MAX_SAMPLE_RATE);
+}
+
+
+/** @brief      Decode a capture to CSV, or check the decoder with no arguments
+ *  @param      argc Number of arguments
+ *  @param      argv The capture's file, the CSV file and the decimation, which is optional
+ *  @returns    0 if it worked, 1 if not
+ */
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        bool passed = self_test();
+        link_budget();
+        return passed ? 0 : 1;
+    }
+
+    FILE *in = fopen(argv[1], "rb");
+    if (in == NULL)
+    {
+        fprintf(stderr, "Can't open %s\n", argv[1]);
+        return 1;
+    }
+    std::vector<uint8_t> data;
+    int byte;
+    while ((byte = fgetc(in)) != EOF)
+    {
+        data.push_back((uint8_t)byte);
+    }
+    fclose(in);
+
+    size_t bad;
+    std::vector<telemetry_row> rows = decode_stream(data, bad);
+    FILE *out = fopen(argv[2], "w");
+    if (out == NULL)
+    {
+        fprintf(stderr, "Can't write %s\n", argv[2]);
+        return 1;
+    }
+    write_csv(rows, out);
+    fclose(out);
+    printf("%zu frames written to %s, %ld lost, %zu false syncs\n", rows.size(), argv[2],
+           count_lost(rows, (argc > 3) ? atoi(argv[3]) : 0), bad);
+    return 0;
+}
@@ -0,0 +1,330 @@
+/** @file       trace_to_chrome.cpp
+ *  @brief      This file contains a PC program which turns the laser's trace printout into a Chrome trace, to look
+ *              at in chrome://tracing or ui.perfetto.dev.
+ *  @details    Save what the laser prints for @c $TR (see src/trace.h) and run:
+ *
+ *                  g++ -std=c++17 -O2 -o trace_to_chrome tools/trace_to_chrome.cpp
+ *                  ./trace_to_chrome serial_log.txt trace.json
+ *
+ *              With no files it reads standard input and writes standard output. Lines which aren't part of a
+ *              printout, like status reports and @c ok, are skipped, so a whole serial log can be given; if it has
+ *              more than one printout, the last whole one is used. A line ends at @c \n or @c \r, as the motor
+ *              test's status lines end with only a @c \r and the printout comes straight after one.
+ *
+ *              Each task is a row, with a slice for each time it had the CPU. Each queue and ring is a counter of
+ *              the items in it, worked out from the puts and gets: the trace doesn't hold how full it was when it
+ *              starts, so the count starts at whatever makes its lowest point 0. The laser power is a counter too,
+ *              and ramp segments and markers are marks across the whole trace.
+ *
+ *              The trace clock is 32 bits and wraps, about once a minute on the board and every 4 seconds on a PC.
+ *              A gap between two events longer than that can't be seen, but task switches come far more often.
+ *
+ *  @date    10-19-2026 File Created
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+
+///@cond
+// Kinds of event and markers, the same as in src/trace.h
+#define TRACE_TASK_IN 1
+#define TRACE_TASK_OUT 2
+#define TRACE_QUEUE_PUT 3
+#define TRACE_QUEUE_GET 4
+#define TRACE_SEGMENT 5
+#define TRACE_LASER 6
+#define TRACE_MARK 7
+
+static const char *const marker_names[] = {"marker", "line", "reset", "job start", "job end", "homing"};
+
+// One event from the printout, with its time unwrapped
+struct event
+{
+    uint64_t time;                          // Trace clock counts since the first event
+    uint8_t kind;                           // TRACE_ kind
+    uint8_t id;                             // Task, queue or marker
+    uint16_t arg;                           // Number that goes with it
+};
+
+// One printout
+struct printout
+{
+    uint32_t clock_rate = 0;                // Trace clock counts a second
+    std::map<int, std::string> tasks;       // Task names by number
+    std::map<int, std::string> queues;      // Queue and share names by number
+    std::vector<event> events;              // Oldest first
+};
+///@endcond
+
+
+// ==================================== Functions ====================================
+
+/** @brief      Read one line of a serial log, which ends at @c \n or @c \r
+ *  @param      file The file
+ *  @param      line Filled with the line, without its ending
+ *  @returns    @c false at the end of the file, if there was no line left
+ */
+static bool read_line(FILE *file, std::string &line)
+{
+    line.clear();
+    int c;
+    while ((c = fgetc(file)) != EOF)
+    {
+        if (c == '\n' || c == '\r')
+        {
+            return true;
+        }
+        line += (char)c;
+    }
+    return !line.empty();
+}
+
+
+/** @brief      Read the last whole printout in a file
+ *  @param      file The file
+ *  @param      result Filled with the printout
+ *  @returns    @c true if a whole one was found
+ */
+static bool read_printout(FILE *file, printout &result)
+{
+    std::string text;
+    printout reading;
+    bool in_printout = false;
+    bool found = false;
+    uint32_t last_time = 0;
+
+    while (read_line(file, text))
+    {
+        char *line = &text[0];
+        unsigned long rate, count;
+        int id, name_start;
+
+        if (sscanf(line, "TRACE %lu %lu", &rate, &count) == 2)
+        {
+            reading = printout();
+            reading.clock_rate = (uint32_t)rate;
+            in_printout = true;
+        }
+        else if (!in_printout)
+        {
+            continue;
+        }
+        else if (strcmp(line, "END") == 0)
+        {
+            result = reading;
+            found = true;
+            in_printout = false;
+        }
+        else if (sscanf(line, "T %d %n", &id, &name_start) == 1)
+        {
+            reading.tasks[id] = line + name_start;
+        }
+        else if (sscanf(line, "Q %d %n", &id, &name_start) == 1)
+        {
+            reading.queues[id] = line + name_start;
+        }
+        else if (line[0] == 'E' && line[1] == ' ')
+        {
+            for (char *p = line + 2; strlen(p) >= 16; p += (p[16] == ' ') ? 17 : 16)
+            {
+                char digits[17];
+                memcpy(digits, p, 16);
+                digits[16] = '\0';
+                uint64_t packed = strtoull(digits, NULL, 16);
+                uint32_t time = (uint32_t)(packed >> 32);
+
+                event item;
+                item.time = reading.events.empty() ? 0 : reading.events.back().time + (uint32_t)(time - last_time);
+                item.kind = (uint8_t)(packed >> 24);
+                item.id = (uint8_t)(packed >> 16);
+                item.arg = (uint16_t)packed;
+                reading.events.push_back(item);
+                last_time = time;
+            }
+        }
+    }
+    return found;
+}
+
+
+/** @brief      Put a name in a JSON string, with quotes and backslashes escaped
+ *  @param      name The name
+ *  @returns    The name in quotes
+ */
+static std::string json_string(const std::string &name)
+{
+    std::string quoted = "\"";
+    for (char c : name)
+    {
+        if (c == '"' || c == '\\')
+        {
+            quoted += '\\';
+        }
+        if ((unsigned char)c >= ' ')
+        {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+
+/** @brief      Get a name from a list by number, or make one up
+ *  @param      names The list
+ *  @param      id The number
+ *  @param      kind What it is, for a made up name
+ *  @returns    The name
+ */
+static std::string name_of(const std::map<int, std::string> &names, int id, const char *kind)
+{
+    auto found = names.find(id);
+    return (found != names.end()) ? found->second : std::string(kind) + " " + std::to_string(id);
+}
+
+
+/** @brief      Write a printout as a Chrome trace
+ *  @param      trace The printout
+ *  @param      file Where to write
+ */
+static void write_chrome_trace(const printout &trace, FILE *file)
+{
+    std::map<int, long> items;              // Items in each queue, from the start of the trace
+    std::map<int, long> fewest;             // Fewest items each queue got to
+    for (const event &item : trace.events)
+    {
+        if (item.kind == TRACE_QUEUE_PUT || item.kind == TRACE_QUEUE_GET)
+        {
+            long &count = items[item.id];
+            count += (item.kind == TRACE_QUEUE_PUT) ? item.arg : -(long)item.arg;
+            fewest[item.id] = std::min(fewest[item.id], count);
+        }
+    }
+    items.clear();
+
+    const char *separator = "\n";
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    fprintf(file, "%s{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"Laser\"}}", separator);
+    separator = ",\n";
+    fprintf(file, "%s{\"ph\":\"M\",\"pid\":1,\"tid\":0,\"name\":\"thread_name\",\"args\":{\"name\":\"Idle\"}}",
+            separator);
+    for (const auto &task : trace.tasks)
+    {
+        fprintf(file, "%s{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":%s}}",
+                separator, task.first, json_string(task.second).c_str());
+        fprintf(file, "%s{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_sort_index\",\"args\":"
+                "{\"sort_index\":%d}}", separator, task.first, task.first);
+    }
+
+    std::map<int, bool> running;            // Tasks with a slice started and not ended
+    double last_us = 0;
+    for (const event &item : trace.events)
+    {
+        double us = item.time * 1e6 / trace.clock_rate;
+        last_us = us;
+        switch (item.kind)
+        {
+            case TRACE_TASK_IN:
+                fprintf(file, "%s{\"ph\":\"B\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"name\":%s}", separator, item.id, us,
+                        json_string(item.id == 0 ? "Idle" : name_of(trace.tasks, item.id, "task")).c_str());
+                running[item.id] = true;
+                break;
+
+            case TRACE_TASK_OUT:
+                // A task already running when the trace starts has no start to end
+                if (running[item.id])
+                {
+                    fprintf(file, "%s{\"ph\":\"E\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", separator, item.id, us);
+                    running[item.id] = false;
+                }
+                break;
+
+            case TRACE_QUEUE_PUT:
+            case TRACE_QUEUE_GET:
+            {
+                long &count = items[item.id];
+                count += (item.kind == TRACE_QUEUE_PUT) ? item.arg : -(long)item.arg;
+                fprintf(file, "%s{\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"name\":%s,\"args\":{\"items\":%ld}}", separator,
+                        us, json_string(name_of(trace.queues, item.id, "queue")).c_str(), count - fewest[item.id]);
+                break;
+            }
+
+            case TRACE_SEGMENT:
+                fprintf(file, "%s{\"ph\":\"i\",\"s\":\"p\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"name\":\"segment\","
+                        "\"args\":{\"number\":%u}}", separator, us, (unsigned)item.arg);
+                break;
+
+            case TRACE_LASER:
+                fprintf(file, "%s{\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"name\":\"Laser power\",\"args\":{\"S\":%u}}",
+                        separator, us, (unsigned)item.arg);
+                break;
+
+            case TRACE_MARK:
+            {
+                bool known = item.id < sizeof(marker_names)/sizeof(marker_names[0]);
+                fprintf(file, "%s{\"ph\":\"i\",\"s\":\"p\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"name\":%s,"
+                        "\"args\":{\"id\":%u,\"arg\":%u}}", separator, us,
+                        json_string(known ? marker_names[item.id] : marker_names[0]).c_str(), (unsigned)item.id,
+                        (unsigned)item.arg);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    // End the slices still going at the end of the trace
+    for (const auto &task : running)
+    {
+        if (task.second)
+        {
+            fprintf(file, "%s{\"ph\":\"E\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", separator, task.first, last_us);
+        }
+    }
+    fprintf(file, "\n]}\n");
+}
+
+
+/** @brief      Read a trace printout and write it as a Chrome trace
+ *  @param      argc Number of arguments
+ *  @param      argv The printout's file and the trace's file, both optional
+ *  @details    Left out of the unit tests (@c pio @c test), which have their own @c main() in test/.
+ *  @returns    0 if a trace was written, 1 if not
+ */
+#ifndef PIO_UNIT_TESTING
+int main(int argc, char **argv)
+{
+    FILE *in = (argc > 1) ? fopen(argv[1], "r") : stdin;
+    if (in == NULL)
+    {
+        fprintf(stderr, "Can't open %s\n", argv[1]);
+        return 1;
+    }
+
+    printout trace;
+    if (!read_printout(in, trace) || trace.clock_rate == 0)
+    {
+        fprintf(stderr, "No whole trace printout (TRACE ... END) found\n");
+        return 1;
+    }
+
+    FILE *out = (argc > 2) ? fopen(argv[2], "w") : stdout;
+    if (out == NULL)
+    {
+        fprintf(stderr, "Can't write %s\n", argv[2]);
+        return 1;
+    }
+    write_chrome_trace(trace, out);
+    fprintf(stderr, "%zu events, %zu tasks, %.3f ms\n", trace.events.size(), trace.tasks.size(),
+            trace.events.empty() ? 0.0 : trace.events.back().time * 1e3 / trace.clock_rate);
+    return 0;
+}
+#endif //PIO_UNIT_TESTING